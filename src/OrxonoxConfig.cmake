@@ -61,6 +61,11 @@ IF(ENABLE_BUILD_UNITS)
   ENDIF()
 ENDIF()
 
+# Output with a level above this threshold is removed at compile time from
+# orxout_filtered(). Use an output level name like "internal_info" to strip
+# all verbose output from performance critical code, or "all" to keep it.
+SET(ORXONOX_OUTPUT_LEVEL_MAX "all" CACHE STRING "Maximum output level compiled into orxout_filtered()")
+
 # Use WinMain() or main()?
 IF(WIN32)
   OPTION(ORXONOX_USE_WINMAIN "Use WinMain (doesn't show console) or main" FALSE)
@@ -0,0 +1,98 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+@file
+@brief
+    Entry point of orxonox-metrics-reader which converts a binary metrics stream to the text format.
+
+    Usage: orxonox-metrics-reader <file> [instance]
+
+    Reads the binary stream written by MetricsWriter from the file (or from
+    stdin if the file is "-") and prints one line per metric and snapshot to
+    stdout. The lines can be imported into most time series databases.
+*/
+
+#include "OrxonoxConfig.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "util/Metrics.h"
+
+int main(int argc, char** argv)
+{
+    using namespace orxonox;
+
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <file> [instance]" << std::endl;
+        std::cerr << "Converts a binary metrics stream to the text format. Use '-' to read from stdin." << std::endl;
+        return 1;
+    }
+
+    std::ifstream file;
+    std::istream* stream = &std::cin;
+    if (strcmp(argv[1], "-") != 0)
+    {
+        file.open(argv[1], std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Could not open " << argv[1] << std::endl;
+            return 1;
+        }
+        stream = &file;
+    }
+
+    const std::string instance = (argc > 2 ? argv[2] : "");
+
+    MetricsReader reader;
+    if (!reader.readStreamHeader(*stream))
+    {
+        std::cerr << reader.getError() << std::endl;
+        return 1;
+    }
+
+    std::string lines;
+    while (reader.readRecord(*stream, lines, instance))
+    {
+        std::cout << lines;
+        lines.clear();
+    }
+    std::cout << lines << std::flush;
+
+    if (!reader.getError().empty())
+    {
+        // a stream of a running (or crashed) instance may end with an incomplete record
+        std::cerr << reader.getError() << " after " << reader.getNumSnapshots() << " snapshots" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -54,10 +54,12 @@
 #include "util/Output.h"
 #include "util/Exception.h"
 #include "util/output/LogWriter.h"
+#include "util/output/MemoryWriter.h"
 #include "util/output/OutputManager.h"
 #include "util/Scope.h"
 #include "util/ScopedSingletonManager.h"
 #include "util/SignalHandler.h"
+#include "util/StartupProfiler.h"
 #include "PathConfig.h"
 #include "config/CommandLineParser.h"
 #include "config/ConfigFileManager.h"
@@ -70,6 +72,7 @@
 #include "class/Identifier.h"
 #include "Language.h"
 #include "LuaState.h"
+#include "ModuleLoader.h"
 #include "command/ConsoleCommand.h"
 #include "command/IOConsole.h"
 #include "command/TclBind.h"
@@ -87,6 +90,8 @@ namespace orxonox
     SetCommandLineSwitch(noIOConsole).information("Use this if you don't want to use the IOConsole (for instance for Lua debugging)");
 #endif
 
+    SetCommandLineSwitch(lazyModules).information("Load modules only if a level needs one of their classes (intended for dedicated servers)");
+
 #ifdef ORXONOX_PLATFORM_WINDOWS
     SetCommandLineArgument(limitToCPU, 0).information("Limits the program to one CPU/core (1, 2, 3, etc.). Default is off = 0.");
 #endif
@@ -97,6 +102,7 @@ namespace orxonox
     Core::Core(const std::string& cmdLine)
         : pathConfig_(NULL)
         , dynLibManager_(NULL)
+        , moduleLoader_(NULL)
         , signalHandler_(NULL)
         , configFileManager_(NULL)
         , languageInstance_(NULL)
@@ -117,33 +123,45 @@ namespace orxonox
     {
         orxout(internal_status) << "initializing Core object..." << endl;
 
+        StartupProfiler& profiler = StartupProfiler::getInstance();
+
         // Set the hard coded fixed paths
+        profiler.beginPhase("paths");
         this->pathConfig_ = new PathConfig();
 
         // Create a new dynamic library manager
         this->dynLibManager_ = new DynLibManager();
+        this->moduleLoader_ = new ModuleLoader(this->dynLibManager_);
 
-        // Load modules
-        orxout(internal_info) << "Loading modules:" << endl;
+        // In lazy mode, the modules are loaded after the paths are known because the index of the modules is stored in the config directory
+        const bool bLazyModules = CommandLineParser::containsArgument(cmdLine, "lazyModules");
         const std::vector<std::string>& modulePaths = this->pathConfig_->getModulePaths();
-        for (std::vector<std::string>::const_iterator it = modulePaths.begin(); it != modulePaths.end(); ++it)
+
+        // Load modules
+        if (!bLazyModules)
         {
-            try
-            {
-                this->dynLibManager_->load(*it);
-            }
-            catch (...)
-            {
-                orxout(user_error) << "Couldn't load module \"" << *it << "\": " << Exception::handleMessage() << endl;
-            }
+            profiler.beginPhase("modules");
+            orxout(internal_info) << "Loading modules:" << endl;
+            this->moduleLoader_->loadModules(modulePaths);
         }
 
         // Parse command line arguments AFTER the modules have been loaded (static code!)
+        profiler.beginPhase("command_line");
         CommandLineParser::parse(cmdLine);
 
         // Set configurable paths like log, config and media
         this->pathConfig_->setConfigurablePaths();
 
+        // Deferred modules can't add command line arguments because the command line was already parsed
+        const std::string& moduleIndexFilename = PathConfig::getConfigPathString() + "modules.index";
+        if (bLazyModules)
+        {
+            profiler.beginPhase("modules");
+            orxout(internal_info) << "Loading modules lazily:" << endl;
+            this->moduleLoader_->deferModules(modulePaths, moduleIndexFilename);
+        }
+        this->moduleLoader_->writeIndex(moduleIndexFilename);
+
         orxout(internal_info) << "Root path:       " << PathConfig::getRootPathString() << endl;
         orxout(internal_info) << "Executable path: " << PathConfig::getExecutablePathString() << endl;
         orxout(internal_info) << "Data path:       " << PathConfig::getDataPathString() << endl;
@@ -167,6 +185,7 @@ namespace orxonox
 #endif
 
         // Manage ini files and set the default settings file (usually orxonox.ini)
+        profiler.beginPhase("config");
         orxout(internal_info) << "Loading config:" << endl;
         this->configFileManager_ = new ConfigFileManager();
         this->configFileManager_->setFilename(ConfigFileType::Settings,
@@ -199,18 +218,26 @@ namespace orxonox
 #endif
 
         // creates the class hierarchy for all classes with factories
+        profiler.beginPhase("class_hierarchy");
         orxout(internal_info) << "creating class hierarchy" << endl;
         IdentifierManager::getInstance().createClassHierarchy();
 
+        // From now on, deferred modules are loaded as soon as one of their classes is requested
+        if (bLazyModules)
+            IdentifierManager::getInstance().setModuleLoader(this->moduleLoader_);
+
         // Load OGRE excluding the renderer and the render window
+        profiler.beginPhase("resources");
         orxout(internal_info) << "creating GraphicsManager:" << endl;
         this->graphicsManager_ = new GraphicsManager(false);
 
         // initialise Tcl
+        profiler.beginPhase("tcl");
         this->tclBind_ = new TclBind(PathConfig::getDataPathString());
         this->tclThreadManager_ = new TclThreadManager(tclBind_->getTclInterpreter());
 
         // Create singletons that always exist (in other libraries)
+        profiler.beginPhase("root_scope");
         orxout(internal_info) << "creating root scope:" << endl;
         this->rootScope_ = new Scope<ScopeID::Root>();
 
@@ -229,6 +256,7 @@ namespace orxonox
                 orxout(internal_error) << "Could not open file for documentation writing" << endl;
         }
 
+        profiler.endPhase();
         orxout(internal_status) << "finished initializing Core object" << endl;
     }
 
@@ -239,6 +267,9 @@ namespace orxonox
         // Remove us from the object lists again to avoid problems when destroying them
         this->unregisterObject();
 
+        // Don't load modules while shutting down
+        IdentifierManager::getInstance().setModuleLoader(NULL);
+
         safeObjectDelete(&graphicsScope_);
         safeObjectDelete(&guiManager_);
         safeObjectDelete(&inputManager_);
@@ -253,6 +284,7 @@ namespace orxonox
         Context::setRootContext(NULL);
         IdentifierManager::getInstance().destroyAllIdentifiers();
         safeObjectDelete(&signalHandler_);
+        safeObjectDelete(&moduleLoader_);
         safeObjectDelete(&dynLibManager_);
         safeObjectDelete(&pathConfig_);
 
@@ -280,6 +312,30 @@ namespace orxonox
                                OutputManager::getInstance().getLogWriter()->configurableAdditionalContexts_)
             .description("Additional output contexts shown in the log file")
             .callback(static_cast<BaseWriter*>(OutputManager::getInstance().getLogWriter()), &BaseWriter::changedConfigurableAdditionalContexts);
+        SetConfigValueExternal(OutputManager::getInstance().getLogWriter()->configurableAsynchronous_,
+                               OutputManager::getInstance().getLogWriter()->getConfigurableSectionName(),
+                               OutputManager::getInstance().getLogWriter()->getConfigurableAsynchronousName(),
+                               OutputManager::getInstance().getLogWriter()->configurableAsynchronous_)
+            .description("If true, output is written to the log file by a separate thread")
+            .callback(OutputManager::getInstance().getLogWriter(), &LogWriter::changedConfigurableAsynchronous);
+        SetConfigValueExternal(OutputManager::getInstance().getLogWriter()->configurableQueueCapacity_,
+                               OutputManager::getInstance().getLogWriter()->getConfigurableSectionName(),
+                               OutputManager::getInstance().getLogWriter()->getConfigurableQueueCapacityName(),
+                               OutputManager::getInstance().getLogWriter()->configurableQueueCapacity_)
+            .description("The maximum number of lines which wait to be written to the log file if it is written asynchronously")
+            .callback(OutputManager::getInstance().getLogWriter(), &LogWriter::changedConfigurableQueueCapacity);
+        SetConfigValueExternal(OutputManager::getInstance().getLogWriter()->configurableBlockIfQueueFull_,
+                               OutputManager::getInstance().getLogWriter()->getConfigurableSectionName(),
+                               OutputManager::getInstance().getLogWriter()->getConfigurableBlockIfQueueFullName(),
+                               OutputManager::getInstance().getLogWriter()->configurableBlockIfQueueFull_)
+            .description("If true, the game waits if the log queue is full. Otherwise further output is dropped")
+            .callback(OutputManager::getInstance().getLogWriter(), &LogWriter::changedConfigurableBlockIfQueueFull);
+        SetConfigValueExternal(OutputManager::getInstance().getMemoryWriter()->configurableMaxMessages_,
+                               BaseWriter::getConfigurableSectionName(),
+                               MemoryWriter::getConfigurableMaxMessagesName(),
+                               100000)
+            .description("The maximum number of output messages kept in memory to re-send them to the console or the log file (0 means no limit)")
+            .callback(OutputManager::getInstance().getMemoryWriter(), &MemoryWriter::changedConfigurableMaxMessages);
 
         SetConfigValue(bDevMode_, PathConfig::buildDirectoryRun())
             .description("Developer mode. If not set, hides some things from the user to not confuse him.")
@@ -498,6 +554,9 @@ namespace orxonox
             // Render (doesn't throw)
             this->graphicsManager_->postUpdate(time);
         }
+
+        // Save changed config files in the background
+        this->configFileManager_->update(time);
     }
 
     void Core::updateLastLevelTimestamp()
@@ -121,6 +121,7 @@ namespace orxonox
 
             PathConfig*               pathConfig_;
             DynLibManager*            dynLibManager_;
+            ModuleLoader*             moduleLoader_;
             SignalHandler*            signalHandler_;
             ConfigFileManager*        configFileManager_;
             Language*                 languageInstance_;
@@ -168,6 +168,8 @@ namespace orxonox
     class LuaState;
     class MemoryArchive;
     class MemoryArchiveFactory;
+    class MetricsWriter;
+    class ModuleLoader;
     class Namespace;
     class NamespaceNode;
     template <class T>
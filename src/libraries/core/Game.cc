@@ -41,6 +41,8 @@
 #include "util/Clock.h"
 #include "util/Output.h"
 #include "util/Exception.h"
+#include "util/Metrics.h"
+#include "util/StartupProfiler.h"
 #include "util/Sleep.h"
 #include "util/SubString.h"
 #include "Core.h"
@@ -81,10 +83,14 @@ namespace orxonox
         , core_(NULL)
         , bChangingState_(false)
         , bAbort_(false)
+        , fixedTimeStep_(0)
         , destructionHelper_(this)
     {
         orxout(internal_status) << "initializing Game object..." << endl;
 
+        // The startup time is measured from here
+        StartupProfiler::getInstance().beginPhase("game");
+
 #ifdef ORXONOX_PLATFORM_WINDOWS
         minimumSleepTime_ = 1000/*us*/;
 #else
@@ -111,6 +117,7 @@ namespace orxonox
         this->core_ = new Core(cmdLine);
 
         // Do this after the Core creation!
+        StartupProfiler::getInstance().beginPhase("game_states");
         RegisterObject(Game);
         this->setConfigValues();
 
@@ -128,6 +135,7 @@ namespace orxonox
         this->loadedTopStateNode_ = this->rootStateNode_;
         this->loadedStates_.push_back(this->getState(rootStateNode_->name_));
 
+        StartupProfiler::getInstance().endPhase();
         orxout(internal_status) << "finished initializing Game object" << endl;
     }
 
@@ -176,6 +184,7 @@ namespace orxonox
         // Update the GameState stack if required. We do this already here to have a properly initialized game before entering the main loop
         this->updateGameStateStack();
 
+        StartupProfiler::getInstance().finish();
         orxout(user_status) << "Game loaded" << endl;
         orxout(internal_status) << "-------------------- starting main loop --------------------" << endl;
 
@@ -188,7 +197,10 @@ namespace orxonox
         while (!this->bAbort_ && (!this->loadedStates_.empty() || this->requestedStateNodes_.size() > 0))
         {
             // Generate the dt
-            this->gameClock_->capture();
+            if (this->fixedTimeStep_ > 0)
+                this->gameClock_->advance(this->fixedTimeStep_);
+            else
+                this->gameClock_->capture();
 
             // Statistics init
             StatisticsTickInfo tickInfo = {gameClock_->getMicroseconds(), 0};
@@ -228,7 +240,7 @@ namespace orxonox
 
             // Limit frame rate
             static bool hasVSync = GameMode::showsGraphics() && GraphicsManager::getInstance().hasVSyncEnabled(); // can be static since changes of VSync currently require a restart
-            if (this->fpsLimit_ > 0 && !hasVSync)
+            if (this->fpsLimit_ > 0 && !hasVSync && this->fixedTimeStep_ == 0)
                 this->updateFPSLimiter();
         }
 
@@ -310,6 +322,10 @@ namespace orxonox
         uint64_t currentRealTime = gameClock_->getRealMicroseconds();
         this->statisticsTickTimes_.back().tickLength += (uint32_t)(currentRealTime - currentTime);
         this->periodTickTime_ += (uint32_t)(currentRealTime - currentTime);
+
+        static MetricHistogram& tickTimeMetric = MetricsRegistry::getInstance().registerHistogram("game.tick_time", MetricHistogram::getDefaultTimeBounds());
+        tickTimeMetric.sample(this->statisticsTickTimes_.back().tickLength / 1000000.0);
+
         if (this->periodTime_ > this->statisticsRefreshCycle_)
         {
             std::list<StatisticsTickInfo>::iterator it = this->statisticsTickTimes_.begin();
@@ -332,6 +348,9 @@ namespace orxonox
             this->avgFPS_ = -1 + static_cast<float>(framesPerPeriod) / (currentTime - this->statisticsTickTimes_.front().tickTime) * 1000000.0f;
             this->avgTickTime_ = static_cast<float>(this->periodTickTime_) / framesPerPeriod / 1000.0f;
 
+            static MetricGauge& fpsMetric = MetricsRegistry::getInstance().registerGauge("game.fps");
+            fpsMetric.set(this->avgFPS_);
+
             this->periodTime_ -= this->statisticsRefreshCycle_;
         }
     }
@@ -582,6 +601,9 @@ namespace orxonox
     {
         orxout(internal_status) << "loading state '" << name << "'" << endl;
 
+        // Only measured during the startup, ignored afterwards
+        StartupProfiler::getInstance().beginPhase("state." + name);
+
         this->bChangingState_ = true;
         LOKI_ON_BLOCK_EXIT_OBJ(*this, &Game::resetChangingState); (void)LOKI_ANONYMOUS_VARIABLE(scopeGuard);
 
@@ -600,6 +622,7 @@ namespace orxonox
         state->activity_.topState = true;
 
         graphicsUnloader.Dismiss();
+        StartupProfiler::getInstance().endPhase();
     }
 
     void Game::unloadState(const std::string& name)
@@ -104,6 +104,13 @@ namespace orxonox
         void run();
         void stop();
 
+        /// Runs the game with a fixed time step (in seconds) as fast as possible instead of measuring the real time. 0 restores the normal behaviour.
+        void setFixedTimeStep(float dt)
+            { this->fixedTimeStep_ = static_cast<long>(dt * 1000000.0f); }
+        /// Returns the fixed time step in seconds (0 if the real time is used).
+        float getFixedTimeStep() const
+            { return this->fixedTimeStep_ / 1000000.0f; }
+
         static Game& getInstance(){ return Singleton<Game>::getInstance(); } // tolua_export
 
         void requestState(const std::string& name); //tolua_export
@@ -177,6 +184,7 @@ namespace orxonox
 
         bool                               bChangingState_;
         bool                               bAbort_;
+        long                               fixedTimeStep_;      ///< The fixed time step in microseconds (0 if the real time is used)
 
         // variables for time statistics
         uint64_t                           statisticsStartTime_;
@@ -34,8 +34,10 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 
+#include "util/Clock.h"
 #include "util/Output.h"
 #include "util/Exception.h"
+#include "util/Metrics.h"
 #include "util/StringUtils.h"
 #include "BaseObject.h"
 #include "LuaState.h"
@@ -157,6 +159,9 @@ namespace orxonox
 
         Loader::currentMask_s = file->getMask() * mask;
 
+        // measures the time needed to load the file (used for metrics)
+        Clock loadClock;
+
         std::string xmlInput;
 
         shared_ptr<std::vector<std::vector<std::pair<std::string, size_t> > > > lineTrace(new std::vector<std::vector<std::pair<std::string, size_t> > >());
@@ -230,6 +235,11 @@ namespace orxonox
 
             orxout(verbose, context::loader) << "Namespace-tree:" << '\n' << rootNamespace->toString("  ") << endl;
 
+            static MetricCounter& loadedFilesMetric = MetricsRegistry::getInstance().registerCounter("loader.loaded_files");
+            static MetricHistogram& loadTimeMetric = MetricsRegistry::getInstance().registerHistogram("loader.load_time", MetricHistogram::getDefaultTimeBounds());
+            loadedFilesMetric.add();
+            loadTimeMetric.sample(loadClock.getRealMicroseconds() / 1000000.0);
+
             return true;
         }
         catch (ticpp::Exception& ex)
@@ -0,0 +1,279 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of the MetricsWriter singleton.
+*/
+
+#include "MetricsWriter.h"
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/filesystem.hpp>
+
+#ifdef ORXONOX_PLATFORM_UNIX
+#  include <cerrno>
+#  include <cstring>
+#  include <fcntl.h>
+#  include <sys/socket.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+#endif
+
+#include "util/Clock.h"
+#include "util/Metrics.h"
+#include "util/Output.h"
+#include "util/ScopedSingletonManager.h"
+#include "config/ConfigValueIncludes.h"
+#include "CoreIncludes.h"
+#include "PathConfig.h"
+
+namespace orxonox
+{
+    ManageScopedSingleton(MetricsWriter, ScopeID::Root, false);
+
+    namespace
+    {
+        /// Returns the current time in seconds since the epoch.
+        double getWallTime()
+        {
+            static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+            return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds() / 1000000.0;
+        }
+
+        const std::string UNIX_SOCKET_PREFIX = "unix:";
+    }
+
+    /**
+        @brief Constructor: Initializes the variables and sets the config values.
+    */
+    MetricsWriter::MetricsWriter()
+    {
+        RegisterObject(MetricsWriter);
+
+        this->socket_ = -1;
+        this->bOpen_ = false;
+        this->numDefinedMetrics_ = 0;
+        this->timeSinceSnapshot_ = 0;
+
+        this->setConfigValues();
+    }
+
+    /**
+        @brief Destructor: Writes a last snapshot and closes the target.
+    */
+    MetricsWriter::~MetricsWriter()
+    {
+        if (this->bEnabled_)
+            this->writeSnapshot();
+        this->close();
+    }
+
+    /**
+        @brief Defines the config values.
+    */
+    void MetricsWriter::setConfigValues()
+    {
+        SetConfigValue(bEnabled_, false)
+            .description("If true, snapshots of all metrics (tick, network, physics and loader statistics) are written periodically.")
+            .callback(this, &MetricsWriter::changedTarget);
+        SetConfigValue(interval_, 1.0f)
+            .description("The time between two snapshots of the metrics (in seconds).");
+        SetConfigValue(target_, "metrics.bin")
+            .description("The file (relative to the log directory) which receives the metrics. Use \"unix:<path>\" to send them to a local socket.")
+            .callback(this, &MetricsWriter::changedTarget);
+        SetConfigValue(bLineProtocol_, false)
+            .description("If true, the metrics are written as text (one line per metric) instead of the compact binary format.")
+            .callback(this, &MetricsWriter::changedTarget);
+        SetConfigValue(instanceName_, "")
+            .description("The name of this instance, added to each line of the text format.");
+    }
+
+    /**
+        @brief Closes the current target if the configuration changes. The new target is opened with the next snapshot.
+    */
+    void MetricsWriter::changedTarget()
+    {
+        this->close();
+    }
+
+    /**
+        @brief Writes a snapshot if the interval has elapsed.
+    */
+    void MetricsWriter::postUpdate(const Clock& time)
+    {
+        if (!this->bEnabled_)
+            return;
+
+        this->timeSinceSnapshot_ += time.getDeltaTime();
+        if (this->timeSinceSnapshot_ < this->interval_)
+            return;
+
+        this->timeSinceSnapshot_ = 0;
+        this->writeSnapshot();
+    }
+
+    /**
+        @brief Writes a snapshot of all metrics to the target and starts a new interval.
+    */
+    void MetricsWriter::writeSnapshot()
+    {
+        MetricsRegistry& registry = MetricsRegistry::getInstance();
+
+        if (this->open())
+        {
+            std::string buffer;
+            double time = getWallTime();
+
+            if (this->bLineProtocol_)
+                registry.writeLineProtocol(buffer, this->instanceName_, time);
+            else
+            {
+                // metrics may be registered at any time (e.g. when a module is loaded), so new definitions are written before the snapshot
+                if (this->numDefinedMetrics_ < registry.getMetrics().size())
+                {
+                    registry.writeDefinitions(buffer, this->numDefinedMetrics_);
+                    this->numDefinedMetrics_ = registry.getMetrics().size();
+                }
+                registry.writeSnapshot(buffer, time);
+            }
+
+            if (!this->write(buffer))
+                this->close();
+        }
+
+        registry.resetIntervals();
+    }
+
+    /**
+        @brief Opens the target (if not yet open) and writes the stream header. Returns true if the target is open.
+    */
+    bool MetricsWriter::open()
+    {
+        if (this->bOpen_)
+            return true;
+
+        this->numDefinedMetrics_ = 0;
+
+        if (this->target_.compare(0, UNIX_SOCKET_PREFIX.size(), UNIX_SOCKET_PREFIX) == 0)
+        {
+#ifdef ORXONOX_PLATFORM_UNIX
+            std::string path = this->target_.substr(UNIX_SOCKET_PREFIX.size());
+
+            sockaddr_un address;
+            memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+            this->socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (this->socket_ < 0 || connect(this->socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                // the collector is not running - try again with the next snapshot
+                orxout(internal_info) << "Metrics: Could not connect to socket " << path << ": " << strerror(errno) << endl;
+                this->close();
+                return false;
+            }
+
+            // never block the main loop if the collector is too slow
+            fcntl(this->socket_, F_SETFL, fcntl(this->socket_, F_GETFL, 0) | O_NONBLOCK);
+#else
+            orxout(internal_warning) << "Metrics: UNIX sockets are not supported on this platform" << endl;
+            this->bEnabled_ = false;
+            return false;
+#endif
+        }
+        else
+        {
+            boost::filesystem::path path(this->target_);
+            if (!path.has_root_directory())
+                path = PathConfig::getLogPath() / path;
+
+            std::ios_base::openmode mode = std::ios::out | std::ios::trunc;
+            if (!this->bLineProtocol_)
+                mode |= std::ios::binary;
+
+            this->file_.open(path.string().c_str(), mode);
+            if (!this->file_.is_open())
+            {
+                orxout(internal_warning) << "Metrics: Could not open " << path.string() << ", disabling metrics" << endl;
+                this->bEnabled_ = false;
+                return false;
+            }
+        }
+
+        this->bOpen_ = true;
+
+        if (!this->bLineProtocol_)
+        {
+            std::string header;
+            MetricsRegistry::writeStreamHeader(header);
+            if (!this->write(header))
+            {
+                this->close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+        @brief Closes the file or the socket.
+    */
+    void MetricsWriter::close()
+    {
+        if (this->file_.is_open())
+            this->file_.close();
+
+#ifdef ORXONOX_PLATFORM_UNIX
+        if (this->socket_ >= 0)
+            ::close(this->socket_);
+#endif
+        this->socket_ = -1;
+        this->bOpen_ = false;
+    }
+
+    /**
+        @brief Writes the data to the file or the socket. Returns false if the data couldn't be written completely.
+    */
+    bool MetricsWriter::write(const std::string& data)
+    {
+#ifdef ORXONOX_PLATFORM_UNIX
+        if (this->socket_ >= 0)
+        {
+            // a partially sent record would corrupt the stream, so the connection is closed in this case and a new stream is started later
+            ssize_t sent = send(this->socket_, data.data(), data.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+            return (sent == static_cast<ssize_t>(data.size()));
+        }
+#endif
+
+        this->file_.write(data.data(), data.size());
+        this->file_.flush();
+        return this->file_.good();
+    }
+}
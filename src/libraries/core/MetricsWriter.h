@@ -0,0 +1,97 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @ingroup Metrics
+    @brief Declaration of the MetricsWriter singleton which periodically writes snapshots of all metrics.
+*/
+
+#ifndef _MetricsWriter_H__
+#define _MetricsWriter_H__
+
+#include "CorePrereqs.h"
+
+#include <fstream>
+#include <string>
+
+#include "util/Singleton.h"
+#include "config/Configurable.h"
+
+namespace orxonox
+{
+    /**
+        @brief Writes snapshots of all metrics in @ref MetricsRegistry to a file or to a UNIX socket.
+
+        The writer is disabled by default. If enabled, it writes a snapshot every
+        @a interval_ seconds, either in the binary format (the default, can be
+        converted with orxonox-metrics-reader) or in the line protocol.
+
+        The target is a path relative to the log directory (or an absolute path).
+        On UNIX systems it can also be "unix:<path>" to send the stream to a local
+        socket, e.g. a collector which forwards the metrics to a time series database.
+        If the socket is not available, the snapshots are dropped until the collector
+        accepts the connection again.
+    */
+    class _CoreExport MetricsWriter : public Singleton<MetricsWriter>, public Configurable
+    {
+            friend class Singleton<MetricsWriter>;
+        public:
+            MetricsWriter();
+            virtual ~MetricsWriter();
+
+            void setConfigValues();
+
+            void postUpdate(const Clock& time);
+
+            void writeSnapshot();
+
+        private:
+            void changedTarget();
+
+            bool open();
+            void close();
+            bool write(const std::string& data);
+
+            bool bEnabled_;                 //!< If true, snapshots are written
+            float interval_;                //!< The time between two snapshots (in seconds)
+            std::string target_;            //!< The target file (relative to the log path) or "unix:<path>" for a UNIX socket
+            bool bLineProtocol_;            //!< If true, the line protocol is written instead of the binary format
+            std::string instanceName_;      //!< The name of this instance, added to each line of the line protocol
+
+            std::ofstream file_;            //!< The output file (if the target is a file)
+            int socket_;                    //!< The socket (if the target is a UNIX socket), -1 if not connected
+            bool bOpen_;                    //!< True if the file or the socket is open
+            size_t numDefinedMetrics_;      //!< The number of metrics whose definition was already written to the binary stream
+            float timeSinceSnapshot_;       //!< The real time since the last snapshot
+
+            static MetricsWriter* singletonPtr_s;
+    };
+}
+
+#endif /* _MetricsWriter_H__ */
@@ -0,0 +1,293 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of ModuleLoader.
+*/
+
+#include "ModuleLoader.h"
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "util/Exception.h"
+#include "util/Output.h"
+#include "util/ScopedSingletonManager.h"
+#include "util/StringUtils.h"
+#include "DynLibManager.h"
+#include "class/IdentifierManager.h"
+#include "config/ConfigFile.h"
+
+namespace orxonox
+{
+    ModuleLoader::ModuleLoader(DynLibManager* dynLibManager)
+    {
+        this->dynLibManager_ = dynLibManager;
+        this->bLoading_ = false;
+    }
+
+    ModuleLoader::~ModuleLoader()
+    {
+    }
+
+    /**
+        @brief Loads all modules immediately.
+        @param modulePaths The paths of the module libraries (without extension)
+    */
+    void ModuleLoader::loadModules(const std::vector<std::string>& modulePaths)
+    {
+        for (std::vector<std::string>::const_iterator it = modulePaths.begin(); it != modulePaths.end(); ++it)
+        {
+            ModuleInfo& module = this->modules_[getModuleName(*it)];
+            module.path = *it;
+            this->loadModule(module);
+        }
+    }
+
+    /**
+        @brief Reads the index and defers loading the modules until one of their classes is requested.
+        @param modulePaths The paths of the module libraries (without extension)
+        @param indexFilename The file which contains the classes of each module (see writeIndex())
+
+        Modules which are not in the index and modules with scoped singletons are loaded immediately.
+    */
+    void ModuleLoader::deferModules(const std::vector<std::string>& modulePaths, const std::string& indexFilename)
+    {
+        this->readIndex(indexFilename);
+
+        // only keep the modules of the index which still exist
+        std::map<std::string, ModuleInfo> indexedModules;
+        indexedModules.swap(this->modules_);
+
+        for (std::vector<std::string>::const_iterator it = modulePaths.begin(); it != modulePaths.end(); ++it)
+        {
+            const std::string& name = getModuleName(*it);
+            ModuleInfo& module = this->modules_[name];
+            module.path = *it;
+
+            std::map<std::string, ModuleInfo>::const_iterator it_indexed = indexedModules.find(name);
+            if (it_indexed == indexedModules.end() || it_indexed->second.bEager)
+            {
+                this->loadModule(module);
+            }
+            else
+            {
+                module.classes = it_indexed->second.classes;
+                for (std::vector<std::string>::const_iterator it_class = module.classes.begin(); it_class != module.classes.end(); ++it_class)
+                    this->deferredClasses_[getLowercase(*it_class)] = name;
+            }
+        }
+
+        // the modules which were loaded may depend on deferred modules
+        this->updateDeferredClasses();
+
+        orxout(internal_info) << "Deferred loading of " << this->getNumDeferredModules() << " of " << this->modules_.size() << " modules" << endl;
+    }
+
+    /**
+        @brief Reads the classes of each module from the index file.
+    */
+    void ModuleLoader::readIndex(const std::string& indexFilename)
+    {
+        std::ifstream file(indexFilename.c_str());
+        if (!file.is_open())
+        {
+            orxout(internal_info) << "No module index found, loading all modules" << endl;
+            return;
+        }
+
+        ModuleInfo* module = 0;
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream stream(line);
+            std::string keyword, name, flag;
+            stream >> keyword >> name >> flag;
+
+            if (keyword == "module" && !name.empty())
+            {
+                module = &this->modules_[name];
+                module->bEager = (flag == "eager");
+                module->classes.clear();
+            }
+            else if (keyword == "class" && !name.empty() && module)
+                module->classes.push_back(name);
+        }
+    }
+
+    /**
+        @brief Writes the classes of each module to the index file. The file is only written if its content changed.
+    */
+    void ModuleLoader::writeIndex(const std::string& indexFilename) const
+    {
+        std::ostringstream content;
+        content << "# Classes of each module, used to load modules on demand (--lazyModules). This file is generated automatically." << '\n';
+        for (std::map<std::string, ModuleInfo>::const_iterator it = this->modules_.begin(); it != this->modules_.end(); ++it)
+        {
+            if (it->second.bFailed)
+                continue;
+
+            content << "module " << it->first << (it->second.bEager ? " eager" : "") << '\n';
+            for (std::vector<std::string>::const_iterator it_class = it->second.classes.begin(); it_class != it->second.classes.end(); ++it_class)
+                content << "class " << *it_class << '\n';
+        }
+
+        std::ifstream file(indexFilename.c_str());
+        if (file.is_open())
+        {
+            std::ostringstream oldContent;
+            oldContent << file.rdbuf();
+            if (oldContent.str() == content.str())
+                return;
+            file.close();
+        }
+
+        if (!ConfigFile::writeFile(indexFilename, content.str()))
+            orxout(internal_warning) << "Couldn't write module index \"" << indexFilename << "\"" << endl;
+    }
+
+    /**
+        @brief Loads the module which contains the class with the given name (if it is known and was not loaded yet).
+        @param lowercaseClassName The name of the class in lowercase
+        @return Returns true if a module was loaded
+
+        Modules are not loaded while the class hierarchy is being created or while another
+        module is being loaded, because the new classes would not be initialized correctly.
+    */
+    bool ModuleLoader::loadModuleOfClass(const std::string& lowercaseClassName)
+    {
+        if (this->bLoading_ || IdentifierManager::getInstance().isCreatingHierarchy())
+            return false;
+
+        std::map<std::string, std::string>::const_iterator it = this->deferredClasses_.find(lowercaseClassName);
+        if (it == this->deferredClasses_.end())
+            return false;
+
+        orxout(internal_info) << "Loading module " << it->second << " on demand for class " << lowercaseClassName << endl;
+
+        bool bLoaded = this->loadModule(this->modules_[it->second]);
+        if (bLoaded)
+            IdentifierManager::getInstance().createClassHierarchy();
+
+        this->updateDeferredClasses();
+        return bLoaded;
+    }
+
+    /**
+        @brief Returns the number of modules which were not loaded yet.
+    */
+    size_t ModuleLoader::getNumDeferredModules() const
+    {
+        size_t count = 0;
+        for (std::map<std::string, ModuleInfo>::const_iterator it = this->modules_.begin(); it != this->modules_.end(); ++it)
+            if (!it->second.bLoaded && !it->second.bFailed)
+                ++count;
+        return count;
+    }
+
+    /**
+        @brief Loads the library of a module and stores the names of the classes and whether the module contains scoped singletons.
+    */
+    bool ModuleLoader::loadModule(ModuleInfo& module)
+    {
+        if (module.bLoaded || module.bFailed)
+            return module.bLoaded;
+
+        const std::map<std::string, Identifier*>& identifiers = IdentifierManager::getInstance().getIdentifierByStringMap();
+        std::set<std::string> knownClasses;
+        for (std::map<std::string, Identifier*>::const_iterator it = identifiers.begin(); it != identifiers.end(); ++it)
+            knownClasses.insert(it->first);
+        size_t numSingletons = ScopedSingletonManager::getManagers().size();
+
+        this->bLoading_ = true;
+        try
+        {
+            this->dynLibManager_->load(module.path);
+            module.bLoaded = true;
+        }
+        catch (...)
+        {
+            orxout(user_error) << "Couldn't load module \"" << module.path << "\": " << Exception::handleMessage() << endl;
+            module.bFailed = true;
+        }
+        this->bLoading_ = false;
+
+        if (module.bLoaded)
+        {
+            module.classes.clear();
+            for (std::map<std::string, Identifier*>::const_iterator it = identifiers.begin(); it != identifiers.end(); ++it)
+                if (knownClasses.find(it->first) == knownClasses.end())
+                    module.classes.push_back(it->first);
+            module.bEager = (ScopedSingletonManager::getManagers().size() > numSingletons);
+        }
+
+        return module.bLoaded;
+    }
+
+    /**
+        @brief Marks modules as loaded if all their classes are known (e.g. because another module depends on them) and removes their deferred classes.
+    */
+    void ModuleLoader::updateDeferredClasses()
+    {
+        const std::map<std::string, Identifier*>& identifiers = IdentifierManager::getInstance().getIdentifierByLowercaseStringMap();
+        for (std::map<std::string, ModuleInfo>::iterator it = this->modules_.begin(); it != this->modules_.end(); ++it)
+        {
+            ModuleInfo& module = it->second;
+            if (module.bLoaded || module.bFailed || module.classes.empty())
+                continue;
+
+            bool bAllClassesKnown = true;
+            for (std::vector<std::string>::const_iterator it_class = module.classes.begin(); it_class != module.classes.end() && bAllClassesKnown; ++it_class)
+                bAllClassesKnown = (identifiers.find(getLowercase(*it_class)) != identifiers.end());
+            module.bLoaded = bAllClassesKnown;
+        }
+
+        for (std::map<std::string, std::string>::iterator it = this->deferredClasses_.begin(); it != this->deferredClasses_.end(); )
+        {
+            const ModuleInfo& module = this->modules_[it->second];
+            if (module.bLoaded || module.bFailed)
+                this->deferredClasses_.erase(it++);
+            else
+                ++it;
+        }
+    }
+
+    /**
+        @brief Returns the name of a module, i.e. the filename of its library.
+    */
+    /*static*/ std::string ModuleLoader::getModuleName(const std::string& path)
+    {
+        size_t pos = path.find_last_of("/\\");
+        if (pos == std::string::npos)
+            return path;
+        else
+            return path.substr(pos + 1);
+    }
+}
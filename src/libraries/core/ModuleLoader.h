@@ -0,0 +1,107 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @ingroup Management CoreGame
+    @brief Declaration of ModuleLoader, which loads the modules either at startup or on demand.
+*/
+
+#ifndef _ModuleLoader_H__
+#define _ModuleLoader_H__
+
+#include "CorePrereqs.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace orxonox
+{
+    /**
+        @brief Loads the modules (plugins) with the DynLibManager and remembers which classes each module registers.
+
+        By default all modules are loaded at startup (see loadModules()). Afterwards the
+        classes of each module are written to an index file (see writeIndex()).
+
+        In lazy mode (see deferModules()) the index is used to defer loading a module until
+        one of its classes is requested by name, for instance because a level contains
+        an object of this class. IdentifierManager asks the loader with loadModuleOfClass()
+        if it doesn't know a class. Modules which are not in the index yet and modules which
+        contain scoped singletons are still loaded at startup, because their singletons
+        have to exist as soon as their scope is active.
+
+        @note Classes of modules which are loaded on demand get their network ID when the
+        module is loaded. Clients which are already connected don't know these classes,
+        hence lazy mode is intended for dedicated servers which load their level before
+        clients connect.
+    */
+    class _CoreExport ModuleLoader
+    {
+        public:
+            ModuleLoader(DynLibManager* dynLibManager);
+            ~ModuleLoader();
+
+            void loadModules(const std::vector<std::string>& modulePaths);
+            void deferModules(const std::vector<std::string>& modulePaths, const std::string& indexFilename);
+            void writeIndex(const std::string& indexFilename) const;
+
+            bool loadModuleOfClass(const std::string& lowercaseClassName);
+
+            /// Returns the number of modules which were not loaded yet.
+            size_t getNumDeferredModules() const;
+
+        private:
+            ModuleLoader(const ModuleLoader&);
+
+            /// Stores the state of a module and the names of its classes.
+            struct ModuleInfo
+            {
+                ModuleInfo() : bLoaded(false), bFailed(false), bEager(false) {}
+
+                std::string path;                   //!< The path of the module library (without extension)
+                bool bLoaded;                       //!< True if the library was loaded
+                bool bFailed;                       //!< True if the library could not be loaded
+                bool bEager;                        //!< True if the module contains scoped singletons and must be loaded at startup
+                std::vector<std::string> classes;   //!< The names of all classes which were registered when the library was loaded
+            };
+
+            void readIndex(const std::string& indexFilename);
+            bool loadModule(ModuleInfo& module);
+            void updateDeferredClasses();
+
+            static std::string getModuleName(const std::string& path);
+
+            DynLibManager* dynLibManager_;                          //!< The manager which loads the libraries
+            std::map<std::string, ModuleInfo> modules_;             //!< All modules, mapped by their name
+            std::map<std::string, std::string> deferredClasses_;    //!< The lowercase names of the classes of modules which were not loaded yet, mapped to the name of the module
+            bool bLoading_;                                         //!< True while a module is being loaded
+    };
+}
+
+#endif /* _ModuleLoader_H__ */
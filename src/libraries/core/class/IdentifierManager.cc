@@ -37,6 +37,7 @@
 
 #include "util/StringUtils.h"
 #include "core/CoreIncludes.h"
+#include "core/ModuleLoader.h"
 #include "core/config/ConfigValueContainer.h"
 #include "core/XMLPort.h"
 #include "core/object/ClassFactory.h"
@@ -53,6 +54,7 @@ namespace orxonox
     {
         this->hierarchyCreatingCounter_s = 0;
         this->classIDCounter_s = 0;
+        this->moduleLoader_ = 0;
     }
 
     /**
@@ -96,6 +98,9 @@ namespace orxonox
 
     /**
         @brief Creates the class-hierarchy by creating and destroying one object of each type.
+
+        Identifiers which are already initialized are skipped, hence this function can be
+        called again after loading a module to initialize the classes of the module.
     */
     void IdentifierManager::createClassHierarchy()
     {
@@ -113,6 +118,9 @@ namespace orxonox
             Context temporaryContext(NULL);
             for (std::map<std::string, Identifier*>::const_iterator it = this->identifierByTypeidName_.begin(); it != this->identifierByTypeidName_.end(); ++it)
             {
+                if (it->second->isInitialized())
+                    continue;
+
                 orxout(verbose, context::identifier) << "Initialize ClassIdentifier<" << it->second->getName() << ">-Singleton." << endl;
                 // To initialize the identifier, we create a new object and delete it afterwards.
                 if (it->second->hasFactory())
@@ -139,7 +147,9 @@ namespace orxonox
         // finish the initialization of all identifiers
         for (std::map<std::string, Identifier*>::const_iterator it = this->identifierByTypeidName_.begin(); it != this->identifierByTypeidName_.end(); ++it)
         {
-            if (initializedIdentifiers.find(it->second) != initializedIdentifiers.end())
+            if (it->second->isInitialized())
+                continue;
+            else if (initializedIdentifiers.find(it->second) != initializedIdentifiers.end())
                 it->second->finishInitialization();
             else
                 orxout(internal_error) << "Identifier was registered late and is not initialized: " << it->second->getName() << " / " << it->second->getTypeidName() << endl;
@@ -184,6 +194,8 @@ namespace orxonox
         std::map<std::string, Identifier*>::const_iterator it = this->identifierByString_.find(name);
         if (it != this->identifierByString_.end())
             return it->second;
+        else if (this->moduleLoader_ && this->moduleLoader_->loadModuleOfClass(getLowercase(name)))
+            return this->getIdentifierByString(name);
         else
             return 0;
     }
@@ -198,6 +210,8 @@ namespace orxonox
         std::map<std::string, Identifier*>::const_iterator it = this->identifierByLowercaseString_.find(name);
         if (it != this->identifierByLowercaseString_.end())
             return it->second;
+        else if (this->moduleLoader_ && this->moduleLoader_->loadModuleOfClass(name))
+            return this->getIdentifierByLowercaseString(name);
         else
             return 0;
     }
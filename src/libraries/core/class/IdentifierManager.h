@@ -76,6 +76,10 @@ namespace orxonox
 
             void clearNetworkIDs();
 
+            /// Sets the loader which is asked to load the module of a class if an Identifier is requested by a name which is not (yet) known.
+            inline void setModuleLoader(ModuleLoader* loader)
+                { this->moduleLoader_ = loader; }
+
             /// Returns the map that stores all Identifiers with their names.
             inline const std::map<std::string, Identifier*>& getIdentifierByStringMap()
                 { return this->identifierByString_; }
@@ -107,6 +111,7 @@ namespace orxonox
             int hierarchyCreatingCounter_s;                         //!< Bigger than zero if at least one Identifier stores its parents (its an int instead of a bool to avoid conflicts with multithreading)
             std::set<const Identifier*> identifiersOfNewObject_;    //!< Used while creating the object hierarchy to keep track of the identifiers of a newly created object
             unsigned int classIDCounter_s;                          //!< counter for the unique classIDs
+            ModuleLoader* moduleLoader_;                            //!< Loads modules on demand if an unknown class is requested (may be NULL)
     };
 }
 
@@ -234,6 +234,25 @@ namespace orxonox
         }
     }
 
+    /**
+    @brief
+        Returns true if the command line contains the argument with the given full name.
+        This can be used before parse() if an argument is needed before all arguments
+        are known (for instance before the modules are loaded).
+    @param cmdLine
+        Command line string WITHOUT the execution path.
+    @param name
+        Full name of the argument (without "--")
+    */
+    bool CommandLineParser::containsArgument(const std::string& cmdLine, const std::string& name)
+    {
+        SubString tokens(cmdLine, " ", " ", false, '\\', true, '"', true, '\0', '\0', false);
+        for (unsigned i = 0; i < tokens.size(); ++i)
+            if (tokens[i] == "--" + name)
+                return true;
+        return false;
+    }
+
     /**
     @brief
         Parses an argument based on its full name.
@@ -166,6 +166,8 @@ namespace orxonox
             return !(it == _getInstance().cmdLineArgs_.end());
         }
 
+        static bool containsArgument(const std::string& cmdLine, const std::string& name);
+
         static void destroyAllArguments();
 
         static void generateDoc(std::ofstream& file);
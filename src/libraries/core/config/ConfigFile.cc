@@ -33,6 +33,8 @@
 
 #include "ConfigFile.h"
 
+#include <fstream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #include "util/Convert.h"
@@ -40,6 +42,7 @@
 #include "core/PathConfig.h"
 #include "ConfigFileEntryComment.h"
 #include "ConfigFileEntryValue.h"
+#include "ConfigFileManager.h"
 
 namespace orxonox
 {
@@ -58,14 +61,18 @@ namespace orxonox
         : filename_(filename)
         , bCopyFallbackFile_(bCopyFallbackFile)
         , bUpdated_(false)
+        , bDirty_(false)
     {
     }
 
     /**
-        @brief Destructor: Deletes all sections and entries.
+        @brief Destructor: Saves the file if it was changed and deletes all sections and entries.
     */
     ConfigFile::~ConfigFile()
     {
+        if (this->bDirty_)
+            this->save();
+
         this->clear();
     }
 
@@ -76,6 +83,8 @@ namespace orxonox
     {
         // Be sure we start from new in the memory
         this->clear();
+        this->bUpdated_ = false;
+        this->bDirty_ = false;
 
         boost::filesystem::path filepath(this->filename_);
         if (!filepath.is_complete())
@@ -129,7 +138,7 @@ namespace orxonox
                             newsection = new ConfigFileSection(line.substr(pos1 + 1, pos2 - pos1 - 1), comment);
                         else
                             newsection = new ConfigFileSection(line.substr(pos1 + 1, pos2 - pos1 - 1));
-                        this->sections_.insert(this->sections_.end(), newsection);
+                        this->addSection(newsection);
                         continue;
                     }
                 }
@@ -139,7 +148,7 @@ namespace orxonox
                     if (isComment(line))
                     {
                         // New comment
-                        newsection->getEntries().insert(newsection->getEntries().end(), new ConfigFileEntryComment(removeTrailingWhitespaces(line)));
+                        newsection->addEntry(new ConfigFileEntryComment(removeTrailingWhitespaces(line)));
                         continue;
                     }
                     else
@@ -185,7 +194,7 @@ namespace orxonox
                             }
 
                             // New value
-                            newsection->getEntries().insert(newsection->getEntries().end(), new ConfigFileEntryValue(getStripped(line.substr(0, pos1)), value, false, comment));
+                            newsection->addEntry(new ConfigFileEntryValue(getStripped(line.substr(0, pos1)), value, false, comment));
                             continue;
                         }
                     }
@@ -194,6 +203,10 @@ namespace orxonox
 
             file.close();
 
+            // the loaded values are not a change
+            for (std::list<ConfigFileSection*>::iterator it = this->sections_.begin(); it != this->sections_.end(); ++it)
+                (*it)->bUpdated_ = false;
+
             orxout(internal_info, context::config) << "Loaded config file \"" << this->filename_ << "\"." << endl;
 
             // DO NOT save the file --> we can open supposedly read only config files
@@ -206,6 +219,7 @@ namespace orxonox
     void ConfigFile::save() const
     {
         this->saveAs(this->filename_);
+        this->bDirty_ = false;
     }
 
     /**
@@ -216,30 +230,96 @@ namespace orxonox
         boost::filesystem::path filepath(filename);
         if (!filepath.is_complete())
             filepath = PathConfig::getConfigPath() / filename;
-        std::ofstream file;
-        file.open(filepath.string().c_str(), std::fstream::out);
-        file.setf(std::ios::fixed, std::ios::floatfield);
-        file.precision(6);
 
-        if (!file.is_open())
+        // make sure an older version of the file which is still saved in the background doesn't overwrite this version
+        if (ConfigFileManager::exists())
+            ConfigFileManager::getInstance().waitForPendingWrites();
+
+        if (!ConfigFile::writeFile(filepath.string(), this->getContent()))
         {
-            orxout(user_error, context::config) << "Couldn't open config-file \"" << filename << "\"." << endl;
+            orxout(user_error, context::config) << "Couldn't write config-file \"" << filename << "\"." << endl;
             return;
         }
 
+        orxout(verbose, context::config) << "Saved config file \"" << filename << "\"." << endl;
+    }
+
+    /**
+        @brief Returns the sections and values as they will be stored in the file.
+    */
+    std::string ConfigFile::getContent() const
+    {
+        std::ostringstream content;
+        content.setf(std::ios::fixed, std::ios::floatfield);
+        content.precision(6);
+
         for (std::list<ConfigFileSection*>::const_iterator it = this->sections_.begin(); it != this->sections_.end(); ++it)
         {
-            file << (*it)->getFileEntry() << endl;
+            content << (*it)->getFileEntry() << '\n';
 
             for (std::list<ConfigFileEntry*>::const_iterator it_entries = (*it)->getEntriesBegin(); it_entries != (*it)->getEntriesEnd(); ++it_entries)
-                file << (*it_entries)->getFileEntry() << endl;
+                content << (*it_entries)->getFileEntry() << '\n';
 
-            file << endl;
+            content << '\n';
         }
 
+        return content.str();
+    }
+
+    /**
+        @brief Returns the complete path of the file (relative file-names are completed with the config path).
+    */
+    std::string ConfigFile::getFilepath() const
+    {
+        boost::filesystem::path filepath(this->filename_);
+        if (!filepath.is_complete())
+            filepath = PathConfig::getConfigPath() / this->filename_;
+        return filepath.string();
+    }
+
+    /**
+        @brief Writes the content to a temporary file and replaces the file with it. Returns false if an error occurred.
+
+        The file is never left half-written, even if the program crashes while saving.
+        This function doesn't print any output, so it may be called from another thread.
+    */
+    /*static*/ bool ConfigFile::writeFile(const std::string& filepath, const std::string& content)
+    {
+        const std::string temppath = filepath + ".tmp";
+
+        std::ofstream file;
+        file.open(temppath.c_str(), std::fstream::out | std::fstream::trunc);
+        if (!file.is_open())
+            return false;
+
+        file << content;
         file.close();
 
-        orxout(verbose, context::config) << "Saved config file \"" << filename << "\"." << endl;
+        try
+        {
+            if (file.fail())
+            {
+                boost::filesystem::remove(temppath);
+                return false;
+            }
+
+            try
+            {
+                boost::filesystem::rename(temppath, filepath);
+            }
+            catch (const boost::filesystem::filesystem_error&)
+            {
+                // older versions of boost::filesystem don't replace existing files
+                boost::filesystem::remove(filepath);
+                boost::filesystem::rename(temppath, filepath);
+            }
+        }
+        catch (const boost::filesystem::filesystem_error&)
+        {
+            return false;
+        }
+
+        return true;
     }
 
     /**
@@ -250,6 +330,7 @@ namespace orxonox
         for (std::list<ConfigFileSection*>::iterator it = this->sections_.begin(); it != this->sections_.end(); )
             delete (*(it++));
         this->sections_.clear();
+        this->sectionsByName_.clear();
     }
 
     /**
@@ -264,7 +345,7 @@ namespace orxonox
         if (ConfigFileSection* sectionPtr = this->getSection(section))
         {
             sectionPtr->deleteVectorEntries(name, startindex);
-            this->save();
+            this->setDirty();
         }
     }
 
@@ -273,10 +354,8 @@ namespace orxonox
     */
     ConfigFileSection* ConfigFile::getSection(const std::string& section) const
     {
-        for (std::list<ConfigFileSection*>::const_iterator it = this->sections_.begin(); it != this->sections_.end(); ++it)
-            if ((*it)->getName() == section)
-                return (*it);
-        return NULL;
+        boost::unordered_map<std::string, ConfigFileSection*>::const_iterator it = this->sectionsByName_.find(section);
+        return (it != this->sectionsByName_.end() ? it->second : NULL);
     }
 
     /**
@@ -284,35 +363,60 @@ namespace orxonox
     */
     ConfigFileSection* ConfigFile::getOrCreateSection(const std::string& section)
     {
-        for (std::list<ConfigFileSection*>::iterator it = this->sections_.begin(); it != this->sections_.end(); ++it)
-            if ((*it)->getName() == section)
-                return (*it);
+        if (ConfigFileSection* sectionPtr = this->getSection(section))
+            return sectionPtr;
 
         this->bUpdated_ = true;
 
-        return (*this->sections_.insert(this->sections_.end(), new ConfigFileSection(section)));
+        ConfigFileSection* sectionPtr = new ConfigFileSection(section);
+        this->addSection(sectionPtr);
+        return sectionPtr;
     }
 
     /**
-        @brief Saves the config file if it was updated (or if any of its sections were updated).
+        @brief Appends a section to the list of sections. If there's already a section with the same name, the first section is used.
     */
-    void ConfigFile::saveIfUpdated()
+    void ConfigFile::addSection(ConfigFileSection* section)
     {
-        bool sectionsUpdated = false;
+        this->sections_.push_back(section);
+        this->sectionsByName_.insert(std::make_pair(section->getName(), section));
+    }
 
-        for (std::list<ConfigFileSection*>::iterator it = this->sections_.begin(); it != this->sections_.end(); ++it)
+    /**
+        @brief Deletes a section and removes it from the list of sections. Returns the iterator to the next section.
+    */
+    std::list<ConfigFileSection*>::iterator ConfigFile::removeSection(std::list<ConfigFileSection*>::iterator it)
+    {
+        const std::string name = (*it)->getName();
+        if (this->getSection(name) == (*it))
         {
-            if ((*it)->bUpdated_)
+            this->sectionsByName_.erase(name);
+
+            // if the file contains the same section twice, the next one is used from now on
+            for (std::list<ConfigFileSection*>::iterator it2 = this->sections_.begin(); it2 != this->sections_.end(); ++it2)
             {
-                sectionsUpdated = true;
-                (*it)->bUpdated_ = false;
+                if (it2 != it && (*it2)->getName() == name)
+                {
+                    this->sectionsByName_[name] = (*it2);
+                    break;
+                }
             }
         }
 
-        if (this->bUpdated_ || sectionsUpdated)
+        delete (*it);
+        return this->sections_.erase(it);
+    }
+
+    /**
+        @brief Marks the config file as dirty if a section was added or if the given section was updated.
+    */
+    void ConfigFile::setDirtyIfUpdated(ConfigFileSection* section)
+    {
+        if (this->bUpdated_ || section->bUpdated_)
         {
             this->bUpdated_ = false;
-            this->save();
+            section->bUpdated_ = false;
+            this->bDirty_ = true;
         }
     }
 }
@@ -46,7 +46,13 @@ namespace orxonox
     /**
         @brief This class represents a config file, which is stored on the hard-disk and contains config values in different sections.
 
-        It provides an interface to manipulate the sections and values.
+        It provides an interface to manipulate the sections and values. Sections are indexed
+        by name, so looking up a value doesn't depend on the size of the file.
+
+        Changes mark the file as dirty instead of saving it immediately. The ConfigFileManager
+        saves dirty files periodically in the background, hence many changes in a short time
+        (e.g. when the config values of all classes are initialized) are written only once.
+        Call save() to write the file immediately.
     */
     class _CoreExport ConfigFile
     {
@@ -59,10 +65,21 @@ namespace orxonox
             virtual void saveAs(const std::string& filename) const;
             virtual void clear();
 
+            std::string getContent() const;
+            std::string getFilepath() const;
+            static bool writeFile(const std::string& filepath, const std::string& content);
+
             /// Returns the file-name of this config file
             inline const std::string& getFilename()
                 { return this->filename_; }
 
+            /// Returns true if the config file was changed since it was saved the last time.
+            inline bool isDirty() const
+                { return this->bDirty_; }
+            /// Marks the config file as saved (used by ConfigFileManager if the content is saved in the background).
+            inline void setSaved()
+                { this->bDirty_ = false; }
+
             /**
                 @brief Stores a value in the config file. If the entry or its section doesn't exist, it's created.
 
@@ -73,8 +90,9 @@ namespace orxonox
             */
             inline void setValue(const std::string& section, const std::string& name, const std::string& value, bool bString)
             {
-                this->getOrCreateSection(section)->setValue(name, value, bString);
-                this->save();
+                ConfigFileSection* sectionPtr = this->getOrCreateSection(section);
+                sectionPtr->setValue(name, value, bString);
+                this->setDirtyIfUpdated(sectionPtr);
             }
             /**
                 @brief Returns the value of a given entry in the config file. Returns a blank string if the value doesn't exist.
@@ -98,8 +116,9 @@ namespace orxonox
             */
             inline const std::string& getOrCreateValue(const std::string& section, const std::string& name, const std::string& fallback, bool bString)
             {
-                const std::string& output = this->getOrCreateSection(section)->getOrCreateValue(name, fallback, bString);
-                this->saveIfUpdated();
+                ConfigFileSection* sectionPtr = this->getOrCreateSection(section);
+                const std::string& output = sectionPtr->getOrCreateValue(name, fallback, bString);
+                this->setDirtyIfUpdated(sectionPtr);
                 return output;
             }
 
@@ -114,8 +133,9 @@ namespace orxonox
             */
             inline void setValue(const std::string& section, const std::string& name, unsigned int index, const std::string& value, bool bString)
             {
-                this->getOrCreateSection(section)->setValue(name, index, value, bString);
-                this->save();
+                ConfigFileSection* sectionPtr = this->getOrCreateSection(section);
+                sectionPtr->setValue(name, index, value, bString);
+                this->setDirtyIfUpdated(sectionPtr);
             }
             /**
                 @brief Returns the value of a given element of a vector in the config file. Returns a blank string if the value doesn't exist.
@@ -141,8 +161,9 @@ namespace orxonox
             */
             const std::string& getOrCreateValue(const std::string& section, const std::string& name, unsigned int index, const std::string& fallback, bool bString)
             {
-                const std::string& output = this->getOrCreateSection(section)->getOrCreateValue(name, index, fallback, bString);
-                this->saveIfUpdated();
+                ConfigFileSection* sectionPtr = this->getOrCreateSection(section);
+                const std::string& output = sectionPtr->getOrCreateValue(name, index, fallback, bString);
+                this->setDirtyIfUpdated(sectionPtr);
                 return output;
             }
 
@@ -163,15 +184,24 @@ namespace orxonox
         protected:
             ConfigFileSection* getSection(const std::string& section) const;
             ConfigFileSection* getOrCreateSection(const std::string& section);
+            std::list<ConfigFileSection*>::iterator removeSection(std::list<ConfigFileSection*>::iterator it);
+
+            /// Marks the config file as changed. It will be saved by ConfigFileManager.
+            inline void setDirty()
+                { this->bDirty_ = true; }
 
             std::list<ConfigFileSection*> sections_;    ///< A list of sections in this config file
 
         private:
-            void saveIfUpdated();
+            void addSection(ConfigFileSection* section);
+            void setDirtyIfUpdated(ConfigFileSection* section);
+
+            boost::unordered_map<std::string, ConfigFileSection*> sectionsByName_;  ///< The sections of this config file, mapped by name
 
             const std::string filename_;                ///< The filename of this config file
             const bool bCopyFallbackFile_;              ///< If true, the default config file is copied into the config-directory before loading the file
             bool bUpdated_;                             ///< Becomes true if a section is added
+            mutable bool bDirty_;                       ///< True if the file was changed since it was saved the last time
     };
 }
 
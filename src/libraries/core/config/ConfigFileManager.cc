@@ -33,6 +33,13 @@
 
 #include "ConfigFileManager.h"
 
+#include <boost/bind.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "util/Clock.h"
+#include "util/Output.h"
 #include "SettingsConfigFile.h"
 
 namespace orxonox
@@ -43,15 +50,42 @@ namespace orxonox
 
     ConfigFileManager* ConfigFileManager::singletonPtr_s = 0;
 
+    const float ConfigFileManager::SAVE_DELAY = 1.0f;
+
     /// Constructor: Initializes the array of config files with NULL.
     ConfigFileManager::ConfigFileManager()
     {
         this->configFiles_.assign(NULL);
+        this->timeSinceChange_ = 0;
+
+        this->bWriting_ = false;
+        this->bStopWriter_ = false;
+        this->writerThread_ = 0;
+        this->writerMutex_ = new boost::mutex;
+        this->writerCondition_ = new boost::condition_variable;
     }
 
-    /// Destructor: Deletes the config files.
+    /// Destructor: Saves and deletes the config files and stops the background thread.
     ConfigFileManager::~ConfigFileManager()
     {
+        // save remaining changes synchronously (this also waits for the background thread)
+        for (boost::array<ConfigFile*, 3>::const_iterator it = this->configFiles_.begin(); it != this->configFiles_.end(); ++it)
+            if (*it && (*it)->isDirty())
+                (*it)->save();
+
+        if (this->writerThread_)
+        {
+            {
+                boost::mutex::scoped_lock lock(*this->writerMutex_);
+                this->bStopWriter_ = true;
+            }
+            this->writerCondition_->notify_all();
+            this->writerThread_->join();
+            delete this->writerThread_;
+        }
+        delete this->writerCondition_;
+        delete this->writerMutex_;
+
         for (boost::array<ConfigFile*, 3>::const_iterator it = this->configFiles_.begin(); it != this->configFiles_.end(); ++it)
             if (*it)
                 delete (*it);
@@ -75,4 +109,120 @@ namespace orxonox
         }
         this->configFiles_[type]->load();
     }
+
+    /**
+        @brief Saves the changed config files in the background if the first unsaved change is older than SAVE_DELAY. Called once per frame.
+    */
+    void ConfigFileManager::update(const Clock& time)
+    {
+        // report files which couldn't be written by the background thread
+        {
+            boost::mutex::scoped_lock lock(*this->writerMutex_);
+            for (size_t i = 0; i < this->failedWrites_.size(); ++i)
+                orxout(user_error, context::config) << "Couldn't write config-file \"" << this->failedWrites_[i] << "\"." << endl;
+            this->failedWrites_.clear();
+        }
+
+        bool bChanged = false;
+        for (boost::array<ConfigFile*, 3>::const_iterator it = this->configFiles_.begin(); it != this->configFiles_.end(); ++it)
+            if (*it && (*it)->isDirty())
+                bChanged = true;
+
+        if (!bChanged)
+        {
+            this->timeSinceChange_ = 0;
+            return;
+        }
+
+        this->timeSinceChange_ += time.getDeltaTime();
+        if (this->timeSinceChange_ >= SAVE_DELAY)
+            this->saveChangedFiles();
+    }
+
+    /**
+        @brief Passes the content of all changed config files to the background thread which saves them.
+    */
+    void ConfigFileManager::saveChangedFiles()
+    {
+        for (boost::array<ConfigFile*, 3>::const_iterator it = this->configFiles_.begin(); it != this->configFiles_.end(); ++it)
+        {
+            if (*it && (*it)->isDirty())
+            {
+                // the content is assembled in the main thread, only writing the file happens in the background
+                this->queueWrite((*it)->getFilepath(), (*it)->getContent());
+                (*it)->setSaved();
+            }
+        }
+        this->timeSinceChange_ = 0;
+    }
+
+    /**
+        @brief Blocks until the background thread has written all pending files.
+    */
+    void ConfigFileManager::waitForPendingWrites()
+    {
+        boost::mutex::scoped_lock lock(*this->writerMutex_);
+        while (!this->pendingWrites_.empty() || this->bWriting_)
+            this->writerCondition_->wait(lock);
+    }
+
+    /**
+        @brief Adds a file to the pending writes. If the file is already waiting to be written, only its content is replaced.
+    */
+    void ConfigFileManager::queueWrite(const std::string& filepath, const std::string& content)
+    {
+        {
+            boost::mutex::scoped_lock lock(*this->writerMutex_);
+
+            bool bFound = false;
+            for (std::list<PendingWrite>::iterator it = this->pendingWrites_.begin(); it != this->pendingWrites_.end(); ++it)
+            {
+                if (it->filepath == filepath)
+                {
+                    it->content = content;
+                    bFound = true;
+                    break;
+                }
+            }
+            if (!bFound)
+            {
+                PendingWrite write = { filepath, content };
+                this->pendingWrites_.push_back(write);
+            }
+        }
+
+        if (!this->writerThread_)
+            this->writerThread_ = new boost::thread(boost::bind(&ConfigFileManager::writerThread, this));
+
+        this->writerCondition_->notify_all();
+    }
+
+    /**
+        @brief The function of the background thread: Writes pending files until the ConfigFileManager is destroyed.
+    */
+    void ConfigFileManager::writerThread()
+    {
+        boost::mutex::scoped_lock lock(*this->writerMutex_);
+        while (true)
+        {
+            while (this->pendingWrites_.empty() && !this->bStopWriter_)
+                this->writerCondition_->wait(lock);
+
+            if (this->pendingWrites_.empty())
+                break;
+
+            PendingWrite write = this->pendingWrites_.front();
+            this->pendingWrites_.pop_front();
+            this->bWriting_ = true;
+
+            lock.unlock();
+            bool bSuccess = ConfigFile::writeFile(write.filepath, write.content);
+            lock.lock();
+
+            if (!bSuccess)
+                this->failedWrites_.push_back(write.filepath);
+            this->bWriting_ = false;
+            this->writerCondition_->notify_all();
+        }
+    }
 }
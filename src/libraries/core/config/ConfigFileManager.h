@@ -37,6 +37,9 @@
 
 #include "core/CorePrereqs.h"
 
+#include <list>
+#include <string>
+#include <vector>
 #include <boost/array.hpp>
 
 #include "util/Singleton.h"
@@ -48,6 +51,10 @@ namespace orxonox
     ///////////////////////
     /**
         @brief Manages the different config files (settings, calibration, etc). Implemented as Singleton.
+
+        Changed config files are saved in a background thread. update() waits until the first
+        change is at least SAVE_DELAY seconds old and then saves all changed files at once.
+        Remaining changes are saved synchronously when the ConfigFileManager is destroyed.
     */
     class _CoreExport ConfigFileManager : public Singleton<ConfigFileManager>
     {
@@ -58,6 +65,10 @@ namespace orxonox
 
             void setFilename(ConfigFileType::Value type, const std::string& filename);
 
+            void update(const Clock& time);
+            void saveChangedFiles();
+            void waitForPendingWrites();
+
             /// Returns the config file of a given type (settings, calibration, etc.)
             inline ConfigFile* getConfigFile(ConfigFileType::Value type)
             {
@@ -65,10 +76,32 @@ namespace orxonox
                 return configFiles_.at(type);
             }
 
+            static const float SAVE_DELAY;                  ///< The time (in seconds) between the first change of a file and saving it
+
         private:
             ConfigFileManager(const ConfigFileManager&);    ///< Copy-constructor: not implemented
 
+            /// A file which is waiting to be written by the background thread
+            struct PendingWrite
+            {
+                std::string filepath;                       ///< The complete path of the file
+                std::string content;                        ///< The new content of the file
+            };
+
+            void queueWrite(const std::string& filepath, const std::string& content);
+            void writerThread();
+
             boost::array<ConfigFile*, 3> configFiles_;      ///< Stores the config files for each type in an array (must have the same size like ConfigFileType::Value)
+            float timeSinceChange_;                         ///< The time since the first unsaved change
+
+            std::list<PendingWrite> pendingWrites_;         ///< The files which are waiting to be written (at most one per file)
+            std::vector<std::string> failedWrites_;         ///< The files which couldn't be written by the background thread
+            bool bWriting_;                                 ///< True while the background thread writes a file
+            bool bStopWriter_;                              ///< If true, the background thread terminates
+            boost::thread* writerThread_;                   ///< The background thread (created with the first write)
+            boost::mutex* writerMutex_;                     ///< Protects the pending writes, failed writes and flags
+            boost::condition_variable* writerCondition_;    ///< Signals new pending writes and finished writes
+
             static ConfigFileManager* singletonPtr_s;       ///< Stores the singleton-pointer
     };
 }
@@ -61,14 +61,9 @@ namespace orxonox
         for (std::list<ConfigFileEntry*>::iterator it = this->entries_.begin(); it != this->entries_.end(); )
         {
             if (((*it)->getName() == name) && ((*it)->getIndex() >= startindex))
-            {
-                delete (*it);
-                this->entries_.erase(it++);
-            }
+                it = this->removeEntry(it);
             else
-            {
                 ++it;
-            }
         }
     }
 
@@ -78,12 +73,10 @@ namespace orxonox
     */
     unsigned int ConfigFileSection::getVectorSize(const std::string& name) const
     {
-        unsigned int size = 0;
-        for (std::list<ConfigFileEntry*>::const_iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
-            if ((*it)->getName() == name)
-                if ((*it)->getIndex() >= size)
-                    size = (*it)->getIndex() + 1;
-        return size;
+        this->updateIndex();
+
+        boost::unordered_map<std::string, unsigned int>::const_iterator it = this->vectorSizes_.find(name);
+        return (it != this->vectorSizes_.end() ? it->second : 0);
     }
 
     /**
@@ -104,12 +97,10 @@ namespace orxonox
     */
     ConfigFileEntry* ConfigFileSection::getEntry(const std::string& name) const
     {
-        for (std::list<ConfigFileEntry*>::const_iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
-        {
-            if ((*it)->getName() == name)
-                return *it;
-        }
-        return NULL;
+        this->updateIndex();
+
+        boost::unordered_map<std::string, EntryIterator>::const_iterator it = this->entriesByName_.find(name);
+        return (it != this->entriesByName_.end() ? *it->second : NULL);
     }
 
     /**
@@ -120,12 +111,10 @@ namespace orxonox
     */
     ConfigFileEntry* ConfigFileSection::getEntry(const std::string& name, unsigned int index) const
     {
-        for (std::list<ConfigFileEntry*>::const_iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
-        {
-            if (((*it)->getName() == name) && ((*it)->getIndex() == index))
-                return *it;
-        }
-        return NULL;
+        this->updateIndex();
+
+        boost::unordered_map<std::pair<std::string, unsigned int>, EntryIterator>::const_iterator it = this->entriesByNameAndIndex_.find(std::make_pair(name, index));
+        return (it != this->entriesByNameAndIndex_.end() ? *it->second : NULL);
     }
 
     /**
@@ -135,20 +124,20 @@ namespace orxonox
         @param fallback The value that will be used if the entry doesn't exist
         @param bString  If true, the value is treated as string which means some special treatment of special characters.
     */
-    std::list<ConfigFileEntry*>::iterator ConfigFileSection::getOrCreateEntryIterator(const std::string& name, const std::string& fallback, bool bString)
+    ConfigFileSection::EntryIterator ConfigFileSection::getOrCreateEntryIterator(const std::string& name, const std::string& fallback, bool bString)
     {
-        for (std::list<ConfigFileEntry*>::iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
+        this->updateIndex();
+
+        boost::unordered_map<std::string, EntryIterator>::const_iterator it = this->entriesByName_.find(name);
+        if (it != this->entriesByName_.end())
         {
-            if ((*it)->getName() == name)
-            {
-                (*it)->setString(bString);
-                return it;
-            }
+            (*it->second)->setString(bString);
+            return it->second;
         }
 
         this->bUpdated_ = true;
 
-        return this->entries_.insert(this->entries_.end(), new ConfigFileEntryValue(name, fallback, bString));
+        return this->insertEntry(this->entries_.end(), new ConfigFileEntryValue(name, fallback, bString));
     }
 
     /**
@@ -159,22 +148,84 @@ namespace orxonox
         @param fallback The value that will be used if the entry doesn't exist
         @param bString  If true, the value is treated as string which means some special treatment of special characters.
     */
-    std::list<ConfigFileEntry*>::iterator ConfigFileSection::getOrCreateEntryIterator(const std::string& name, unsigned int index, const std::string& fallback, bool bString)
+    ConfigFileSection::EntryIterator ConfigFileSection::getOrCreateEntryIterator(const std::string& name, unsigned int index, const std::string& fallback, bool bString)
     {
-        for (std::list<ConfigFileEntry*>::iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
+        this->updateIndex();
+
+        boost::unordered_map<std::pair<std::string, unsigned int>, EntryIterator>::const_iterator it = this->entriesByNameAndIndex_.find(std::make_pair(name, index));
+        if (it != this->entriesByNameAndIndex_.end())
         {
-            if (((*it)->getName() == name) && ((*it)->getIndex() == index))
-            {
-                (*it)->setString(bString);
-                return it;
-            }
+            (*it->second)->setString(bString);
+            return it->second;
         }
 
         this->bUpdated_ = true;
 
         if (index == 0)
-            return this->entries_.insert(this->entries_.end(), new ConfigFileEntryVectorValue(name, index, fallback, bString));
+            return this->insertEntry(this->entries_.end(), new ConfigFileEntryVectorValue(name, index, fallback, bString));
         else
-            return this->entries_.insert(++this->getOrCreateEntryIterator(name, index - 1, "", bString), new ConfigFileEntryVectorValue(name, index, fallback, bString));
+            return this->insertEntry(++this->getOrCreateEntryIterator(name, index - 1, "", bString), new ConfigFileEntryVectorValue(name, index, fallback, bString));
+    }
+
+    /**
+        @brief Inserts an entry into the list of entries and adds it to the index.
+
+        @param position The entry is inserted before this position
+        @param entry    The new entry
+    */
+    ConfigFileSection::EntryIterator ConfigFileSection::insertEntry(EntryIterator position, ConfigFileEntry* entry)
+    {
+        EntryIterator it = this->entries_.insert(position, entry);
+        if (this->bIndexValid_)
+            this->indexEntry(it);
+        return it;
+    }
+
+    /**
+        @brief Deletes an entry and removes it from the list. Returns the iterator to the next entry.
+
+        The index is rebuilt with the next lookup (removing entries is rare compared to lookups).
+    */
+    ConfigFileSection::EntryIterator ConfigFileSection::removeEntry(EntryIterator it)
+    {
+        delete (*it);
+        this->bIndexValid_ = false;
+        return this->entries_.erase(it);
+    }
+
+    /**
+        @brief Adds an entry to the index unless there's already an entry with the same name (and index).
+    */
+    void ConfigFileSection::indexEntry(EntryIterator it) const
+    {
+        const std::string& name = (*it)->getName();
+        unsigned int index = (*it)->getIndex();
+
+        // like a search in the list, the index returns the first entry with a given name
+        this->entriesByName_.insert(std::make_pair(name, it));
+        this->entriesByNameAndIndex_.insert(std::make_pair(std::make_pair(name, index), it));
+
+        unsigned int& size = this->vectorSizes_[name];
+        if (index >= size)
+            size = index + 1;
+    }
+
+    /**
+        @brief Rebuilds the index if entries were removed.
+    */
+    void ConfigFileSection::updateIndex() const
+    {
+        if (this->bIndexValid_)
+            return;
+
+        this->entriesByName_.clear();
+        this->entriesByNameAndIndex_.clear();
+        this->vectorSizes_.clear();
+
+        std::list<ConfigFileEntry*>& entries = const_cast<std::list<ConfigFileEntry*>&>(this->entries_);
+        for (EntryIterator it = entries.begin(); it != entries.end(); ++it)
+            this->indexEntry(it);
+
+        this->bIndexValid_ = true;
     }
 }
@@ -38,6 +38,7 @@
 
 #include <string>
 #include <list>
+#include <boost/unordered_map.hpp>
 #include "ConfigFileEntry.h"
 
 namespace orxonox
@@ -48,7 +49,9 @@ namespace orxonox
     /**
         @brief Represents a section in a config file.
 
-        A section has a name and a list of config values.
+        A section has a name and a list of config values. The entries are indexed
+        by name (and by name and index for vector elements), so looking up an entry
+        doesn't depend on the number of entries in the section.
     */
     class _CoreExport ConfigFileSection
     {
@@ -66,6 +69,7 @@ namespace orxonox
                 : name_(name)
                 , additionalComment_(additionalComment)
                 , bUpdated_(false)
+                , bIndexValid_(true)
                 {}
             ~ConfigFileSection();
 
@@ -85,7 +89,7 @@ namespace orxonox
                 @param bString  If true, the value is treated as string which means some special treatment of special characters.
             */
             inline void setValue(const std::string& name, const std::string& value, bool bString)
-                { this->getOrCreateEntry(name, value, bString)->setValue(value); }
+                { this->setEntryValue(this->getOrCreateEntry(name, value, bString), value); }
             /**
                 @brief Returns the value of a given entry in the section. Returns a blank string if the value doesn't exist.
 
@@ -121,7 +125,7 @@ namespace orxonox
                 @param bString  If true, the value is treated as string which means some special treatment of special characters.
             */
             inline void setValue(const std::string& name, unsigned int index, const std::string& value, bool bString)
-                { this->getOrCreateEntry(name, index, value, bString)->setValue(value); }
+                { this->setEntryValue(this->getOrCreateEntry(name, index, value, bString), value); }
             /**
                 @brief Returns the value of a given element of a vector in the section. Returns a blank string if the value doesn't exist.
 
@@ -156,9 +160,8 @@ namespace orxonox
             std::string getFileEntry() const;
 
         private:
-            /// Returns the list of entries in this section.
-            std::list<ConfigFileEntry*>& getEntries()
-                { return this->entries_; }
+            typedef std::list<ConfigFileEntry*>::iterator EntryIterator;
+
             /// Returns the begin-iterator of the list of entries in this section.
             std::list<ConfigFileEntry*>::const_iterator getEntriesBegin() const
                 { return this->entries_.begin(); }
@@ -166,8 +169,25 @@ namespace orxonox
             std::list<ConfigFileEntry*>::const_iterator getEntriesEnd() const
                 { return this->entries_.end(); }
 
-            std::list<ConfigFileEntry*>::iterator getOrCreateEntryIterator(const std::string& name, const std::string& fallback, bool bString);
-            std::list<ConfigFileEntry*>::iterator getOrCreateEntryIterator(const std::string& name, unsigned int index, const std::string& fallback, bool bString);
+            EntryIterator getOrCreateEntryIterator(const std::string& name, const std::string& fallback, bool bString);
+            EntryIterator getOrCreateEntryIterator(const std::string& name, unsigned int index, const std::string& fallback, bool bString);
+
+            /// Appends an entry to the section.
+            inline void addEntry(ConfigFileEntry* entry)
+                { this->insertEntry(this->entries_.end(), entry); }
+            EntryIterator insertEntry(EntryIterator position, ConfigFileEntry* entry);
+            EntryIterator removeEntry(EntryIterator it);
+
+            void indexEntry(EntryIterator it) const;
+            void updateIndex() const;
+
+            /// Changes the value of an entry. Marks the section as updated if the value was changed.
+            inline void setEntryValue(ConfigFileEntry* entry, const std::string& value)
+            {
+                if (entry->getValue() != value)
+                    this->bUpdated_ = true;
+                entry->setValue(value);
+            }
 
             ConfigFileEntry* getEntry(const std::string& name) const;
             /**
@@ -195,7 +215,12 @@ namespace orxonox
             std::string name_;                      ///< The name of the section
             std::string additionalComment_;         ///< The additional comment which is placed after the title of the section in the config file
             std::list<ConfigFileEntry*> entries_;   ///< The list of entries in this section
-            bool bUpdated_;                         ///< True if an entry is created
+            bool bUpdated_;                         ///< True if an entry is created or changed
+
+            mutable boost::unordered_map<std::string, EntryIterator> entriesByName_;                                 ///< The first entry with a given name
+            mutable boost::unordered_map<std::pair<std::string, unsigned int>, EntryIterator> entriesByNameAndIndex_;  ///< The first entry with a given name and index
+            mutable boost::unordered_map<std::string, unsigned int> vectorSizes_;                                   ///< The size of the vector with a given name (1 for entries which are no vectors)
+            mutable bool bIndexValid_;                                                                              ///< False if entries were removed and the index has to be rebuilt
     };
 }
 
@@ -183,8 +183,7 @@ namespace orxonox
                     if (!bFound)
                     {
                         // The config-value doesn't exist
-                        delete (*itEntry);
-                        (*itSection)->entries_.erase(itEntry++);
+                        itEntry = (*itSection)->removeEntry(itEntry);
                     }
                 }
                 ++itSection;
@@ -192,8 +191,7 @@ namespace orxonox
             else
             {
                 // The section doesn't exist
-                delete (*itSection);
-                this->sections_.erase(itSection++);
+                itSection = this->removeSection(itSection);
             }
         }
 
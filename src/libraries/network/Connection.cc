@@ -37,13 +37,24 @@
 #include <boost/date_time.hpp>
 
 #include "packet/Packet.h"
+#include <util/Metrics.h>
 #include <util/Sleep.h>
 
 namespace orxonox
 {
   const boost::posix_time::millisec NETWORK_COMMUNICATION_THREAD_WAIT_TIME(200);
+  const unsigned int NETWORK_PEER_STATISTICS_INTERVAL = 50; // number of iterations of the communication thread between two updates of the peer statistics
   const unsigned int                NETWORK_DISCONNECT_TIMEOUT = 500;
 
+  /// Counts the outgoing packets and their size (called from the main thread)
+  static void countOutgoingPacket(ENetPacket* packet)
+  {
+    static MetricCounter& packetsSentMetric = MetricsRegistry::getInstance().registerCounter("network.packets_sent");
+    static MetricCounter& bytesSentMetric = MetricsRegistry::getInstance().registerCounter("network.bytes_sent");
+    packetsSentMetric.add();
+    bytesSentMetric.add(packet->dataLength);
+  }
+
   Connection::Connection(uint32_t firstPeerID):
     host_(0), bCommunicationThreadRunning_(false), nextPeerID_(firstPeerID)
   {
@@ -51,6 +62,7 @@ namespace orxonox
     atexit(enet_deinitialize);
     this->incomingEventsMutex_ = new boost::mutex;
     this->outgoingEventsMutex_ = new boost::mutex;
+    this->peerStatisticsMutex_ = new boost::mutex;
 //     this->overallMutex_ = new boost::mutex;
   }
 
@@ -58,6 +70,7 @@ namespace orxonox
   {
     delete this->incomingEventsMutex_;
     delete this->outgoingEventsMutex_;
+    delete this->peerStatisticsMutex_;
   }
 
   void Connection::startCommunicationThread()
@@ -101,6 +114,7 @@ namespace orxonox
   {
 //     this->overallMutex_->lock();
     outgoingEvent outEvent = { peerID, outgoingEventType::sendPacket, packet, channelID };
+    countOutgoingPacket(packet);
     
     this->outgoingEventsMutex_->lock();
     this->outgoingEvents_.push_back(outEvent);
@@ -112,6 +126,7 @@ namespace orxonox
   {
 //     this->overallMutex_->lock();
     outgoingEvent outEvent = { 0, outgoingEventType::broadcastPacket, packet, channelID };
+    countOutgoingPacket(packet);
     
     this->outgoingEventsMutex_->lock();
     this->outgoingEvents_.push_back(outEvent);
@@ -123,6 +138,7 @@ namespace orxonox
   void Connection::communicationThread()
   {
     ENetEvent event;
+    unsigned int iteration = 0;
     
 //     this->overallMutex_->lock();
     while( bCommunicationThreadRunning_ )
@@ -161,10 +177,48 @@ namespace orxonox
       {
         processIncomingEvent(event);
       }
+      
+      if( ++iteration % NETWORK_PEER_STATISTICS_INTERVAL == 0 )
+        this->updatePeerStatistics();
     }
 //     this->overallMutex_->unlock();
   }
   
+  /**
+   * @brief Copies the round trip time and packet loss of all peers, so the main thread can read them without touching the ENet peers.
+   */
+  void Connection::updatePeerStatistics()
+  {
+    std::map<uint32_t, PeerStatistics> statistics;
+    for( std::map<uint32_t, ENetPeer*>::iterator it = this->peerMap_.begin(); it != this->peerMap_.end(); ++it )
+    {
+      PeerStatistics& peerStatistics = statistics[it->first];
+      peerStatistics.roundTripTime = it->second->roundTripTime;
+      peerStatistics.packetLoss = static_cast<float>(it->second->packetLoss) / ENET_PEER_PACKET_LOSS_SCALE;
+    }
+    
+    this->peerStatisticsMutex_->lock();
+    this->peerStatistics_.swap(statistics);
+    this->peerStatisticsMutex_->unlock();
+  }
+  
+  /**
+   * @brief Returns the link statistics of a peer (updated a few times per second). Returns false if the peer is unknown.
+   */
+  bool Connection::getPeerStatistics(uint32_t peerID, PeerStatistics& statistics) const
+  {
+    bool bFound = false;
+    this->peerStatisticsMutex_->lock();
+    std::map<uint32_t, PeerStatistics>::const_iterator it = this->peerStatistics_.find(peerID);
+    if( it != this->peerStatistics_.end() )
+    {
+      statistics = it->second;
+      bFound = true;
+    }
+    this->peerStatisticsMutex_->unlock();
+    return bFound;
+  }
+  
   void Connection::processIncomingEvent(ENetEvent& event)
   {
     incomingEvent inEvent;
@@ -278,8 +332,14 @@ namespace orxonox
           removePeer(inEvent.peerID);
           break;
         case incomingEventType::receivePacket:
+        {
+          static MetricCounter& packetsReceivedMetric = MetricsRegistry::getInstance().registerCounter("network.packets_received");
+          static MetricCounter& bytesReceivedMetric = MetricsRegistry::getInstance().registerCounter("network.bytes_received");
+          packetsReceivedMetric.add();
+          bytesReceivedMetric.add(inEvent.packet->getSize());
           processPacket(inEvent.packet);
           break;
+        }
         default:
           break;
       }
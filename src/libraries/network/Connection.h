@@ -98,11 +98,19 @@ namespace orxonox
     ENetChannelID             channelID;
   };
   
+  /// The link statistics of a peer as measured by ENet
+  struct _NetworkExport PeerStatistics
+  {
+    uint32_t                  roundTripTime;  //!< mean round trip time in milliseconds
+    float                     packetLoss;     //!< ratio of lost reliable packets (0 to 1)
+  };
+  
   class _NetworkExport Connection
   {
   public:
     virtual ~Connection();
 
+    bool getPeerStatistics(uint32_t peerID, PeerStatistics& statistics) const;
   protected:
     Connection(uint32_t firstPeerID = NETWORK_PEER_ID_SERVER+1);
     
@@ -134,6 +142,7 @@ namespace orxonox
     ENetHost*                     host_;
   private:
     void communicationThread();
+    void updatePeerStatistics();
     
     boost::thread*                communicationThread_;
     bool                          bCommunicationThreadRunning_;
@@ -143,6 +152,8 @@ namespace orxonox
     boost::mutex*                 incomingEventsMutex_;
     boost::mutex*                 outgoingEventsMutex_;
     boost::mutex*                 overallMutex_;
+    boost::mutex*                 peerStatisticsMutex_;
+    std::map<uint32_t, PeerStatistics> peerStatistics_;  //!< copied from the ENet peers by the communication thread
     std::map<uint32_t, ENetPeer*> peerMap_;
     std::map<ENetPeer*, uint32_t> peerIDMap_;
     uint32_t                      nextPeerID_;
@@ -49,6 +49,9 @@ public:
   ~FunctionCall();
 
   inline unsigned int getSize() const { return this->size_; }
+  inline bool isStatic() const { return this->bIsStatic_; }
+  inline uint32_t getFunctionID() const { return this->functionID_; }
+  inline uint32_t getObjectID() const { return this->objectID_; }
   bool execute();
 
   void setCallStatic( uint32_t networkID, const MultiType* mt1=0, const MultiType* mt2=0, const MultiType* mt3=0, const MultiType* mt4=0, const MultiType* mt5=0);
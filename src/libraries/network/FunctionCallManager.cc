@@ -31,68 +31,54 @@
 #include "core/GameMode.h"
 #include "GamestateHandler.h"
 #include "Host.h"
+#include "NetworkFunction.h"
+#include "util/Metrics.h"
 #include "util/OrxAssert.h"
 
 namespace orxonox {
 
-std::map<uint32_t, packet::FunctionCalls*> FunctionCallManager::sPeerMap_;
+std::map<std::pair<uint32_t, CallQoS::Value>, packet::FunctionCalls*> FunctionCallManager::sPeerMap_;
+std::vector<packet::FunctionCalls*> FunctionCallManager::sFullPackets_;
+unsigned int FunctionCallManager::sMaxPacketSize_ = 1200;
 std::vector<std::pair<FunctionCall, std::pair<uint32_t, uint32_t> > > FunctionCallManager::sIncomingFunctionCallBuffer_;
 
 // Static calls
 
 void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallStatic(functionID);
+  FunctionCall call;
+  call.setCallStatic(functionID);
+  FunctionCallManager::addCall(call, peerID, NetworkFunctionStatic::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID, const MultiType& mt1)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager:: sPeerMap_[peerID]->addCallStatic(functionID, &mt1);
+  FunctionCall call;
+  call.setCallStatic(functionID, &mt1);
+  FunctionCallManager::addCall(call, peerID, NetworkFunctionStatic::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager:: sPeerMap_[peerID]->addCallStatic(functionID, &mt1, &mt2);
+  FunctionCall call;
+  call.setCallStatic(functionID, &mt1, &mt2);
+  FunctionCallManager::addCall(call, peerID, NetworkFunctionStatic::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager:: sPeerMap_[peerID]->addCallStatic(functionID, &mt1, &mt2, &mt3);
+  FunctionCall call;
+  call.setCallStatic(functionID, &mt1, &mt2, &mt3);
+  FunctionCallManager::addCall(call, peerID, NetworkFunctionStatic::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3, const MultiType& mt4)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager:: sPeerMap_[peerID]->addCallStatic(functionID, &mt1, &mt2, &mt3, &mt4);
+  FunctionCall call;
+  call.setCallStatic(functionID, &mt1, &mt2, &mt3, &mt4);
+  FunctionCallManager::addCall(call, peerID, NetworkFunctionStatic::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3, const MultiType& mt4, const MultiType& mt5)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager:: sPeerMap_[peerID]->addCallStatic(functionID, &mt1, &mt2, &mt3, &mt4, &mt5);
+  FunctionCall call;
+  call.setCallStatic(functionID, &mt1, &mt2, &mt3, &mt4, &mt5);
+  FunctionCallManager::addCall(call, peerID, NetworkFunctionStatic::getFunction(functionID)->getQoS());
 }
 
 
@@ -100,70 +86,80 @@ void FunctionCallManager::addCallStatic(uint32_t functionID, uint32_t peerID, co
 
 void FunctionCallManager::addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallMember(functionID, objectID);
+  FunctionCall call;
+  call.setCallMember(functionID, objectID);
+  FunctionCallManager::addCall(call, peerID, NetworkMemberFunctionBase::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID, const MultiType& mt1)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallMember(functionID, objectID, &mt1);
+  FunctionCall call;
+  call.setCallMember(functionID, objectID, &mt1);
+  FunctionCallManager::addCall(call, peerID, NetworkMemberFunctionBase::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallMember(functionID, objectID, &mt1, &mt2);
+  FunctionCall call;
+  call.setCallMember(functionID, objectID, &mt1, &mt2);
+  FunctionCallManager::addCall(call, peerID, NetworkMemberFunctionBase::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallMember(functionID, objectID, &mt1, &mt2, &mt3);
+  FunctionCall call;
+  call.setCallMember(functionID, objectID, &mt1, &mt2, &mt3);
+  FunctionCallManager::addCall(call, peerID, NetworkMemberFunctionBase::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3, const MultiType& mt4)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallMember(functionID, objectID, &mt1, &mt2, &mt3, &mt4);
+  FunctionCall call;
+  call.setCallMember(functionID, objectID, &mt1, &mt2, &mt3, &mt4);
+  FunctionCallManager::addCall(call, peerID, NetworkMemberFunctionBase::getFunction(functionID)->getQoS());
 }
 void FunctionCallManager::addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3, const MultiType& mt4, const MultiType& mt5)
 {
-  if(sPeerMap_.find(peerID)==sPeerMap_.end())
-  {
-    FunctionCallManager::sPeerMap_[peerID] = new packet::FunctionCalls;
-    FunctionCallManager::sPeerMap_[peerID]->setPeerID(peerID);
-  }
-  FunctionCallManager::sPeerMap_[peerID]->addCallMember(functionID, objectID, &mt1, &mt2, &mt3, &mt4, &mt5);
+  FunctionCall call;
+  call.setCallMember(functionID, objectID, &mt1, &mt2, &mt3, &mt4, &mt5);
+  FunctionCallManager::addCall(call, peerID, NetworkMemberFunctionBase::getFunction(functionID)->getQoS());
 }
 
 // Send calls
 
 void FunctionCallManager::sendCalls(orxonox::Host* host)
 {
-  std::map<uint32_t, packet::FunctionCalls*>::iterator it;
+  static MetricCounter& packetsMetric = MetricsRegistry::getInstance().registerCounter("network.function_call_packets");
+
+  std::map<std::pair<uint32_t, CallQoS::Value>, packet::FunctionCalls*>::iterator it;
   for (it = FunctionCallManager::sPeerMap_.begin(); it != FunctionCallManager::sPeerMap_.end(); ++it )
+    FunctionCallManager::sFullPackets_.push_back(it->second);
+  FunctionCallManager::sPeerMap_.clear();
+
+  for (size_t i = 0; i < FunctionCallManager::sFullPackets_.size(); ++i)
+    FunctionCallManager::sFullPackets_[i]->send(host);
+  packetsMetric.add(FunctionCallManager::sFullPackets_.size());
+  FunctionCallManager::sFullPackets_.clear();
+}
+
+/**
+    @brief Adds the call to the open packet for the given peer and delivery guarantee. If the call
+    doesn't fit into this packet anymore, the packet is closed and the call starts a new one.
+*/
+void FunctionCallManager::addCall(const FunctionCall& call, uint32_t peerID, CallQoS::Value qos)
+{
+  static MetricCounter& callsMetric = MetricsRegistry::getInstance().registerCounter("network.function_calls");
+  callsMetric.add();
+
+  std::pair<uint32_t, CallQoS::Value> key = std::make_pair(peerID, qos);
+  packet::FunctionCalls*& calls = FunctionCallManager::sPeerMap_[key];
+  if (calls && calls->getNumberOfCalls() != 0 && calls->getSize() + call.getSize() > FunctionCallManager::sMaxPacketSize_)
   {
-    assert(!FunctionCallManager::sPeerMap_.empty());
-    it->second->send(host);
+    FunctionCallManager::sFullPackets_.push_back(calls);
+    calls = 0;
   }
-  FunctionCallManager::sPeerMap_.clear();
+  if (!calls)
+  {
+    calls = new packet::FunctionCalls(qos);
+    calls->setPeerID(peerID);
+  }
+  calls->addCall(call);
 }
 
 void FunctionCallManager::bufferIncomingFunctionCall(const orxonox::FunctionCall& fctCall, uint32_t minGamestateID, uint32_t peerID)
@@ -40,6 +40,12 @@
 namespace orxonox {
 /**
     @author
+
+    Collects the outgoing function calls of a tick and sends them in one packet
+    per peer and delivery guarantee (see CallQoS). If a call would make a packet
+    exceed the maximum packet size, the packet is closed and the call starts a
+    new one, so large batches are split before ENet has to fragment them (a lost
+    fragment would drop the whole unreliable packet).
 */
 
 class _NetworkExport FunctionCallManager
@@ -60,15 +66,27 @@ public:
   static void addCallMember(uint32_t functionID, uint32_t objectID, uint32_t peerID, const MultiType& mt1, const MultiType& mt2, const MultiType& mt3, const MultiType& mt4, const MultiType& mt5);
 
   static void sendCalls(orxonox::Host* host);
-  
+
+  /// Sets the size (in bytes) after which a packet of function calls is closed and sent (config value maxFunctionCallPacketSize_ of GSRoot).
+  static inline void setMaxPacketSize(unsigned int size)
+    { FunctionCallManager::sMaxPacketSize_ = size; }
+  static inline unsigned int getMaxPacketSize()
+    { return FunctionCallManager::sMaxPacketSize_; }
+
   static void bufferIncomingFunctionCall( const FunctionCall& fctCall, uint32_t minGamestateID, uint32_t peerID );
   static void processBufferedFunctionCalls();
 
-  static std::map<uint32_t, packet::FunctionCalls*>                           sPeerMap_;
+  static std::map<std::pair<uint32_t, CallQoS::Value>, packet::FunctionCalls*> sPeerMap_;
+  static std::vector<packet::FunctionCalls*>                                   sFullPackets_;
   static std::vector<std::pair<FunctionCall,std::pair<uint32_t, uint32_t> > > sIncomingFunctionCallBuffer_;
 protected:
   FunctionCallManager();
   ~FunctionCallManager();
+
+private:
+  static void addCall(const FunctionCall& call, uint32_t peerID, CallQoS::Value qos);
+
+  static unsigned int sMaxPacketSize_;
 };
 
 } //namespace orxonox
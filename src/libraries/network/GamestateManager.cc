@@ -40,6 +40,7 @@
 
 #include "GamestateManager.h"
 
+#include <algorithm>
 #include <cassert>
 #include <queue>
 // #include <boost/thread/mutex.hpp>
@@ -47,19 +48,49 @@
 #include "packet/Acknowledgement.h"
 #include "packet/Gamestate.h"
 #include "synchronisable/NetworkCallbackManager.h"
+#include "synchronisable/Synchronisable.h"
+#include "Host.h"
+#include "NetworkFunction.h"
 
 #include "core/ThreadPool.h"
 #include "core/command/Executor.h"
 #include "core/GameMode.h"
 #include "util/Output.h"
 #include "util/Clock.h"
+#include "util/Metrics.h"
 #include "util/OrxAssert.h"
 // #include "TrafficControl.h"
 
 namespace orxonox
 { 
+  // limits of the adaptive send rate of the server
+  const float    SEND_INTERVAL_LAN      = NETWORK_PERIOD / 2;   // peers in the LAN get twice the normal rate
+  const float    SEND_INTERVAL_MAX      = NETWORK_PERIOD * 8;   // congested peers still get ~3 gamestates per second
+  const float    LAN_ROUND_TRIP_TIME    = 0.02f;                // peers with a shorter round trip time (and no packet loss) are in the LAN
+  const uint32_t BYTE_BUDGET_INITIAL    = 16000;
+  const uint32_t BYTE_BUDGET_MIN        = 1000;
+  const uint32_t BYTE_BUDGET_MAX        = 64000;
+
+  // signals of a congested link
+  const float    CONGESTION_MIN_DELAY   = 0.05f;    // queueing delay which is tolerated in any case (jitter)
+  const float    CONGESTION_PACKET_LOSS = 0.05f;
+  const float    ACK_TIMEOUT            = 1.0f;     // at least, 4 round trip times otherwise
+  const float    MIN_RTT_INCREASE       = 0.0002f;  // per ack, so the minimum follows slowly if the route changes
+
+  // priority values from which on the changes of objects are left out, by omitLevel
+  const int      OMIT_PRIORITIES[]      = { packet::GAMESTATE_OMIT_NONE, Priority::VeryLow, Priority::Low };
+  const unsigned int OMIT_LEVELS        = sizeof(OMIT_PRIORITIES) / sizeof(OMIT_PRIORITIES[0]);
+
+  // objects which a joining peer gets per gamestate (the peer creates them all in the frame in which it receives the gamestate)
+  const uint32_t JOIN_OBJECTS_PER_GAMESTATE = 50;
+
+  std::queue<std::string> GamestateManager::prefetchQueue_;
+
+  // the order of the resources doesn't matter
+  registerStaticNetworkFunctionWithQoS(GamestateManager::prefetchResource, CallQoS::ReliableUnordered);
+
   GamestateManager::GamestateManager() :
-  currentGamestate_(0), id_(0)
+  currentGamestate_(0), id_(0), time_(0)
   {
 //     trafficControl_ = new TrafficControl();
 //     threadMutex_ = new boost::mutex();
@@ -132,7 +163,7 @@ namespace orxonox
     }
     else
     {
-      orxout(verbose_more, context::network) << "acked a gamestate: " << gamestateID << endl;
+      orxout_filtered(verbose_more, context::network) << "acked a gamestate: " << gamestateID << endl;
       return true;
     }
   }
@@ -175,17 +206,34 @@ namespace orxonox
     if(!currentGamestate_)
       return std::vector<packet::Gamestate*>();
     std::vector<packet::Gamestate*> peerGamestates;
+    const float snapshotInterval = this->getSnapshotInterval();
+    unsigned int congestedPeers = 0;
     
     std::map<uint32_t, peerInfo>::iterator peerIt;
     for( peerIt=peerMap_.begin(); peerIt!=peerMap_.end(); ++peerIt )
     {
       if( !peerIt->second.isSynched )
       {
-        orxout(verbose_more, context::network) << "Server: not sending gamestate" << endl;
+        orxout_filtered(verbose_more, context::network) << "Server: not sending gamestate" << endl;
         continue;
       }
-      orxout(verbose_more, context::network) << "client id: " << peerIt->first << endl;
-      orxout(verbose_more, context::network) << "Server: doing gamestate gamestate preparation" << endl;
+      peerInfo& peer = peerIt->second;
+      if( GameMode::isMaster() )
+      {
+        // no ack for a long time: the gamestates (or the acks) are stuck somewhere
+        const float timeout = std::max(ACK_TIMEOUT, 4 * peer.smoothedRTT);
+        if( !peer.sentGamestates.empty() && (this->time_ - peer.sentGamestates.begin()->second.first) / 1000000.0f > timeout )
+          this->updateSendRate( peer, true );
+        if( peer.sendInterval > NETWORK_PERIOD || peer.omitLevel > 0 )
+          ++congestedPeers;
+
+        // send only if the interval of the peer is over (snapshots may be taken more often for other peers)
+        if( peer.timeSinceLastSend + snapshotInterval / 2 < peer.sendInterval )
+          continue;
+        peer.timeSinceLastSend = std::min(peer.timeSinceLastSend - peer.sendInterval, peer.sendInterval);
+      }
+      orxout_filtered(verbose_more, context::network) << "client id: " << peerIt->first << endl;
+      orxout_filtered(verbose_more, context::network) << "Server: doing gamestate gamestate preparation" << endl;
       int peerID = peerIt->first; //get client id
 
       unsigned int lastAckedGamestateID = peerIt->second.lastAckedGamestateID;
@@ -204,6 +252,18 @@ namespace orxonox
       if( peerGamestates.back()==0 )
         // nothing to send to remove pointer from vector
         peerGamestates.pop_back();
+      else if( GameMode::isMaster() )
+      {
+        const uint32_t size = peerGamestates.back()->getDataSize();
+        peer.sentGamestates[currentGamestate_->getID()] = std::make_pair(this->time_, size);
+        ++peer.sentCount;
+
+        // leave out more low priority objects if the gamestates are too big for the link, and less if there's space again
+        if( size > peer.byteBudget && peer.omitLevel + 1 < OMIT_LEVELS )
+          ++peer.omitLevel;
+        else if( size < peer.byteBudget / 2 && peer.omitLevel > 0 )
+          --peer.omitLevel;
+      }
       //FunctorMember<GamestateManager>* functor =
 //       ExecutorMember<GamestateManager>* executor = createExecutor( createFunctor(&GamestateManager::finishGamestate, this) );
 //       executor->setDefaultValues( cid, &clientGamestates.back(), client, currentGamestate_ );
@@ -214,6 +274,8 @@ namespace orxonox
 
 //     threadPool_->synchronise();
 
+    if( GameMode::isMaster() )
+      MetricsRegistry::getInstance().registerGauge("network.congested_peers").set(congestedPeers);
     return peerGamestates;
   }
 
@@ -238,7 +300,9 @@ namespace orxonox
 
     if(base)
     {
-      packet::Gamestate *diffed1 = gs->diffVariables(base);
+      // new objects are limited as long as the peer hasn't received the whole level since it joined
+      const uint32_t maxNewObjects = (GameMode::isMaster() && base->getNrOfMissingObjects() != 0 ? JOIN_OBJECTS_PER_GAMESTATE : packet::GAMESTATE_NEW_OBJECTS_UNLIMITED);
+      packet::Gamestate *diffed1 = gs->diffVariables(base, OMIT_PRIORITIES[peerMap_[peerID].omitLevel], peerMap_[peerID].sentCount, maxNewObjects);
       if( diffed1->getDataSize() == 0 )
       {
         delete diffed1;
@@ -247,6 +311,18 @@ namespace orxonox
       }
       gs = diffed1;
     }
+    else if( GameMode::isMaster() )
+    {
+      // the peer joins: the objects are sent over several gamestates (see Gamestate::selectObjects())
+      packet::Gamestate* fullGamestate = gs;
+      gs = gs->selectObjects(JOIN_OBJECTS_PER_GAMESTATE);
+      // the resources are announced only once, the peer gets full gamestates until it acks the first one
+      if( !peerMap_[peerID].prefetchSent )
+      {
+        this->sendPrefetchResources(peerID, fullGamestate->getMissingObjects());
+        peerMap_[peerID].prefetchSent = true;
+      }
+    }
     else
     {
       gs = new packet::Gamestate(*gs);
@@ -255,7 +331,12 @@ namespace orxonox
 
 //     OrxVerify(gs->compressData(), "");
     clock.capture();
-    orxout(verbose_more, context::network) << "diff and compress time: " << clock.getDeltaTime() << endl;
+    orxout_filtered(verbose_more, context::network) << "diff and compress time: " << clock.getDeltaTime() << endl;
+
+    static MetricHistogram& diffTimeMetric = MetricsRegistry::getInstance().registerHistogram("network.gamestate_diff_time", MetricHistogram::getDefaultTimeBounds());
+    static MetricHistogram& gamestateSizeMetric = MetricsRegistry::getInstance().registerHistogram("network.gamestate_size", MetricHistogram::getDefaultSizeBounds());
+    diffTimeMetric.sample(clock.getDeltaTime());
+    gamestateSizeMetric.sample(gs->getDataSize());
 //     orxout(verbose_more, context::network) << "sending gamestate with id " << gs->getID();
 //     if(gamestate->isDiffed())
 //       orxout(verbose_more, context::network) << " and baseid " << gs->getBaseID() << endl;
@@ -290,7 +371,7 @@ namespace orxonox
 //    assert(curid==GAMESTATEID_INITIAL || curid<=gamestateID); // this line is commented out because acknowledgements are unreliable and may arrive in distorted order
     if( gamestateID <= curid && curid != GAMESTATEID_INITIAL )
         return true;
-orxout(verbose, context::network) << "acking gamestate " << gamestateID << " for peerID: " << peerID << " curid: " << curid << endl;
+orxout_filtered(verbose, context::network) << "acking gamestate " << gamestateID << " for peerID: " << peerID << " curid: " << curid << endl;
     std::map<uint32_t, packet::Gamestate*>::iterator it2;
     for( it2=it->second.gamestates.begin(); it2!=it->second.gamestates.end(); )
     {
@@ -311,8 +392,112 @@ orxout(verbose, context::network) << "acking gamestate " << gamestateID << " for
     it->second.lastAckedGamestateID = gamestateID;
 //     temp->setGamestateID(gamestateID);
 //     TrafficControl::processAck(peerID, gamestateID);
+    if( GameMode::isMaster() )
+      this->processAckTiming( it->second, gamestateID );
     return true;
   }
+
+  /**
+  * Updates the estimated round trip time and bandwidth of a peer with the ack of a gamestate and adapts the send rate.
+  */
+  void GamestateManager::processAckTiming( peerInfo& peer, uint32_t gamestateID )
+  {
+    // all gamestates up to the acked one either arrived or got lost
+    float roundTripTime = -1;
+    uint32_t deliveredBytes = 0;
+    std::map< uint32_t, std::pair<unsigned long long, uint32_t> >::iterator it = peer.sentGamestates.begin();
+    while( it != peer.sentGamestates.end() && it->first <= gamestateID )
+    {
+      if( it->first == gamestateID )
+        roundTripTime = (this->time_ - it->second.first) / 1000000.0f;
+      deliveredBytes += it->second.second;
+      peer.sentGamestates.erase(it++);
+    }
+
+    if( roundTripTime >= 0 )
+    {
+      peer.smoothedRTT = (peer.smoothedRTT == 0 ? roundTripTime : 0.875f * peer.smoothedRTT + 0.125f * roundTripTime);
+      peer.minRTT = (peer.minRTT == 0 ? roundTripTime : std::min(roundTripTime, peer.minRTT + MIN_RTT_INCREASE));
+    }
+    if( peer.lastAckTime != 0 && this->time_ > peer.lastAckTime )
+    {
+      const float bandwidth = deliveredBytes / ((this->time_ - peer.lastAckTime) / 1000000.0f);
+      peer.bandwidth = (peer.bandwidth == 0 ? bandwidth : 0.9f * peer.bandwidth + 0.1f * bandwidth);
+    }
+    peer.lastAckTime = this->time_;
+
+    // the link is congested if the gamestates queue up (the round trip time grows) or get lost
+    const bool bQueueing = peer.smoothedRTT > peer.minRTT + std::max(peer.minRTT, CONGESTION_MIN_DELAY);
+    this->updateSendRate( peer, bQueueing || peer.packetLoss > CONGESTION_PACKET_LOSS );
+  }
+
+  /**
+  * Sends fewer and smaller gamestates to a congested peer (at most once per round trip and send interval, so
+  * the effect of the last change can be seen first) and slowly increases the rate again otherwise.
+  */
+  void GamestateManager::updateSendRate( peerInfo& peer, bool bCongested )
+  {
+    if( bCongested )
+    {
+      if( (this->time_ - peer.lastDecreaseTime) / 1000000.0f < std::max(peer.smoothedRTT, peer.sendInterval) )
+        return;
+      peer.sendInterval = std::min(peer.sendInterval * 1.5f, SEND_INTERVAL_MAX);
+      peer.byteBudget = std::max(peer.byteBudget * 7 / 10, BYTE_BUDGET_MIN);
+      peer.lastDecreaseTime = this->time_;
+    }
+    else
+    {
+      const bool bLAN = peer.enetRTT > 0 && peer.enetRTT < LAN_ROUND_TRIP_TIME && peer.packetLoss == 0;
+      const float minInterval = (bLAN ? SEND_INTERVAL_LAN : NETWORK_PERIOD);
+      peer.sendInterval = std::max(peer.sendInterval * 0.95f, minInterval);
+      // don't plan much more bytes per gamestate than the link delivered so far (but let the budget grow slowly)
+      uint32_t maxBudget = BYTE_BUDGET_MAX;
+      if( peer.bandwidth > 0 )
+        maxBudget = std::max(static_cast<uint32_t>(std::min(2 * peer.bandwidth * peer.sendInterval, static_cast<float>(BYTE_BUDGET_MAX))), BYTE_BUDGET_MIN);
+      peer.byteBudget = std::min(peer.byteBudget + peer.byteBudget / 16, std::max(maxBudget, peer.byteBudget));
+    }
+  }
+
+  /**
+  * Stores the current time (used to measure the round trip times) and advances the send timers of all peers.
+  */
+  void GamestateManager::updateTime(const Clock& time)
+  {
+    this->time_ = time.getMicroseconds();
+    std::map<uint32_t, peerInfo>::iterator it;
+    for( it = this->peerMap_.begin(); it != this->peerMap_.end(); ++it )
+      it->second.timeSinceLastSend += time.getDeltaTime();
+  }
+
+  /**
+  * Sets the round trip time (in seconds) and packet loss of a peer as measured by ENet.
+  */
+  void GamestateManager::setPeerStatistics( uint32_t peerID, float roundTripTime, float packetLoss )
+  {
+    std::map<uint32_t, peerInfo>::iterator it = this->peerMap_.find(peerID);
+    if( it == this->peerMap_.end() )
+      return;
+    it->second.enetRTT = roundTripTime;
+    it->second.packetLoss = packetLoss;
+  }
+
+  /**
+  * Returns the time between two snapshots, i.e. the shortest send interval of all peers.
+  */
+  float GamestateManager::getSnapshotInterval() const
+  {
+    float interval = SEND_INTERVAL_MAX;
+    bool bSynched = false;
+    std::map<uint32_t, peerInfo>::const_iterator it;
+    for( it = this->peerMap_.begin(); it != this->peerMap_.end(); ++it )
+    {
+      if( !it->second.isSynched )
+        continue;
+      interval = std::min(interval, it->second.sendInterval);
+      bSynched = true;
+    }
+    return (bSynched ? std::max(interval, SEND_INTERVAL_LAN) : NETWORK_PERIOD);
+  }
   
   uint32_t GamestateManager::getLastReceivedGamestateID(unsigned int peerID)
   {
@@ -334,6 +519,24 @@ orxout(verbose, context::network) << "acking gamestate " << gamestateID << " for
       peerMap_[peerID].isSynched = false;
     else
       peerMap_[peerID].isSynched = true;
+
+    // the server starts with the normal rate, the client sends a gamestate whenever it is asked to
+    peerInfo& peer = peerMap_[peerID];
+    peer.sendInterval = (GameMode::isMaster() ? NETWORK_PERIOD : 0);
+    peer.timeSinceLastSend = peer.sendInterval;
+    peer.byteBudget = BYTE_BUDGET_INITIAL;
+    peer.omitLevel = 0;
+    peer.sentCount = 0;
+    peer.smoothedRTT = 0;
+    peer.minRTT = 0;
+    peer.enetRTT = 0;
+    peer.packetLoss = 0;
+    peer.bandwidth = 0;
+    peer.lastAckTime = 0;
+    peer.lastDecreaseTime = 0;
+    peer.prefetchSent = false;
+
+    MetricsRegistry::getInstance().registerGauge("network.peers").set(peerMap_.size());
   }
 
   void GamestateManager::removePeer(uint32_t peerID)
@@ -345,8 +548,59 @@ orxout(verbose, context::network) << "acking gamestate " << gamestateID << " for
       delete peerIt->second;
     }
     peerMap_.erase(peerMap_.find(peerID));
+
+    // the client's only peer is the server, the resources it announced aren't needed anymore after the disconnect
+    if( !GameMode::isMaster() )
+      prefetchQueue_ = std::queue<std::string>();
+
+    MetricsRegistry::getInstance().registerGauge("network.peers").set(peerMap_.size());
+  }
+
+
+  /**
+   * Sends a joining peer the resources (e.g. meshes) of the objects which it will get with the following
+   * gamestates. The peer loads them while it creates the first objects (see popPrefetchResource()).
+   * @param peerID the joining peer
+   * @param objectIDs the objects which were held back from the first gamestate
+   */
+  void GamestateManager::sendPrefetchResources( uint32_t peerID, const std::set<uint32_t>& objectIDs )
+  {
+    std::set<std::string> resources;
+    std::vector<std::string> objectResources;
+    for( std::set<uint32_t>::const_iterator it = objectIDs.begin(); it != objectIDs.end(); ++it )
+    {
+      Synchronisable* object = Synchronisable::getSynchronisable(*it);
+      if( !object )
+        continue;
+      objectResources.clear();
+      object->getPrefetchResources(objectResources);
+      resources.insert(objectResources.begin(), objectResources.end());
+    }
+    for( std::set<std::string>::const_iterator it = resources.begin(); it != resources.end(); ++it )
+      callStaticNetworkFunction(GamestateManager::prefetchResource, peerID, *it);
+  }
+
+  /**
+   * Queues a resource which the server will need soon (called by the server on a joining client).
+   */
+  void GamestateManager::prefetchResource( const std::string& name )
+  {
+    prefetchQueue_.push(name);
   }
 
+  /**
+   * Takes the next resource which should be loaded in advance, see sendPrefetchResources().
+   * The client loads them one by one between the frames (e.g. GSClient).
+   * @return false if the queue is empty
+   */
+  bool GamestateManager::popPrefetchResource( std::string& name )
+  {
+    if( prefetchQueue_.empty() )
+      return false;
+    name = prefetchQueue_.front();
+    prefetchQueue_.pop();
+    return true;
+  }
 
 //   void GamestateManager::removeClient(ClientInformation* client){
 //     assert(client);
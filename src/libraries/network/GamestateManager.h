@@ -43,6 +43,9 @@
 #include "NetworkPrereqs.h"
 
 #include <map>
+#include <queue>
+#include <set>
+#include <string>
 #include "GamestateHandler.h"
 #include "core/CorePrereqs.h"
 #include "packet/Gamestate.h"
@@ -65,6 +68,23 @@ namespace orxonox
   * x=(a^b)
   * b=(a^x)
   * diff(a,diff(a,x))=x (hope this is correct)
+  *
+  * SEND RATE:
+  * The server estimates the round trip time and the bandwidth of each peer
+  * from the acks of the gamestates (and the statistics of ENet) and adapts
+  * the time between two gamestates and their size to the link of the peer.
+  * Congested peers get fewer gamestates and the changes of low priority
+  * objects are left out for a few gamestates, peers in the LAN get more.
+  *
+  * JOINING:
+  * A joining peer doesn't get all objects in its first gamestate, because it
+  * would create the whole level in one frame. Only a limited number of objects
+  * is sent per gamestate (in the order of their creation, each one together
+  * with its context and the objects it refers to), the others are
+  * marked as missing in the gamestate which is kept as base and are sent by
+  * the following diffs. Since the diffs are based on the last acked gamestate,
+  * a slow peer (which acks late) gets the objects more slowly. Meanwhile it
+  * loads the resources of the missing objects (see prefetchResource()).
   * @author Oliver Scheuss
   */
   class _NetworkExport GamestateManager: public GamestateHandler
@@ -76,6 +96,21 @@ namespace orxonox
       uint32_t  lastAckedGamestateID;     //!< id of the last gamestate on which we received an ack from the peer
       bool      isSynched;
       std::map< uint32_t, packet::Gamestate* > gamestates;
+
+      float     sendInterval;             //!< time between two gamestates (adapted to the link of the peer on the server)
+      float     timeSinceLastSend;        //!< time since the last gamestate was sent to the peer
+      uint32_t  byteBudget;               //!< size which the gamestates shouldn't exceed, low priority objects are left out otherwise
+      unsigned int omitLevel;             //!< index in OMIT_PRIORITIES, the higher the more objects are left out
+      uint32_t  sentCount;                //!< number of gamestates sent to the peer (limits how long objects are left out, see Gamestate::diffVariables())
+      float     smoothedRTT;              //!< smoothed time between sending a gamestate and receiving its ack in seconds (0 if not measured yet)
+      float     minRTT;                   //!< lowest (slowly increasing) round trip time, i.e. the delay of the link without queueing
+      float     enetRTT;                  //!< round trip time of reliable packets as measured by ENet
+      float     packetLoss;               //!< packet loss as measured by ENet (0 to 1)
+      float     bandwidth;                //!< estimated bytes per second which reach the peer
+      unsigned long long lastAckTime;     //!< time of the last ack in microseconds
+      unsigned long long lastDecreaseTime;//!< time when the send rate was decreased the last time
+      std::map< uint32_t, std::pair<unsigned long long, uint32_t> > sentGamestates; //!< send time and size of the gamestates which weren't acked yet
+      bool      prefetchSent;             //!< true if the resources of the objects missing on the joining peer were already announced
     };
     
   public:
@@ -87,6 +122,7 @@ namespace orxonox
     virtual bool      ackGamestate(unsigned int gamestateID, unsigned int peerID);
     virtual uint32_t  getLastReceivedGamestateID( unsigned int peerID );
     virtual uint32_t  getCurrentGamestateID(){ if( currentGamestate_) return currentGamestate_->getID(); else return GAMESTATEID_INITIAL; }
+    packet::Gamestate* getCurrentGamestate(){ return currentGamestate_; }
     
     bool processGamestates();
     bool sendAck(unsigned int gamestateID, uint32_t peerID);
@@ -96,16 +132,26 @@ namespace orxonox
 
     bool getSnapshot();
 
+    void updateTime(const Clock& time);
+    void setPeerStatistics( uint32_t peerID, float roundTripTime, float packetLoss );
+    float getSnapshotInterval() const;
+
     void addPeer( uint32_t peerID );
     void setSynched( uint32_t peerID )
       { assert(peerMap_.find(peerID)!=peerMap_.end()); peerMap_[peerID].isSynched = true; }
     void removePeer( uint32_t peerID );
     bool hasPeers(){ return this->peerMap_.size()!=0; }
+
+    static void prefetchResource( const std::string& name );
+    static bool popPrefetchResource( std::string& name );
 //     void removeClient(ClientInformation *client);
   protected:
     virtual bool sendPacket( packet::Packet* packet ) = 0;
   private:
     bool processGamestate(packet::Gamestate *gs);
+    void processAckTiming( peerInfo& peer, uint32_t gamestateID );
+    void updateSendRate( peerInfo& peer, bool bCongested );
+    void sendPrefetchResources( uint32_t peerID, const std::set<uint32_t>& objectIDs );
 
 //     std::map<unsigned int, std::map<unsigned int, packet::Gamestate*> > gamestateMap_;
     std::map<unsigned int, packet::Gamestate*> gamestateQueue;
@@ -114,8 +160,11 @@ namespace orxonox
     packet::Gamestate* currentGamestate_;
 //     TrafficControl *trafficControl_;
     unsigned int id_;
+    unsigned long long time_;   //!< current time in microseconds (set by updateTime())
 //     boost::mutex* threadMutex_;
     ThreadPool*   /*thread*/Pool_;
+
+    static std::queue<std::string> prefetchQueue_;  //!< resources which the client loads before it gets the objects that use them
   };
 
 }
@@ -49,6 +49,7 @@ namespace orxonox
     this->networkID_ = networkID++;
 
     this->name_ = name;
+    this->qos_ = CallQoS::ReliableOrdered;
     NetworkFunctionBase::getNameMap()[name] = this;
   }
   NetworkFunctionBase::~NetworkFunctionBase()
@@ -78,6 +78,8 @@ class _NetworkExport NetworkFunctionBase: virtual public Listable {
     virtual void        setNetworkID(uint32_t id)       { this->networkID_ = id; }
     inline uint32_t     getNetworkID() const            { return this->networkID_; }
     inline const std::string& getName() const           { return name_; }
+    inline void         setQoS(CallQoS::Value qos)      { this->qos_ = qos; }
+    inline CallQoS::Value getQoS() const                { return this->qos_; }
     static inline bool  isStatic( uint32_t networkID )  { return isStaticMap_[networkID]; }
 
     static inline void setNetworkID(const std::string& name, uint32_t id)
@@ -96,6 +98,7 @@ class _NetworkExport NetworkFunctionBase: virtual public Listable {
     static std::map<std::string, NetworkFunctionBase*>& getNameMap();
     uint32_t networkID_;
     std::string name_;
+    CallQoS::Value qos_;  ///< The delivery guarantee of the calls (see FunctionCallManager)
 
 };
 
@@ -236,21 +239,23 @@ template<class T> inline void copyPtr( T ptr, NetworkFunctionPointer& destptr)
 //     *((uint32_t*)destptr+i) = p2>>32*i;
 }
 
-template<class T> inline void* registerStaticNetworkFunctionFct( T ptr, const std::string& name )
+template<class T> inline void* registerStaticNetworkFunctionFct( T ptr, const std::string& name, CallQoS::Value qos = CallQoS::ReliableOrdered )
 {
   BOOST_STATIC_ASSERT( sizeof(T)<=sizeof(NetworkFunctionPointer) ); // if this fails your compiler uses bigger pointers for static functions than defined above
   NetworkFunctionPointer destptr;
   copyPtr( ptr, destptr );
-  new NetworkFunctionStatic( createFunctor(ptr), name, destptr );
+  NetworkFunctionStatic* function = new NetworkFunctionStatic( createFunctor(ptr), name, destptr );
+  function->setQoS( qos );
   return 0;
 }
 
-template<class T, class PT> inline void* registerMemberNetworkFunctionFct( PT ptr, const std::string& name )
+template<class T, class PT> inline void* registerMemberNetworkFunctionFct( PT ptr, const std::string& name, CallQoS::Value qos = CallQoS::ReliableOrdered )
 {
   BOOST_STATIC_ASSERT( sizeof(PT)<=sizeof(NetworkFunctionPointer) ); // if this fails your compiler uses bigger pointers for a specific kind of member functions than defined above
   NetworkFunctionPointer destptr;
   copyPtr( ptr, destptr );
-  new NetworkMemberFunction<T>( createFunctor(ptr), name, destptr );
+  NetworkMemberFunction<T>* function = new NetworkMemberFunction<T>( createFunctor(ptr), name, destptr );
+  function->setQoS( qos );
   return 0;
 }
 
@@ -258,6 +263,11 @@ template<class T, class PT> inline void* registerMemberNetworkFunctionFct( PT pt
   static void* BOOST_PP_CAT( NETWORK_FUNCTION_, __UNIQUE_NUMBER__ ) = registerStaticNetworkFunctionFct( functionPointer, #functionPointer );
 #define registerMemberNetworkFunction( class, function ) \
   static void* BOOST_PP_CAT( NETWORK_FUNCTION_##class, __UNIQUE_NUMBER__ ) = registerMemberNetworkFunctionFct<class>( &class::function, #class "_" #function);
+  // same as above, but with a delivery guarantee other than CallQoS::ReliableOrdered
+#define registerStaticNetworkFunctionWithQoS( functionPointer, qos ) \
+  static void* BOOST_PP_CAT( NETWORK_FUNCTION_, __UNIQUE_NUMBER__ ) = registerStaticNetworkFunctionFct( functionPointer, #functionPointer, qos );
+#define registerMemberNetworkFunctionWithQoS( class, function, qos ) \
+  static void* BOOST_PP_CAT( NETWORK_FUNCTION_##class, __UNIQUE_NUMBER__ ) = registerMemberNetworkFunctionFct<class>( &class::function, #class "_" #function, qos);
   // call it with functionPointer, clientID, args
 #define callStaticNetworkFunction( functionPointer, ...) \
   { \
@@ -75,7 +75,8 @@ namespace orxonox
   static const unsigned int NETWORK_PEER_ID_UNKNOWN     = static_cast<unsigned int>(-2);
   static const unsigned int NETWORK_CHANNEL_DEFAULT     = 0;
   static const unsigned int NETWORK_CHANNEL_UNRELIABLE  = 1;
-  static const unsigned int NETWORK_CHANNEL_COUNT       = 2;
+  static const unsigned int NETWORK_CHANNEL_UNORDERED   = 2;
+  static const unsigned int NETWORK_CHANNEL_COUNT       = 3;
 }
 
 //-----------------------------------------------------------------------
@@ -84,6 +85,17 @@ namespace orxonox
 
 namespace orxonox
 {
+  /// The delivery guarantee of a network function call
+  namespace CallQoS
+  {
+    enum Value
+    {
+      ReliableOrdered,      ///< Arrives in order with all other reliable packets (e.g. object deletions and other ordered calls) (default)
+      ReliableUnordered,    ///< Arrives, but on its own channel, so it isn't held back by lost packets of the ordered calls
+      UnreliableSequenced   ///< May get lost, late calls are dropped; repeated calls to the same object are merged within a tick
+    };
+  }
+
   namespace packet
   {
     namespace PacketFlag
@@ -138,6 +150,8 @@ namespace orxonox
   class NetworkMemberFunction;
   class NetworkMemberFunctionBase;
   class PeerList;
+  class ReplayPlayer;
+  class ReplayRecorder;
   class Server;
   class ServerConnection;
   class TrafficControl;
@@ -166,8 +180,14 @@ namespace orxonox
   class NetworkCallbackBase;
   class NetworkCallbackManager;
   class Synchronisable;
+  class SynchronisableCallback;
+  struct SynchronisableCodec;
+  struct SynchronisableDescriptor;
   class SynchronisableHeader;
   template <class T>
+  class SynchronisableMemberCallback;
+  class SynchronisableTable;
+  template <class T>
   class SynchronisableVariable;
   class SynchronisableVariableBase;
   template <class T>
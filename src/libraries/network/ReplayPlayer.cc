@@ -0,0 +1,290 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of the ReplayPlayer class.
+*/
+
+#include "ReplayPlayer.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <enet/enet.h>
+
+#include "util/Clock.h"
+#include "util/Output.h"
+#include "core/object/ObjectList.h"
+#include "synchronisable/Synchronisable.h"
+#include "packet/Packet.h"
+#include "FunctionCallManager.h"
+#include "ReplayRecorder.h"
+
+namespace orxonox
+{
+  ReplayPlayer::ReplayPlayer()
+    : firstRecordOffset_(0)
+    , time_(0)
+    , duration_(0)
+    , speed_(1.0f)
+    , bHasRecord_(false)
+  {
+  }
+
+  ReplayPlayer::~ReplayPlayer()
+  {
+    this->close();
+  }
+
+  /**
+  * Opens a replay file and prepares the playback like a connection to a server.
+  * @return false if the file couldn't be read
+  */
+  bool ReplayPlayer::open(const std::string& filename)
+  {
+    this->file_.open(filename.c_str(), std::ios::in | std::ios::binary);
+    uint32_t magic = 0, version = 0;
+    this->file_.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    this->file_.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if( !this->file_.good() || magic != REPLAY_MAGIC || version != REPLAY_VERSION )
+    {
+      orxout(user_error, context::network) << "Could not read replay file " << filename << endl;
+      this->file_.close();
+      return false;
+    }
+    this->firstRecordOffset_ = this->file_.tellg();
+
+    if( !this->readIndex() )
+      orxout(internal_warning, context::network) << "Replay file " << filename << " wasn't closed properly, searching the keyframes" << endl;
+
+    this->file_.clear();
+    this->file_.seekg(this->firstRecordOffset_);
+    this->bHasRecord_ = this->readRecord(this->nextRecord_);
+    this->time_ = 0;
+
+    Synchronisable::setClient(true);
+    Host::setActive(true);
+    GamestateManager::addPeer(NETWORK_PEER_ID_SERVER);
+
+    orxout(user_status) << "Playing replay " << filename << " (" << this->getDuration() << " seconds, " << this->keyframes_.size() << " keyframes)" << endl;
+    return true;
+  }
+
+  /**
+  * Stops the playback. The objects of the replay are left to the level (like after closing the connection of a client).
+  */
+  void ReplayPlayer::close()
+  {
+    if( !this->file_.is_open() )
+      return;
+
+    Host::setActive(false);
+    GamestateManager::removePeer(NETWORK_PEER_ID_SERVER);
+    this->file_.close();
+    this->bHasRecord_ = false;
+  }
+
+  /**
+  * Advances the playback by the (scaled) time of the tick and applies all records up to the new time.
+  */
+  void ReplayPlayer::update(const Clock& time)
+  {
+    if( !this->bHasRecord_ )
+      return;
+
+    this->time_ += static_cast<unsigned long long>(time.getDeltaTime() * this->speed_ * 1000000);
+    this->playUntil(this->time_, false);
+
+    if( !this->bHasRecord_ )
+      orxout(user_info) << "Replay finished" << endl;
+  }
+
+  /**
+  * Moves the playback to the given time in seconds.
+  */
+  void ReplayPlayer::seek(float time)
+  {
+    if( !this->file_.is_open() )
+      return;
+
+    const unsigned long long target = std::min(static_cast<unsigned long long>(std::max(time, 0.0f) * 1000000), this->duration_);
+
+    // the records can't be applied backwards: start again from the last keyframe before the target
+    // (seeking forwards has to apply all records as well, otherwise the deleted objects would be missed)
+    if( target < this->time_ || !this->bHasRecord_ )
+    {
+      unsigned long long offset = this->firstRecordOffset_;
+      for( size_t i = 0; i < this->keyframes_.size() && this->keyframes_[i].first <= target; ++i )
+        offset = this->keyframes_[i].second;
+
+      this->destroyObjects();
+      this->file_.clear();
+      this->file_.seekg(offset);
+      this->bHasRecord_ = this->readRecord(this->nextRecord_);
+    }
+
+    this->playUntil(target, true);
+    this->time_ = target;
+    orxout(user_info) << "Replay at " << this->getTime() << " of " << this->getDuration() << " seconds" << endl;
+  }
+
+  void ReplayPlayer::printRTT()
+  {
+    orxout(message) << "Playing a replay, there's no connection" << endl;
+  }
+
+  void ReplayPlayer::doSendChat(const std::string& message, unsigned int sourceID, unsigned int targetID)
+  {
+    // there's no server which could receive the message
+  }
+
+  void ReplayPlayer::doReceiveChat(const std::string& message, unsigned int sourceID, unsigned int targetID)
+  {
+    Host::doReceiveChat(message, sourceID, targetID);
+  }
+
+  /**
+  * Packets to the server (acks etc.) are dropped.
+  */
+  void ReplayPlayer::queuePacket(ENetPacket* packet, int clientID, uint8_t channelID)
+  {
+    enet_packet_destroy(packet);
+  }
+
+  /**
+  * Reads the keyframes from the index at the end of the file. If the file has no index (e.g. because the server
+  * crashed), all records are searched for keyframes.
+  * @return false if the file had no index
+  */
+  bool ReplayPlayer::readIndex()
+  {
+    this->keyframes_.clear();
+    this->duration_ = 0;
+
+    unsigned long long indexOffset = 0;
+    uint32_t magic = 0;
+    this->file_.seekg(-static_cast<int>(sizeof(indexOffset) + sizeof(magic)), std::ios::end);
+    this->file_.read(reinterpret_cast<char*>(&indexOffset), sizeof(indexOffset));
+    this->file_.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+
+    Record record;
+    if( this->file_.good() && magic == REPLAY_MAGIC )
+    {
+      this->file_.seekg(indexOffset);
+      if( !this->readRecord(record) && this->file_.good() && (record.flags & ReplayRecordFlag::Index) )
+      {
+        const unsigned long long* index = reinterpret_cast<const unsigned long long*>(record.data.empty() ? 0 : &record.data[0]);
+        for( size_t i = 0; i + 1 < record.data.size() / sizeof(unsigned long long); i += 2 )
+          this->keyframes_.push_back(std::make_pair(index[i], index[i + 1]));
+        this->duration_ = record.time;
+        return true;
+      }
+    }
+
+    this->file_.clear();
+    this->file_.seekg(this->firstRecordOffset_);
+    while( this->readRecord(record) )
+    {
+      if( record.flags & ReplayRecordFlag::Keyframe )
+        this->keyframes_.push_back(std::make_pair(record.time, record.offset));
+      this->duration_ = record.time;
+    }
+    return false;
+  }
+
+  /**
+  * Reads the next record of the file.
+  * @return false at the end of the records (the index record is read, but false is returned as well)
+  */
+  bool ReplayPlayer::readRecord(Record& record)
+  {
+    uint32_t size = 0;
+    record.offset = this->file_.tellg();
+    this->file_.read(reinterpret_cast<char*>(&record.flags), sizeof(record.flags));
+    this->file_.read(reinterpret_cast<char*>(&record.time), sizeof(record.time));
+    this->file_.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if( !this->file_.good() )
+      return false;
+
+    record.data.resize(size);
+    if( size )
+      this->file_.read(reinterpret_cast<char*>(&record.data[0]), size);
+    return this->file_.good() && !(record.flags & ReplayRecordFlag::Index);
+  }
+
+  /**
+  * Applies all records up to the given time.
+  * @param bFastForward if true, function calls and chat messages are skipped
+  */
+  void ReplayPlayer::playUntil(unsigned long long time, bool bFastForward)
+  {
+    while( this->bHasRecord_ && this->nextRecord_.time <= time )
+    {
+      this->processRecord(this->nextRecord_, bFastForward);
+      this->bHasRecord_ = this->readRecord(this->nextRecord_);
+    }
+  }
+
+  /**
+  * Passes a record to the client path, as if the packet was received from the server.
+  */
+  void ReplayPlayer::processRecord(const Record& record, bool bFastForward)
+  {
+    if( record.data.size() < sizeof(packet::Type::Value) )
+      return;
+
+    const packet::Type::Value type = *reinterpret_cast<const packet::Type::Value*>(&record.data[0]);
+    if( bFastForward && (type == packet::Type::FunctionCalls || type == packet::Type::Chat) )
+      return;
+
+    ENetPacket* enetPacket = enet_packet_create(&record.data[0], record.data.size(), ENET_PACKET_FLAG_RELIABLE);
+    packet::Packet* received = packet::Packet::createPacket(enetPacket, NETWORK_PEER_ID_SERVER);
+    received->process(static_cast<Host*>(this));
+
+    // apply each gamestate immediately, the GamestateManager keeps only the newest gamestate of a peer
+    if( type == packet::Type::Gamestate )
+    {
+      GamestateManager::processGamestates();
+      FunctionCallManager::processBufferedFunctionCalls();
+    }
+  }
+
+  /**
+  * Destroys all objects which were created by the replay (like Client::connectionClosed()).
+  */
+  void ReplayPlayer::destroyObjects()
+  {
+    ObjectList<Synchronisable>::iterator it;
+    for( it = ObjectList<Synchronisable>::begin(); it; )
+    {
+      if( it->getSyncMode() != 0x0 )
+        (it++)->destroy();
+      else
+        ++it;
+    }
+  }
+}
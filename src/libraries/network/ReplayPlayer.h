@@ -0,0 +1,130 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Declaration of the ReplayPlayer class.
+*/
+
+#ifndef _ReplayPlayer_H__
+#define _ReplayPlayer_H__
+
+#include "NetworkPrereqs.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "util/UtilPrereqs.h"
+#include "Host.h"
+
+namespace orxonox
+{
+  /**
+    Plays a file written by ReplayRecorder back. It acts like a client which is
+    connected to the recorded server: the records are passed as packets through
+    the normal client path (packet::Packet::createPacket(), process(),
+    GamestateManager::processGamestates()), hence the objects are created,
+    updated and destroyed exactly as on a client. Packets which would be sent to
+    the server (acks, gamestates of the client, function calls) are dropped.
+
+    The playback can be scaled in time (setSpeed()) and moved to any time
+    (seek()). Seeking backwards destroys all synchronised objects and starts at
+    the last keyframe before the target, from where the records are applied
+    without executing function calls and chat messages (fast-forward).
+  */
+  class _NetworkExport ReplayPlayer : public Host
+  {
+  public:
+    ReplayPlayer();
+    ~ReplayPlayer();
+
+    bool open(const std::string& filename);
+    void close();
+    void update(const Clock& time);
+    void seek(float time);
+
+    /// Sets the playback speed (1 is real time, 0 pauses the playback).
+    inline void setSpeed(float speed)
+      { this->speed_ = std::max(speed, 0.0f); }
+    /// Returns the playback speed.
+    inline float getSpeed() const
+      { return this->speed_; }
+    /// Returns the current playback time in seconds.
+    inline float getTime() const
+      { return this->time_ / 1000000.0f; }
+    /// Returns the length of the replay in seconds.
+    inline float getDuration() const
+      { return this->duration_ / 1000000.0f; }
+    /// Returns true if all records were played.
+    inline bool isFinished() const
+      { return !this->bHasRecord_; }
+
+    virtual bool sendPacket( packet::Packet* packet ){ return packet->send( static_cast<Host*>(this) ); }
+    virtual void printRTT();
+
+  protected:
+    virtual void doSendChat(const std::string& message, unsigned int sourceID, unsigned int targetID);
+    virtual void doReceiveChat(const std::string& message, unsigned int sourceID, unsigned int targetID);
+
+  private:
+    /// A record of the replay file.
+    struct Record
+    {
+      Record() : flags(0), time(0), offset(0) {}
+
+      uint32_t flags;             //!< see ReplayRecordFlag
+      unsigned long long time;    //!< time since the start of the recording in microseconds
+      unsigned long long offset;  //!< position of the record in the file
+      std::vector<uint8_t> data;  //!< data of the packet
+    };
+
+    ReplayPlayer(const ReplayPlayer&); // not used
+    virtual void queuePacket(ENetPacket* packet, int clientID, uint8_t channelID);
+    virtual bool isServer_(){ return false; }
+
+    bool readIndex();
+    bool readRecord(Record& record);
+    void playUntil(unsigned long long time, bool bFastForward);
+    void processRecord(const Record& record, bool bFastForward);
+    void destroyObjects();
+
+    std::ifstream file_;
+    std::vector<std::pair<unsigned long long, unsigned long long> > keyframes_; //!< time and file offset of all keyframes
+    unsigned long long firstRecordOffset_;  //!< position of the first record (after the header)
+    unsigned long long time_;               //!< current playback time in microseconds
+    unsigned long long duration_;           //!< time of the last record
+    float speed_;                           //!< playback speed
+    Record nextRecord_;                     //!< the next record which wasn't played yet
+    bool bHasRecord_;                       //!< true if nextRecord_ is valid (false at the end of the replay)
+  };
+}
+
+#endif /* _ReplayPlayer_H__ */
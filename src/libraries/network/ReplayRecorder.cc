@@ -0,0 +1,196 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of the ReplayRecorder class.
+*/
+
+#include "ReplayRecorder.h"
+
+#include "util/Clock.h"
+#include "util/Output.h"
+#include "packet/ClassID.h"
+#include "packet/FunctionIDs.h"
+#include "packet/Gamestate.h"
+
+namespace orxonox
+{
+  /**
+  * Opens the file and writes the header and the current class and function IDs.
+  * @param filename path of the replay file (overwritten if it exists)
+  * @param keyframeInterval time between two full gamestates in seconds
+  */
+  ReplayRecorder::ReplayRecorder(const std::string& filename, float keyframeInterval)
+    : file_(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)
+    , lastGamestate_(0)
+    , keyframeInterval_(static_cast<unsigned long long>(keyframeInterval * 1000000))
+    , lastKeyframeTime_(0)
+    , startTime_(0)
+    , time_(0)
+    , bStarted_(false)
+  {
+    if( !this->file_.is_open() )
+    {
+      orxout(user_error, context::network) << "Could not open replay file " << filename << endl;
+      return;
+    }
+
+    this->file_.write(reinterpret_cast<const char*>(&REPLAY_MAGIC), sizeof(REPLAY_MAGIC));
+    this->file_.write(reinterpret_cast<const char*>(&REPLAY_VERSION), sizeof(REPLAY_VERSION));
+
+    // the player needs the ids to interpret the gamestates and function calls
+    packet::ClassID classIDs;
+    this->writeRecord(ReplayRecordFlag::Packet, classIDs);
+    packet::FunctionIDs functionIDs;
+    this->writeRecord(ReplayRecordFlag::Packet, functionIDs);
+
+    orxout(user_status) << "Recording replay to " << filename << endl;
+  }
+
+  /**
+  * Writes the index and closes the file.
+  */
+  ReplayRecorder::~ReplayRecorder()
+  {
+    if( this->file_.is_open() )
+    {
+      this->writeIndex();
+      this->file_.close();
+    }
+    delete this->lastGamestate_;
+  }
+
+  /**
+  * Sets the time of the following records. Call this once per tick.
+  */
+  void ReplayRecorder::updateTime(const Clock& time)
+  {
+    if( !this->bStarted_ )
+    {
+      this->startTime_ = time.getMicroseconds();
+      this->bStarted_ = true;
+    }
+    this->time_ = time.getMicroseconds() - this->startTime_;
+  }
+
+  /**
+  * Writes a snapshot of the server, either as keyframe or as diff to the previously written snapshot.
+  * @param gamestate the (undiffed and uncompressed) snapshot, it isn't changed
+  */
+  void ReplayRecorder::recordGamestate(packet::Gamestate* gamestate)
+  {
+    if( !this->file_.is_open() || !gamestate )
+      return;
+
+    packet::Gamestate* copy = new packet::Gamestate(*gamestate);
+    packet::Gamestate* record;
+    uint32_t flags;
+    if( !this->lastGamestate_ || this->time_ - this->lastKeyframeTime_ >= this->keyframeInterval_ )
+    {
+      record = new packet::Gamestate(*copy);
+      flags = ReplayRecordFlag::Keyframe;
+      this->lastKeyframeTime_ = this->time_;
+      this->keyframes_.push_back(std::make_pair(this->time_, static_cast<unsigned long long>(this->file_.tellp())));
+    }
+    else
+    {
+      record = copy->diffVariables(this->lastGamestate_);
+      flags = ReplayRecordFlag::Packet;
+      if( record->getDataSize() == 0 )
+      {
+        // nothing changed, the next diff is based on the last written gamestate again
+        delete record;
+        delete copy;
+        return;
+      }
+    }
+
+    if( record->compressData() )
+      this->writeRecord(flags, *record);
+    else
+      orxout(internal_warning, context::network) << "ReplayRecorder: could not compress gamestate " << gamestate->getID() << endl;
+    delete record;
+
+    delete this->lastGamestate_;
+    this->lastGamestate_ = copy;
+  }
+
+  /**
+  * Writes a packet which was sent to all clients. Only function calls, deleted objects and chat messages are written.
+  */
+  void ReplayRecorder::recordPacket(const uint8_t* data, uint32_t size)
+  {
+    if( !this->file_.is_open() || size < sizeof(packet::Type::Value) )
+      return;
+
+    switch( *reinterpret_cast<const packet::Type::Value*>(data) )
+    {
+      case packet::Type::Chat:
+      case packet::Type::DeleteObjects:
+      case packet::Type::FunctionCalls:
+        this->writeRecord(ReplayRecordFlag::Packet, data, size);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void ReplayRecorder::writeRecord(uint32_t flags, packet::Packet& data)
+  {
+    this->writeRecord(flags, data.getData(), data.getSize());
+  }
+
+  void ReplayRecorder::writeRecord(uint32_t flags, const uint8_t* data, uint32_t size)
+  {
+    this->file_.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    this->file_.write(reinterpret_cast<const char*>(&this->time_), sizeof(this->time_));
+    this->file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    this->file_.write(reinterpret_cast<const char*>(data), size);
+  }
+
+  /**
+  * Writes the index record (time and offset of all keyframes) and the trailer which points to it.
+  */
+  void ReplayRecorder::writeIndex()
+  {
+    const unsigned long long indexOffset = this->file_.tellp();
+
+    std::vector<unsigned long long> index;
+    for( size_t i = 0; i < this->keyframes_.size(); ++i )
+    {
+      index.push_back(this->keyframes_[i].first);
+      index.push_back(this->keyframes_[i].second);
+    }
+    const uint32_t size = static_cast<uint32_t>(index.size() * sizeof(unsigned long long));
+    this->writeRecord(ReplayRecordFlag::Index, index.empty() ? 0 : reinterpret_cast<const uint8_t*>(&index[0]), size);
+
+    this->file_.write(reinterpret_cast<const char*>(&indexOffset), sizeof(indexOffset));
+    this->file_.write(reinterpret_cast<const char*>(&REPLAY_MAGIC), sizeof(REPLAY_MAGIC));
+  }
+}
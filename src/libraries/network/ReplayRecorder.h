@@ -0,0 +1,111 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Declaration of the ReplayRecorder class and the format of replay files.
+*/
+
+#ifndef _ReplayRecorder_H__
+#define _ReplayRecorder_H__
+
+#include "NetworkPrereqs.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "util/UtilPrereqs.h"
+
+namespace orxonox
+{
+  const uint32_t REPLAY_MAGIC   = 0x4C505852; //!< "RXPL", the first and the last 4 bytes of a replay file
+  const uint32_t REPLAY_VERSION = 1;
+
+  namespace ReplayRecordFlag
+  {
+    enum Value
+    {
+      Packet    = 0x0,  //!< The record holds the data of a packet
+      Keyframe  = 0x1,  //!< The record holds a full (undiffed) gamestate, playback can start here
+      Index     = 0x2   //!< The record holds the time and file offset of all keyframes (the last record of the file)
+    };
+  }
+
+  /**
+    Writes the gamestates and the broadcasted packets of a server to a replay
+    file, which can be played back with ReplayPlayer.
+
+    File format (native byte order, like the network packets):
+    - header: magic, version
+    - records: flags (ReplayRecordFlag), time since the start in microseconds,
+      size, data of the packet (starting with its packet::Type)
+    - an index record with the time and file offset of each keyframe
+    - trailer: file offset of the index record, magic
+
+    The class and function IDs are written first. Each snapshot of the server
+    is written as a diff to the previously written gamestate (unchanged objects
+    are left out), every keyframe interval a full gamestate is written instead.
+    Both are compressed. Function calls, deleted objects and chat messages are
+    written if they're sent to all clients (calls to a single client are left
+    out).
+  */
+  class _NetworkExport ReplayRecorder
+  {
+  public:
+    ReplayRecorder(const std::string& filename, float keyframeInterval = 10.0f);
+    ~ReplayRecorder();
+
+    /// Returns true if the file could be opened.
+    inline bool isOpen() const
+      { return this->file_.is_open(); }
+
+    void updateTime(const Clock& time);
+    void recordGamestate(packet::Gamestate* gamestate);
+    void recordPacket(const uint8_t* data, uint32_t size);
+
+  private:
+    ReplayRecorder(const ReplayRecorder&); // not used
+
+    void writeRecord(uint32_t flags, packet::Packet& data);
+    void writeRecord(uint32_t flags, const uint8_t* data, uint32_t size);
+    void writeIndex();
+
+    std::ofstream file_;
+    std::vector<std::pair<unsigned long long, unsigned long long> > keyframes_; //!< time and file offset of all keyframes
+    packet::Gamestate* lastGamestate_;  //!< the last written gamestate (undiffed), the base of the next diff
+    unsigned long long keyframeInterval_; //!< time between two keyframes in microseconds
+    unsigned long long lastKeyframeTime_; //!< time of the last keyframe
+    unsigned long long startTime_;      //!< time of the clock when the recording started
+    unsigned long long time_;           //!< time since the recording started in microseconds
+    bool bStarted_;                     //!< true once the start time is known
+  };
+}
+
+#endif /* _ReplayRecorder_H__ */
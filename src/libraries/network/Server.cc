@@ -57,6 +57,7 @@
 // #include "ClientInformation.h"
 #include "FunctionCallManager.h"
 #include "GamestateManager.h"
+#include "ReplayRecorder.h"
 
 namespace orxonox
 {
@@ -69,12 +70,14 @@ namespace orxonox
   Server::Server()
   {
     this->timeSinceLastUpdate_=0;
+    this->recorder_=0;
   }
 
   Server::Server(int port)
   {
     this->setPort( port );
     this->timeSinceLastUpdate_=0;
+    this->recorder_=0;
   }
 
   /**
@@ -87,6 +90,7 @@ namespace orxonox
     this->setPort( port );
     this->setBindAddress( bindAddress );
     this->timeSinceLastUpdate_=0;
+    this->recorder_=0;
   }
 
   /**
@@ -94,6 +98,7 @@ namespace orxonox
   */
   Server::~Server()
   {
+    this->stopRecording();
   }
 
   /**
@@ -141,13 +146,19 @@ namespace orxonox
   */
   void Server::update(const Clock& time)
   {
+    // the time is needed to measure the round trip time of the acks
+    GamestateManager::updateTime(time);
+    if( this->recorder_ )
+      this->recorder_->updateTime(time);
+
     // receive incoming packets
     Connection::processQueue();
 
     // receive and process incoming discovery packets
     LANDiscoverable::update();
 
-    if ( GamestateManager::hasPeers() )
+    // snapshots are taken while recording even if there are no peers
+    if ( GamestateManager::hasPeers() || this->recorder_ )
     {
       // process incoming gamestates
       GamestateManager::processGamestates();
@@ -156,11 +167,13 @@ namespace orxonox
       // send function calls to clients
       FunctionCallManager::sendCalls( static_cast<Host*>(this) );
 
-      //this steers our network frequency
+      //this steers our network frequency (each peer gets gamestates at its own rate, see GamestateManager)
+      this->updatePeerLinks();
+      const float period = GamestateManager::getSnapshotInterval();
       timeSinceLastUpdate_+=time.getDeltaTime();
-      if(timeSinceLastUpdate_>=NETWORK_PERIOD)
+      if(timeSinceLastUpdate_>=period)
       {
-        timeSinceLastUpdate_ -= static_cast<unsigned int>( timeSinceLastUpdate_ / NETWORK_PERIOD ) * NETWORK_PERIOD;
+        timeSinceLastUpdate_ -= static_cast<unsigned int>( timeSinceLastUpdate_ / period ) * period;
         updateGamestate();
       }
 //       sendPackets(); // flush the enet queue
@@ -169,6 +182,8 @@ namespace orxonox
 
   void Server::queuePacket(ENetPacket *packet, int clientID, uint8_t channelID)
   {
+    if( this->recorder_ && clientID == static_cast<int>(NETWORK_PEER_ID_BROADCAST) )
+      this->recorder_->recordPacket(packet->data, static_cast<uint32_t>(packet->dataLength));
     ServerConnection::addPacket(packet, clientID, channelID);
   }
 
@@ -177,16 +192,16 @@ namespace orxonox
    */
   unsigned int Server::getRTT(unsigned int clientID)
   {
-//     assert(ClientInformation::findClient(clientID));
-//     return ClientInformation::findClient(clientID)->getRTT();
-    // TODO: reimplement
+    PeerStatistics statistics;
+    if( Connection::getPeerStatistics(clientID, statistics) )
+      return statistics.roundTripTime;
     return 0;
   }
 
   void Server::printRTT()
   {
-//     for( ClientInformation* temp=ClientInformation::getBegin(); temp!=0; temp=temp->next() )
-//       orxout(message) << "Round trip time to client with ID: " << temp->getID() << " is " << temp->getRTT() << " ms" << endl;
+    for( std::vector<uint32_t>::iterator it = this->clientIDs_.begin(); it != this->clientIDs_.end(); ++it )
+      orxout(message) << "Round trip time to client with ID: " << *it << " is " << this->getRTT(*it) << " ms" << endl;
   }
 
   /**
@@ -194,20 +209,54 @@ namespace orxonox
    */
   float Server::getPacketLoss(unsigned int clientID)
   {
-//     assert(ClientInformation::findClient(clientID));
-//     return ClientInformation::findClient(clientID)->getPacketLoss();
+    PeerStatistics statistics;
+    if( Connection::getPeerStatistics(clientID, statistics) )
+      return statistics.packetLoss;
     return 0.;
   }
 
+  /**
+   * @brief: passes the round trip time and packet loss measured by ENet to the GamestateManager, which adapts the send rate of each client
+   */
+  void Server::updatePeerLinks()
+  {
+    PeerStatistics statistics;
+    for( std::vector<uint32_t>::iterator it = this->clientIDs_.begin(); it != this->clientIDs_.end(); ++it )
+    {
+      if( Connection::getPeerStatistics(*it, statistics) )
+        GamestateManager::setPeerStatistics(*it, statistics.roundTripTime / 1000.0f, statistics.packetLoss);
+    }
+  }
+
+  /**
+   * @brief Writes the gamestates and the function calls to all clients to a replay file (see ReplayRecorder).
+   * @return false if the file couldn't be opened
+   */
+  bool Server::startRecording(const std::string& filename)
+  {
+    this->stopRecording();
+    this->recorder_ = new ReplayRecorder(filename);
+    if( !this->recorder_->isOpen() )
+      this->stopRecording();
+    return this->recorder_ != 0;
+  }
+
+  void Server::stopRecording()
+  {
+    delete this->recorder_;
+    this->recorder_ = 0;
+  }
+
   /**
   * takes a new snapshot of the gamestate and sends it to the clients
   */
   void Server::updateGamestate()
   {
-    if( this->clientIDs_.size()==0 )
+    if( this->clientIDs_.size()==0 && !this->recorder_ )
       //no client connected
       return;
-    GamestateManager::update();
+    if( GamestateManager::update() && this->recorder_ )
+      this->recorder_->recordGamestate(GamestateManager::getCurrentGamestate());
 //     orxout(verbose_more, context::network) << "Server: one gamestate update complete, goig to sendGameState" << endl;
     //orxout(verbose_more, context::network) << "updated gamestate, sending it" << endl;
     //if(clients->getGamestateID()!=GAMESTATEID_INITIAL)
@@ -237,7 +286,7 @@ namespace orxonox
 //     ClientInformation *temp = ClientInformation::getBegin();
 //     if( temp == NULL )
       //no client connected
-    if( this->clientIDs_.size()==0 )
+    if( this->clientIDs_.size()==0 && !this->recorder_ )
       return true;
     packet::DeleteObjects *del = new packet::DeleteObjects();
     if(!del->fetchIDs())
@@ -66,8 +66,12 @@ namespace orxonox
     unsigned int getRTT(unsigned int clientID);
     virtual void printRTT();
     float getPacketLoss(unsigned int clientID);
+
+    bool startRecording(const std::string& filename);
+    void stopRecording();
   protected:
     void updateGamestate();
+    void updatePeerLinks();
   private:
     virtual bool isServer_(){return true;}
     unsigned int playerID(){return 0;}
@@ -88,6 +92,7 @@ namespace orxonox
     float timeSinceLastUpdate_;
     std::deque<packet::Packet*> packetQueue_;
     std::vector<uint32_t>       clientIDs_;
+    ReplayRecorder*             recorder_;    //!< writes the gamestates to a replay file (0 if not recording)
   };
 
 
@@ -63,7 +63,7 @@ unsigned int Acknowledgement::getSize() const{
 }
 
 bool Acknowledgement::process(orxonox::Host* host){
-  orxout(verbose_more, context::packets) << "processing ACK with ID: " << getAckID() << endl;
+  orxout_filtered(verbose_more, context::packets) << "processing ACK with ID: " << getAckID() << endl;
   bool b = host->ackGamestate(getAckID(), peerID_);
   delete this;
   return b;
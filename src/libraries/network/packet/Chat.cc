@@ -49,6 +49,8 @@ Chat::Chat( const std::string& message, unsigned int sourceID, unsigned int targ
 {
   /* Add chat flag to packet flags */
   flags_ = flags_ | PACKET_FLAGS_CHAT;
+  /* messages don't depend on the other packets, so they aren't held back by lost packets on the default channel */
+  channelID_ = NETWORK_CHANNEL_UNORDERED;
 
   /* set message length to length of input string + 1 */
   messageLength_ = message.length()+1;
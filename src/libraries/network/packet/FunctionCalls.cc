@@ -41,15 +41,20 @@ namespace packet {
 #define   _PACKETID         0
 const unsigned int FUNCTIONCALLS_MEM_ALLOCATION = 1000;
 
-FunctionCalls::FunctionCalls():
-  Packet(), minGamestateID_(GAMESTATEID_INITIAL)
+FunctionCalls::FunctionCalls(CallQoS::Value qos):
+  Packet(), qos_(qos), minGamestateID_(GAMESTATEID_INITIAL)
 {
-  flags_ = flags_ | PACKET_FLAGS_FUNCTIONCALLS;
+  if( qos == CallQoS::UnreliableSequenced )
+    flags_ = flags_ & ~PacketFlag::Reliable;
+  else
+    flags_ = flags_ | PACKET_FLAGS_FUNCTIONCALLS;
+  if( qos == CallQoS::ReliableUnordered )
+    channelID_ = NETWORK_CHANNEL_UNORDERED;
   currentSize_ = 3*sizeof(uint32_t); // for packetid, nrOfCalls and minGamestateID_
 }
 
 FunctionCalls::FunctionCalls( uint8_t* data, unsigned int clientID ): 
-  Packet(data, clientID), minGamestateID_(GAMESTATEID_INITIAL)
+  Packet(data, clientID), qos_(CallQoS::ReliableOrdered), minGamestateID_(GAMESTATEID_INITIAL)
 {
 }
 
@@ -81,22 +86,32 @@ bool FunctionCalls::process(orxonox::Host* host)
   return true;
 }
 
-void FunctionCalls::addCallStatic( uint32_t networkID, const MultiType* mt1, const MultiType* mt2, const MultiType* mt3, const MultiType* mt4, const MultiType* mt5)
+/**
+    @brief Adds a call to the packet. Returns false if the call replaced an earlier
+    call (only unreliable calls to the same member function of the same object are
+    merged, because only the latest of them has to arrive anyway).
+*/
+bool FunctionCalls::addCall( const orxonox::FunctionCall& call )
 {
   assert(!isDataENetAllocated());
   
-  this->functionCalls_.push(orxonox::FunctionCall());
-  this->functionCalls_.back().setCallStatic( networkID, mt1, mt2, mt3, mt4, mt5 );
-  this->currentSize_ += this->functionCalls_.back().getSize();
-}
-
-void FunctionCalls::addCallMember( uint32_t networkID, uint32_t objectID, const MultiType* mt1, const MultiType* mt2, const MultiType* mt3, const MultiType* mt4, const MultiType* mt5)
-{
-  assert(!isDataENetAllocated());
+  if( this->qos_ == CallQoS::UnreliableSequenced && !call.isStatic() )
+  {
+    for( std::vector<orxonox::FunctionCall>::iterator it = this->functionCalls_.begin(); it != this->functionCalls_.end(); ++it )
+    {
+      if( !it->isStatic() && it->getFunctionID() == call.getFunctionID() && it->getObjectID() == call.getObjectID() )
+      {
+        this->currentSize_ -= it->getSize();
+        *it = call;
+        this->currentSize_ += it->getSize();
+        return false;
+      }
+    }
+  }
   
-  this->functionCalls_.push(orxonox::FunctionCall());
-  this->functionCalls_.back().setCallMember( networkID, objectID, mt1, mt2, mt3, mt4, mt5 );
-  this->currentSize_ += this->functionCalls_.back().getSize();
+  this->functionCalls_.push_back(call);
+  this->currentSize_ += call.getSize();
+  return true;
 }
 
 bool FunctionCalls::send(orxonox::Host* host)
@@ -109,11 +124,9 @@ bool FunctionCalls::send(orxonox::Host* host)
   *(uint32_t*)(data_+2*sizeof(uint32_t)) = this->minGamestateID_; // set minGamestateID_
   uint8_t* temp = data_+3*sizeof(uint32_t);
   
-  while( this->functionCalls_.size() )
-  {
-    this->functionCalls_.front().saveData( temp );
-    this->functionCalls_.pop();
-  }
+  for( std::vector<orxonox::FunctionCall>::iterator it = this->functionCalls_.begin(); it != this->functionCalls_.end(); ++it )
+    it->saveData( temp );
+  this->functionCalls_.clear();
   
   assert( temp==data_+currentSize_ );
   
@@ -32,7 +32,7 @@
 #include "network/NetworkPrereqs.h"
 
 #include <cassert>
-#include <queue>
+#include <vector>
 #include "Packet.h"
 #include "network/FunctionCall.h"
 
@@ -47,19 +47,23 @@ namespace packet {
 class _NetworkExport FunctionCalls : public Packet
 {
 public:
-  FunctionCalls();
+  FunctionCalls(CallQoS::Value qos = CallQoS::ReliableOrdered);
   FunctionCalls( uint8_t* data, unsigned int clientID );
   ~FunctionCalls();
 
   inline unsigned int getSize() const
     { assert(!this->isDataENetAllocated()); return currentSize_; }
+  inline CallQoS::Value getQoS() const
+    { return this->qos_; }
+  inline unsigned int getNumberOfCalls() const
+    { return this->functionCalls_.size(); }
   virtual bool process(orxonox::Host* host);
 
-  void addCallStatic( uint32_t networkID, const MultiType* mt1=0, const MultiType* mt2=0, const MultiType* mt3=0, const MultiType* mt4=0, const MultiType* mt5=0);
-  void addCallMember( uint32_t networkID, uint32_t objectID, const MultiType* mt1=0, const MultiType* mt2=0, const MultiType* mt3=0, const MultiType* mt4=0, const MultiType* mt5=0);
+  bool addCall( const orxonox::FunctionCall& call );
   virtual bool send(orxonox::Host* host);
 private:
-  std::queue<orxonox::FunctionCall> functionCalls_;
+  std::vector<orxonox::FunctionCall> functionCalls_;
+  CallQoS::Value                    qos_;
   unsigned int                      clientID_;
   uint32_t                          minGamestateID_;
   uint32_t                          currentSize_;
@@ -30,6 +30,7 @@
 
 #include <zlib.h>
 
+#include "util/Metrics.h"
 #include "util/Output.h"
 #include "util/OrxAssert.h"
 #include "core/CoreIncludes.h"
@@ -94,6 +95,8 @@ Gamestate::Gamestate(const Gamestate& g) :
 {
   flags_ = flags_ | PACKET_FLAG_GAMESTATE;
   sizes_ = g.sizes_;
+  omittedObjects_ = g.omittedObjects_;
+  missingObjects_ = g.missingObjects_;
 }
 
 
@@ -105,10 +108,11 @@ Gamestate::~Gamestate()
 bool Gamestate::collectData(int id, uint8_t mode)
 {
   uint32_t tempsize=0, currentsize=0;
+  uint32_t changedObjects=0;
   assert(data_==0);
   uint32_t size = calcGamestateSize(id, mode);
 
-  orxout(verbose_more, context::packets) << "G.ST.Man: producing gamestate with id: " << id << endl;
+  orxout_filtered(verbose_more, context::packets) << "G.ST.Man: producing gamestate with id: " << id << endl;
   if(size==0)
     return false;
   data_ = new uint8_t[size + GamestateHeader::getSize()];
@@ -132,7 +136,11 @@ bool Gamestate::collectData(int id, uint8_t mode)
 
     tempsize = it->getData(mem, this->sizes_, id, mode);
     if ( tempsize != 0 )
+    {
       dataVector_.push_back( obj(it->getObjectID(), it->getContextID(), tempsize, mem-data_) );
+      if ( it->getLastChangedID() == static_cast<uint32_t>(id) )
+        ++changedObjects;
+    }
 
 #ifndef NDEBUG
     if(currentsize+tempsize > size)
@@ -167,15 +175,18 @@ bool Gamestate::collectData(int id, uint8_t mode)
   header_.setCompressed( false );
   //stop write gamestate header
 
-  orxout(verbose_more, context::packets) << "Gamestate: Gamestate size: " << currentsize << endl;
-  orxout(verbose_more, context::packets) << "Gamestate: 'estimated' (and corrected) Gamestate size: " << size << endl;
+  static MetricGauge& changedObjectsMetric = MetricsRegistry::getInstance().registerGauge("network.gamestate_changed_objects");
+  changedObjectsMetric.set(changedObjects);
+
+  orxout_filtered(verbose_more, context::packets) << "Gamestate: Gamestate size: " << currentsize << endl;
+  orxout_filtered(verbose_more, context::packets) << "Gamestate: 'estimated' (and corrected) Gamestate size: " << size << endl;
   return true;
 }
 
 
 bool Gamestate::spreadData(uint8_t mode)
 {
-  orxout(verbose_more, context::packets) << "processing gamestate with id " << header_.getID() << endl;
+  orxout_filtered(verbose_more, context::packets) << "processing gamestate with id " << header_.getID() << endl;
   assert(data_);
   assert(!header_.isCompressed());
   uint8_t *mem=data_+GamestateHeader::getSize();
@@ -293,7 +304,7 @@ bool Gamestate::compressData()
   retval = compress( dest, &buffer, source, (uLong)(header_.getDataSize()) );
   switch ( retval )
   {
-    case Z_OK: orxout(verbose_more, context::packets) << "G.St.Man: compress: successfully compressed" << endl; break;
+    case Z_OK: orxout_filtered(verbose_more, context::packets) << "G.St.Man: compress: successfully compressed" << endl; break;
     case Z_MEM_ERROR: orxout(internal_error, context::packets) << "G.St.Man: compress: not enough memory available in gamestate.compress" << endl; return false;
     case Z_BUF_ERROR: orxout(internal_warning, context::packets) << "G.St.Man: compress: not enough memory available in the buffer in gamestate.compress" << endl; return false;
     case Z_DATA_ERROR: orxout(internal_warning, context::packets) << "G.St.Man: compress: data corrupted in gamestate.compress" << endl; return false;
@@ -310,7 +321,7 @@ bool Gamestate::compressData()
   data_ = ndata;
   header_.setCompSize( buffer );
   header_.setCompressed( true );
-  orxout(verbose, context::packets) << "gamestate compress datasize: " << header_.getDataSize() << " compsize: " << header_.getCompSize() << endl;
+  orxout_filtered(verbose, context::packets) << "gamestate compress datasize: " << header_.getDataSize() << " compsize: " << header_.getCompSize() << endl;
   return true;
 }
 
@@ -319,7 +330,7 @@ bool Gamestate::decompressData()
 {
   assert(data_);
   assert(header_.isCompressed());
-  orxout(verbose, context::packets) << "GameStateClient: uncompressing gamestate. id: " << header_.getID() << ", baseid: " << header_.getBaseID() << ", datasize: " << header_.getDataSize() << ", compsize: " << header_.getCompSize() << endl;
+  orxout_filtered(verbose, context::packets) << "GameStateClient: uncompressing gamestate. id: " << header_.getID() << ", baseid: " << header_.getBaseID() << ", datasize: " << header_.getDataSize() << ", compsize: " << header_.getCompSize() << endl;
   uint32_t datasize = header_.getDataSize();
   uint32_t compsize = header_.getCompSize();
   uint32_t bufsize;
@@ -333,7 +344,7 @@ bool Gamestate::decompressData()
   retval = uncompress( dest, &length, source, (uLong)compsize );
   switch ( retval )
   {
-    case Z_OK: orxout(verbose_more, context::packets) << "successfully decompressed" << endl; break;
+    case Z_OK: orxout_filtered(verbose_more, context::packets) << "successfully decompressed" << endl; break;
     case Z_MEM_ERROR: orxout(internal_error, context::packets) << "not enough memory available" << endl; return false;
     case Z_BUF_ERROR: orxout(internal_warning, context::packets) << "not enough memory available in the buffer" << endl; return false;
     case Z_DATA_ERROR: orxout(internal_warning, context::packets) << "data corrupted (zlib)" << endl; return false;
@@ -451,6 +462,26 @@ inline void /*Gamestate::*/copyObject( uint8_t*& newData, uint8_t*& origData, ui
     //       orxout(verbose, context::packets) << endl;
 }
 
+/**
+  Leaves the changes of an object out of the diff. The gamestate is kept as the base of later diffs,
+  hence its data is replaced by the data of the base (which the peer really has). Returns true if
+  the object changed.
+*/
+inline bool /*Gamestate::*/omitObject( uint8_t*& origDataPtr, uint8_t*& baseDataPtr, SynchronisableHeader& objectHeader, std::vector<uint32_t>::iterator& sizes )
+{
+  assert( objectHeader.getDataSize() == SynchronisableHeader(baseDataPtr).getDataSize() );
+
+  uint32_t objectOffset = SynchronisableHeader::getSize();
+  bool bChanged = memcmp( origDataPtr+objectOffset, baseDataPtr+objectOffset, objectHeader.getDataSize() ) != 0;
+  if( bChanged )
+    memcpy( origDataPtr+objectOffset, baseDataPtr+objectOffset, objectHeader.getDataSize() );
+
+  origDataPtr += objectOffset + objectHeader.getDataSize();
+  baseDataPtr += objectOffset + objectHeader.getDataSize();
+  sizes += Synchronisable::getSynchronisable(objectHeader.getObjectID())->getNrOfVariables();
+  return bChanged;
+}
+
 inline bool findObject(uint8_t*& dataPtr, uint8_t* endPtr, SynchronisableHeader& objectHeader)
 {
   // Some assertions to make sure the dataPtr is valid (pointing to a SynchronisableHeader)
@@ -488,7 +519,29 @@ inline bool findObject(uint8_t*& dataPtr, uint8_t* endPtr, SynchronisableHeader&
   return false;
 }
 
-Gamestate* Gamestate::diffVariables(Gamestate *base)
+/**
+  Leaves an object which the peer doesn't have out of the gamestate. It's marked as missing, hence
+  the diffs which are based on this gamestate send it completely.
+*/
+void Gamestate::holdBackObject( uint8_t*& dataPtr, SynchronisableHeader& objectHeader, std::vector<uint32_t>::iterator& sizes )
+{
+  this->missingObjects_.insert(objectHeader.getObjectID());
+  dataPtr += objectHeader.getDataSize() + SynchronisableHeader::getSize();
+  sizes += Synchronisable::getSynchronisable(objectHeader.getObjectID())->getNrOfVariables();
+}
+
+/**
+  Returns the difference of this gamestate to @a base. Changes of objects whose priority value is at
+  least @a omitPriority (i.e. the least important objects) are left out to save bandwidth, but
+  not for more than GAMESTATE_MAX_OMITTED gamestates in a row. @a sendNumber counts the gamestates
+  sent to the peer, so the limit doesn't depend on the rate at which the gamestates are collected.
+
+  Objects which the peer doesn't have (new objects and objects which were held back from the base)
+  are sent completely, but at most @a maxNewObjects of them. They are chosen in the order of their
+  creation, together with the objects they need (see selectNewObjects()). The others are held back
+  for the next diff.
+*/
+Gamestate* Gamestate::diffVariables(Gamestate *base, int omitPriority, uint32_t sendNumber, uint32_t maxNewObjects)
 {
   assert(this && base); assert(data_ && base->data_);
   assert(!header_.isCompressed() && !base->header_.isCompressed());
@@ -512,11 +565,63 @@ Gamestate* Gamestate::diffVariables(Gamestate *base)
 
   std::vector<uint32_t>::iterator sizesIt = this->sizes_.begin();
 
+  // the server stamps each object with the id of the gamestate in which it changed last (the ids of the client aren't unique)
+  const bool bUseChangedIDs = GameMode::isMaster();
+  static MetricCounter& omittedMetric = MetricsRegistry::getInstance().registerCounter("network.omitted_objects");
+
+  // if the number of new objects is limited, choose them before diffing (an object is only sent together with the objects it needs)
+  const bool bLimitNewObjects = ( maxNewObjects != GAMESTATE_NEW_OBJECTS_UNLIMITED );
+  std::set<uint32_t> newObjects;
+  if( bLimitNewObjects )
+  {
+    std::set<uint32_t> baseObjects;
+    for( uint8_t* dataPtr = GAMESTATE_START(base->data_); dataPtr < GAMESTATE_START(base->data_) + base->header_.getDataSize(); )
+    {
+      SynchronisableHeader objectHeader(dataPtr);
+      if( base->missingObjects_.find(objectHeader.getObjectID()) == base->missingObjects_.end() )
+        baseObjects.insert(objectHeader.getObjectID());
+      dataPtr += objectHeader.getDataSize() + SynchronisableHeader::getSize();
+    }
+    std::vector<uint32_t> candidates;
+    for( uint8_t* dataPtr = origDataPtr; dataPtr < origDataEnd; )
+    {
+      SynchronisableHeader objectHeader(dataPtr);
+      if( baseObjects.find(objectHeader.getObjectID()) == baseObjects.end() )
+        candidates.push_back(objectHeader.getObjectID());
+      dataPtr += objectHeader.getDataSize() + SynchronisableHeader::getSize();
+    }
+    selectNewObjects(candidates, maxNewObjects, newObjects);
+  }
+
   while( origDataPtr < origDataEnd )
   {
     //iterate through all objects
 
     SynchronisableHeader origHeader(origDataPtr);
+    Synchronisable* object = Synchronisable::getSynchronisable(origHeader.getObjectID());
+
+    // check whether the changes of the object were already left out of the base
+    std::map<uint32_t, uint32_t>::const_iterator omittedIt = base->omittedObjects_.find(origHeader.getObjectID());
+    const uint32_t omittedSince = (omittedIt != base->omittedObjects_.end() ? omittedIt->second : sendNumber);
+    const bool bOmittable = object && static_cast<int>(object->getPriority()) >= omitPriority && sendNumber - omittedSince < GAMESTATE_MAX_OMITTED;
+
+    // objects which weren't sent with the base are sent completely (if the number of new objects allows it)
+    if( base->missingObjects_.find(origHeader.getObjectID()) != base->missingObjects_.end() )
+    {
+      if( !bLimitNewObjects || newObjects.find(origHeader.getObjectID()) != newObjects.end() )
+        copyObject(destDataPtr, origDataPtr, baseDataPtr, origHeader, sizesIt);
+      else
+        this->holdBackObject(origDataPtr, origHeader, sizesIt);
+      continue;
+    }
+
+    // skip objects which didn't change since the base was collected, the peer already has their data
+    if( bUseChangedIDs && object && object->getLastChangedID() != GAMESTATEID_INITIAL && object->getLastChangedID() <= base->getID() && omittedIt == base->omittedObjects_.end() )
+    {
+      origDataPtr += origHeader.getDataSize() + SynchronisableHeader::getSize();
+      sizesIt += object->getNrOfVariables();
+      continue;
+    }
 
     // Find (if possible) the current object in the datastream of the old gamestate
     // Start at the current offset position
@@ -541,7 +646,10 @@ Gamestate* Gamestate::diffVariables(Gamestate *base)
       if( SynchronisableHeader(baseDataPtr).getDataSize()==origHeader.getDataSize() )
       {
 //         orxout(verbose, context::packets) << "diffing object in order: " << Synchronisable::getSynchronisable(origHeader.getObjectID())->getIdentifier()->getName() << endl;
-        diffObject(destDataPtr, origDataPtr, baseDataPtr, origHeader, sizesIt);
+        if( !bOmittable )
+          diffObject(destDataPtr, origDataPtr, baseDataPtr, origHeader, sizesIt);
+        else if( omitObject(origDataPtr, baseDataPtr, origHeader, sizesIt) )
+          this->omittedObjects_[origHeader.getObjectID()] = omittedSince;
       }
       else
       {
@@ -564,7 +672,10 @@ Gamestate* Gamestate::diffVariables(Gamestate *base)
         if( SynchronisableHeader(baseDataPtr).getDataSize()==origHeader.getDataSize() )
         {
 //           orxout(verbose, context::packets) << "diffing object out of order: " << Synchronisable::getSynchronisable(origHeader.getObjectID())->getIdentifier()->getName() << endl;
-          diffObject(destDataPtr, origDataPtr, baseDataPtr, origHeader, sizesIt);
+          if( !bOmittable )
+            diffObject(destDataPtr, origDataPtr, baseDataPtr, origHeader, sizesIt);
+          else if( omitObject(origDataPtr, baseDataPtr, origHeader, sizesIt) )
+            this->omittedObjects_[origHeader.getObjectID()] = omittedSince;
         }
         else
         {
@@ -573,16 +684,22 @@ Gamestate* Gamestate::diffVariables(Gamestate *base)
           assert(sizesIt != this->sizes_.end() || origDataPtr==origDataEnd);
         }
       }
-      else
+      else if( !bLimitNewObjects || newObjects.find(origHeader.getObjectID()) != newObjects.end() )
       {
 //         orxout(verbose, context::packets) << "copy object: " << Synchronisable::getSynchronisable(origHeader.getObjectID())->getIdentifier()->getName() << endl;
         assert(baseDataPtr == oldBaseDataPtr);
         copyObject(destDataPtr, origDataPtr, baseDataPtr, origHeader, sizesIt);
         assert(sizesIt != this->sizes_.end() || origDataPtr==origDataEnd);
       }
+      else
+      {
+        assert(baseDataPtr == oldBaseDataPtr);
+        this->holdBackObject(origDataPtr, origHeader, sizesIt);
+      }
     }
   }
   assert(sizesIt==this->sizes_.end());
+  omittedMetric.add(this->omittedObjects_.size());
 
 
   Gamestate *g = new Gamestate(newData, getPeerID());
@@ -596,6 +713,103 @@ Gamestate* Gamestate::diffVariables(Gamestate *base)
 }
 
 
+/**
+  Returns a copy of the gamestate which contains only about @a maxObjects objects (see selectNewObjects()).
+  The others are marked as missing, hence the diffs which are based on this gamestate send them (see
+  diffVariables()). This spreads the creation of all objects on a joining client over several
+  gamestates instead of creating the whole level in one frame.
+*/
+Gamestate* Gamestate::selectObjects(uint32_t maxObjects)
+{
+  assert(data_);
+  assert(!header_.isCompressed());
+  assert(!header_.isDiffed());
+
+  uint8_t *origDataPtr = GAMESTATE_START(this->data_);
+  uint8_t *origDataEnd = origDataPtr + header_.getDataSize();
+  uint8_t *newData = new uint8_t[header_.getDataSize() + GamestateHeader::getSize()];
+  uint8_t *destDataPtr = GAMESTATE_START(newData);
+  uint8_t *unusedBaseDataPtr = 0;
+
+  std::vector<uint32_t> candidates;
+  for( uint8_t* dataPtr = origDataPtr; dataPtr < origDataEnd; )
+  {
+    SynchronisableHeader objectHeader(dataPtr);
+    candidates.push_back(objectHeader.getObjectID());
+    dataPtr += objectHeader.getDataSize() + SynchronisableHeader::getSize();
+  }
+  std::set<uint32_t> objects;
+  selectNewObjects(candidates, maxObjects, objects);
+
+  std::vector<uint32_t>::iterator sizesIt = this->sizes_.begin();
+  while( origDataPtr < origDataEnd )
+  {
+    SynchronisableHeader origHeader(origDataPtr);
+    if( objects.find(origHeader.getObjectID()) != objects.end() )
+      copyObject(destDataPtr, origDataPtr, unusedBaseDataPtr, origHeader, sizesIt);
+    else
+      this->holdBackObject(origDataPtr, origHeader, sizesIt);
+  }
+  assert(sizesIt==this->sizes_.end());
+
+  Gamestate *g = new Gamestate(newData, getPeerID());
+  (g->header_) = header_;
+  g->header_.setDataSize(destDataPtr - newData - GamestateHeader::getSize());
+  g->flags_=flags_;
+  g->packetDirection_ = packetDirection_;
+  return g;
+}
+
+
+/**
+  Chooses the objects which are sent completely to a peer that doesn't have them yet. An object is only
+  chosen together with the objects which it needs on the peer and which the peer doesn't have either:
+  its context and the objects it refers to (see Synchronisable::getReferencedObjects()). Otherwise the peer
+  would create it without them and e.g. never attach it to its parent. The callbacks are called after the
+  whole gamestate was applied, so the referenced objects may be sent after the object in the same gamestate.
+  @param candidates the ids of the objects which the peer doesn't have, in the order of the gamestate (earlier ones are preferred)
+  @param maxObjects the number of objects to choose (exceeded only if a single object needs more objects)
+  @param objects the chosen ids are added to this set
+*/
+void Gamestate::selectNewObjects(const std::vector<uint32_t>& candidates, uint32_t maxObjects, std::set<uint32_t>& objects)
+{
+  const std::set<uint32_t> candidateSet(candidates.begin(), candidates.end());
+  std::set<uint32_t> needed;
+  std::vector<uint32_t> open, references;
+
+  for( std::vector<uint32_t>::const_iterator it = candidates.begin(); it != candidates.end() && objects.size() < maxObjects; ++it )
+  {
+    if( objects.find(*it) != objects.end() )
+      continue;
+
+    // collect the object and (recursively) the missing objects it needs
+    needed.clear();
+    needed.insert(*it);
+    open.assign(1, *it);
+    while( !open.empty() )
+    {
+      Synchronisable* object = Synchronisable::getSynchronisable(open.back());
+      open.pop_back();
+      if( !object )
+        continue;
+      references.clear();
+      references.push_back(object->getContextID());
+      object->getReferencedObjects(references);
+      for( std::vector<uint32_t>::const_iterator ref = references.begin(); ref != references.end(); ++ref )
+      {
+        if( candidateSet.find(*ref) != candidateSet.end() && objects.find(*ref) == objects.end() && needed.insert(*ref).second )
+          open.push_back(*ref);
+      }
+    }
+
+    // a later object may need fewer objects and still fit into this gamestate
+    if( !objects.empty() && objects.size() + needed.size() > maxObjects )
+      continue;
+    objects.insert(needed.begin(), needed.end());
+  }
+}
+
+
 /*Gamestate* Gamestate::diffData(Gamestate *base)
 {
   assert(this && base); assert(data_ && base->data_);
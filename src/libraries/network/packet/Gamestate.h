@@ -35,6 +35,8 @@
 #include <cassert>
 #include <cstring>
 #include <list>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "util/CRC32.h"
@@ -50,6 +52,10 @@ namespace packet
 static const uint8_t GAMESTATE_MODE_SERVER = 0x1;
 static const uint8_t GAMESTATE_MODE_CLIENT = 0x2;
 
+static const int      GAMESTATE_OMIT_NONE   = 0x7FFFFFFF; // no object has such a high priority value, hence nothing is left out
+static const uint32_t GAMESTATE_MAX_OMITTED = 8;          // number of gamestates sent to a peer after which the changes of a left out object are sent anyway
+static const uint32_t GAMESTATE_NEW_OBJECTS_UNLIMITED = 0xFFFFFFFF; // all objects which the peer doesn't have are sent at once
+
 class _NetworkExport GamestateHeader
 {
   public:
@@ -125,7 +131,11 @@ class _NetworkExport Gamestate: public Packet
     inline bool isCompressed() const { return header_.isCompressed(); }
     inline int32_t getBaseID() const { return header_.getBaseID(); }
     inline uint32_t getDataSize() const { return header_.getDataSize(); }
-    Gamestate* diffVariables(Gamestate *base);
+    Gamestate* diffVariables(Gamestate *base, int omitPriority = GAMESTATE_OMIT_NONE, uint32_t sendNumber = 0, uint32_t maxNewObjects = GAMESTATE_NEW_OBJECTS_UNLIMITED);
+    Gamestate* selectObjects(uint32_t maxObjects);
+    inline size_t getNrOfOmittedObjects() const { return this->omittedObjects_.size(); }
+    inline size_t getNrOfMissingObjects() const { return this->missingObjects_.size(); }
+    inline const std::set<uint32_t>& getMissingObjects() const { return this->missingObjects_; }
 //     Gamestate* diffData(Gamestate *base);
 //     Gamestate *undiff(Gamestate *base);
 //     Gamestate* doSelection(unsigned int clientID, unsigned int targetSize);
@@ -140,6 +150,8 @@ class _NetworkExport Gamestate: public Packet
     virtual uint32_t getSize() const;
     virtual bool process(orxonox::Host* host);
     uint32_t calcGamestateSize(uint32_t id, uint8_t mode=0x0);
+    void holdBackObject( uint8_t*& dataPtr, SynchronisableHeader& objectHeader, std::vector<uint32_t>::iterator& sizes );
+    static void selectNewObjects(const std::vector<uint32_t>& candidates, uint32_t maxObjects, std::set<uint32_t>& objects);
 //     inline void diffObject( uint8_t*& newData, uint8_t*& origData, uint8_t*& baseData, SynchronisableHeader& objectHeader, std::vector<uint32_t>::iterator& sizes );
 //     inline void copyObject( uint8_t*& newData, uint8_t*& origData, uint8_t*& baseData, SynchronisableHeader& objectHeader, std::vector<uint32_t>::iterator& sizes );
     
@@ -147,6 +159,8 @@ class _NetworkExport Gamestate: public Packet
     GamestateHeader         header_;
     std::vector<uint32_t>   sizes_;
     uint32_t                nrOfVariables_;
+    std::map<uint32_t, uint32_t> omittedObjects_; // objects whose changes weren't sent (objectID -> send number of the first gamestate which left them out)
+    std::set<uint32_t>      missingObjects_; // objects which weren't sent at all yet (the peer doesn't have them, see selectObjects())
 };
 
 }
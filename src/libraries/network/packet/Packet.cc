@@ -66,6 +66,7 @@ boost::mutex Packet::packetMapMutex_;
 Packet::Packet()
 {
   flags_ = PACKET_FLAG_DEFAULT;
+  channelID_ = NETWORK_CHANNEL_DEFAULT;
   packetDirection_ = Direction::Outgoing;
   peerID_=0;
   data_=0;
@@ -76,6 +77,7 @@ Packet::Packet()
 Packet::Packet(uint8_t *data, unsigned int peerID)
 {
   flags_ = PACKET_FLAG_DEFAULT;
+  channelID_ = NETWORK_CHANNEL_DEFAULT;
   packetDirection_ = Direction::Incoming;
   peerID_=peerID;
   data_=data;
@@ -88,6 +90,7 @@ Packet::Packet(const Packet &p)
 {
   enetPacket_=p.enetPacket_;
   flags_=p.flags_;
+  channelID_=p.channelID_;
   packetDirection_ = p.packetDirection_;
   peerID_ = p.peerID_;
   if(p.data_){
@@ -176,7 +179,7 @@ bool Packet::send(orxonox::Host* host)
 //  ENetPacket *temp = enetPacket_;
 //  enetPacket_ = 0; // otherwise we have a double free because enet already handles the deallocation of the packet
   if( this->flags_ & PacketFlag::Reliable )
-    host->addPacket( enetPacket_, peerID_, NETWORK_CHANNEL_DEFAULT);
+    host->addPacket( enetPacket_, peerID_, channelID_);
   else
     host->addPacket( enetPacket_, peerID_, NETWORK_CHANNEL_UNRELIABLE);
   return true;
@@ -95,6 +95,9 @@ class _NetworkExport Packet
       { return bDataENetAllocated_; }
 
     uint32_t flags_;
+    /** The channel of reliable packets (unreliable packets always use
+        NETWORK_CHANNEL_UNRELIABLE) */
+    uint8_t channelID_;
     unsigned int peerID_;
     uint32_t requiredGamestateID_;
     Direction::Value packetDirection_;
@@ -44,6 +44,10 @@ namespace orxonox{
       virtual void call() = 0;
       NetworkCallbackBase(){ NetworkCallbackManager::registerCallback( this ); }
       virtual ~NetworkCallbackBase() {}
+
+      // callbacks are allocated from the same pools as the SynchronisableVariables
+      static void* operator new(size_t size);
+      static void operator delete(void* object, size_t size);
   };
 
   template <class T>
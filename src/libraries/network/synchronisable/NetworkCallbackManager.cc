@@ -28,11 +28,24 @@
 
 #include "NetworkCallbackManager.h"
 #include "NetworkCallback.h"
+#include "Synchronisable.h"
+#include "SynchronisableTable.h"
+#include "SynchronisableVariable.h"
 
 namespace orxonox{
 
   std::set<NetworkCallbackBase*> NetworkCallbackManager::callbackSet_;
-  std::queue<NetworkCallbackBase*> NetworkCallbackManager::triggeredCallbacks_;
+  std::queue<NetworkCallbackManager::TriggeredCallback> NetworkCallbackManager::triggeredCallbacks_;
+
+  void* NetworkCallbackBase::operator new(size_t size)
+  {
+    return SynchronisableVariableBase::allocate(size);
+  }
+
+  void NetworkCallbackBase::operator delete(void* object, size_t size)
+  {
+    SynchronisableVariableBase::deallocate(object, size);
+  }
 
   void NetworkCallbackManager::registerCallback(NetworkCallbackBase *cb)
   {
@@ -50,17 +63,35 @@ namespace orxonox{
 
   void NetworkCallbackManager::triggerCallback(NetworkCallbackBase *cb)
   {
-    if (triggeredCallbacks_.empty() || triggeredCallbacks_.front() != cb)
-      triggeredCallbacks_.push(cb);
+    if (triggeredCallbacks_.empty() || triggeredCallbacks_.front().callback != cb)
+    {
+      TriggeredCallback triggered = { cb, 0, OBJECTID_UNKNOWN, 0 };
+      triggeredCallbacks_.push(triggered);
+    }
+  }
+
+  void NetworkCallbackManager::triggerCallback(Synchronisable* object, const SynchronisableCallback* callback)
+  {
+    // several variables of an object may share the same callback (e.g. the components of a vector), call it only once
+    if (!triggeredCallbacks_.empty() && triggeredCallbacks_.back().object == object && triggeredCallbacks_.back().function == callback)
+      return;
+    TriggeredCallback triggered = { 0, object, object->getObjectID(), callback };
+    triggeredCallbacks_.push(triggered);
   }
 
   void NetworkCallbackManager::callCallbacks()
   {
     while( triggeredCallbacks_.empty()==false )
     {
-      //make sure callback hasn't been deleted before
-      if ( callbackSet_.find(triggeredCallbacks_.front()) != callbackSet_.end() )
-        triggeredCallbacks_.front()->call();
+      const TriggeredCallback& triggered = triggeredCallbacks_.front();
+      //make sure callback (or its object) hasn't been deleted before
+      if ( triggered.callback )
+      {
+        if ( callbackSet_.find(triggered.callback) != callbackSet_.end() )
+          triggered.callback->call();
+      }
+      else if ( Synchronisable::getSynchronisable(triggered.objectID) == triggered.object )
+        triggered.function->call(triggered.object);
       triggeredCallbacks_.pop();
     }
   }
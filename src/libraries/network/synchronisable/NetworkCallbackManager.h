@@ -42,10 +42,19 @@ namespace orxonox{
       static void registerCallback(NetworkCallbackBase *cb);
       static void deleteCallback(NetworkCallbackBase *cb);
       static void triggerCallback(NetworkCallbackBase *cb);
+      static void triggerCallback(Synchronisable* object, const SynchronisableCallback* callback);
       static void callCallbacks();
     private:
+      struct TriggeredCallback
+      {
+        NetworkCallbackBase* callback;          ///< The callback object (NULL if a member function of object is called)
+        Synchronisable* object;                 ///< The object whose member function is called
+        uint32_t objectID;                      ///< The id of object, used to check that it wasn't destroyed meanwhile
+        const SynchronisableCallback* function; ///< The member function (shared by all objects of the class)
+      };
+
       static std::set<NetworkCallbackBase*> callbackSet_;
-      static std::queue<NetworkCallbackBase*> triggeredCallbacks_;
+      static std::queue<TriggeredCallback> triggeredCallbacks_;
   };
 
 
@@ -65,8 +65,10 @@ namespace orxonox
     }
     classID_ = static_cast<uint32_t>(-1);
 
-    // set dataSize to 0
+    // no variables are registered yet
+    this->table_ = SynchronisableTable::getRoot();
     this->dataSize_ = 0;
+    this->lastChangedID_ = GAMESTATEID_INITIAL;
     // set standard priority
     this->setPriority( Priority::Normal );
 
@@ -86,11 +88,13 @@ namespace orxonox
       if (this->objectMode_ != 0x0 && (Host::running() && Host::isServer()))
         deletedObjects_.push(objectID_);
     }
-    // delete all Synchronisable Variables from syncList_ ( which are also in stringList_ )
-    for(std::vector<SynchronisableVariableBase*>::iterator it = syncList_.begin(); it!=syncList_.end(); it++)
-      delete (*it);
-    syncList_.clear();
-    stringList_.clear();
+    // delete the SynchronisableVariables of bidirectional variables and variables with a NetworkCallback
+    for(size_t i = 0; i < this->variables_.size(); ++i)
+    {
+      if( !(*this->table_)[i].codec )
+        delete static_cast<SynchronisableVariableBase*>(this->variables_[i]);
+    }
+    this->variables_.clear();
     std::map<uint32_t, Synchronisable*>::iterator it2;
     it2 = objectMap_.find(objectID_);
     if (it2 != objectMap_.end())
@@ -143,7 +147,7 @@ namespace orxonox
     }
 //     assert( !header.isDiffed() );
 
-    orxout(verbose, context::network) << "fabricating object with id: " << header.getObjectID() << endl;
+    orxout_filtered(verbose, context::network) << "fabricating object with id: " << header.getObjectID() << endl;
 
     Identifier* id = ClassByID(header.getClassID());
     if (!id)
@@ -188,7 +192,7 @@ namespace orxonox
           bo->setLevel(boContext->getLevel()); // Note: this ensures that the level is known on the client for child objects of the scene (and the scene itself)
     }
     //assert(no->classID_ == header.getClassID());
-    orxout(verbose, context::network) << "fabricate objectID_: " << no->objectID_ << " classID_: " << no->classID_ << endl;
+    orxout_filtered(verbose, context::network) << "fabricate objectID_: " << no->objectID_ << " classID_: " << no->classID_ << endl;
           // update data and create object/entity...
     bool b = no->updateData(mem, mode, true);
     assert(b);
@@ -257,7 +261,11 @@ namespace orxonox
       mode=state_;
     //if this tick is we dont synchronise, then abort now
     if(!doSync(/*id,*/ mode))
+    {
+      // the object isn't part of this gamestate, so it has to be sent completely the next time
+      this->markDirty();
       return 0;
+    }
     uint32_t tempsize = 0;
 #ifndef NDEBUG
     uint8_t* oldmem = mem;
@@ -271,24 +279,68 @@ namespace orxonox
     assert(ClassByID(this->classID_));
     assert(this->classID_==this->getIdentifier()->getNetworkID());
     assert(this->objectID_!=OBJECTID_UNKNOWN);
-    std::vector<SynchronisableVariableBase*>::iterator i;
+    const SynchronisableTable& table = *this->table_;
 
     // start copy header
     SynchronisableHeader header(mem);
     mem += SynchronisableHeader::getSize();
     // end copy header
 
-    orxout(verbose_more, context::network) << "getting data from objectID_: " << objectID_ << ", classID_: " << classID_ << endl;
+    orxout_filtered(verbose_more, context::network) << "getting data from objectID_: " << objectID_ << ", classID_: " << classID_ << endl;
+
+    // compare the variables with the data of the last gamestate, most objects don't change at all
+    bool bChanged = this->dataCache_.empty();
+    if(!bChanged)
+    {
+      uint8_t* cachedData = &this->dataCache_[0];
+      for(size_t i = 0; i < this->variables_.size() && !bChanged; ++i)
+      {
+        const SynchronisableDescriptor& descriptor = table[i];
+        if( !descriptor.codec )
+          bChanged = static_cast<SynchronisableVariableBase*>(this->variables_[i])->hasChanged( cachedData, mode );
+        else if( descriptor.mode == mode )
+          bChanged = !descriptor.codec->isEqual( this->variables_[i], cachedData );
+        cachedData += this->getVariableSize( i, mode );
+      }
+    }
+
+    if(bChanged)
+    {
 //     orxout(verbose, context::network) << "objectid: " << this->objectID_ << ":";
-    // copy to location
-    for(i=syncList_.begin(); i!=syncList_.end(); ++i)
+      // copy to location
+      for(size_t i = 0; i < this->variables_.size(); ++i)
+      {
+        const SynchronisableDescriptor& descriptor = table[i];
+        uint32_t varsize = 0;
+        if( !descriptor.codec )
+          varsize = static_cast<SynchronisableVariableBase*>(this->variables_[i])->getData( mem, mode );
+        else if( descriptor.mode == mode )
+        {
+          descriptor.codec->save( this->variables_[i], mem );
+          varsize = descriptor.codec->getSize( this->variables_[i] );
+        }
+//         orxout(verbose, context::network) << " " << varsize;
+        tempsize += varsize;
+        sizes.push_back(varsize);
+        ++test;
+        //tempsize += (*i)->getSize( mode );
+      }
+      this->dataCache_.assign(mem-tempsize, mem);
+      this->lastChangedID_ = id;
+    }
+    else
     {
-      uint32_t varsize = (*i)->getData( mem, mode );
-//       orxout(verbose, context::network) << " " << varsize;
-      tempsize += varsize;
-      sizes.push_back(varsize);
-      ++test;
-      //tempsize += (*i)->getSize( mode );
+      // nothing changed: copy the data of the last gamestate instead of serialising all variables again
+      for(size_t i = 0; i < this->variables_.size(); ++i)
+      {
+        uint32_t varsize = this->getVariableSize( i, mode );
+        tempsize += varsize;
+        sizes.push_back(varsize);
+        ++test;
+      }
+      assert( tempsize == this->dataCache_.size() );
+      memcpy( mem, &this->dataCache_[0], tempsize );
+      mem += tempsize;
     }
     assert(tempsize!=0);  // if this happens an empty object (with no variables) would be transmitted
 //     orxout(verbose, context::network) << endl;
@@ -323,9 +375,9 @@ namespace orxonox
     if(mode==0x0)
       mode=state_;
     
-    if(syncList_.empty())
+    if(variables_.empty())
     {
-      orxout(internal_warning, context::network) << "Synchronisable::updateData syncList_ is empty" << endl;
+      orxout(internal_warning, context::network) << "Synchronisable::updateData no variables registered" << endl;
       assert(0);
       return false;
     }
@@ -353,11 +405,10 @@ namespace orxonox
       assert( this->getClassID() == syncHeader2.getClassID() );
       assert( this->getContextID() == syncHeader2.getContextID() );
       mem += SynchronisableHeader::getSize();
-      std::vector<SynchronisableVariableBase *>::iterator i;
-      for(i=syncList_.begin(); i!=syncList_.end(); ++i)
+      for(size_t i = 0; i < this->variables_.size(); ++i)
       {
         assert( mem <= data+syncHeader2.getDataSize()+SynchronisableHeader::getSize() ); // always make sure we don't exceed the datasize in our stream
-        (*i)->putData( mem, mode, forceCallback );
+        this->putVariable( i, mem, mode, forceCallback );
       }
       assert(mem == data+syncHeaderLight.getDataSize()+SynchronisableHeader::getSize() );
     }
@@ -369,9 +420,9 @@ namespace orxonox
       {
         VariableID varID = *(VariableID*)mem;
 //         orxout(debug_output, context::network) << "varID: " << varID << endl;
-        assert( varID < syncList_.size() );
+        assert( varID < variables_.size() );
         mem += sizeof(VariableID);
-        syncList_[varID]->putData( mem, mode, forceCallback );
+        this->putVariable( varID, mem, mode, forceCallback );
       }
       assert(mem == data+syncHeaderLight.getDataSize()+SynchronisableHeaderLight::getSize() );
     }
@@ -393,14 +444,51 @@ namespace orxonox
       return 0;
     assert( mode==state_ );
     tsize += this->dataSize_;
-    std::vector<SynchronisableVariableBase*>::iterator i;
-    for(i=stringList_.begin(); i!=stringList_.end(); ++i)
+    const std::vector<size_t>& variableSizeIndices = this->table_->getVariableSizeIndices();
+    for(std::vector<size_t>::const_iterator i=variableSizeIndices.begin(); i!=variableSizeIndices.end(); ++i)
     {
-      tsize += (*i)->getSize( mode );
+      tsize += this->getVariableSize( *i, mode );
     }
     return tsize;
   }
 
+  /**
+   * Returns the number of bytes which getData writes for the variable with the given index
+   */
+  uint32_t Synchronisable::getVariableSize(size_t index, uint8_t mode)
+  {
+    const SynchronisableDescriptor& descriptor = (*this->table_)[index];
+    if( !descriptor.codec )
+      return static_cast<SynchronisableVariableBase*>(this->variables_[index])->getSize( mode );
+    else if( descriptor.mode == mode )
+      return descriptor.codec->getSize( this->variables_[index] );
+    else
+      return 0;
+  }
+
+  /**
+   * Loads the variable with the given index from the bytestream and triggers its callback if the value changed
+   * @param index index of the variable
+   * @param mem pointer to the data of the variable, will be increased by the size of the data
+   * @param mode same as in getData
+   * @param forceCallback triggers the callback even if the value didn't change
+   */
+  void Synchronisable::putVariable(size_t index, uint8_t*& mem, uint8_t mode, bool forceCallback)
+  {
+    const SynchronisableDescriptor& descriptor = (*this->table_)[index];
+    if( !descriptor.codec )
+    {
+      static_cast<SynchronisableVariableBase*>(this->variables_[index])->putData( mem, mode, forceCallback );
+      return;
+    }
+    assert( mode == 0x1 || mode == 0x2 );
+    if( descriptor.mode == mode ) // the variable was not sent in this direction
+      return;
+    if( descriptor.callback && ( forceCallback || !descriptor.codec->isEqual( this->variables_[index], mem ) ) )
+      NetworkCallbackManager::triggerCallback( this, descriptor.callback );
+    descriptor.codec->load( this->variables_[index], mem );
+  }
+
   /**
    * This function determines, wheter the object should be saved to the bytestream (according to its syncmode/direction)
    * @param mode Synchronisation mode (toclient, toserver or bidirectional)
@@ -411,7 +499,7 @@ namespace orxonox
 //     if(mode==0x0)
 //       mode=state_;
     assert(mode!=0x0);
-    return ( (this->objectMode_ & mode)!=0 && (!syncList_.empty() ) );
+    return ( (this->objectMode_ & mode)!=0 && (!variables_.empty() ) );
   }
   
   /**
@@ -439,51 +527,67 @@ namespace orxonox
     this->objectMode_=mode;
   }
 
-  template <> void Synchronisable::registerVariable( std::string& variable, uint8_t mode, NetworkCallbackBase *cb, bool bidirectional)
+  /**
+   * Adds a variable which is serialised by the given codec to the table of this object
+   * @param variable the address of the variable
+   * @param codec the functions that serialise the variable
+   * @param mode the direction in which the variable is synchronised
+   * @param callback the member function that is called if the variable changed (or NULL), the table stores a copy of it
+   */
+  void Synchronisable::addVariable(void* variable, const SynchronisableCodec* codec, uint8_t mode, const SynchronisableCallback* callback)
   {
-    SynchronisableVariableBase* sv;
-    if (bidirectional)
-      sv = new SynchronisableVariableBidirectional<std::string>(variable, mode, cb);
-    else
-      sv = new SynchronisableVariable<std::string>(variable, mode, cb);
-    syncList_.push_back(sv);
-    stringList_.push_back(sv);
+    SynchronisableDescriptor descriptor = { codec, callback, mode, codec->bVariableSize };
+    this->table_ = this->table_->getChild(descriptor);
+    // objects of the same class register the same variables, so the table knows how many will follow
+    if( this->variables_.size() == this->variables_.capacity() )
+      this->variables_.reserve(this->table_->getMaxSize());
+    this->variables_.push_back(variable);
+    if( !codec->bVariableSize && mode == state_ )
+      this->dataSize_ += codec->getSize(variable);
+    this->markDirty();
   }
 
-template <> void Synchronisable::unregisterVariable( std::string& variable )
+  /**
+   * Adds a SynchronisableVariable (bidirectional variables and variables with a NetworkCallback) to the table of this object
+   * @param variable the SynchronisableVariable, will be deleted by this object
+   * @param bVariableSize true if the size of the variable depends on its value
+   */
+  void Synchronisable::addVariable(SynchronisableVariableBase* variable, bool bVariableSize)
   {
-    bool unregistered_nonexistent_variable = true;
-    std::vector<SynchronisableVariableBase*>::iterator it = syncList_.begin();
-    while(it!=syncList_.end())
-    {
-      if( ((*it)->getReference()) == &variable )
-      {
-        delete (*it);
-        syncList_.erase(it);
-        unregistered_nonexistent_variable = false;
-        break;
-      }
-      else
-        ++it;
-    }
-    assert(unregistered_nonexistent_variable == false);
-    
-    it = stringList_.begin();
-    while(it!=stringList_.end())
+    SynchronisableDescriptor descriptor = { 0, 0, variable->getMode(), bVariableSize };
+    this->table_ = this->table_->getChild(descriptor);
+    if( this->variables_.size() == this->variables_.capacity() )
+      this->variables_.reserve(this->table_->getMaxSize());
+    this->variables_.push_back(variable);
+    if( !bVariableSize )
+      this->dataSize_ += variable->getSize(state_);
+    this->markDirty();
+  }
+
+  /**
+   * Removes a registered variable from the table of this object
+   * @param variable the address of the variable
+   */
+  void Synchronisable::removeVariable(void* variable)
+  {
+    for(size_t i = 0; i < this->variables_.size(); ++i)
     {
-      if( ((*it)->getReference()) == &variable )
+      const SynchronisableDescriptor& descriptor = (*this->table_)[i];
+      SynchronisableVariableBase* sv = descriptor.codec ? 0 : static_cast<SynchronisableVariableBase*>(this->variables_[i]);
+      if( (sv ? sv->getReference() : this->variables_[i]) == variable )
       {
-        delete (*it);
-        stringList_.erase(it);
+        if( !descriptor.bVariableSize )
+          this->dataSize_ -= this->getVariableSize(i, state_);
+        delete sv;
+        this->variables_.erase(this->variables_.begin() + i);
+        this->table_ = this->table_->getWithout(i);
+        this->markDirty();
         return;
       }
-      else
-        ++it;
     }
-    unregistered_nonexistent_variable = true;
-    assert(unregistered_nonexistent_variable == false); //if we reach this point something went wrong:
+    orxout(internal_error, context::network) << "Tried to unregister not registered variable" << endl;
+    assert(false); //if we reach this point something went wrong:
     // the variable has not been registered before
   }
 
-
 }
@@ -37,10 +37,12 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <string>
 
 #include "util/mbool.h"
 #include "util/Output.h"
 #include "core/class/OrxonoxInterface.h"
+#include "SynchronisableTable.h"
 #include "SynchronisableVariable.h"
 #include "NetworkCallback.h"
 
@@ -164,14 +166,24 @@ namespace orxonox
 
     void setSyncMode(uint8_t mode);
     
-    inline uint32_t getNrOfVariables(){ return this->syncList_.size(); }
+    /// Returns the id of the last gamestate in which the data of this object changed (or GAMESTATEID_INITIAL if it wasn't collected since the last change of its variables)
+    inline uint32_t getLastChangedID() const { return this->lastChangedID_; }
+    /// Makes sure the variables are serialised again in the next gamestate, even if they seem to be unchanged
+    inline void markDirty(){ this->dataCache_.clear(); }
+
+    /// Adds the ids of the objects which this object refers to in its variables (e.g. its parent). A joining client gets them together with this object.
+    virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const {}
+    /// Adds the names of the resources which this object loads on a client (e.g. its mesh). A joining client loads them in advance.
+    virtual void getPrefetchResources(std::vector<std::string>& resources) const {}
+
+    inline uint32_t getNrOfVariables(){ return this->variables_.size(); }
     inline uint32_t getVarSize( VariableID ID )
-    { return this->syncList_[ID]->getSize(state_); }
+    { return this->getVariableSize(ID, state_); }
 
   protected:
     Synchronisable(Context* context);
     template <class T> void registerVariable(T& variable, uint8_t mode=0x1, NetworkCallbackBase *cb=0, bool bidirectional=false);
-    template <class T> void registerVariable(std::set<T>& variable, uint8_t mode=0x1, NetworkCallbackBase *cb=0, bool bidirectional=false);
+    template <class T, class C> void registerVariable(T& variable, uint8_t mode, void (C::*function) (void), bool bidirectional=false);
     template <class T> void unregisterVariable(T& var);
 
     void setPriority(unsigned int freq){ objectFrequency_ = freq; }
@@ -184,6 +196,12 @@ namespace orxonox
     bool doSync(/*int32_t id,*/ uint8_t mode=0x0);
     bool doReceive( uint8_t mode );
 
+    void addVariable(void* variable, const SynchronisableCodec* codec, uint8_t mode, const SynchronisableCallback* callback);
+    void addVariable(SynchronisableVariableBase* variable, bool bVariableSize);
+    void removeVariable(void* variable);
+    uint32_t getVariableSize(size_t index, uint8_t mode);
+    void putVariable(size_t index, uint8_t*& mem, uint8_t mode, bool forceCallback);
+
     inline void setObjectID(uint32_t id){ this->objectID_ = id; objectMap_[this->objectID_] = this; }
     inline void setClassID(uint32_t id){ this->classID_ = id; }
 
@@ -191,9 +209,11 @@ namespace orxonox
     uint32_t contextID_;
     uint32_t classID_;
 
-    std::vector<SynchronisableVariableBase*> syncList_;
-    std::vector<SynchronisableVariableBase*> stringList_;
+    const SynchronisableTable* table_; // describes the registered variables, shared by all objects of the class
+    std::vector<void*> variables_; // the addresses of the registered variables (or their SynchronisableVariableBase, see SynchronisableDescriptor)
     uint32_t dataSize_; //size of all variables except strings
+    std::vector<uint8_t> dataCache_; // the variables as serialised in the last gamestate, used to detect changes
+    uint32_t lastChangedID_; // id of the gamestate in which the data last changed
     static uint8_t state_; // detemines wheter we are server (default) or client
     bool backsync_; // if true the variables with mode > 1 will be synchronised to server (client -> server)
     unsigned int objectFrequency_;
@@ -205,54 +225,33 @@ namespace orxonox
   template <class T> void Synchronisable::registerVariable(T& variable, uint8_t mode, NetworkCallbackBase *cb, bool bidirectional)
   {
     if (bidirectional)
-    {
-      syncList_.push_back(new SynchronisableVariableBidirectional<T>(variable, mode, cb));
-      this->dataSize_ += syncList_.back()->getSize(state_);
-    }
+      this->addVariable(new SynchronisableVariableBidirectional<T>(variable, mode, cb), SynchronisableVariableSize<T>::value);
+    else if (cb)
+      this->addVariable(new SynchronisableVariable<T>(variable, mode, cb), SynchronisableVariableSize<T>::value);
     else
-    {
-      syncList_.push_back(new SynchronisableVariable<T>(variable, mode, cb));
-      if ( this->state_ == mode )
-        this->dataSize_ += syncList_.back()->getSize(state_);
-    }
+      this->addVariable(const_cast<void*>(static_cast<const void*>(&variable)), SynchronisableCodec::get<T>(), mode, 0);
   }
-  
-  template <class T> void Synchronisable::unregisterVariable(T& variable)
+
+  /**
+   * Registers a variable whose changes are reported to a member function of this object. In contrast to passing a
+   * NetworkCallback, this doesn't allocate anything: the member function is stored in the table of the class.
+   */
+  template <class T, class C> void Synchronisable::registerVariable(T& variable, uint8_t mode, void (C::*function) (void), bool bidirectional)
   {
-    std::vector<SynchronisableVariableBase*>::iterator it = syncList_.begin();
-    while(it!=syncList_.end())
+    if (bidirectional)
+      this->registerVariable(variable, mode, new NetworkCallback<C>(dynamic_cast<C*>(this), function), true);
+    else
     {
-      if( ((*it)->getReference()) == &variable )
-      {
-        this->dataSize_ -= (*it)->getSize(Synchronisable::state_);
-        delete (*it);
-        syncList_.erase(it);
-        return;
-      }
-      else
-        it++;
+      SynchronisableMemberCallback<C> callback(function);
+      this->addVariable(const_cast<void*>(static_cast<const void*>(&variable)), SynchronisableCodec::get<T>(), mode, &callback);
     }
-    orxout(internal_error, context::network) << "Tried to unregister not registered variable" << endl;
-    assert(false); //if we reach this point something went wrong:
-    // the variable has not been registered before
   }
 
-  template <class T> void Synchronisable::registerVariable( std::set<T>& variable, uint8_t mode, NetworkCallbackBase *cb, bool bidirectional)
+  template <class T> void Synchronisable::unregisterVariable(T& variable)
   {
-    SynchronisableVariableBase* sv;
-    if (bidirectional)
-      sv = new SynchronisableVariableBidirectional<std::set<T> >(variable, mode, cb);
-    else
-      sv = new SynchronisableVariable<std::set<T> >(variable, mode, cb);
-    syncList_.push_back(sv);
-    stringList_.push_back(sv);
+    this->removeVariable(const_cast<void*>(static_cast<const void*>(&variable)));
   }
 
-  template <> _NetworkExport void Synchronisable::registerVariable( std::string& variable, uint8_t mode, NetworkCallbackBase *cb, bool bidirectional);
-//   template <class T> _NetworkExport void Synchronisable::registerVariable<std::set<T> >( std::set<T>& variable, uint8_t mode, NetworkCallbackBase *cb, bool bidirectional);
-  template <> _NetworkExport void Synchronisable::unregisterVariable( std::string& variable );
-
-
 }
 
 #endif /* _Synchronisable_H__ */
@@ -0,0 +1,104 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of the SynchronisableTable class.
+*/
+
+#include "SynchronisableTable.h"
+
+namespace orxonox{
+
+  SynchronisableTable::SynchronisableTable(SynchronisableTable* parent)
+    : parent_(parent), maxSize_(0)
+  {
+  }
+
+  /**
+   * Returns the empty table which all objects start with
+   */
+  SynchronisableTable* SynchronisableTable::getRoot()
+  {
+    static SynchronisableTable* root = new SynchronisableTable(0);
+    return root;
+  }
+
+  /**
+   * Returns the table which contains the variables of this table plus the given variable. The table is created if
+   * no other object registered the same variables before.
+   * @param descriptor the descriptor of the new variable (the callback is copied if a new table is created)
+   */
+  SynchronisableTable* SynchronisableTable::getChild(const SynchronisableDescriptor& descriptor)
+  {
+    for( std::vector<SynchronisableTable*>::const_iterator it = this->children_.begin(); it != this->children_.end(); ++it )
+    {
+      if( isEqual((*it)->descriptors_.back(), descriptor) )
+        return *it;
+    }
+
+    SynchronisableTable* child = new SynchronisableTable(this);
+    child->descriptors_ = this->descriptors_;
+    child->variableSizeIndices_ = this->variableSizeIndices_;
+    child->descriptors_.push_back(descriptor);
+    if( descriptor.callback )
+      child->descriptors_.back().callback = descriptor.callback->clone();
+    if( descriptor.bVariableSize )
+      child->variableSizeIndices_.push_back(this->descriptors_.size());
+    this->children_.push_back(child);
+
+    for( SynchronisableTable* table = child; table && table->maxSize_ < child->size(); table = table->parent_ )
+      table->maxSize_ = child->size();
+    return child;
+  }
+
+  /**
+   * Returns the table which contains the variables of this table except the variable with the given index
+   */
+  SynchronisableTable* SynchronisableTable::getWithout(size_t index) const
+  {
+    assert( index < this->size() );
+    SynchronisableTable* table = getRoot();
+    for( size_t i = 0; i < this->size(); ++i )
+    {
+      if( i != index )
+        table = table->getChild(this->descriptors_[i]);
+    }
+    return table;
+  }
+
+  bool SynchronisableTable::isEqual(const SynchronisableDescriptor& a, const SynchronisableDescriptor& b)
+  {
+    if( a.codec != b.codec || a.mode != b.mode || a.bVariableSize != b.bVariableSize )
+      return false;
+    if( a.callback && b.callback )
+      return a.callback->equals(*b.callback);
+    return a.callback == b.callback;
+  }
+
+}
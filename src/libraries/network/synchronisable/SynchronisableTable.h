@@ -0,0 +1,185 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Declaration of the tables that describe the synchronised variables of a class.
+*/
+
+#ifndef _SynchronisableTable_H__
+#define _SynchronisableTable_H__
+
+#include "network/NetworkPrereqs.h"
+
+#include <cassert>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Serialise.h"
+
+namespace orxonox{
+
+  /// Defines whether the serialised size of a type depends on the value (true for strings and sets)
+  template <class T> struct SynchronisableVariableSize { static const bool value = false; };
+  template <> struct SynchronisableVariableSize<std::string> { static const bool value = true; };
+  template <class T> struct SynchronisableVariableSize<std::set<T> > { static const bool value = true; };
+
+  /**
+   * @brief The functions which serialise the variables of one type
+   *
+   * There is only one codec per type (see get()), so two codecs are equal if their addresses are equal.
+   */
+  struct SynchronisableCodec
+  {
+    uint32_t (*getSize)(void* variable);
+    void (*save)(void* variable, uint8_t*& mem);
+    void (*load)(void* variable, uint8_t*& mem);
+    bool (*isEqual)(void* variable, uint8_t* mem);
+    bool bVariableSize;
+
+    template <class T> static const SynchronisableCodec* get();
+  };
+
+  template <class T>
+  struct SynchronisableCodecFunctions
+  {
+    static uint32_t getSize(void* variable)
+      { return returnSize( *static_cast<T*>(variable) ); }
+    static void save(void* variable, uint8_t*& mem)
+      { saveAndIncrease( *static_cast<T*>(variable), mem ); }
+    static void load(void* variable, uint8_t*& mem)
+      { loadAndIncrease( *static_cast<T*>(variable), mem ); }
+    static bool isEqual(void* variable, uint8_t* mem)
+      { return checkEquality( *static_cast<T*>(variable), mem ); }
+  };
+
+  template <class T> const SynchronisableCodec* SynchronisableCodec::get()
+  {
+    static const SynchronisableCodec codec =
+    {
+      &SynchronisableCodecFunctions<T>::getSize,
+      &SynchronisableCodecFunctions<T>::save,
+      &SynchronisableCodecFunctions<T>::load,
+      &SynchronisableCodecFunctions<T>::isEqual,
+      SynchronisableVariableSize<T>::value
+    };
+    return &codec;
+  }
+
+  /**
+   * @brief A member function of a Synchronisable which is called if a synchronised variable changed
+   *
+   * The callback is stored once per class in its SynchronisableTable and called for the object whose variable changed.
+   */
+  class _NetworkExport SynchronisableCallback
+  {
+    public:
+      virtual ~SynchronisableCallback() {}
+      virtual void call(Synchronisable* object) const = 0;
+      virtual bool equals(const SynchronisableCallback& other) const = 0;
+      virtual SynchronisableCallback* clone() const = 0;
+  };
+
+  template <class T>
+  class SynchronisableMemberCallback: public SynchronisableCallback
+  {
+    public:
+      SynchronisableMemberCallback(void (T::*function) (void)) : function_(function) {}
+      // T may be a base class which is not derived from Synchronisable (e.g. BaseObject::changedName), hence the cross cast
+      virtual void call(Synchronisable* object) const
+        { (dynamic_cast<T*>(object)->*this->function_)(); }
+      virtual bool equals(const SynchronisableCallback& other) const
+      {
+        const SynchronisableMemberCallback<T>* callback = dynamic_cast<const SynchronisableMemberCallback<T>*>(&other);
+        return callback && callback->function_ == this->function_;
+      }
+      virtual SynchronisableCallback* clone() const
+        { return new SynchronisableMemberCallback<T>(this->function_); }
+
+    private:
+      void (T::*function_) (void);
+  };
+
+  /**
+   * @brief Describes one registered variable
+   *
+   * If codec is NULL the object stores a SynchronisableVariableBase instead of the address of the variable
+   * (used for bidirectional variables and for callbacks of other objects).
+   */
+  struct SynchronisableDescriptor
+  {
+    const SynchronisableCodec* codec;       //!< The functions that serialise the variable
+    const SynchronisableCallback* callback; //!< The member function that is called if the variable changed (or NULL)
+    uint8_t mode;                           //!< The direction in which the variable is synchronised
+    bool bVariableSize;                     //!< True if the size of the variable depends on its value
+  };
+
+  /**
+   * @brief The list of the variables which an object registered
+   *
+   * All objects of a class register the same variables in the same order, so they share the same table.
+   * The tables form a tree: registering a variable moves the object from its table to the child which
+   * describes one more variable. The tables are never destroyed.
+   */
+  class _NetworkExport SynchronisableTable
+  {
+    public:
+      static SynchronisableTable* getRoot();
+
+      SynchronisableTable* getChild(const SynchronisableDescriptor& descriptor);
+      SynchronisableTable* getWithout(size_t index) const;
+
+      /// Returns the number of variables in this table
+      inline size_t size() const
+        { return this->descriptors_.size(); }
+      /// Returns the number of variables in the largest table which was created below this table
+      inline size_t getMaxSize() const
+        { return this->maxSize_; }
+      inline const SynchronisableDescriptor& operator[](size_t index) const
+        { assert(index < this->descriptors_.size()); return this->descriptors_[index]; }
+      /// Returns the indices of the variables with a variable size
+      inline const std::vector<size_t>& getVariableSizeIndices() const
+        { return this->variableSizeIndices_; }
+
+    private:
+      SynchronisableTable(SynchronisableTable* parent);
+      SynchronisableTable(const SynchronisableTable&);  // not implemented
+
+      static bool isEqual(const SynchronisableDescriptor& a, const SynchronisableDescriptor& b);
+
+      SynchronisableTable* parent_;                       //!< The table with one variable less (NULL for the root)
+      std::vector<SynchronisableDescriptor> descriptors_; //!< The descriptors of all variables
+      std::vector<size_t> variableSizeIndices_;           //!< The indices of the variables with a variable size
+      std::vector<SynchronisableTable*> children_;        //!< The tables with one more variable
+      size_t maxSize_;                                    //!< The size of the largest table below this table
+  };
+
+}
+
+#endif /* _SynchronisableTable_H__ */
@@ -28,9 +28,60 @@
 
 #include "SynchronisableVariable.h"
 
+#include <new>
+#include "util/SmallObjectAllocator.h"
+
 namespace orxonox{
 
 uint8_t SynchronisableVariableBase::state_ = 0;
 
+static const size_t POOL_GRANULARITY = 16; // the pools provide chunks of 16, 32, 48, ... bytes
+static const size_t NUMBER_OF_POOLS = 16;   // larger objects are allocated with the global operator new
+
+/**
+ * Returns the pool for objects of the given size or NULL if the object is too large
+ */
+static SmallObjectAllocator* getPool(size_t size)
+{
+  if( size == 0 || size > POOL_GRANULARITY*NUMBER_OF_POOLS )
+    return 0;
+
+  // the pools are never destroyed, because static objects may still delete their variables at shutdown
+  static SmallObjectAllocator* pools[NUMBER_OF_POOLS] = { 0 };
+  const size_t index = (size-1)/POOL_GRANULARITY;
+  if( !pools[index] )
+    pools[index] = new SmallObjectAllocator((index+1)*POOL_GRANULARITY, 256);
+  return pools[index];
+}
+
+/**
+ * Allocates memory for a SynchronisableVariable or a NetworkCallback
+ * @param size the size of the object
+ */
+void* SynchronisableVariableBase::allocate(size_t size)
+{
+  SmallObjectAllocator* pool = getPool(size);
+  if( pool )
+    return pool->alloc();
+  else
+    return ::operator new(size);
+}
+
+/**
+ * Returns the memory of an object allocated with allocate()
+ * @param object the memory of the object
+ * @param size the size of the object (the same as given to allocate())
+ */
+void SynchronisableVariableBase::deallocate(void* object, size_t size)
+{
+  if( !object )
+    return;
+  SmallObjectAllocator* pool = getPool(size);
+  if( pool )
+    pool->free(object);
+  else
+    ::operator delete(object);
+}
+
 
 } //namespace
@@ -61,9 +61,17 @@ namespace orxonox{
       virtual uint32_t getData(uint8_t*& mem, uint8_t mode)=0;
       virtual void putData(uint8_t*& mem, uint8_t mode, bool forceCallback = false)=0;
       virtual uint32_t getSize(uint8_t mode)=0;
+      virtual bool hasChanged(uint8_t* mem, uint8_t mode)=0;
       virtual void* getReference()=0;
       virtual uint8_t getMode()=0;
       virtual ~SynchronisableVariableBase() {}
+
+      // each networked object registers dozens of variables and callbacks, so they are allocated from pools
+      static void* operator new(size_t size){ return allocate(size); }
+      static void operator delete(void* object, size_t size){ deallocate(object, size); }
+
+      static void* allocate(size_t size);
+      static void deallocate(void* object, size_t size);
     protected:
       static uint8_t state_;
   };
@@ -79,6 +87,7 @@ namespace orxonox{
       virtual inline uint32_t getData(uint8_t*& mem, uint8_t mode);
       virtual inline void putData(uint8_t*& mem, uint8_t mode, bool forceCallback = false);
       virtual inline uint32_t getSize(uint8_t mode);
+      virtual inline bool hasChanged(uint8_t* mem, uint8_t mode);
       virtual inline void* getReference(){ return static_cast<void*>(const_cast<typename Loki::TypeTraits<T>::UnqualifiedType*>(&this->variable_)); }
     protected:
       T&                       variable_;
@@ -97,6 +106,7 @@ namespace orxonox{
       virtual inline uint32_t getData(uint8_t*& mem, uint8_t mode);
       virtual void putData(uint8_t*& mem, uint8_t mode, bool forceCallback = false);
       virtual inline uint32_t getSize(uint8_t mode);
+      virtual inline bool hasChanged(uint8_t* mem, uint8_t mode);
     private:
       T varBuffer_;
       uint8_t varReference_;
@@ -161,6 +171,18 @@ namespace orxonox{
       return 0;
   }
 
+  /**
+   * Compares the variable with the data written by a previous call of getData, without serialising it again
+   * @return true if getData would write different data
+   */
+  template <class T> inline bool SynchronisableVariable<T>::hasChanged(uint8_t* mem, uint8_t mode)
+  {
+    if ( mode == this->mode_ )
+      return !checkEquality( this->variable_, mem );
+    else
+      return false;
+  }
+
 
 
 
@@ -254,6 +276,14 @@ namespace orxonox{
       return returnSize( this->variable_ ) + sizeof(varReference_);
     }
 
+    template <class T> inline bool SynchronisableVariableBidirectional<T>::hasChanged(uint8_t* mem, uint8_t mode)
+    {
+      // if we are master, getData would increase the reference number
+      if ( this->mode_ == mode && this->varBuffer_ != this->variable_ )
+        return true;
+      return *static_cast<uint8_t*>(mem) != this->varReference_ || !checkEquality( this->variable_, mem+sizeof(varReference_) );
+    }
+
 
 }
 
@@ -51,6 +51,13 @@ namespace orxonox
         tickDtFloat_ = static_cast<float>(tickDt_) / 1000000.0f;
     }
 
+    void Clock::advance(long microseconds)
+    {
+        tickDt_ = microseconds;
+        tickTime_ += tickDt_;
+        tickDtFloat_ = static_cast<float>(tickDt_) / 1000000.0f;
+    }
+
     unsigned long long Clock::getRealMicroseconds() const
     {
         return tickTime_ + (timer_->getMicroseconds() - (unsigned long)tickTime_);
@@ -73,6 +73,11 @@ namespace orxonox
         */
         void capture();
 
+        /** Advances the captured time by a fixed amount instead of measuring it.
+            Used to run simulations with a fixed time step (independent of the real time).
+        */
+        void advance(long microseconds);
+
         /// Returns the last captured absolute time in microseconds
         unsigned long long getMicroseconds() const
             { return tickTime_; }
@@ -0,0 +1,634 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of the metrics registry, the metric types and the reader of the binary metrics stream.
+*/
+
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "Output.h"
+
+namespace orxonox
+{
+    static const char STREAM_MAGIC[4] = { 'O', 'X', 'M', 'T' };
+    static const uint8_t STREAM_VERSION = 2;
+    static const size_t MAX_HISTOGRAM_BOUNDS = 0xFFFF; // the number of bounds is stored as uint16 in the definition record
+
+    namespace
+    {
+        /// Returns true if the machine uses little endian byte order.
+        inline bool isLittleEndian()
+        {
+            uint16_t test = 1;
+            return (*reinterpret_cast<uint8_t*>(&test) == 1);
+        }
+
+        /// Appends the raw bytes of a value to the buffer.
+        template <class T>
+        inline void append(std::string& buffer, const T& value)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /// Reads a value from the data at the given position and increases the position. Returns false if the data is too short.
+        template <class T>
+        inline bool extract(const std::string& data, size_t& pos, T& value, bool bSwapBytes)
+        {
+            if (pos + sizeof(T) > data.size())
+                return false;
+
+            char* bytes = reinterpret_cast<char*>(&value);
+            memcpy(bytes, data.data() + pos, sizeof(T));
+            if (bSwapBytes)
+                std::reverse(bytes, bytes + sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        /// Appends a record with the given type and data to the buffer.
+        inline void appendRecord(std::string& buffer, char type, const std::string& data)
+        {
+            append(buffer, type);
+            append(buffer, static_cast<uint32_t>(data.size()));
+            buffer += data;
+        }
+    }
+
+    // ###############################
+    // ###         Metric          ###
+    // ###############################
+
+    /**
+        @brief Constructor: Initializes name, type and ID.
+    */
+    Metric::Metric(const std::string& name, Type type, uint16_t id)
+        : name_(name), type_(type), id_(id)
+    {
+    }
+
+    /**
+        @brief Destructor.
+    */
+    Metric::~Metric()
+    {
+    }
+
+    // ###############################
+    // ###     MetricHistogram     ###
+    // ###############################
+
+    /**
+        @brief Constructor: Initializes the buckets. The bounds are sorted in ascending order.
+
+        At most 65535 bounds are supported, additional (largest) bounds are dropped.
+    */
+    MetricHistogram::MetricHistogram(const std::string& name, uint16_t id, const std::vector<double>& bounds)
+        : Metric(name, Histogram, id), bounds_(bounds)
+    {
+        std::sort(this->bounds_.begin(), this->bounds_.end());
+        if (this->bounds_.size() > MAX_HISTOGRAM_BOUNDS)
+        {
+            orxout(internal_error) << "Histogram '" << name << "' has " << this->bounds_.size() << " bounds, only the smallest " << MAX_HISTOGRAM_BOUNDS << " are used" << endl;
+            this->bounds_.resize(MAX_HISTOGRAM_BOUNDS);
+        }
+        this->resetInterval();
+    }
+
+    /**
+        @brief Adds a sample to the histogram.
+    */
+    void MetricHistogram::sample(double value)
+    {
+        size_t bucket = std::lower_bound(this->bounds_.begin(), this->bounds_.end(), value) - this->bounds_.begin();
+        ++this->buckets_[bucket];
+
+        if (this->count_ == 0 || value > this->max_)
+            this->max_ = value;
+        this->sum_ += value;
+        ++this->count_;
+    }
+
+    /**
+        @brief Writes count, sum, maximum and all buckets to @a value.
+    */
+    void MetricHistogram::getValue(MetricValue& value) const
+    {
+        value.count = this->count_;
+        value.sum = this->sum_;
+        value.max = this->max_;
+        value.buckets = this->buckets_;
+    }
+
+    /**
+        @brief Removes all samples, called after each snapshot.
+    */
+    void MetricHistogram::resetInterval()
+    {
+        this->buckets_.assign(this->bounds_.size() + 1, 0);
+        this->count_ = 0;
+        this->sum_ = 0;
+        this->max_ = 0;
+    }
+
+    /**
+        @brief Returns bucket bounds (in seconds) which are suited for frame and tick durations.
+    */
+    /*static*/ const std::vector<double>& MetricHistogram::getDefaultTimeBounds()
+    {
+        static std::vector<double> bounds;
+        if (bounds.empty())
+        {
+            const double values[] = { 0.001, 0.002, 0.005, 0.010, 0.017, 0.033, 0.050, 0.100, 0.250, 0.500, 1.0 };
+            bounds.assign(values, values + sizeof(values) / sizeof(values[0]));
+        }
+        return bounds;
+    }
+
+    /**
+        @brief Returns bucket bounds (in bytes) which are suited for packet and gamestate sizes.
+    */
+    /*static*/ const std::vector<double>& MetricHistogram::getDefaultSizeBounds()
+    {
+        static std::vector<double> bounds;
+        if (bounds.empty())
+        {
+            const double values[] = { 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576 };
+            bounds.assign(values, values + sizeof(values) / sizeof(values[0]));
+        }
+        return bounds;
+    }
+
+    // ###############################
+    // ###     MetricsRegistry     ###
+    // ###############################
+
+    /**
+        @brief Constructor.
+    */
+    MetricsRegistry::MetricsRegistry()
+    {
+    }
+
+    /**
+        @brief Destructor: Deletes all metrics.
+    */
+    MetricsRegistry::~MetricsRegistry()
+    {
+        for (size_t i = 0; i < this->metrics_.size(); ++i)
+            delete this->metrics_[i];
+    }
+
+    /**
+        @brief Returns the only instance of MetricsRegistry.
+    */
+    /*static*/ MetricsRegistry& MetricsRegistry::getInstance()
+    {
+        static MetricsRegistry instance;
+        return instance;
+    }
+
+    /**
+        @brief Registers a counter with the given name or returns the existing counter.
+    */
+    MetricCounter& MetricsRegistry::registerCounter(const std::string& name)
+    {
+        return this->registerMetric(name, Metric::Counter, static_cast<MetricCounter*>(0));
+    }
+
+    /**
+        @brief Registers a gauge with the given name or returns the existing gauge.
+    */
+    MetricGauge& MetricsRegistry::registerGauge(const std::string& name)
+    {
+        return this->registerMetric(name, Metric::Gauge, static_cast<MetricGauge*>(0));
+    }
+
+    /**
+        @brief Registers a histogram with the given name and bucket bounds or returns the existing histogram.
+    */
+    MetricHistogram& MetricsRegistry::registerHistogram(const std::string& name, const std::vector<double>& bounds)
+    {
+        std::map<std::string, Metric*>::const_iterator it = this->metricsByName_.find(name);
+        if (it != this->metricsByName_.end())
+        {
+            if (it->second->getType() == Metric::Histogram)
+                return *static_cast<MetricHistogram*>(it->second);
+
+            orxout(internal_error) << "Metric '" << name << "' was registered with different types" << endl;
+        }
+
+        MetricHistogram* metric = new MetricHistogram(name, static_cast<uint16_t>(this->metrics_.size()), bounds);
+        this->metrics_.push_back(metric);
+        if (it == this->metricsByName_.end())
+            this->metricsByName_[name] = metric;
+        return *metric;
+    }
+
+    /**
+        @brief Returns the existing metric with the given name or creates a new one. If the existing metric has another type, an error is printed and a new metric which is not accessible by name is returned.
+    */
+    template <class T>
+    T& MetricsRegistry::registerMetric(const std::string& name, Metric::Type type, T*)
+    {
+        std::map<std::string, Metric*>::const_iterator it = this->metricsByName_.find(name);
+        if (it != this->metricsByName_.end())
+        {
+            // a metric with this name already exists - it has to be of the same type
+            if (it->second->getType() == type)
+                return *static_cast<T*>(it->second);
+
+            orxout(internal_error) << "Metric '" << name << "' was registered with different types" << endl;
+        }
+
+        T* metric = new T(name, static_cast<uint16_t>(this->metrics_.size()));
+        this->metrics_.push_back(metric);
+        if (it == this->metricsByName_.end())
+            this->metricsByName_[name] = metric;
+        return *metric;
+    }
+
+    /**
+        @brief Returns the metric with the given name (or NULL if no such metric exists).
+    */
+    Metric* MetricsRegistry::getMetric(const std::string& name) const
+    {
+        std::map<std::string, Metric*>::const_iterator it = this->metricsByName_.find(name);
+        if (it != this->metricsByName_.end())
+            return it->second;
+        else
+            return 0;
+    }
+
+    /**
+        @brief Appends the header of the binary stream to the buffer. It contains a magic number, the version and the byte order.
+    */
+    /*static*/ void MetricsRegistry::writeStreamHeader(std::string& buffer)
+    {
+        buffer.append(STREAM_MAGIC, sizeof(STREAM_MAGIC));
+        append(buffer, STREAM_VERSION);
+        append(buffer, static_cast<uint8_t>(isLittleEndian() ? 1 : 0));
+    }
+
+    /**
+        @brief Appends a definition record for each metric with an ID of at least @a firstID to the buffer.
+    */
+    void MetricsRegistry::writeDefinitions(std::string& buffer, size_t firstID) const
+    {
+        for (size_t i = firstID; i < this->metrics_.size(); ++i)
+        {
+            const Metric* metric = this->metrics_[i];
+
+            std::string data;
+            append(data, metric->getID());
+            append(data, static_cast<uint8_t>(metric->getType()));
+            append(data, static_cast<uint8_t>(std::min<size_t>(metric->getName().size(), 255)));
+            data.append(metric->getName(), 0, 255);
+
+            if (metric->getType() == Metric::Histogram)
+            {
+                const std::vector<double>& bounds = static_cast<const MetricHistogram*>(metric)->getBounds();
+                append(data, static_cast<uint16_t>(bounds.size()));
+                for (size_t j = 0; j < bounds.size(); ++j)
+                    append(data, bounds[j]);
+            }
+
+            appendRecord(buffer, DefinitionRecord, data);
+        }
+    }
+
+    /**
+        @brief Appends a snapshot record with the current values of all metrics to the buffer.
+        @param buffer The buffer
+        @param time The time of the snapshot (seconds since the epoch)
+    */
+    void MetricsRegistry::writeSnapshot(std::string& buffer, double time) const
+    {
+        std::string data;
+        append(data, time);
+        append(data, static_cast<uint16_t>(this->metrics_.size()));
+
+        MetricValue value;
+        for (size_t i = 0; i < this->metrics_.size(); ++i)
+        {
+            const Metric* metric = this->metrics_[i];
+            metric->getValue(value);
+
+            append(data, metric->getID());
+            switch (metric->getType())
+            {
+                case Metric::Counter:
+                    append(data, value.counter);
+                    break;
+                case Metric::Gauge:
+                    append(data, value.gauge);
+                    break;
+                case Metric::Histogram:
+                    append(data, value.count);
+                    append(data, value.sum);
+                    append(data, value.max);
+                    for (size_t j = 0; j < value.buckets.size(); ++j)
+                        append(data, value.buckets[j]);
+                    break;
+            }
+        }
+
+        appendRecord(buffer, SnapshotRecord, data);
+    }
+
+    /**
+        @brief Appends one line per metric with its current value to the buffer.
+        @param buffer The buffer
+        @param instance The name of this instance (e.g. the server name), added as tag to each line
+        @param time The time of the snapshot (seconds since the epoch)
+    */
+    void MetricsRegistry::writeLineProtocol(std::string& buffer, const std::string& instance, double time) const
+    {
+        static const std::vector<double> noBounds;
+
+        MetricValue value;
+        for (size_t i = 0; i < this->metrics_.size(); ++i)
+        {
+            const Metric* metric = this->metrics_[i];
+            metric->getValue(value);
+
+            if (metric->getType() == Metric::Histogram)
+                MetricsRegistry::formatLine(buffer, metric->getName(), metric->getType(), static_cast<const MetricHistogram*>(metric)->getBounds(), value, instance, time);
+            else
+                MetricsRegistry::formatLine(buffer, metric->getName(), metric->getType(), noBounds, value, instance, time);
+        }
+    }
+
+    /**
+        @brief Resets the interval of all metrics, called after each snapshot.
+    */
+    void MetricsRegistry::resetIntervals()
+    {
+        for (size_t i = 0; i < this->metrics_.size(); ++i)
+            this->metrics_[i]->resetInterval();
+    }
+
+    /**
+        @brief Appends one line in the line protocol to the buffer.
+
+        The format is <tt>name,instance=<instance> field=value[,field=value...] <timestamp in nanoseconds></tt>.
+        Integer fields end with 'i'. Histograms contain the fields count, sum, max and one field
+        per bucket named after its upper bound (le_<bound> and le_inf).
+    */
+    /*static*/ void MetricsRegistry::formatLine(std::string& buffer, const std::string& name, Metric::Type type, const std::vector<double>& bounds, const MetricValue& value, const std::string& instance, double time)
+    {
+        std::ostringstream line;
+        line.precision(15);
+
+        line << name;
+        if (!instance.empty())
+            line << ",instance=" << instance;
+        line << ' ';
+
+        switch (type)
+        {
+            case Metric::Counter:
+                line << "value=" << value.counter << 'i';
+                break;
+            case Metric::Gauge:
+                line << "value=" << value.gauge;
+                break;
+            case Metric::Histogram:
+                line << "count=" << value.count << "i,sum=" << value.sum << ",max=" << value.max;
+                for (size_t i = 0; i < value.buckets.size(); ++i)
+                {
+                    if (i < bounds.size())
+                        line << ",le_" << bounds[i] << '=' << value.buckets[i] << 'i';
+                    else
+                        line << ",le_inf=" << value.buckets[i] << 'i';
+                }
+                break;
+        }
+
+        // the timestamp is rounded to microseconds because a double can't represent nanoseconds since the epoch
+        line << ' ' << static_cast<uint64_t>(time * 1e6 + 0.5) * 1000 << '\n';
+        buffer += line.str();
+    }
+
+    // ###############################
+    // ###      MetricsReader      ###
+    // ###############################
+
+    /**
+        @brief Constructor.
+    */
+    MetricsReader::MetricsReader()
+    {
+        this->bSwapBytes_ = false;
+        this->numSnapshots_ = 0;
+    }
+
+    /**
+        @brief Reads and checks the header of the binary stream. Returns false if the stream is not a valid metrics stream.
+    */
+    bool MetricsReader::readStreamHeader(std::istream& stream)
+    {
+        char magic[sizeof(STREAM_MAGIC)];
+        uint8_t version = 0;
+        uint8_t littleEndian = 0;
+
+        stream.read(magic, sizeof(magic));
+        stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+        stream.read(reinterpret_cast<char*>(&littleEndian), sizeof(littleEndian));
+
+        if (!stream.good() || memcmp(magic, STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0)
+        {
+            this->error_ = "Not a metrics stream";
+            return false;
+        }
+        if (version != STREAM_VERSION)
+        {
+            this->error_ = "Unsupported version of the metrics stream";
+            return false;
+        }
+
+        this->bSwapBytes_ = ((littleEndian != 0) != isLittleEndian());
+        return true;
+    }
+
+    /**
+        @brief Reads the next record from the stream. If it's a snapshot, the values are appended to @a lines in the line protocol.
+        @return Returns false at the end of the stream or if an error occurred (see getError()).
+    */
+    bool MetricsReader::readRecord(std::istream& stream, std::string& lines, const std::string& instance)
+    {
+        char type = 0;
+        uint32_t length = 0;
+
+        stream.read(&type, sizeof(type));
+        if (stream.eof())
+            return false;
+
+        std::string lengthData(sizeof(length), '\0');
+        stream.read(&lengthData[0], sizeof(length));
+        size_t pos = 0;
+        if (!stream.good() || !extract(lengthData, pos, length, this->bSwapBytes_))
+        {
+            this->error_ = "Unexpected end of stream";
+            return false;
+        }
+
+        std::string data(length, '\0');
+        if (length > 0)
+            stream.read(&data[0], length);
+        if (static_cast<uint32_t>(stream.gcount()) != length && length > 0)
+        {
+            this->error_ = "Unexpected end of stream";
+            return false;
+        }
+
+        switch (type)
+        {
+            case MetricsRegistry::DefinitionRecord:
+                return this->readDefinition(data);
+            case MetricsRegistry::SnapshotRecord:
+                return this->readSnapshot(data, lines, instance);
+            default:
+                // unknown records are skipped
+                return true;
+        }
+    }
+
+    /**
+        @brief Reads a definition record and stores the definition.
+    */
+    bool MetricsReader::readDefinition(const std::string& data)
+    {
+        size_t pos = 0;
+        uint16_t id;
+        uint8_t type;
+        uint8_t nameLength;
+
+        if (!extract(data, pos, id, this->bSwapBytes_) || !extract(data, pos, type, false) || !extract(data, pos, nameLength, false) || pos + nameLength > data.size())
+        {
+            this->error_ = "Corrupt definition record";
+            return false;
+        }
+
+        Definition& definition = this->definitions_[id];
+        definition.name = data.substr(pos, nameLength);
+        definition.type = static_cast<Metric::Type>(type);
+        definition.bounds.clear();
+        pos += nameLength;
+
+        if (definition.type == Metric::Histogram)
+        {
+            uint16_t numBounds;
+            if (!extract(data, pos, numBounds, this->bSwapBytes_))
+            {
+                this->error_ = "Corrupt definition record";
+                return false;
+            }
+
+            definition.bounds.resize(numBounds);
+            for (size_t i = 0; i < numBounds; ++i)
+            {
+                if (!extract(data, pos, definition.bounds[i], this->bSwapBytes_))
+                {
+                    this->error_ = "Corrupt definition record";
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /**
+        @brief Reads a snapshot record and appends one line per metric to @a lines.
+    */
+    bool MetricsReader::readSnapshot(const std::string& data, std::string& lines, const std::string& instance)
+    {
+        size_t pos = 0;
+        double time;
+        uint16_t count;
+
+        if (!extract(data, pos, time, this->bSwapBytes_) || !extract(data, pos, count, this->bSwapBytes_))
+        {
+            this->error_ = "Corrupt snapshot record";
+            return false;
+        }
+
+        MetricValue value;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint16_t id;
+            if (!extract(data, pos, id, this->bSwapBytes_))
+            {
+                this->error_ = "Corrupt snapshot record";
+                return false;
+            }
+
+            std::map<uint16_t, Definition>::const_iterator it = this->definitions_.find(id);
+            if (it == this->definitions_.end())
+            {
+                this->error_ = "Snapshot contains an undefined metric";
+                return false;
+            }
+
+            const Definition& definition = it->second;
+            bool bSuccess = true;
+            switch (definition.type)
+            {
+                case Metric::Counter:
+                    bSuccess = extract(data, pos, value.counter, this->bSwapBytes_);
+                    break;
+                case Metric::Gauge:
+                    bSuccess = extract(data, pos, value.gauge, this->bSwapBytes_);
+                    break;
+                case Metric::Histogram:
+                    bSuccess = extract(data, pos, value.count, this->bSwapBytes_) && extract(data, pos, value.sum, this->bSwapBytes_) && extract(data, pos, value.max, this->bSwapBytes_);
+                    value.buckets.resize(definition.bounds.size() + 1);
+                    for (size_t j = 0; j < value.buckets.size() && bSuccess; ++j)
+                        bSuccess = extract(data, pos, value.buckets[j], this->bSwapBytes_);
+                    break;
+            }
+
+            if (!bSuccess)
+            {
+                this->error_ = "Corrupt snapshot record";
+                return false;
+            }
+
+            MetricsRegistry::formatLine(lines, definition.name, definition.type, definition.bounds, value, instance, time);
+        }
+
+        ++this->numSnapshots_;
+        return true;
+    }
+}
@@ -0,0 +1,290 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @defgroup Metrics Metrics
+    @ingroup Util
+*/
+
+/**
+    @file
+    @ingroup Metrics
+    @brief Declaration of the metrics registry and the metric types (counters, gauges and histograms).
+
+    Metrics are registered once by name and live until the program ends, hence
+    it is safe to store the returned reference in a static variable:
+
+    @code
+    static MetricCounter& packetsSent = MetricsRegistry::getInstance().registerCounter("network.packets_sent");
+    packetsSent.add();
+
+    static MetricHistogram& tickTime = MetricsRegistry::getInstance().registerHistogram("game.tick_time", MetricHistogram::getDefaultTimeBounds());
+    tickTime.sample(dt);
+    @endcode
+
+    The registry encodes the current state of all metrics either in a compact
+    binary format or in a line based text protocol (one line per metric, similar
+    to the InfluxDB line protocol). The binary stream can be converted to the
+    text protocol with MetricsReader (see also the orxonox-metrics-reader tool).
+
+    The binary stream starts with a header (see MetricsRegistry::writeStreamHeader()),
+    followed by records. Each record starts with a type byte and the length of the
+    record data (uint32). Definition records assign an ID, type, name and (for
+    histograms) the bucket bounds to a metric. Snapshot records contain a timestamp
+    and the current values of all metrics, referenced by their ID. All values are
+    stored in the byte order of the writing machine, which is declared in the header.
+
+    @note Metrics are not thread-safe and should only be updated from the main thread.
+*/
+
+#ifndef _Metrics_H__
+#define _Metrics_H__
+
+#include "UtilPrereqs.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <istream>
+#include <ostream>
+
+namespace orxonox
+{
+    /**
+        @brief Stores the value of a metric at the time of a snapshot. Only the fields belonging to the type of the metric are used.
+    */
+    struct _UtilExport MetricValue
+    {
+        MetricValue() : counter(0), gauge(0), count(0), sum(0), max(0) {}
+
+        uint64_t counter;               //!< The value of a counter
+        double gauge;                   //!< The value of a gauge
+        uint32_t count;                 //!< The number of samples of a histogram
+        double sum;                     //!< The sum of all samples of a histogram
+        double max;                     //!< The largest sample of a histogram
+        std::vector<uint32_t> buckets;  //!< The number of samples per bucket of a histogram (one more bucket than bounds for samples above the largest bound)
+    };
+
+    /**
+        @brief Base class of all metrics. Stores name, type and ID of the metric.
+    */
+    class _UtilExport Metric
+    {
+        public:
+            /// @brief The type of a metric, used in the binary stream.
+            enum Type
+            {
+                Counter     = 0,    //!< A monotonically increasing integer value (e.g. the number of sent packets)
+                Gauge       = 1,    //!< A value which can go up and down (e.g. the number of players)
+                Histogram   = 2     //!< The distribution of samples since the last snapshot (e.g. the duration of ticks)
+            };
+
+            Metric(const std::string& name, Type type, uint16_t id);
+            virtual ~Metric();
+
+            /// @brief Returns the name of the metric.
+            inline const std::string& getName() const
+                { return this->name_; }
+            /// @brief Returns the type of the metric.
+            inline Type getType() const
+                { return this->type_; }
+            /// @brief Returns the ID of the metric which is used in the binary stream.
+            inline uint16_t getID() const
+                { return this->id_; }
+
+            /// @brief Writes the current value of the metric to @a value.
+            virtual void getValue(MetricValue& value) const = 0;
+            /// @brief Called after each snapshot, used by histograms to start a new interval.
+            virtual void resetInterval() {}
+
+        private:
+            Metric(const Metric&);
+
+            std::string name_;  //!< The name of the metric
+            Type type_;         //!< The type of the metric
+            uint16_t id_;       //!< The ID of the metric
+    };
+
+    /**
+        @brief A monotonically increasing integer value.
+    */
+    class _UtilExport MetricCounter : public Metric
+    {
+        public:
+            MetricCounter(const std::string& name, uint16_t id) : Metric(name, Counter, id), value_(0) {}
+
+            /// @brief Increases the counter.
+            inline void add(uint64_t amount = 1)
+                { this->value_ += amount; }
+            /// @brief Returns the value of the counter.
+            inline uint64_t getCounter() const
+                { return this->value_; }
+
+            virtual void getValue(MetricValue& value) const
+                { value.counter = this->value_; }
+
+        private:
+            uint64_t value_;    //!< The value of the counter
+    };
+
+    /**
+        @brief A value which can go up and down.
+    */
+    class _UtilExport MetricGauge : public Metric
+    {
+        public:
+            MetricGauge(const std::string& name, uint16_t id) : Metric(name, Gauge, id), value_(0) {}
+
+            /// @brief Changes the value of the gauge.
+            inline void set(double value)
+                { this->value_ = value; }
+            /// @brief Returns the value of the gauge.
+            inline double getGauge() const
+                { return this->value_; }
+
+            virtual void getValue(MetricValue& value) const
+                { value.gauge = this->value_; }
+
+        private:
+            double value_;      //!< The value of the gauge
+    };
+
+    /**
+        @brief Counts samples in buckets with fixed upper bounds. The histogram is reset after each snapshot.
+    */
+    class _UtilExport MetricHistogram : public Metric
+    {
+        public:
+            MetricHistogram(const std::string& name, uint16_t id, const std::vector<double>& bounds);
+
+            void sample(double value);
+
+            /// @brief Returns the upper bounds of the buckets (in ascending order).
+            inline const std::vector<double>& getBounds() const
+                { return this->bounds_; }
+            /// @brief Returns the number of samples since the last snapshot.
+            inline uint32_t getCount() const
+                { return this->count_; }
+
+            virtual void getValue(MetricValue& value) const;
+            virtual void resetInterval();
+
+            static const std::vector<double>& getDefaultTimeBounds();
+            static const std::vector<double>& getDefaultSizeBounds();
+
+        private:
+            std::vector<double> bounds_;        //!< The upper bounds of the buckets
+            std::vector<uint32_t> buckets_;     //!< The number of samples per bucket
+            uint32_t count_;                    //!< The number of samples
+            double sum_;                        //!< The sum of all samples
+            double max_;                        //!< The largest sample
+    };
+
+    /**
+        @brief The registry of all metrics. Encodes the state of all metrics in the binary stream or in the line protocol.
+    */
+    class _UtilExport MetricsRegistry
+    {
+        public:
+            /// @brief The type of a record in the binary stream.
+            enum RecordType
+            {
+                DefinitionRecord    = 'D',  //!< Defines ID, type, name and bucket bounds of a metric
+                SnapshotRecord      = 'S'   //!< Contains the values of all metrics at a given time
+            };
+
+            MetricsRegistry();
+            ~MetricsRegistry();
+
+            static MetricsRegistry& getInstance();
+
+            MetricCounter& registerCounter(const std::string& name);
+            MetricGauge& registerGauge(const std::string& name);
+            MetricHistogram& registerHistogram(const std::string& name, const std::vector<double>& bounds);
+
+            Metric* getMetric(const std::string& name) const;
+            /// @brief Returns all registered metrics, ordered by their ID.
+            inline const std::vector<Metric*>& getMetrics() const
+                { return this->metrics_; }
+
+            static void writeStreamHeader(std::string& buffer);
+            void writeDefinitions(std::string& buffer, size_t firstID = 0) const;
+            void writeSnapshot(std::string& buffer, double time) const;
+            void writeLineProtocol(std::string& buffer, const std::string& instance, double time) const;
+            void resetIntervals();
+
+            static void formatLine(std::string& buffer, const std::string& name, Metric::Type type, const std::vector<double>& bounds, const MetricValue& value, const std::string& instance, double time);
+
+        private:
+            MetricsRegistry(const MetricsRegistry&);
+
+            template <class T>
+            T& registerMetric(const std::string& name, Metric::Type type, T* metric);
+
+            std::vector<Metric*> metrics_;                  //!< All registered metrics, the index is the ID
+            std::map<std::string, Metric*> metricsByName_;  //!< All registered metrics, ordered by name
+    };
+
+    /**
+        @brief Reads a binary metrics stream written by MetricsRegistry and converts it to the line protocol.
+    */
+    class _UtilExport MetricsReader
+    {
+        public:
+            MetricsReader();
+
+            bool readStreamHeader(std::istream& stream);
+            bool readRecord(std::istream& stream, std::string& lines, const std::string& instance);
+
+            /// @brief Returns the number of snapshots read so far.
+            inline size_t getNumSnapshots() const
+                { return this->numSnapshots_; }
+            /// @brief Returns the error message if reading failed (or an empty string).
+            inline const std::string& getError() const
+                { return this->error_; }
+
+        private:
+            /// @brief Stores the definition of a metric which was read from the stream.
+            struct Definition
+            {
+                std::string name;               //!< The name of the metric
+                Metric::Type type;              //!< The type of the metric
+                std::vector<double> bounds;     //!< The bucket bounds (only used by histograms)
+            };
+
+            bool readDefinition(const std::string& data);
+            bool readSnapshot(const std::string& data, std::string& lines, const std::string& instance);
+
+            std::map<uint16_t, Definition> definitions_;    //!< All definitions read from the stream, mapped by ID
+            bool bSwapBytes_;                               //!< True if the stream was written with a different byte order
+            size_t numSnapshots_;                           //!< The number of snapshots read so far
+            std::string error_;                             //!< The error message if reading failed
+    };
+}
+
+#endif /* _Metrics_H__ */
@@ -58,6 +58,18 @@
     orxout(user_info) << "Orxonox version 1.2.3" << endl;
     orxout(internal_status, context::input) << "Loading joystick" << endl;
     @endcode
+
+    orxout() itself ignores output that isn't accepted by any listener, but
+    the arguments of the << operator are still evaluated. In performance
+    critical code, use the macro orxout_filtered() instead. It checks the
+    combined masks of OutputManager before any argument is evaluated and
+    removes output with levels above ORXONOX_OUTPUT_LEVEL_MAX entirely at
+    compile time (the threshold is defined by the CMake variable of the same
+    name).
+
+    @code
+    orxout_filtered(verbose, context::network) << "Received " << getSize() << " bytes" << endl;
+    @endcode
 */
 
 #ifndef _Output_H__
@@ -65,6 +77,31 @@
 
 #include "UtilPrereqs.h"
 #include "output/OutputStream.h"
+#include "output/OutputManager.h"
+
+#ifndef ORXONOX_OUTPUT_LEVEL_MAX
+    /// Output with a level above this threshold is removed at compile time from orxout_filtered()
+    #define ORXONOX_OUTPUT_LEVEL_MAX orxonox::level::all
+#endif
+
+/**
+    @brief Sends output to orxout(), but evaluates the arguments only if the output is accepted by at least one listener.
+    @param level The level of the output
+    @param context The context of the output (a context function or a container)
+
+    The level is first compared with ORXONOX_OUTPUT_LEVEL_MAX. Since the level
+    is usually a constant, the compiler removes the whole statement if the
+    level is above this threshold. Otherwise the combined level- and context-
+    masks of OutputManager are checked before the message is formatted.
+
+    The macro expands to an if-else statement, hence it can be safely used in
+    the body of an if-statement without braces.
+*/
+#define orxout_filtered(level, context) \
+    if (!(static_cast<int>(level) <= static_cast<int>(ORXONOX_OUTPUT_LEVEL_MAX) && orxonox::acceptsOutput(level, context))) \
+        ; \
+    else \
+        orxonox::orxout(level, context)
 
 namespace orxonox
 {
@@ -99,6 +136,23 @@ namespace orxonox
         return orxout(level, context());
     }
 
+    /**
+        @brief Returns true if at least one output listener accepts output with the given level and context.
+        Used by orxout_filtered() to check the masks before the output is formatted.
+    */
+    inline bool acceptsOutput(OutputLevel level, const OutputContextContainer& context)
+    {
+        return OutputManager::getInstanceAndCreateListeners().acceptsOutput(level, context);
+    }
+
+    /**
+        @brief Shortcut for acceptsOutput() to allow passing contexts directly as functions without using "()".
+    */
+    inline bool acceptsOutput(OutputLevel level, OutputContextFunction context)
+    {
+        return acceptsOutput(level, context());
+    }
+
     // COUT() is deprecated, please use orxout()
     inline __DEPRECATED__(OutputStream& COUT(int level));
 
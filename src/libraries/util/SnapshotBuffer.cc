@@ -0,0 +1,144 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of SnapshotBuffer.
+*/
+
+#include "SnapshotBuffer.h"
+
+#include <algorithm>
+
+namespace orxonox
+{
+    /**
+        @brief Constructor: The buffer stores at most @a capacity snapshots, older snapshots are removed.
+    */
+    SnapshotBuffer::SnapshotBuffer(size_t capacity)
+    {
+        this->capacity_ = (capacity > 2 ? capacity : 2);
+        this->clockOffset_ = 0;
+        this->bHasClockOffset_ = false;
+    }
+
+    /**
+        @brief Adds a snapshot. Snapshots which are older than the newest snapshot are ignored (e.g. if they arrived out of order).
+    */
+    void SnapshotBuffer::add(const Snapshot& snapshot)
+    {
+        if (!this->snapshots_.empty() && snapshot.time <= this->snapshots_.back().time)
+            return;
+
+        this->snapshots_.push_back(snapshot);
+        if (this->snapshots_.size() > this->capacity_)
+            this->snapshots_.pop_front();
+    }
+
+    /**
+        @brief Removes all snapshots (e.g. if the object was teleported). The clock offset is kept.
+    */
+    void SnapshotBuffer::clear()
+    {
+        this->snapshots_.clear();
+    }
+
+    /**
+    @brief
+        Returns the interpolated state at the given (server) time. Returns false if the buffer is empty.
+    @param time The time of the requested state
+    @param maxExtrapolation The maximal time in seconds the state is extrapolated beyond the newest snapshot
+    @param position Returns the position
+    @param orientation Returns the orientation
+    */
+    bool SnapshotBuffer::sample(double time, float maxExtrapolation, Vector3& position, Quaternion& orientation) const
+    {
+        if (this->snapshots_.empty())
+            return false;
+
+        // before the oldest snapshot: use the oldest state
+        const Snapshot& oldest = this->snapshots_.front();
+        if (time <= oldest.time)
+        {
+            position = oldest.position;
+            orientation = oldest.orientation;
+            return true;
+        }
+
+        // after the newest snapshot: extrapolate
+        const Snapshot& newest = this->snapshots_.back();
+        if (time >= newest.time)
+        {
+            const float dt = std::min(static_cast<float>(time - newest.time), maxExtrapolation);
+            position = newest.position + newest.linearVelocity * dt;
+
+            // quaternion derivative, like MobileEntity
+            const float mult = dt * 0.5f;
+            const Quaternion rotation(0.0f, newest.angularVelocity.x * mult, newest.angularVelocity.y * mult, newest.angularVelocity.z * mult);
+            orientation = newest.orientation + rotation * newest.orientation;
+            orientation.normalise();
+            return true;
+        }
+
+        // find the snapshots before and after the time (the buffer is small and the time is usually near the end)
+        size_t index = this->snapshots_.size() - 1;
+        while (this->snapshots_[index - 1].time > time)
+            --index;
+
+        const Snapshot& from = this->snapshots_[index - 1];
+        const Snapshot& to = this->snapshots_[index];
+        const float duration = static_cast<float>(to.time - from.time);
+        const float t = static_cast<float>((time - from.time) / (to.time - from.time));
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+
+        // cubic Hermite spline, the velocities are scaled to the length of the interval
+        position = from.position * (2 * t3 - 3 * t2 + 1) + from.linearVelocity * (duration * (t3 - 2 * t2 + t))
+                 + to.position * (-2 * t3 + 3 * t2) + to.linearVelocity * (duration * (t3 - t2));
+        orientation = Quaternion::Slerp(t, from.orientation, to.orientation, true);
+        return true;
+    }
+
+    /**
+    @brief
+        Updates the estimated offset between the local and the server time with a received snapshot.
+
+        The smallest offset belongs to the snapshot with the lowest latency, hence
+        smaller offsets are taken immediately while larger offsets (e.g. if the
+        latency increased) are approached slowly to ignore the jitter.
+    */
+    void SnapshotBuffer::updateClockOffset(double localTime, double serverTime)
+    {
+        const double offset = localTime - serverTime;
+        if (!this->bHasClockOffset_ || offset < this->clockOffset_)
+            this->clockOffset_ = offset;
+        else
+            this->clockOffset_ += (offset - this->clockOffset_) * 0.01f;
+        this->bHasClockOffset_ = true;
+    }
+}
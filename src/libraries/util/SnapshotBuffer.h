@@ -0,0 +1,107 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @ingroup Util
+    @brief Declaration of SnapshotBuffer, which interpolates the received states of remote objects.
+*/
+
+#ifndef _SnapshotBuffer_H__
+#define _SnapshotBuffer_H__
+
+#include "UtilPrereqs.h"
+
+#include <deque>
+#include "Math.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Stores the last received states (snapshots) of a remote object and returns
+        the state at an arbitrary time between them.
+
+        Positions are interpolated with cubic Hermite splines (using the velocities
+        of the snapshots as tangents), orientations with slerp. After the last
+        snapshot the state is extrapolated with the last velocities for at most
+        the given time, which hides single lost updates.
+
+        Remote objects are usually rendered some time in the past (the
+        interpolation delay), so there's almost always a snapshot on both sides
+        of the rendered time:
+        @code
+        buffer.updateClockOffset(localTime, snapshot.time);
+        buffer.add(snapshot);
+        ...
+        buffer.sample(buffer.getServerTime(localTime) - delay, maxExtrapolation, position, orientation);
+        @endcode
+    */
+    class _UtilExport SnapshotBuffer
+    {
+        public:
+            /// @brief The state of an object at a given time.
+            struct Snapshot
+            {
+                Snapshot() : time(0), position(Vector3::ZERO), linearVelocity(Vector3::ZERO), orientation(Quaternion::IDENTITY), angularVelocity(Vector3::ZERO) {}
+
+                double time;                //!< The time of the snapshot (server time in seconds, double because the server may run for days)
+                Vector3 position;
+                Vector3 linearVelocity;
+                Quaternion orientation;
+                Vector3 angularVelocity;    //!< The angular velocity in world coordinates
+            };
+
+            SnapshotBuffer(size_t capacity = 32);
+
+            void add(const Snapshot& snapshot);
+            void clear();
+
+            bool sample(double time, float maxExtrapolation, Vector3& position, Quaternion& orientation) const;
+
+            /// @brief Returns the number of stored snapshots.
+            inline size_t size() const
+                { return this->snapshots_.size(); }
+            /// @brief Returns the newest snapshot. The buffer must not be empty.
+            inline const Snapshot& getLatest() const
+                { return this->snapshots_.back(); }
+
+            void updateClockOffset(double localTime, double serverTime);
+            /// @brief Converts a local time to the server time (using the estimated offset between the clocks).
+            inline double getServerTime(double localTime) const
+                { return localTime - this->clockOffset_; }
+
+        private:
+            std::deque<Snapshot> snapshots_;    //!< The snapshots, ordered by time
+            size_t capacity_;                   //!< The maximal number of snapshots
+            double clockOffset_;                //!< The estimated difference between the local and the server time (including the latency)
+            bool bHasClockOffset_;              //!< False until the first snapshot was received
+    };
+}
+
+#endif /* _SnapshotBuffer_H__ */
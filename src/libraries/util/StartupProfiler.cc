@@ -0,0 +1,178 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @brief Implementation of StartupProfiler.
+*/
+
+#include "StartupProfiler.h"
+
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "Clock.h"
+#include "Metrics.h"
+#include "Output.h"
+
+namespace orxonox
+{
+    StartupProfiler::StartupProfiler()
+    {
+        this->clock_ = new Clock();
+        this->bPhaseActive_ = false;
+        this->bFinished_ = false;
+        this->totalTime_ = 0;
+    }
+
+    StartupProfiler::~StartupProfiler()
+    {
+        delete this->clock_;
+    }
+
+    /**
+        @brief Returns the profiler of the program startup. The startup time is measured from the first call to this function.
+    */
+    /*static*/ StartupProfiler& StartupProfiler::getInstance()
+    {
+        static StartupProfiler instance;
+        return instance;
+    }
+
+    /**
+        @brief Returns the current time in microseconds since the profiler was created.
+    */
+    uint64_t StartupProfiler::getTime() const
+    {
+        return this->clock_->getRealMicroseconds();
+    }
+
+    /**
+        @brief Ends the current phase and starts a new phase with the given name.
+    */
+    void StartupProfiler::beginPhase(const std::string& name)
+    {
+        this->beginPhase(name, this->getTime());
+    }
+
+    /**
+        @brief Ends the current phase and starts a new phase with the given name at the given time (in microseconds since the profiler was created).
+    */
+    void StartupProfiler::beginPhase(const std::string& name, uint64_t time)
+    {
+        if (this->bFinished_)
+            return;
+
+        this->endPhase(time);
+
+        Phase phase;
+        phase.name = name;
+        phase.begin = time;
+        phase.duration = 0;
+        this->phases_.push_back(phase);
+        this->bPhaseActive_ = true;
+    }
+
+    /**
+        @brief Ends the current phase. The time until the next phase starts is not assigned to any phase.
+    */
+    void StartupProfiler::endPhase()
+    {
+        this->endPhase(this->getTime());
+    }
+
+    /**
+        @brief Ends the current phase at the given time (in microseconds since the profiler was created).
+    */
+    void StartupProfiler::endPhase(uint64_t time)
+    {
+        if (!this->bPhaseActive_)
+            return;
+
+        Phase& phase = this->phases_.back();
+        phase.duration = (time > phase.begin) ? time - phase.begin : 0;
+        this->bPhaseActive_ = false;
+    }
+
+    /**
+        @brief Ends the startup. Writes the trace to the log and publishes the duration of each phase in the MetricsRegistry.
+    */
+    void StartupProfiler::finish()
+    {
+        this->finish(this->getTime());
+    }
+
+    /**
+        @brief Ends the startup at the given time (in microseconds since the profiler was created).
+    */
+    void StartupProfiler::finish(uint64_t time)
+    {
+        if (this->bFinished_)
+            return;
+
+        this->endPhase(time);
+        this->totalTime_ = time;
+        this->bFinished_ = true;
+
+        // phases with the same name (e.g. a module which was loaded twice) are summed up in the metrics
+        std::map<std::string, uint64_t> durations;
+        for (size_t i = 0; i < this->phases_.size(); ++i)
+            durations[this->phases_[i].name] += this->phases_[i].duration;
+        for (std::map<std::string, uint64_t>::const_iterator it = durations.begin(); it != durations.end(); ++it)
+            MetricsRegistry::getInstance().registerGauge("startup." + it->first).set(it->second / 1000000.0);
+        MetricsRegistry::getInstance().registerGauge("startup.total").set(this->totalTime_ / 1000000.0);
+
+        std::istringstream trace(this->getTrace());
+        std::string line;
+        while (std::getline(trace, line))
+            orxout(internal_info) << line << endl;
+        orxout(user_info) << "Startup took " << (this->totalTime_ / 1000) << " ms" << endl;
+    }
+
+    /**
+        @brief Returns a human readable table with the duration of all phases, one phase per line.
+    */
+    std::string StartupProfiler::getTrace() const
+    {
+        uint64_t total = this->bFinished_ ? this->totalTime_ : this->getTime();
+
+        std::ostringstream trace;
+        trace << std::fixed << std::setprecision(1);
+        trace << "Startup trace (total " << (total / 1000.0) << " ms):" << std::endl;
+        for (size_t i = 0; i < this->phases_.size(); ++i)
+        {
+            const Phase& phase = this->phases_[i];
+            trace << "  " << std::left << std::setw(24) << phase.name << std::right
+                  << " at " << std::setw(8) << (phase.begin / 1000.0) << " ms"
+                  << " took " << std::setw(8) << (phase.duration / 1000.0) << " ms"
+                  << " (" << std::setw(5) << (total > 0 ? 100.0 * phase.duration / total : 0.0) << "%)" << std::endl;
+        }
+        return trace.str();
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file
+    @ingroup Util
+    @brief Declaration of StartupProfiler, which measures the duration of the phases of the program startup.
+
+    The startup is divided into consecutive phases. Each call to StartupProfiler::beginPhase()
+    ends the current phase and starts a new one:
+
+    @code
+    StartupProfiler::getInstance().beginPhase("modules");
+    // load modules
+    StartupProfiler::getInstance().beginPhase("config");
+    // read config files
+    StartupProfiler::getInstance().finish();
+    @endcode
+
+    finish() ends the last phase, writes the trace to the log and publishes the
+    duration of each phase as gauge "startup.<phase>" (in seconds) in the MetricsRegistry.
+    Phases which are started after finish() was called are ignored.
+*/
+
+#ifndef _StartupProfiler_H__
+#define _StartupProfiler_H__
+
+#include "UtilPrereqs.h"
+
+#include <string>
+#include <vector>
+
+namespace orxonox
+{
+    /**
+        @brief Measures the duration of the phases of the program startup.
+    */
+    class _UtilExport StartupProfiler
+    {
+        public:
+            /// @brief A phase of the startup.
+            struct Phase
+            {
+                std::string name;   //!< The name of the phase
+                uint64_t begin;     //!< The time when the phase started (in microseconds since the profiler was created)
+                uint64_t duration;  //!< The duration of the phase in microseconds
+            };
+
+            StartupProfiler();
+            ~StartupProfiler();
+
+            static StartupProfiler& getInstance();
+
+            void beginPhase(const std::string& name);
+            void beginPhase(const std::string& name, uint64_t time);
+            void endPhase();
+            void endPhase(uint64_t time);
+            void finish();
+            void finish(uint64_t time);
+
+            /// @brief Returns true if finish() was called.
+            inline bool isFinished() const
+                { return this->bFinished_; }
+            /// @brief Returns all phases in the order they were started.
+            inline const std::vector<Phase>& getPhases() const
+                { return this->phases_; }
+            /// @brief Returns the time between the creation of the profiler and the call to finish() in microseconds.
+            inline uint64_t getTotalTime() const
+                { return this->totalTime_; }
+
+            std::string getTrace() const;
+
+        private:
+            StartupProfiler(const StartupProfiler&);
+
+            uint64_t getTime() const;
+
+            Clock* clock_;                  //!< The clock used to measure the time
+            std::vector<Phase> phases_;     //!< All phases in the order they were started
+            bool bPhaseActive_;             //!< True if the last phase in phases_ is still running
+            bool bFinished_;                //!< True if finish() was called
+            uint64_t totalTime_;            //!< The total duration of the startup in microseconds
+    };
+}
+
+#endif /* _StartupProfiler_H__ */
@@ -91,6 +91,13 @@ namespace orxonox
     class ExprParser;
     class LogWriter;
     class MemoryWriter;
+    class Metric;
+    class MetricCounter;
+    class MetricGauge;
+    class MetricHistogram;
+    class MetricsReader;
+    class MetricsRegistry;
+    struct MetricValue;
     class MultiType;
     class OutputListener;
     class OutputManager;
@@ -103,12 +110,21 @@ namespace orxonox
     template <class T>
     class SharedPtr;
     class SignalHandler;
+    class SnapshotBuffer;
     template <class T>
     class Singleton;
+    class StartupProfiler;
     class SubcontextOutputListener;
     class SubString;
 }
 
+namespace boost
+{
+    class condition_variable;
+    class mutex;
+    class thread;
+}
+
 namespace Ogre
 {
     class Radian;
@@ -35,6 +35,9 @@
 
 #include <ctime>
 #include <cstdlib>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 #include "OutputManager.h"
 #include "MemoryWriter.h"
@@ -43,6 +46,7 @@
 namespace orxonox
 {
     static const int MAX_ARCHIVED_FILES = 9;
+    static const size_t DEFAULT_QUEUE_CAPACITY = 4096;
 
     /**
         @brief Constructor, initializes the desired output levels and the name and path of the log-file, and opens the log-file.
@@ -50,12 +54,30 @@ namespace orxonox
         By default, LogWriter receives all output up to level::internal_info.
         The log-file has a default name which usually doesn't change. The path
         is initialized with a temporary directory, depending on the system,
-        and can be changed later.
+        and can be changed later. The LogWriter starts in synchronous mode,
+        the writer thread is only created if setAsynchronous() is called.
     */
     LogWriter::LogWriter() : BaseWriter("Log")
     {
         this->setLevelMax(level::internal_info);
 
+        this->queueBegin_ = 0;
+        this->queueSize_ = 0;
+        this->overflowPolicy_ = DropLines;
+        this->numDroppedLines_ = 0;
+        this->numUnreportedDroppedLines_ = 0;
+        this->bWriterBusy_ = false;
+        this->bStopWriterThread_ = false;
+        this->writerThread_ = 0;
+        this->queueMutex_ = new boost::mutex();
+        this->fileMutex_ = new boost::mutex();
+        this->queueChanged_ = new boost::condition_variable();
+        this->queue_.resize(DEFAULT_QUEUE_CAPACITY);
+
+        this->configurableAsynchronous_ = false;
+        this->configurableQueueCapacity_ = DEFAULT_QUEUE_CAPACITY;
+        this->configurableBlockIfQueueFull_ = false;
+
         this->filename_ = "orxonox.log";
 
         // get the path for a temporary file, depending on the system
@@ -77,6 +99,11 @@ namespace orxonox
     LogWriter::~LogWriter()
     {
         this->closeFile();
+        this->stopWriterThread();
+
+        delete this->queueChanged_;
+        delete this->fileMutex_;
+        delete this->queueMutex_;
     }
 
     /**
@@ -84,11 +111,15 @@ namespace orxonox
     */
     void LogWriter::openFile()
     {
-        // archive the old log file
-        this->archive();
+        {
+            boost::mutex::scoped_lock lock(*this->fileMutex_);
 
-        // open the file
-        this->file_.open(this->getPath().c_str(), std::fstream::out);
+            // archive the old log file
+            this->archive();
+
+            // open the file
+            this->file_.open(this->getPath().c_str(), std::fstream::out);
+        }
 
         // check if it worked and print some output
         if (this->file_.is_open())
@@ -105,6 +136,11 @@ namespace orxonox
         if (this->file_.is_open())
         {
             this->printLine("Log file closed", level::none);
+
+            // make sure all queued lines are written before the file is closed
+            this->flush();
+
+            boost::mutex::scoped_lock lock(*this->fileMutex_);
             this->file_.close();
         }
     }
@@ -173,6 +209,8 @@ namespace orxonox
 
     /**
         @brief Inherited function from BaseWriter, writers output together with a timestamp to the log-file.
+
+        In asynchronous mode the line is only added to the queue and written later by the writer thread.
     */
     void LogWriter::printLine(const std::string& line, OutputLevel)
     {
@@ -181,13 +219,226 @@ namespace orxonox
 
         // get the current time
         time_t rawtime;
-        struct tm* timeinfo;
         time(&rawtime);
-        timeinfo = localtime(&rawtime);
+
+        if (!this->writerThread_)
+        {
+            this->writeLine(rawtime, line);
+            this->file_.flush();
+            return;
+        }
+
+        boost::mutex::scoped_lock lock(*this->queueMutex_);
+
+        if (this->queueSize_ == this->queue_.size())
+        {
+            if (this->overflowPolicy_ == DropLines)
+            {
+                ++this->numDroppedLines_;
+                ++this->numUnreportedDroppedLines_;
+                return;
+            }
+
+            // wait until the writer thread made room in the queue
+            while (this->queueSize_ == this->queue_.size())
+                this->queueChanged_->wait(lock);
+        }
+
+        // assign the line to the next free slot in the ring buffer (re-uses the memory of the old string)
+        QueuedLine& slot = this->queue_[(this->queueBegin_ + this->queueSize_) % this->queue_.size()];
+        slot.time = rawtime;
+        slot.text = line;
+        ++this->queueSize_;
+
+        this->queueChanged_->notify_all();
+    }
+
+    /**
+        @brief Formats a line together with its timestamp and writes it to the log-file (without flushing the file).
+    */
+    void LogWriter::writeLine(time_t time, const std::string& line)
+    {
+        struct tm* timeinfo = localtime(&time);
 
         // print timestamp and output line to the log file
         this->file_ << (timeinfo->tm_hour < 10 ? "0" : "") << timeinfo->tm_hour << ':' <<
                        (timeinfo->tm_min  < 10 ? "0" : "") << timeinfo->tm_min  << ':' <<
-                       (timeinfo->tm_sec  < 10 ? "0" : "") << timeinfo->tm_sec  << ' ' << line << std::endl;
+                       (timeinfo->tm_sec  < 10 ? "0" : "") << timeinfo->tm_sec  << ' ' << line << '\n';
+    }
+
+    /**
+        @brief Enables or disables asynchronous mode. In asynchronous mode, a separate thread writes the output to the log-file.
+    */
+    void LogWriter::setAsynchronous(bool bAsynchronous)
+    {
+        this->configurableAsynchronous_ = bAsynchronous;
+
+        if (bAsynchronous)
+            this->startWriterThread();
+        else
+            this->stopWriterThread();
+    }
+
+    /**
+        @brief Changes the maximum number of queued lines in asynchronous mode. Waits until the queue is empty before it's resized.
+    */
+    void LogWriter::setQueueCapacity(size_t capacity)
+    {
+        if (capacity == 0)
+            capacity = 1;
+
+        this->configurableQueueCapacity_ = static_cast<unsigned int>(capacity);
+
+        boost::mutex::scoped_lock lock(*this->queueMutex_);
+
+        // wait until the writer thread wrote all queued lines
+        while (this->queueSize_ > 0 || this->bWriterBusy_)
+            this->queueChanged_->wait(lock);
+
+        this->queue_.clear();
+        this->queue_.resize(capacity);
+        this->queueBegin_ = 0;
+        this->queueSize_ = 0;
+    }
+
+    /**
+        @brief Blocks until all queued lines are written to the log-file. Does nothing in synchronous mode.
+    */
+    void LogWriter::flush()
+    {
+        if (!this->writerThread_)
+            return;
+
+        boost::mutex::scoped_lock lock(*this->queueMutex_);
+        while (this->queueSize_ > 0 || this->bWriterBusy_)
+            this->queueChanged_->wait(lock);
+    }
+
+    /**
+        @brief Creates the writer thread (if it doesn't exist already).
+    */
+    void LogWriter::startWriterThread()
+    {
+        if (this->writerThread_)
+            return;
+
+        this->bStopWriterThread_ = false;
+        this->writerThread_ = new boost::thread(&LogWriter::writerThread, this);
+    }
+
+    /**
+        @brief Writes all remaining lines to the log-file, terminates the writer thread and waits until it's finished.
+    */
+    void LogWriter::stopWriterThread()
+    {
+        if (!this->writerThread_)
+            return;
+
+        {
+            boost::mutex::scoped_lock lock(*this->queueMutex_);
+            this->bStopWriterThread_ = true;
+            this->queueChanged_->notify_all();
+        }
+
+        this->writerThread_->join();
+        delete this->writerThread_;
+        this->writerThread_ = 0;
+
+        // write lines which were queued while the thread was terminating
+        boost::mutex::scoped_lock lock(*this->queueMutex_);
+        for (; this->queueSize_ > 0; --this->queueSize_)
+        {
+            const QueuedLine& slot = this->queue_[this->queueBegin_];
+            if (this->file_.is_open())
+                this->writeLine(slot.time, slot.text);
+            this->queueBegin_ = (this->queueBegin_ + 1) % this->queue_.size();
+        }
+        this->file_.flush();
+    }
+
+    /**
+        @brief The main function of the writer thread. Takes all queued lines in one batch, writes them to the log-file, and flushes the file once per batch.
+    */
+    void LogWriter::writerThread()
+    {
+        std::vector<QueuedLine> batch;
+
+        while (true)
+        {
+            size_t numDroppedLines = 0;
+
+            {
+                boost::mutex::scoped_lock lock(*this->queueMutex_);
+
+                while (this->queueSize_ == 0 && this->numUnreportedDroppedLines_ == 0 && !this->bStopWriterThread_)
+                    this->queueChanged_->wait(lock);
+
+                if (this->queueSize_ == 0 && this->numUnreportedDroppedLines_ == 0 && this->bStopWriterThread_)
+                    break;
+
+                // move all queued lines into the batch (swapping the strings avoids copies and keeps the memory of the slots)
+                batch.resize(this->queueSize_);
+                for (size_t i = 0; i < this->queueSize_; ++i)
+                {
+                    QueuedLine& slot = this->queue_[(this->queueBegin_ + i) % this->queue_.size()];
+                    batch[i].time = slot.time;
+                    batch[i].text.swap(slot.text);
+                }
+                this->queueBegin_ = (this->queueBegin_ + this->queueSize_) % this->queue_.size();
+                this->queueSize_ = 0;
+
+                numDroppedLines = this->numUnreportedDroppedLines_;
+                this->numUnreportedDroppedLines_ = 0;
+
+                this->bWriterBusy_ = true;
+                this->queueChanged_->notify_all();
+            }
+
+            {
+                boost::mutex::scoped_lock lock(*this->fileMutex_);
+
+                if (this->file_.is_open())
+                {
+                    for (size_t i = 0; i < batch.size(); ++i)
+                        this->writeLine(batch[i].time, batch[i].text);
+
+                    if (numDroppedLines > 0)
+                        this->writeLine(time(0), OutputManager::getInstance().getLevelName(level::internal_warning) + ": " + multi_cast<std::string>(numDroppedLines) + " lines of output were dropped because the log queue was full");
+
+                    this->file_.flush();
+                }
+            }
+
+            {
+                boost::mutex::scoped_lock lock(*this->queueMutex_);
+                this->bWriterBusy_ = false;
+                this->queueChanged_->notify_all();
+            }
+        }
+    }
+
+    /**
+        @brief Called if the config value has changed, starts or stops the writer thread.
+    */
+    void LogWriter::changedConfigurableAsynchronous()
+    {
+        this->setAsynchronous(this->configurableAsynchronous_);
+    }
+
+    /**
+        @brief Called if the config value has changed, resizes the queue.
+    */
+    void LogWriter::changedConfigurableQueueCapacity()
+    {
+        if (this->configurableQueueCapacity_ != this->queue_.size())
+            this->setQueueCapacity(this->configurableQueueCapacity_);
+    }
+
+    /**
+        @brief Called if the config value has changed, updates the overflow policy.
+    */
+    void LogWriter::changedConfigurableBlockIfQueueFull()
+    {
+        this->setOverflowPolicy(this->configurableBlockIfQueueFull_ ? BlockCaller : DropLines);
     }
 }
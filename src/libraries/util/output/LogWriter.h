@@ -37,7 +37,9 @@
 
 #include "util/UtilPrereqs.h"
 
+#include <ctime>
 #include <fstream>
+#include <vector>
 
 #include "BaseWriter.h"
 
@@ -51,10 +53,25 @@ namespace orxonox
         possibility to change the desired output levels before changing the
         path in order to get the complete output with the new output levels
         at the new path.
+
+        LogWriter can optionally run asynchronously. In this mode printLine()
+        only stores the line together with its timestamp in a bounded ring
+        buffer and returns immediately. A separate writer thread takes all
+        queued lines in one batch, formats them and flushes the file once per
+        batch. If the ring buffer is full, new lines are either dropped (and
+        counted) or the calling thread blocks until the writer thread made
+        room, depending on the overflow policy.
     */
     class _UtilExport LogWriter : public BaseWriter
     {
         public:
+            /// @brief Defines what happens to new output in asynchronous mode if the queue is full.
+            enum OverflowPolicy
+            {
+                DropLines,  ///< The new line is dropped, the number of dropped lines is written to the log-file later
+                BlockCaller ///< The calling thread waits until the writer thread made room in the queue
+            };
+
             LogWriter();
             LogWriter(const LogWriter&);
             virtual ~LogWriter();
@@ -68,19 +85,90 @@ namespace orxonox
             inline const std::ofstream& getFile() const
                 { return this->file_; }
 
+            void setAsynchronous(bool bAsynchronous);
+            /** @brief Returns true if output is written to the log-file by a separate thread. */
+            inline bool isAsynchronous() const
+                { return (this->writerThread_ != 0); }
+
+            void setQueueCapacity(size_t capacity);
+            /** @brief Returns the maximum number of lines which can be queued in asynchronous mode. */
+            inline size_t getQueueCapacity() const
+                { return this->queue_.size(); }
+
+            /** @brief Defines what happens to new output in asynchronous mode if the queue is full. */
+            inline void setOverflowPolicy(OverflowPolicy policy)
+                { this->overflowPolicy_ = policy; }
+            /** @brief Returns the current overflow policy. */
+            inline OverflowPolicy getOverflowPolicy() const
+                { return this->overflowPolicy_; }
+
+            /** @brief Returns the number of lines which were dropped because the queue was full. */
+            inline size_t getNumDroppedLines() const
+                { return this->numDroppedLines_; }
+
+            void flush();
+
+            /// Config value, used to define if output is written by a separate thread
+            bool configurableAsynchronous_;
+            /// @brief Returns the name of the config value which defines if output is written by a separate thread.
+            inline std::string getConfigurableAsynchronousName() const
+                { return this->getName() + "Asynchronous"; }
+
+            /// Config value, used to define the maximum number of queued lines in asynchronous mode
+            unsigned int configurableQueueCapacity_;
+            /// @brief Returns the name of the config value which defines the maximum number of queued lines in asynchronous mode.
+            inline std::string getConfigurableQueueCapacityName() const
+                { return this->getName() + "QueueCapacity"; }
+
+            /// Config value, used to define if the calling thread blocks if the queue is full (otherwise new output is dropped)
+            bool configurableBlockIfQueueFull_;
+            /// @brief Returns the name of the config value which defines if the calling thread blocks if the queue is full.
+            inline std::string getConfigurableBlockIfQueueFullName() const
+                { return this->getName() + "BlockIfQueueFull"; }
+
+            void changedConfigurableAsynchronous();
+            void changedConfigurableQueueCapacity();
+            void changedConfigurableBlockIfQueueFull();
+
         protected:
             virtual void printLine(const std::string& line, OutputLevel level);
 
         private:
+            /// @brief A line of output which waits in the queue until it's written by the writer thread.
+            struct QueuedLine
+            {
+                time_t time;        ///< The time when the line was printed
+                std::string text;   ///< The text of the line (including the prefix)
+            };
+
             void openFile();
             void closeFile();
 
             void archive(int index = 0);
             std::string getArchivedPath(int index) const;
 
+            void writeLine(time_t time, const std::string& line);
+            void writerThread();
+            void startWriterThread();
+            void stopWriterThread();
+
             std::string filename_;  ///< The name of the log-file (without directory)
             std::string directory_; ///< The directory where the log-file resided (without file-name)
             std::ofstream file_;    ///< The output file stream.
+
+            std::vector<QueuedLine> queue_;                 ///< The ring buffer which stores the lines in asynchronous mode
+            size_t queueBegin_;                             ///< The index of the oldest queued line in the ring buffer
+            size_t queueSize_;                              ///< The number of queued lines in the ring buffer
+            OverflowPolicy overflowPolicy_;                 ///< Defines what happens if the queue is full
+            size_t numDroppedLines_;                        ///< The total number of dropped lines
+            size_t numUnreportedDroppedLines_;              ///< The number of dropped lines which weren't yet reported in the log-file
+            bool bWriterBusy_;                              ///< True while the writer thread writes a batch of lines
+            bool bStopWriterThread_;                        ///< Set to true to terminate the writer thread
+
+            boost::thread* writerThread_;                   ///< The writer thread (or NULL if the LogWriter runs synchronously)
+            boost::mutex* queueMutex_;                      ///< Protects the ring buffer and the related counters
+            boost::mutex* fileMutex_;                       ///< Protects the file stream while the writer thread writes a batch
+            boost::condition_variable* queueChanged_;       ///< Notified if lines were added to or removed from the queue
     };
 }
 
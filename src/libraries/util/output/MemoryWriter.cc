@@ -33,6 +33,7 @@
 
 #include "MemoryWriter.h"
 #include "OutputManager.h"
+#include "util/Convert.h"
 
 namespace orxonox
 {
@@ -42,6 +43,10 @@ namespace orxonox
     MemoryWriter::MemoryWriter()
     {
         this->setLevelMask(level::all);
+
+        this->maxMessages_ = 0;
+        this->numDiscardedMessages_ = 0;
+        this->configurableMaxMessages_ = 0;
     }
 
     /**
@@ -57,6 +62,12 @@ namespace orxonox
     void MemoryWriter::output(OutputLevel level, const OutputContextContainer& context, const std::vector<std::string>& lines)
     {
         this->messages_.push_back(Message(level, context, lines));
+
+        if (this->maxMessages_ > 0 && this->messages_.size() > this->maxMessages_)
+        {
+            this->messages_.pop_front();
+            ++this->numDiscardedMessages_;
+        }
     }
 
     /**
@@ -64,6 +75,9 @@ namespace orxonox
     */
     void MemoryWriter::resendOutput(OutputListener* listener) const
     {
+        if (this->numDiscardedMessages_ > 0)
+            listener->unfilteredOutput(level::internal_warning, context::undefined(), std::vector<std::string>(1, multi_cast<std::string>(this->numDiscardedMessages_) + " older messages were discarded by MemoryWriter"));
+
         for (size_t i = 0; i < this->messages_.size(); ++i)
         {
             const Message& message = this->messages_[i];
@@ -79,4 +93,28 @@ namespace orxonox
         OutputManager::getInstance().unregisterListener(this);
         this->output(level::debug_output, context::undefined(), std::vector<std::string>(1, "MemoryWriter disabled, further messages may be lost"));
     }
+
+    /**
+        @brief Limits the number of stored messages. If the limit is reached, the oldest messages are discarded.
+        @param maxMessages The maximum number of stored messages (0 means no limit)
+    */
+    void MemoryWriter::setMaxMessages(size_t maxMessages)
+    {
+        this->maxMessages_ = maxMessages;
+        this->configurableMaxMessages_ = static_cast<unsigned int>(maxMessages);
+
+        while (this->maxMessages_ > 0 && this->messages_.size() > this->maxMessages_)
+        {
+            this->messages_.pop_front();
+            ++this->numDiscardedMessages_;
+        }
+    }
+
+    /**
+        @brief Called if the config value has changed, applies the new limit.
+    */
+    void MemoryWriter::changedConfigurableMaxMessages()
+    {
+        this->setMaxMessages(this->configurableMaxMessages_);
+    }
 }
@@ -36,6 +36,9 @@
 #define _MemoryWriter_H__
 
 #include "util/UtilPrereqs.h"
+
+#include <deque>
+
 #include "OutputListener.h"
 
 namespace orxonox
@@ -50,6 +53,10 @@ namespace orxonox
         Since MemoryWriter receives output of all levels, this means also that
         all possible output needs to be generated as long as MemoryWriter stays
         active. Hence disable() should be called as soon as possible.
+
+        The number of stored messages can be limited with setMaxMessages(). If
+        the limit is reached, the oldest messages are discarded. This is useful
+        for dedicated servers where MemoryWriter is never disabled.
     */
     class _UtilExport MemoryWriter : public OutputListener
     {
@@ -73,11 +80,31 @@ namespace orxonox
             void resendOutput(OutputListener* listener) const;
             void disable();
 
+            void setMaxMessages(size_t maxMessages);
+            /// @brief Returns the maximum number of stored messages (0 means no limit).
+            inline size_t getMaxMessages() const
+                { return this->maxMessages_; }
+            /// @brief Returns the number of currently stored messages.
+            inline size_t getNumMessages() const
+                { return this->messages_.size(); }
+            /// @brief Returns the number of old messages which were discarded because the limit was reached.
+            inline size_t getNumDiscardedMessages() const
+                { return this->numDiscardedMessages_; }
+
+            /// Config value, used to define the maximum number of stored messages
+            unsigned int configurableMaxMessages_;
+            /// @brief Returns the name of the config value which defines the maximum number of stored messages.
+            static inline std::string getConfigurableMaxMessagesName()
+                { return "MemoryWriterMaxMessages"; }
+            void changedConfigurableMaxMessages();
+
         protected:
             virtual void output(OutputLevel level, const OutputContextContainer& context, const std::vector<std::string>& lines);
 
         private:
-            std::vector<Message> messages_; ///< Stores all output messages from the creation of this instance until disable() is called.
+            std::deque<Message> messages_;  ///< Stores all output messages from the creation of this instance until disable() is called (or the newest maxMessages_ messages if a limit is defined).
+            size_t maxMessages_;            ///< The maximum number of stored messages (0 means no limit)
+            size_t numDiscardedMessages_;   ///< The number of old messages which were discarded because the limit was reached
     };
 }
 
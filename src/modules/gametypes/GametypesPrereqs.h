@@ -64,11 +64,13 @@
 
 namespace orxonox
 {
+    class RaceCheckPoint;
     class SpaceRace;
     class OldSpaceRace;
     class SpaceRaceManager;
     class SpaceRaceBot;
     class SpaceRaceController;
+    class SpaceRaceNavigation;
 }
 
 #endif /* _GametypesPrereqs_H__ */
@@ -38,6 +38,7 @@
 #include "core/CoreIncludes.h"
 #include "core/XMLPort.h"
 #include "gametypes/SpaceRaceManager.h"
+#include "gametypes/SpaceRaceNavigation.h"
 #include "collisionshapes/CollisionShape.h"
 #include "BulletCollision/CollisionShapes/btCollisionShape.h"
 
@@ -48,6 +49,7 @@ namespace orxonox
 
     const int ADJUSTDISTANCE = 500;
     const int MINDISTANCE = 5;
+    const int WAYPOINTDISTANCE = 200;
     /*
      * Idea: Find static Point (checkpoints the spaceship has to reach)
      */
@@ -55,19 +57,20 @@ namespace orxonox
         ArtificialController(context)
     {
         RegisterObject(SpaceRaceController);
-        std::vector<RaceCheckPoint*> checkpoints;
 
         virtualCheckPointIndex = -2;
+        nextRaceCheckpoint_ = NULL;
         if (ObjectList<SpaceRaceManager>::size() != 1)
             orxout(internal_warning) << "Expected 1 instance of SpaceRaceManager but found " << ObjectList<SpaceRaceManager>::size() << endl;
         for (ObjectList<SpaceRaceManager>::iterator it = ObjectList<SpaceRaceManager>::begin(); it != ObjectList<SpaceRaceManager>::end(); ++it)
         {
-            checkpoints = it->getAllCheckpoints();
+            // the navigation graph (with static checkpoints, distances and waypoints) is computed once and shared by all bots
+            navigation_ = it->getNavigation();
             nextRaceCheckpoint_ = it->findCheckpoint(0);
         }
 
-        OrxAssert(!checkpoints.empty(), "No Checkpoints in Level");
-        checkpoints_ = checkpoints;
+        if (!navigation_ || navigation_->getNumCheckpoints() == 0)
+            orxout(internal_warning) << "No Checkpoints in Level, SpaceRaceController will stay idle" << endl;
         /*orxout()<<"es gibt: "<<checkpoints_.size()<<"checkpoints"<<endl;
         for(std::vector<RaceCheckPoint*>::iterator it=checkpoints_.begin(); it!=checkpoints_.end(); it++)
         {
@@ -123,9 +126,9 @@ namespace orxonox
 
         }//ausgabe
         orxout()<<"es gibt: "<<checkpoints_.size()<<"checkpoints"<<endl;*/
-        staticRacePoints_ = findStaticCheckpoints(nextRaceCheckpoint_, checkpoints);
         // initialisation of currentRaceCheckpoint_
         currentRaceCheckpoint_ = NULL;
+        bWaypointReached_ = false;
 
         int i;
         for (i = -2; findCheckpoint(i) != NULL; i--)
@@ -146,63 +149,6 @@ namespace orxonox
         XMLPortObject(ArtificialController, WorldEntity, "waypoints", addWaypoint, getWaypoint, xmlelement, mode);
     }
 
-    /*
-     * called from constructor 'SpaceRaceController'
-     * returns a vector of static Point (checkpoints the spaceship has to reach)
-     */
-    std::vector<RaceCheckPoint*> SpaceRaceController::findStaticCheckpoints(RaceCheckPoint* currentCheckpoint, const std::vector<RaceCheckPoint*>& allCheckpoints)
-    {
-        std::map<RaceCheckPoint*, int> zaehler; // counts how many times the checkpoint was reached (for simulation)
-        for (unsigned int i = 0; i < allCheckpoints.size(); i++)
-        {
-            zaehler.insert(std::pair<RaceCheckPoint*, int>(allCheckpoints[i],0));
-        }
-        int maxWays = rekSimulationCheckpointsReached(currentCheckpoint, zaehler);
-
-        std::vector<RaceCheckPoint*> returnVec;
-        for (std::map<RaceCheckPoint*, int>::iterator iter = zaehler.begin(); iter != zaehler.end(); iter++)
-        {
-            if (iter->second == maxWays)
-            {
-                returnVec.push_back(iter->first);
-            }
-        }
-        return returnVec;
-    }
-
-    /*
-     * called from 'findStaticCheckpoints'
-     * return how many ways go from the given Checkpoint to the last Checkpoint (of the Game)
-     */
-    int SpaceRaceController::rekSimulationCheckpointsReached(RaceCheckPoint* currentCheckpoint, std::map<RaceCheckPoint*, int>& zaehler)
-    {
-
-        if (currentCheckpoint->isLast())
-        {// last point reached
-
-            zaehler[currentCheckpoint] += 1;
-            return 1; // 1 Way form the last point to this one
-        }
-        else
-        {
-            int numberOfWays = 0; // counts number of ways from this Point to the last point
-            for (std::set<int>::iterator it = currentCheckpoint->getNextCheckpoints().begin(); it!= currentCheckpoint->getNextCheckpoints().end(); ++it)
-            {
-                if (currentCheckpoint == findCheckpoint(*it))
-                {
-                    //orxout() << currentCheckpoint->getCheckpointIndex()<<endl;
-                    continue;
-                }
-                if (findCheckpoint(*it) == NULL)
-                    orxout(internal_warning) << "Problematic Point: " << (*it) << endl;
-                else
-                    numberOfWays += rekSimulationCheckpointsReached(findCheckpoint(*it), zaehler);
-            }
-            zaehler[currentCheckpoint] += numberOfWays;
-            return numberOfWays; // returns the number of ways from this point to the last one
-        }
-    }
-
     //-------------------------------------
     // functions for dynamic Way-search
 
@@ -224,11 +170,18 @@ namespace orxonox
         float minDistance = 0;
         RaceCheckPoint* minNextRaceCheckPoint = NULL;
 
-        // find the next checkpoint with the minimal distance
+        // find the next checkpoint with the minimal distance to the next static checkpoint (precomputed in the navigation graph)
         for (std::set<int>::iterator it = raceCheckpoint->getNextCheckpoints().begin(); it != raceCheckpoint->getNextCheckpoints().end(); ++it)
         {
             RaceCheckPoint* nextRaceCheckPoint = findCheckpoint(*it);
-            float distance = recCalculateDistance(nextRaceCheckPoint, this->getControllableEntity()->getPosition());
+            if (nextRaceCheckPoint == NULL)
+                continue;
+
+            float distance;
+            if (this->navigation_)
+                distance = this->navigation_->getDistanceToStaticCheckpoint(nextRaceCheckPoint, this->getControllableEntity()->getPosition());
+            else
+                distance = (nextRaceCheckPoint->getPosition() - this->getControllableEntity()->getPosition()).length();
 
             if (distance < minDistance || minNextRaceCheckPoint == NULL)
             {
@@ -241,28 +194,14 @@ namespace orxonox
     }
 
     /*
-     * called from 'nextPointFind'
-     * returns the distance between "currentPosition" and the next static checkpoint that can be reached from "currentCheckPoint"
+     * called whenever the bot chooses a new checkpoint
+     * resets the waypoint which avoids obstacles on the way to the checkpoint
      */
-    float SpaceRaceController::recCalculateDistance(RaceCheckPoint* currentCheckPoint, const Vector3& currentPosition)
+    void SpaceRaceController::setNextRaceCheckpoint(RaceCheckPoint* checkpoint)
     {
-        // find: looks if the currentCheckPoint is a staticCheckPoint (staticCheckPoint is the same as: static Point)
-        if (std::find(staticRacePoints_.begin(), staticRacePoints_.end(), currentCheckPoint) != staticRacePoints_.end())
-        {
-            return (currentCheckPoint->getPosition() - currentPosition).length();
-        }
-        else
-        {
-            float minimum = std::numeric_limits<float>::max();
-            for (std::set<int>::iterator it = currentCheckPoint->getNextCheckpoints().begin(); it != currentCheckPoint->getNextCheckpoints().end(); ++it)
-            {
-                int dist_currentCheckPoint_currentPosition = static_cast<int> ((currentPosition- currentCheckPoint->getPosition()).length());
-
-                minimum = std::min(minimum, dist_currentCheckPoint_currentPosition + recCalculateDistance(findCheckpoint(*it), currentCheckPoint->getPosition()));
-                // minimum of distanz from 'currentPosition' to the next static Checkpoint
-            }
-            return minimum;
-        }
+        if (checkpoint != nextRaceCheckpoint_)
+            bWaypointReached_ = false;
+        nextRaceCheckpoint_ = checkpoint;
     }
 
     /*called by 'tick'
@@ -288,10 +227,11 @@ namespace orxonox
 
     RaceCheckPoint* SpaceRaceController::findCheckpoint(int index) const
     {
-        for (size_t i = 0; i < this->checkpoints_.size(); ++i)
-            if (this->checkpoints_[i]->getCheckpointIndex() == index)
-                return this->checkpoints_[i];
-        return NULL;
+        // without a SpaceRaceManager in the level there is no navigation graph and hence no checkpoint
+        if (this->navigation_)
+            return this->navigation_->findCheckpoint(index);
+        else
+            return NULL;
     }
 
     /*RaceCheckPoint* SpaceRaceController::addVirtualCheckPoint( RaceCheckPoint* previousCheckpoint, int indexFollowingCheckPoint , const Vector3& virtualCheckPointPosition )
@@ -351,15 +291,19 @@ namespace orxonox
             //orxout()<< this->getControllableEntity() << " in tick"<<endl;
             return;
         }
+        if (nextRaceCheckpoint_ == NULL) // no checkpoint to fly to (e.g. no SpaceRaceManager in the level)
+            return;
         //FOR virtual Checkpoints
         if(nextRaceCheckpoint_->getCheckpointIndex() < 0)
         {
             if( distanceSpaceshipToCheckPoint(nextRaceCheckpoint_) < 200)
             {
                 currentRaceCheckpoint_=nextRaceCheckpoint_;
-                nextRaceCheckpoint_ = nextPointFind(nextRaceCheckpoint_);
+                setNextRaceCheckpoint(nextPointFind(nextRaceCheckpoint_));
                 lastPositionSpaceship=this->getControllableEntity()->getPosition();
                 //orxout()<< "CP "<< currentRaceCheckpoint_->getCheckpointIndex()<<" chanched to: "<< nextRaceCheckpoint_->getCheckpointIndex()<<endl;
+                if (nextRaceCheckpoint_ == NULL)
+                    return;
             }
         }
 
@@ -368,13 +312,15 @@ namespace orxonox
 
             currentRaceCheckpoint_ = nextRaceCheckpoint_;
             OrxAssert(nextRaceCheckpoint_, "next race checkpoint undefined");
-            nextRaceCheckpoint_ = nextPointFind(nextRaceCheckpoint_);
+            setNextRaceCheckpoint(nextPointFind(nextRaceCheckpoint_));
             lastPositionSpaceship = this->getControllableEntity()->getPosition();
             //orxout()<< "CP "<< currentRaceCheckpoint_->getCheckpointIndex()<<" chanched to: "<< nextRaceCheckpoint_->getCheckpointIndex()<<endl;
+            if (nextRaceCheckpoint_ == NULL)
+                return;
         }
         else if ((lastPositionSpaceship-this->getControllableEntity()->getPosition()).length()/dt > ADJUSTDISTANCE)
         {
-            nextRaceCheckpoint_ = adjustNextPoint();
+            setNextRaceCheckpoint(adjustNextPoint());
             lastPositionSpaceship = this->getControllableEntity()->getPosition();
         }
 
@@ -389,7 +335,19 @@ namespace orxonox
         }
         //orxout(user_status) << "dt= " << dt << ";  distance= " << (lastPositionSpaceship-this->getControllableEntity()->getPosition()).length() <<std::endl;
         lastPositionSpaceship = this->getControllableEntity()->getPosition();
-        this->moveToPosition(nextRaceCheckpoint_->getPosition());
+
+        // fly around obstacles between the last and the next checkpoint
+        const Vector3* waypoint = NULL;
+        if (this->navigation_ && currentRaceCheckpoint_ != NULL && !bWaypointReached_)
+        {
+            waypoint = navigation_->getWaypoint(currentRaceCheckpoint_, nextRaceCheckpoint_);
+            if (waypoint != NULL && (*waypoint - lastPositionSpaceship).length() < WAYPOINTDISTANCE)
+            {
+                bWaypointReached_ = true;
+                waypoint = NULL;
+            }
+        }
+        this->moveToPosition(waypoint != NULL ? *waypoint : nextRaceCheckpoint_->getPosition());
     }
 
     // True if a coordinate of 'pointToPoint' is smaller then the corresponding coordinate of 'groesse'
@@ -405,35 +363,6 @@ namespace orxonox
 
     }
 
-    bool SpaceRaceController::directLinePossible(RaceCheckPoint* racepoint1, RaceCheckPoint* racepoint2, const std::vector<StaticEntity*>& allObjects)
-    {
-
-        Vector3 cP1ToCP2 = (racepoint2->getPosition() - racepoint1->getPosition()) / (racepoint2->getPosition() - racepoint1->getPosition()).length(); //unit Vector
-        Vector3 centerCP1 = racepoint1->getPosition();
-        btVector3 positionObject;
-        btScalar radiusObject;
-
-        for (std::vector<StaticEntity*>::const_iterator it = allObjects.begin(); it != allObjects.end(); ++it)
-        {
-            for (int everyShape=0; (*it)->getAttachedCollisionShape(everyShape) != 0; everyShape++)
-            {
-                btCollisionShape* currentShape = (*it)->getAttachedCollisionShape(everyShape)->getCollisionShape();
-                if(currentShape == NULL)
-                continue;
-
-                currentShape->getBoundingSphere(positionObject,radiusObject);
-                Vector3 positionObjectNonBT(positionObject.x(), positionObject.y(), positionObject.z());
-                if((powf((cP1ToCP2.dotProduct(centerCP1-positionObjectNonBT)),2)-(centerCP1-positionObjectNonBT).dotProduct(centerCP1-positionObjectNonBT)+powf(radiusObject, 2))>0)
-                {
-                    return false;
-                }
-
-            }
-        }
-        return true;
-
-    }
-
     /*void SpaceRaceController::computeVirtualCheckpoint(RaceCheckPoint* racepoint1, RaceCheckPoint* racepoint2, const std::vector<StaticEntity*>& allObjects)
     {
         Vector3 cP1ToCP2=(racepoint2->getPosition()-racepoint1->getPosition()) / (racepoint2->getPosition()-racepoint1->getPosition()).length(); //unit Vector
@@ -32,6 +32,7 @@
 #include "gametypes/Gametype.h"
 #include "gametypes/RaceCheckPoint.h"
 #include "util/Math.h"
+#include "util/SharedPtr.h"
 
 namespace orxonox
 {
@@ -45,25 +46,21 @@ namespace orxonox
             virtual void tick(float dt);
 
         private:
-            float recCalculateDistance(RaceCheckPoint*, const Vector3& currentPosition);
             float distanceSpaceshipToCheckPoint(RaceCheckPoint*);
             RaceCheckPoint* nextPointFind(RaceCheckPoint*);
             RaceCheckPoint* adjustNextPoint();
-            std::vector<RaceCheckPoint*> findStaticCheckpoints(RaceCheckPoint*, const std::vector<RaceCheckPoint*>&);
-            std::vector<RaceCheckPoint*> staticCheckpoints();
-            int rekSimulationCheckpointsReached(RaceCheckPoint*, std::map<RaceCheckPoint*, int>&);
+            void setNextRaceCheckpoint(RaceCheckPoint*);
             // same as SpaceRaceManager, but needed to add virtuell Checkpoints ( Checkpoints which don't exist but needed to avoid collisions with big Objects)
             RaceCheckPoint* findCheckpoint(int index) const;
             //RaceCheckPoint * addVirtualCheckPoint(RaceCheckPoint*, int , const Vector3&);
             //void placeVirtualCheckpoints(RaceCheckPoint*, RaceCheckPoint*);
             bool vergleicheQuader(const Vector3&, const Vector3&);
-            bool directLinePossible(RaceCheckPoint*, RaceCheckPoint*, const std::vector<StaticEntity*>&);
             //void computeVirtualCheckpoint(RaceCheckPoint*, RaceCheckPoint*, const std::vector<StaticEntity*>&);
 
-            std::vector<RaceCheckPoint*> staticRacePoints_;
+            SharedPtr<SpaceRaceNavigation> navigation_; // navigation graph of the level, shared by all bots
             RaceCheckPoint* nextRaceCheckpoint_; // checkpoint that should be reached
             RaceCheckPoint* currentRaceCheckpoint_; // last checkPoint (already reached)
-            std::vector<RaceCheckPoint*> checkpoints_;
+            bool bWaypointReached_; // true if the waypoint between currentRaceCheckpoint_ and nextRaceCheckpoint_ was reached (if there is one)
             Vector3 lastPositionSpaceship;
             int virtualCheckPointIndex;
     };
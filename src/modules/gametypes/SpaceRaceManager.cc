@@ -28,6 +28,7 @@
 
 #include "SpaceRaceManager.h"
 #include "SpaceRace.h"
+#include "SpaceRaceNavigation.h"
 #include "infos/PlayerInfo.h"
 
 #include "core/XMLPort.h"
@@ -107,6 +108,16 @@ namespace orxonox
         return checkpoints_;
     }
 
+    /**
+     @brief Returns the navigation graph of this race. The graph is created when it is requested for the first time and shared by all bots.
+     */
+    SharedPtr<SpaceRaceNavigation> SpaceRaceManager::getNavigation()
+    {
+        if (!this->navigation_ || this->navigation_->getNumCheckpoints() != this->checkpoints_.size())
+            this->navigation_ = new SpaceRaceNavigation(this->checkpoints_, this->findCheckpoint(0));
+        return this->navigation_;
+    }
+
     /**
      @brief Returns the checkpoint with the given checkpoint-index (@see RaceCheckPoint::getCheckpointIndex).
      */
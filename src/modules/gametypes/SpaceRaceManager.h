@@ -36,6 +36,7 @@
 #include <vector>
 
 #include <util/Clock.h>
+#include <util/SharedPtr.h>
 
 #include "gametypes/Gametype.h"
 #include "tools/interfaces/Tickable.h"
@@ -68,6 +69,8 @@ namespace orxonox
 
             std::vector<RaceCheckPoint*> getAllCheckpoints();
 
+            SharedPtr<SpaceRaceNavigation> getNavigation();
+
             void tick(float dt);
 
         protected:
@@ -80,6 +83,7 @@ namespace orxonox
             SpaceRace* race_; // needed to get the players
             //int amountOfPlayers;
             std::map<PlayerInfo*, Player> players_;
+            SharedPtr<SpaceRaceNavigation> navigation_; ///< The navigation graph for bots, created when it is needed for the first time
     };
 }
 
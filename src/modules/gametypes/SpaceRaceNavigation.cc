@@ -0,0 +1,421 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file SpaceRaceNavigation.cc
+    @brief Implementation of the SpaceRaceNavigation class.
+*/
+
+#include "SpaceRaceNavigation.h"
+
+#include <limits>
+#include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+
+#include "core/CoreIncludes.h"
+#include "tools/BulletConversions.h"
+#include "Scene.h"
+#include "gametypes/RaceCheckPoint.h"
+
+namespace orxonox
+{
+    /// The number of directions around the direct line which are tested to find a waypoint
+    static const int WAYPOINT_DIRECTIONS = 8;
+    /// The distance of a waypoint to the center of the obstacle, relative to the radius of the obstacle
+    static const float WAYPOINT_MARGIN = 1.2f;
+
+    namespace
+    {
+        /// States of a node while traversing the graph (used to detect loops)
+        enum VisitState { Unvisited, Visiting, Visited };
+
+        /**
+        @brief
+            A ray test callback which only reports static objects (except checkpoints).
+        */
+        struct StaticObstacleCallback : public btCollisionWorld::ClosestRayResultCallback
+        {
+            StaticObstacleCallback(const btVector3& from, const btVector3& to) : btCollisionWorld::ClosestRayResultCallback(from, to) {}
+
+            virtual bool needsCollision(btBroadphaseProxy* proxy) const
+            {
+                if (!btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy))
+                    return false;
+
+                const btCollisionObject* object = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+                const WorldEntity* entity = static_cast<const WorldEntity*>(object->getUserPointer());
+                return (entity != NULL && entity->isStatic() && orxonox_cast<const RaceCheckPoint*>(entity) == NULL);
+            }
+        };
+    }
+
+    /**
+    @brief
+        Builds the navigation graph.
+    @param checkpoints
+        All checkpoints of the level.
+    @param firstCheckpoint
+        The checkpoint where the race starts.
+    */
+    SpaceRaceNavigation::SpaceRaceNavigation(const std::vector<RaceCheckPoint*>& checkpoints, RaceCheckPoint* firstCheckpoint)
+    {
+        this->nodes_.resize(checkpoints.size());
+        for (size_t i = 0; i < checkpoints.size(); ++i)
+        {
+            this->nodes_[i].checkpoint = checkpoints[i];
+            this->nodes_[i].bStatic = false;
+            this->nodes_[i].remainingDistance = 0;
+            this->nodeIndices_[checkpoints[i]] = i;
+            this->checkpointsByIndex_[checkpoints[i]->getCheckpointIndex()] = checkpoints[i];
+        }
+
+        btDiscreteDynamicsWorld* world = NULL;
+        if (!checkpoints.empty() && checkpoints[0]->getScene())
+            world = checkpoints[0]->getScene()->getPhysicalWorld();
+
+        this->buildEdges(world);
+        this->findStaticCheckpoints(firstCheckpoint);
+        this->computeRemainingDistances();
+    }
+
+    SpaceRaceNavigation::~SpaceRaceNavigation()
+    {
+    }
+
+    /**
+    @brief
+        Returns the checkpoint with the given checkpoint-index (@see RaceCheckPoint::getCheckpointIndex) or NULL if there is no such checkpoint.
+    */
+    RaceCheckPoint* SpaceRaceNavigation::findCheckpoint(int index) const
+    {
+        std::map<int, RaceCheckPoint*>::const_iterator it = this->checkpointsByIndex_.find(index);
+        if (it != this->checkpointsByIndex_.end())
+            return it->second;
+        else
+            return NULL;
+    }
+
+    /**
+    @brief
+        Returns true if every way from the first to the last checkpoint passes the given checkpoint.
+    */
+    bool SpaceRaceNavigation::isStaticCheckpoint(RaceCheckPoint* checkpoint) const
+    {
+        std::map<RaceCheckPoint*, size_t>::const_iterator it = this->nodeIndices_.find(checkpoint);
+        return (it != this->nodeIndices_.end() && this->nodes_[it->second].bStatic);
+    }
+
+    /**
+    @brief
+        Returns the length of the shortest way from @a position through @a checkpoint to the next static checkpoint.
+    */
+    float SpaceRaceNavigation::getDistanceToStaticCheckpoint(RaceCheckPoint* checkpoint, const Vector3& position) const
+    {
+        std::map<RaceCheckPoint*, size_t>::const_iterator it = this->nodeIndices_.find(checkpoint);
+        if (it == this->nodeIndices_.end())
+            return (checkpoint->getPosition() - position).length();
+
+        const Node& node = this->nodes_[it->second];
+        if (node.bStatic)
+            return (checkpoint->getPosition() - position).length();
+        else
+            return static_cast<int>((position - checkpoint->getPosition()).length()) + node.remainingDistance;
+    }
+
+    /**
+    @brief
+        Returns true if no static object blocks the direct line between the two checkpoints.
+    */
+    bool SpaceRaceNavigation::isDirectLinePossible(RaceCheckPoint* from, RaceCheckPoint* to) const
+    {
+        const Edge* edge = this->findEdge(from, to);
+        return (edge == NULL || edge->bDirect);
+    }
+
+    /**
+    @brief
+        Returns the waypoint which avoids the obstacle between the two checkpoints or NULL if there is no such waypoint.
+    */
+    const Vector3* SpaceRaceNavigation::getWaypoint(RaceCheckPoint* from, RaceCheckPoint* to) const
+    {
+        const Edge* edge = this->findEdge(from, to);
+        if (edge != NULL && edge->bHasWaypoint)
+            return &edge->waypoint;
+        else
+            return NULL;
+    }
+
+    /**
+    @brief
+        Returns the length of the way between the two checkpoints (through the waypoint if there is one).
+    */
+    float SpaceRaceNavigation::getCost(RaceCheckPoint* from, RaceCheckPoint* to) const
+    {
+        const Edge* edge = this->findEdge(from, to);
+        if (edge != NULL)
+            return edge->cost;
+        else
+            return (to->getPosition() - from->getPosition()).length();
+    }
+
+    /**
+    @brief
+        Returns the connection between the two checkpoints or NULL if @a to is not a next checkpoint of @a from.
+    */
+    const SpaceRaceNavigation::Edge* SpaceRaceNavigation::findEdge(RaceCheckPoint* from, RaceCheckPoint* to) const
+    {
+        std::map<RaceCheckPoint*, size_t>::const_iterator it = this->nodeIndices_.find(from);
+        if (it == this->nodeIndices_.end())
+            return NULL;
+
+        const std::vector<Edge>& edges = this->nodes_[it->second].edges;
+        for (size_t i = 0; i < edges.size(); ++i)
+            if (edges[i].target == to)
+                return &edges[i];
+        return NULL;
+    }
+
+    /**
+    @brief
+        Creates the connections between the checkpoints and tests them for obstacles.
+    */
+    void SpaceRaceNavigation::buildEdges(btDiscreteDynamicsWorld* world)
+    {
+        this->predecessors_.resize(this->nodes_.size());
+
+        for (size_t i = 0; i < this->nodes_.size(); ++i)
+        {
+            RaceCheckPoint* checkpoint = this->nodes_[i].checkpoint;
+            const std::set<int>& nextCheckpoints = checkpoint->getNextCheckpoints();
+            for (std::set<int>::const_iterator it = nextCheckpoints.begin(); it != nextCheckpoints.end(); ++it)
+            {
+                RaceCheckPoint* next = this->findCheckpoint(*it);
+                if (next == NULL)
+                {
+                    orxout(internal_warning) << "Problematic Point: " << (*it) << endl;
+                    continue;
+                }
+                if (next == checkpoint)
+                    continue;
+
+                Edge edge;
+                edge.target = next;
+                edge.bDirect = true;
+                edge.bHasWaypoint = false;
+                edge.cost = (next->getPosition() - checkpoint->getPosition()).length();
+
+                btCollisionObject* obstacle = world ? findObstacle(world, checkpoint->getPosition(), next->getPosition()) : NULL;
+                if (obstacle != NULL)
+                {
+                    edge.bDirect = false;
+                    edge.bHasWaypoint = findWaypoint(world, checkpoint->getPosition(), next->getPosition(), obstacle, edge.waypoint);
+                    if (edge.bHasWaypoint)
+                        edge.cost = (edge.waypoint - checkpoint->getPosition()).length() + (next->getPosition() - edge.waypoint).length();
+                }
+
+                this->nodes_[i].edges.push_back(edge);
+                this->predecessors_[this->nodeIndices_[next]].push_back(i);
+            }
+        }
+    }
+
+    /**
+    @brief
+        Marks the checkpoints which are passed by every way from the first to the last checkpoint.
+
+        The number of ways through a checkpoint is the number of ways from the first checkpoint
+        to it multiplied with the number of ways from it to the last checkpoint. A checkpoint is
+        static if this equals the number of all ways.
+    */
+    void SpaceRaceNavigation::findStaticCheckpoints(RaceCheckPoint* firstCheckpoint)
+    {
+        std::map<RaceCheckPoint*, size_t>::const_iterator it = this->nodeIndices_.find(firstCheckpoint);
+        if (it == this->nodeIndices_.end())
+            return;
+        size_t first = it->second;
+
+        std::vector<unsigned long long> waysToLast(this->nodes_.size(), 0);
+        std::vector<unsigned long long> waysFromFirst(this->nodes_.size(), 0);
+        std::vector<char> stateToLast(this->nodes_.size(), Unvisited);
+        std::vector<char> stateFromFirst(this->nodes_.size(), Unvisited);
+
+        unsigned long long maxWays = this->countWaysToLast(first, waysToLast, stateToLast);
+        for (size_t i = 0; i < this->nodes_.size(); ++i)
+        {
+            unsigned long long ways = this->countWaysFromFirst(i, first, waysFromFirst, stateFromFirst) * this->countWaysToLast(i, waysToLast, stateToLast);
+            this->nodes_[i].bStatic = (ways == maxWays);
+        }
+    }
+
+    /**
+    @brief
+        Returns the number of ways from the given node to the last checkpoint.
+    */
+    unsigned long long SpaceRaceNavigation::countWaysToLast(size_t node, std::vector<unsigned long long>& ways, std::vector<char>& state) const
+    {
+        if (state[node] == Visited)
+            return ways[node];
+        if (state[node] == Visiting)
+        {
+            orxout(internal_warning) << "Checkpoint " << this->nodes_[node].checkpoint->getCheckpointIndex() << " is part of a loop" << endl;
+            return 0;
+        }
+
+        state[node] = Visiting;
+        if (this->nodes_[node].checkpoint->isLast())
+            ways[node] = 1;
+        else
+        {
+            const std::vector<Edge>& edges = this->nodes_[node].edges;
+            for (size_t i = 0; i < edges.size(); ++i)
+                ways[node] += this->countWaysToLast(this->nodeIndices_.find(edges[i].target)->second, ways, state);
+        }
+        state[node] = Visited;
+
+        return ways[node];
+    }
+
+    /**
+    @brief
+        Returns the number of ways from the first checkpoint to the given node.
+    */
+    unsigned long long SpaceRaceNavigation::countWaysFromFirst(size_t node, size_t first, std::vector<unsigned long long>& ways, std::vector<char>& state) const
+    {
+        if (state[node] == Visited)
+            return ways[node];
+        if (state[node] == Visiting)
+            return 0;
+
+        state[node] = Visiting;
+        if (node == first)
+            ways[node] = 1;
+        else
+        {
+            const std::vector<size_t>& predecessors = this->predecessors_[node];
+            for (size_t i = 0; i < predecessors.size(); ++i)
+                ways[node] += this->countWaysFromFirst(predecessors[i], first, ways, state);
+        }
+        state[node] = Visited;
+
+        return ways[node];
+    }
+
+    /**
+    @brief
+        Computes the shortest distance from each checkpoint to the next static checkpoint.
+    */
+    void SpaceRaceNavigation::computeRemainingDistances()
+    {
+        std::vector<char> state(this->nodes_.size(), Unvisited);
+        for (size_t i = 0; i < this->nodes_.size(); ++i)
+            this->computeRemainingDistance(i, state);
+    }
+
+    /**
+    @brief
+        Returns the shortest distance from the given node to the next static checkpoint which can be reached from it.
+    */
+    float SpaceRaceNavigation::computeRemainingDistance(size_t node, std::vector<char>& state)
+    {
+        if (state[node] == Visited)
+            return this->nodes_[node].remainingDistance;
+        if (state[node] == Visiting)
+            return std::numeric_limits<float>::max();
+
+        state[node] = Visiting;
+        float minimum = std::numeric_limits<float>::max();
+        const std::vector<Edge>& edges = this->nodes_[node].edges;
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            const Node& next = this->nodes_[this->nodeIndices_.find(edges[i].target)->second];
+            if (next.bStatic)
+                minimum = std::min(minimum, edges[i].cost);
+            else
+                minimum = std::min(minimum, static_cast<int>(edges[i].cost) + this->computeRemainingDistance(this->nodeIndices_.find(edges[i].target)->second, state));
+        }
+        this->nodes_[node].remainingDistance = minimum;
+        state[node] = Visited;
+
+        return minimum;
+    }
+
+    /**
+    @brief
+        Returns the first static object on the line between @a from and @a to or NULL if the line is free.
+    */
+    /*static*/ btCollisionObject* SpaceRaceNavigation::findObstacle(btDiscreteDynamicsWorld* world, const Vector3& from, const Vector3& to)
+    {
+        btVector3 rayFrom = multi_cast<btVector3>(from);
+        btVector3 rayTo = multi_cast<btVector3>(to);
+
+        StaticObstacleCallback callback(rayFrom, rayTo);
+        world->rayTest(rayFrom, rayTo, callback);
+        return callback.m_collisionObject;
+    }
+
+    /**
+    @brief
+        Searches a waypoint next to the obstacle such that the lines from @a from to the waypoint and from the waypoint to @a to are free.
+    @return
+        Returns true if a waypoint was found. If several waypoints are possible, the one with the shortest way is chosen.
+    */
+    /*static*/ bool SpaceRaceNavigation::findWaypoint(btDiscreteDynamicsWorld* world, const Vector3& from, const Vector3& to, btCollisionObject* obstacle, Vector3& waypoint)
+    {
+        btVector3 aabbMin, aabbMax;
+        obstacle->getCollisionShape()->getAabb(obstacle->getWorldTransform(), aabbMin, aabbMax);
+        Vector3 center = multi_cast<Vector3>((aabbMin + aabbMax) * 0.5f);
+        float radius = (aabbMax - aabbMin).length() * 0.5f * WAYPOINT_MARGIN;
+
+        // start with the side of the obstacle which is closest to the direct line
+        Vector3 direction = (to - from).normalisedCopy();
+        Vector3 offset = (from + direction * direction.dotProduct(center - from)) - center;
+        if (offset.isZeroLength())
+            offset = direction.perpendicular();
+        offset.normalise();
+
+        bool bFound = false;
+        float minCost = 0;
+        for (int i = 0; i < WAYPOINT_DIRECTIONS; ++i)
+        {
+            Quaternion rotation(Radian(i * math::twoPi / WAYPOINT_DIRECTIONS), direction);
+            Vector3 candidate = center + (rotation * offset) * radius;
+            float cost = (candidate - from).length() + (to - candidate).length();
+
+            if (bFound && cost >= minCost)
+                continue;
+            if (findObstacle(world, from, candidate) == NULL && findObstacle(world, candidate, to) == NULL)
+            {
+                waypoint = candidate;
+                minCost = cost;
+                bFound = true;
+            }
+        }
+
+        return bFound;
+    }
+}
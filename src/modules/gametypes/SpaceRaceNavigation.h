@@ -0,0 +1,118 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file SpaceRaceNavigation.h
+    @brief Declaration of the SpaceRaceNavigation class.
+    @ingroup Gametypes
+*/
+
+#ifndef _SpaceRaceNavigation_H__
+#define _SpaceRaceNavigation_H__
+
+#include "gametypes/GametypesPrereqs.h"
+
+#include <map>
+#include <vector>
+
+#include "util/Math.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        The navigation graph of a space race level, shared by all SpaceRaceControllers.
+
+        The graph is computed once per level (see SpaceRaceManager::getNavigation()). For each
+        checkpoint it stores whether all ways to the last checkpoint pass through it (a static
+        checkpoint) and the shortest distance to the next static checkpoint. For each pair of
+        consecutive checkpoints it stores whether the direct line is blocked by a static object
+        and, if so, a waypoint which avoids the obstacle. Obstacles are found with ray tests in
+        the physical world of the scene.
+    */
+    class _GametypesExport SpaceRaceNavigation
+    {
+        public:
+            SpaceRaceNavigation(const std::vector<RaceCheckPoint*>& checkpoints, RaceCheckPoint* firstCheckpoint);
+            ~SpaceRaceNavigation();
+
+            RaceCheckPoint* findCheckpoint(int index) const;
+            bool isStaticCheckpoint(RaceCheckPoint* checkpoint) const;
+            float getDistanceToStaticCheckpoint(RaceCheckPoint* checkpoint, const Vector3& position) const;
+
+            bool isDirectLinePossible(RaceCheckPoint* from, RaceCheckPoint* to) const;
+            const Vector3* getWaypoint(RaceCheckPoint* from, RaceCheckPoint* to) const;
+            float getCost(RaceCheckPoint* from, RaceCheckPoint* to) const;
+
+            /// Returns the number of checkpoints which were used to build the graph.
+            inline size_t getNumCheckpoints() const
+                { return this->nodes_.size(); }
+
+        private:
+            SpaceRaceNavigation(const SpaceRaceNavigation&);
+
+            /// A connection from a checkpoint to one of its next checkpoints.
+            struct Edge
+            {
+                RaceCheckPoint* target;     //!< The next checkpoint
+                bool bDirect;               //!< True if no static object blocks the direct line
+                bool bHasWaypoint;          //!< True if the obstacle can be avoided by flying through the waypoint
+                Vector3 waypoint;           //!< The waypoint which avoids the obstacle
+                float cost;                 //!< The length of the way (through the waypoint if there is one)
+            };
+
+            /// A checkpoint and its connections.
+            struct Node
+            {
+                RaceCheckPoint* checkpoint;     //!< The checkpoint
+                std::vector<Edge> edges;        //!< The connections to the next checkpoints
+                bool bStatic;                   //!< True if every way to the last checkpoint passes this checkpoint
+                float remainingDistance;        //!< The shortest distance from this checkpoint to the next static checkpoint
+            };
+
+            void buildEdges(btDiscreteDynamicsWorld* world);
+            void findStaticCheckpoints(RaceCheckPoint* firstCheckpoint);
+            void computeRemainingDistances();
+
+            unsigned long long countWaysToLast(size_t node, std::vector<unsigned long long>& ways, std::vector<char>& state) const;
+            unsigned long long countWaysFromFirst(size_t node, size_t first, std::vector<unsigned long long>& ways, std::vector<char>& state) const;
+            float computeRemainingDistance(size_t node, std::vector<char>& state);
+
+            static btCollisionObject* findObstacle(btDiscreteDynamicsWorld* world, const Vector3& from, const Vector3& to);
+            static bool findWaypoint(btDiscreteDynamicsWorld* world, const Vector3& from, const Vector3& to, btCollisionObject* obstacle, Vector3& waypoint);
+
+            const Edge* findEdge(RaceCheckPoint* from, RaceCheckPoint* to) const;
+
+            std::vector<Node> nodes_;                               //!< All checkpoints of the level
+            std::map<RaceCheckPoint*, size_t> nodeIndices_;         //!< Maps checkpoints to their index in nodes_
+            std::map<int, RaceCheckPoint*> checkpointsByIndex_;     //!< Maps checkpoint indices to checkpoints
+            std::vector<std::vector<size_t> > predecessors_;        //!< The indices of the nodes which lead to each node
+    };
+}
+
+#endif /* _SpaceRaceNavigation_H__ */
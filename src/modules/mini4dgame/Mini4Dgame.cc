@@ -48,6 +48,7 @@
 
 #include "gamestates/GSLevel.h"
 #include "chat/ChatManager.h"
+#include "Mini4DgameAI.h"
 
 namespace orxonox
 {
@@ -66,6 +67,7 @@ namespace orxonox
         RegisterObject(Mini4Dgame);
 
         this->board_ = 0;
+        this->ai_ = 0;
 
         // Set the type of Bots for this particular Gametype.
         //this->botclass_ = Class(Mini4DgameBot);
@@ -92,6 +94,11 @@ namespace orxonox
             //this->board_->destroy();
             this->board_ = 0;
         }
+        if(this->ai_ != NULL)
+        {
+            this->ai_->destroy();
+            this->ai_ = 0;
+        }
     }
 
     /**
@@ -115,6 +122,9 @@ namespace orxonox
 
             this->board_->setPosition(0, 0, 0);
 
+            this->ai_ = new Mini4DgameAI(this->board_->getContext());
+            this->ai_->setBoard(this->board_);
+
         }
         else // If no centerpoint was specified, an error is thrown and the level is exited.
         {
@@ -189,9 +199,20 @@ namespace orxonox
     //void Mini4Dgame::setStone(Vector4 move, const int playerColor, Mini4DgameBoard* board)
     void Mini4Dgame::setStone(int x,int y,int z,int w)//Vector4 move, const int playerColor)
     {
+        // it's the turn of the computer
+        for (ObjectList<Mini4DgameAI>::iterator ai = ObjectList<Mini4DgameAI>::begin(); ai; ++ai)
+            if (ai->isSearching())
+                return;
+
         Mini4DgamePosition move = Mini4DgamePosition(x,y,z,w);
         ObjectList<Mini4DgameBoard>::iterator it = ObjectList<Mini4DgameBoard>::begin();
+        const int color = it->getNextPlayerColor();
         it->makeMove(move);
+
+        // the computer answers valid moves unless the game is over
+        if (it->getNextPlayerColor() != color && it->getWinner().color_ == mini4DgamePlayerColor::none)
+            for (ObjectList<Mini4DgameAI>::iterator ai = ObjectList<Mini4DgameAI>::begin(); ai; ++ai)
+                ai->makeMove();
     }
 
     void Mini4Dgame::win(Mini4DgameWinner winner)
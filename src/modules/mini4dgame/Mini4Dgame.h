@@ -91,6 +91,7 @@ namespace orxonox
 
             //Player players[2];
             Mini4DgameBoard* board_;
+            Mini4DgameAI* ai_; //!< The computer opponent, it answers each move of the player.
     };
 }
 
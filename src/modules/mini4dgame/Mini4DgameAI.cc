@@ -35,14 +35,13 @@
 
 #include "core/CoreIncludes.h"
 #include "core/config/ConfigValueIncludes.h"
-#include "core/command/Executor.h"
-#include "tools/Timer.h"
 
-#include <list>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 
 #include "worldentities/ControllableEntity.h"
 
-#include "Mini4DgameCenterpoint.h"
+#include "Mini4DgameBoard.h"
 
 namespace orxonox
 {
@@ -58,69 +57,123 @@ namespace orxonox
     {
         RegisterObject(Mini4DgameAI);
 
+        this->board_ = 0;
+        this->numThreads_ = 2;
+        this->searchTime_ = 2.0f;
+        this->thread_ = 0;
+        this->bResultReady_ = false;
+        this->search_ = new Mini4DgameSearch(this->numThreads_);
         this->setConfigValues();
-        this->center_ = 0;
     }
 
     /**
     @brief
-        Destructor. Cleans up the list fo reaction timers.
+        Destructor. Waits until the search thread finished.
     */
     Mini4DgameAI::~Mini4DgameAI()
     {
+        // the search stops after searchTime_ at the latest
+        if (this->thread_)
+        {
+            this->thread_->join();
+            delete this->thread_;
+        }
+        delete this->search_;
+    }
+
+    void Mini4DgameAI::setConfigValues()
+    {
+        SetConfigValue(numThreads_, 2).description("The number of threads which search the moves (0 uses all hardware threads).");
+        SetConfigValue(searchTime_, 2.0f).description("The time in seconds the AI has to decide on a move.");
 
+        // the number of threads can't be changed during a search
+        if (!this->thread_)
+            this->search_->setNumThreads(this->numThreads_);
     }
 
-    Vector4 Mini4DgameAI::makeMove(float timeout)
+    /**
+    @brief
+        Starts the search for the next move of the player whose turn it is. The search runs in a separate thread,
+        the move is made in the first tick after it finished. Does nothing if the AI searches already.
+    */
+    void Mini4DgameAI::makeMove()
     {
-        this->copyBoard();
-        std::list<Vector4> possibleMoves = this->getPossibleMoves();
+        if (this->board_ == NULL || this->thread_)
+            return;
 
-        //TODO: alphabeta ueber possibleMoves
+        Mini4DgameBitboard player;
+        Mini4DgameBitboard opponent;
+        this->copyBoard(player, opponent);
+        this->search_->setPosition(player, opponent);
 
-        //when timeout
-        Vector4 move = possibleMoves.front();
-        return move;
+        this->bResultReady_ = false;
+        this->thread_ = new boost::thread(boost::bind(&Mini4DgameAI::search, this));
     }
 
-    void Mini4DgameAI::copyBoard()
+    /**
+    @brief
+        Runs the search (in the thread started by makeMove()).
+    */
+    void Mini4DgameAI::search()
     {
-        for(int i=0;i<4;i++){
-            for(int j=0;j<4;j++){
-                for(int k=0;k<4;k++){
-                    for(int l=0;l<4;l++){
-                        this->board_[i][j][k][l]=this->center_->board[i][j][k][l];
-                    }
-                }
-            }
-        }
+        const Mini4DgameSearch::Result result = this->search_->search(this->searchTime_);
+
+        boost::mutex::scoped_lock lock(this->resultMutex_);
+        this->result_ = result;
+        this->bResultReady_ = true;
     }
 
-    std::list<Vector4> Mini4DgameAI::getPossibleMoves()
+    /**
+    @brief
+        Converts the board to bitboards. @a player gets the stones of the player who makes the next move.
+    */
+    void Mini4DgameAI::copyBoard(Mini4DgameBitboard& player, Mini4DgameBitboard& opponent)
     {
-        std::list<Vector4> possibleMoves = new std::list<Vector4>;
+        const int color = this->board_->getNextPlayerColor();
         for(int i=0;i<4;i++){
             for(int j=0;j<4;j++){
                 for(int k=0;k<4;k++){
                     for(int l=0;l<4;l++){
-                        if (this->board_[i][j][k][l]==mini4DgamePlayerColor::none)
-                            possibleMoves.push_back(Vector4(i,j,k,l));
+                        const int stone = this->board_->getStone(Mini4DgamePosition(i,j,k,l));
+                        if (stone == color)
+                            player.set(Mini4DgameSearch::getCellIndex(i,j,k,l));
+                        else if (stone != mini4DgamePlayerColor::none)
+                            opponent.set(Mini4DgameSearch::getCellIndex(i,j,k,l));
                     }
                 }
             }
         }
-        return possibleMoves;
     }
 
     /**
     @brief
-        Is called each tick.
-        Implements the behavior of the PongAI (i.e. its intelligence).
+        Is called each tick. Makes the move once the search finished.
     @param dt
         The time that has elapsed since the last tick.
     */
     void Mini4DgameAI::tick(float dt)
     {
+        if (!this->thread_)
+            return;
+
+        {
+            boost::mutex::scoped_lock lock(this->resultMutex_);
+            if (!this->bResultReady_)
+                return;
+        }
+
+        this->thread_->join();
+        delete this->thread_;
+        this->thread_ = 0;
+
+        const Mini4DgameSearch::Result& result = this->result_;
+        orxout(internal_info) << "Mini4DgameAI: searched " << result.nodes << " positions in " << (result.time / 1000) << " ms (depth " << result.depth << ", score " << result.score << ')' << endl;
+
+        if (result.move < 0 || this->board_ == NULL)
+            return;
 
+        int x, y, z, w;
+        Mini4DgameSearch::getCellPosition(result.move, x, y, z, w);
+        this->board_->makeMove(Mini4DgamePosition(x, y, z, w));
     }
 }
@@ -36,13 +36,13 @@
 
 #include "mini4dgame/Mini4DgamePrereqs.h"
 
-#include <list>
+#include <boost/thread/mutex.hpp>
 
 #include "tools/interfaces/Tickable.h"
 
 #include "controllers/Controller.h"
-#include "Mini4DgameCenterpoint.h"
 #include "Mini4Dgame.h"
+#include "Mini4DgameSearch.h"
 
 namespace orxonox
 {
@@ -51,6 +51,10 @@ namespace orxonox
     @brief
         The Mini4DgameAI is an artificial intelligence for the @ref orxonox::Mini4Dgame "Mini4Dgame" gametype.
 
+        The move is searched in a separate thread (see makeMove()) and made in the
+        first tick after the search finished, hence the game keeps running while
+        the AI thinks.
+
     @author
         Oliver Richter
     */
@@ -60,34 +64,35 @@ namespace orxonox
             Mini4DgameAI(Context* context); //!< Constructor. Registers and initializes the object.
             virtual ~Mini4DgameAI();
 
-            //void setConfigValues();
-
-            /**
-                @brief
-                    starts the AI to make a move. implements the intelligence of the AI
-                @param timeout
-                    The time the AI has to decide on a move. (Sets the strength of the AI)
-                @return move
-                    The move that the AI decided to make.
-            */
-            Vector4 makeMove(float timeout);
+            void setConfigValues();
 
+            void makeMove();
+            /// @brief Returns true while the AI searches its next move.
+            inline bool isSearching() const
+                { return this->thread_ != 0; }
 
             virtual void tick(float dt);
 
-            void setCenterpoint(Mini4DgameCenterpoint* center)
-                            { this->center_ = center; }
+            void setBoard(Mini4DgameBoard* board)
+                            { this->board_ = board; }
 
         protected:
 
-            std::list<std::pair<Timer*, char> > reactionTimers_; //!< A list of reaction timers and the directions that take effect when their timer expires.
-            Mini4DgameCenterpoint* center_;
+            Mini4DgameBoard* board_;
 
         private:
 
-            std::list<Vector4> getPossibleMoves();
-            void copyBoard();
-            mini4DgamePlayerColor::color board_[4][4][4][4];
+            void copyBoard(Mini4DgameBitboard& player, Mini4DgameBitboard& opponent);
+            void search();
+
+            Mini4DgameSearch* search_; //!< Searches the moves, the transposition table is kept between the moves.
+            unsigned int numThreads_; //!< The number of threads used by the search (0 uses all hardware threads).
+            float searchTime_; //!< The time in seconds the AI has to decide on a move. (Sets the strength of the AI)
+
+            boost::thread* thread_; //!< The thread which runs the search (0 if the AI doesn't search)
+            boost::mutex resultMutex_; //!< Protects result_ and bResultReady_
+            Mini4DgameSearch::Result result_; //!< The result of the last search
+            bool bResultReady_; //!< True if the search finished and the move wasn't made yet
     };
 }
 
@@ -0,0 +1,104 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+@file
+@brief
+    Entry point of mini4dgame-benchmark which measures the speed of Mini4DgameSearch without starting the game.
+
+    Usage: mini4dgame-benchmark [timeout] [positions] [threads] [stones]
+
+    Searches a number of random positions (the same in each run) for @a timeout
+    seconds each and prints the reached depth and the searched nodes per second.
+*/
+
+#include "OrxonoxConfig.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Mini4DgameSearch.h"
+
+int main(int argc, char** argv)
+{
+    using namespace orxonox;
+
+    if (argc > 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " [timeout] [positions] [threads] [stones]" << std::endl;
+        std::cerr << "Searches random positions for timeout seconds each (default: 1 second, 8 positions, all hardware threads, 12 stones)." << std::endl;
+        return 1;
+    }
+
+    const float timeout = (argc > 1 ? static_cast<float>(atof(argv[1])) : 1.0f);
+    const int numPositions = (argc > 2 ? atoi(argv[2]) : 8);
+    const unsigned int numThreads = (argc > 3 ? static_cast<unsigned int>(atoi(argv[3])) : 0);
+    const int numStones = (argc > 4 ? atoi(argv[4]) : 12);
+
+    Mini4DgameSearch search(numThreads);
+    std::cout << "Searching " << numPositions << " positions with " << search.getNumThreads() << " threads for " << timeout << " seconds each" << std::endl;
+
+    srand(1);
+    uint64_t totalNodes = 0;
+    unsigned long long totalTime = 0;
+    for (int position = 0; position < numPositions; ++position)
+    {
+        // place random stones for both players, but don't complete any line
+        Mini4DgameBitboard stones[2];
+        for (int i = 0; i < numStones; )
+        {
+            const int cell = rand() % Mini4DgameSearch::NumCells;
+            if (stones[0].test(cell) || stones[1].test(cell))
+                continue;
+            Mini4DgameBitboard test = stones[i % 2];
+            test.set(cell);
+            if (Mini4DgameSearch::isWinningMove(test, cell))
+                continue;
+            stones[i % 2] = test;
+            ++i;
+        }
+
+        search.clearTable();
+        search.setPosition(stones[numStones % 2], stones[(numStones + 1) % 2]);
+        const Mini4DgameSearch::Result result = search.search(timeout);
+
+        int x, y, z, w;
+        Mini4DgameSearch::getCellPosition(result.move, x, y, z, w);
+        std::cout << "Position " << position << ": move (" << x << ", " << y << ", " << z << ", " << w << "), score " << result.score
+                  << ", depth " << result.depth << ", " << result.nodes << " nodes in " << result.time / 1000 << " ms, "
+                  << static_cast<uint64_t>(result.nodes * 1000000.0 / std::max(result.time, 1ULL)) << " nodes/s" << std::endl;
+
+        totalNodes += result.nodes;
+        totalTime += result.time;
+    }
+
+    std::cout << "Total: " << totalNodes << " nodes in " << totalTime / 1000 << " ms, "
+              << static_cast<uint64_t>(totalNodes * 1000000.0 / std::max(totalTime, 1ULL)) << " nodes/s" << std::endl;
+
+    return 0;
+}
@@ -104,6 +104,14 @@ namespace orxonox
         }
     }
 
+    /**
+    @brief Returns the color of the player who makes the next move.
+    */
+    int Mini4DgameBoard::getNextPlayerColor() const
+    {
+        return (this->player_toggle_ ? mini4DgamePlayerColor::blue : mini4DgamePlayerColor::green);
+    }
+
     /**
     @brief makes a move on the logic playboard
     @param the position where to put the stone plus the player who makes the move
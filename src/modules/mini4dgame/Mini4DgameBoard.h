@@ -80,6 +80,11 @@ namespace orxonox
             void makeMove(const Mini4DgamePosition& move);
             Mini4DgameWinner getWinner();
 
+            /// @brief Returns the color of the stone at the given position (mini4DgamePlayerColor::none if the cell is free).
+            inline int getStone(const Mini4DgamePosition& position) const
+                { return this->board[position.x][position.y][position.z][position.w]; }
+            int getNextPlayerColor() const;
+
             void changedGametype();
             void checkGametype();
 
@@ -68,7 +68,10 @@
 namespace orxonox
 {
     class Mini4Dgame;
+    class Mini4DgameAI;
     class Mini4DgameBoard;
+    class Mini4DgameSearch;
+    struct Mini4DgameBitboard;
 }
 
 #endif /* _Mini4DgamePrereqs_H__ */
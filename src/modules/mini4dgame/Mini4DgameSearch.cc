@@ -0,0 +1,761 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file Mini4DgameSearch.cc
+    @brief Implementation of the Mini4DgameSearch class.
+*/
+
+#include "Mini4DgameSearch.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <cstring>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "util/Clock.h"
+
+namespace orxonox
+{
+    namespace
+    {
+        const int MaxLinesPerCell = 40;         //!< The number of lines through a corner (or a center) cell
+        const int Infinity = Mini4DgameSearch::WinScore + 1;
+        const int NodesBetweenTimeChecks = 1023;//!< The clock is read after this many nodes (must be 2^n - 1)
+        const int MaxPly = Mini4DgameSearch::NumCells + 1;
+
+        /// The score of a line which contains stones of only one player, indexed by the number of stones
+        const int LineValues[5] = { 0, 1, 12, 150, 0 };
+
+        /// The types of bounds stored in the transposition table
+        enum Bound
+        {
+            UpperBound = 1,
+            LowerBound = 2,
+            ExactScore = 3
+        };
+
+        Mini4DgameBitboard lineMasks[Mini4DgameSearch::NumLines];       //!< The cells of each line as bitboard
+        int lineCells[Mini4DgameSearch::NumLines][4];                   //!< The cells of each line
+        int cellLines[Mini4DgameSearch::NumCells][MaxLinesPerCell];     //!< The lines through each cell
+        int cellLineCount[Mini4DgameSearch::NumCells];                  //!< The number of lines through each cell
+        uint64_t zobristKeys[2][Mini4DgameSearch::NumCells];            //!< The random hash keys of the stones of each player
+        uint64_t zobristSideKey;                                        //!< Is xor'ed to the hash if the second player is to move
+        bool bInitialized = false;
+
+        /// Index table for the bit scan (De Bruijn multiplication)
+        const int bitScanTable[64] =
+        {
+             0,  1, 48,  2, 57, 49, 28,  3,
+            61, 58, 50, 42, 38, 29, 17,  4,
+            62, 55, 59, 36, 53, 51, 43, 22,
+            45, 39, 33, 30, 24, 18, 12,  5,
+            63, 47, 56, 27, 60, 41, 37, 16,
+            54, 35, 52, 21, 44, 32, 23, 11,
+            46, 26, 40, 15, 34, 20, 31, 10,
+            25, 14, 19,  9, 13,  8,  7,  6
+        };
+
+        /// Returns the index of the lowest set bit, @a bits must not be 0.
+        inline int bitScan(uint64_t bits)
+        {
+            return bitScanTable[((bits & (~bits + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+        }
+
+        /// A simple xorshift generator for the Zobrist keys, the keys are the same in each run.
+        inline uint64_t nextRandom(uint64_t& state)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+    }
+
+    /**
+        @brief Returns the number of cells in the set.
+    */
+    int Mini4DgameBitboard::count() const
+    {
+        int count = 0;
+        for (int i = 0; i < 4; ++i)
+            for (uint64_t bits = this->words[i]; bits; bits &= bits - 1)
+                ++count;
+        return count;
+    }
+
+    /**
+        @brief Returns the lowest cell of the set (or -1 if the set is empty).
+    */
+    int Mini4DgameBitboard::first() const
+    {
+        for (int i = 0; i < 4; ++i)
+            if (this->words[i])
+                return (i << 6) | bitScan(this->words[i]);
+        return -1;
+    }
+
+    /**
+    @brief
+        The state of the board in one thread of the search. The evaluation and the
+        threats (cells which would complete a line of a player) are updated with
+        each move.
+    */
+    struct Mini4DgameSearch::Worker
+    {
+        void clear();
+        void placeStone(int cell, int player);
+        void removeStone(int cell, int player);
+        void updateLine(int line, int sign);
+        void updateThreat(int player, int line, int sign);
+
+        /// @brief Places a stone of the player to move and passes the turn to the other player.
+        inline void makeMove(int cell)
+        {
+            this->placeStone(cell, this->side);
+            this->hash ^= zobristSideKey;
+            this->side = 1 - this->side;
+        }
+        /// @brief Takes back a move of makeMove().
+        inline void unmakeMove(int cell)
+        {
+            this->side = 1 - this->side;
+            this->hash ^= zobristSideKey;
+            this->removeStone(cell, this->side);
+        }
+        /// @brief Returns the static evaluation from the point of view of the player to move.
+        inline int evaluate() const
+            { return (this->side == 0 ? this->score : -this->score); }
+
+        Mini4DgameBitboard stones[2];                           //!< The stones of both players (0 is the player to move in the root position)
+        Mini4DgameBitboard threats[2];                          //!< The cells which would complete a line of each player
+        unsigned char lineStones[2][NumLines];                  //!< The number of stones of each player in each line
+        unsigned char threatCount[2][NumCells];                 //!< The number of lines which each cell would complete for each player
+        int score;                                              //!< The evaluation from the point of view of player 0
+        int side;                                               //!< The player to move
+        int numStones;                                          //!< The number of stones on the board
+        uint64_t hash;                                          //!< The Zobrist hash of the position
+        uint64_t nodes;                                         //!< The number of positions searched by this worker
+        int killers[MaxPly][2];                                 //!< Two moves per ply which caused a cutoff recently
+        int history[NumCells];                                  //!< Is increased for moves which caused a cutoff
+    };
+
+    void Mini4DgameSearch::Worker::clear()
+    {
+        this->stones[0].clear();
+        this->stones[1].clear();
+        this->threats[0].clear();
+        this->threats[1].clear();
+        memset(this->lineStones, 0, sizeof(this->lineStones));
+        memset(this->threatCount, 0, sizeof(this->threatCount));
+        this->score = 0;
+        this->side = 0;
+        this->numStones = 0;
+        this->hash = 0;
+        this->nodes = 0;
+        memset(this->killers, -1, sizeof(this->killers));
+        memset(this->history, 0, sizeof(this->history));
+    }
+
+    /**
+        @brief Places a stone and updates all lines through the cell.
+    */
+    void Mini4DgameSearch::Worker::placeStone(int cell, int player)
+    {
+        const int* lines = cellLines[cell];
+        const int count = cellLineCount[cell];
+
+        // the lines are removed from the evaluation before the cell is occupied, because the threats depend on the free cells
+        for (int i = 0; i < count; ++i)
+            this->updateLine(lines[i], -1);
+        this->stones[player].set(cell);
+        ++this->numStones;
+        for (int i = 0; i < count; ++i)
+        {
+            ++this->lineStones[player][lines[i]];
+            this->updateLine(lines[i], 1);
+        }
+        this->hash ^= zobristKeys[player][cell];
+    }
+
+    /**
+        @brief Removes a stone and updates all lines through the cell.
+    */
+    void Mini4DgameSearch::Worker::removeStone(int cell, int player)
+    {
+        const int* lines = cellLines[cell];
+        const int count = cellLineCount[cell];
+
+        for (int i = 0; i < count; ++i)
+            this->updateLine(lines[i], -1);
+        this->stones[player].reset(cell);
+        --this->numStones;
+        for (int i = 0; i < count; ++i)
+        {
+            --this->lineStones[player][lines[i]];
+            this->updateLine(lines[i], 1);
+        }
+        this->hash ^= zobristKeys[player][cell];
+    }
+
+    /**
+        @brief Adds (sign = 1) or removes (sign = -1) the contribution of a line to the evaluation and the threats.
+    */
+    void Mini4DgameSearch::Worker::updateLine(int line, int sign)
+    {
+        const int stones0 = this->lineStones[0][line];
+        const int stones1 = this->lineStones[1][line];
+
+        if (stones1 == 0)
+        {
+            this->score += sign * LineValues[stones0];
+            if (stones0 == 3)
+                this->updateThreat(0, line, sign);
+        }
+        else if (stones0 == 0)
+        {
+            this->score -= sign * LineValues[stones1];
+            if (stones1 == 3)
+                this->updateThreat(1, line, sign);
+        }
+    }
+
+    /**
+        @brief Adds or removes the free cell of a line with three stones of a player to the threats of the player.
+    */
+    void Mini4DgameSearch::Worker::updateThreat(int player, int line, int sign)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            const int cell = lineCells[line][i];
+            if (!this->stones[0].test(cell) && !this->stones[1].test(cell))
+            {
+                this->threatCount[player][cell] += sign;
+                if (this->threatCount[player][cell])
+                    this->threats[player].set(cell);
+                else
+                    this->threats[player].reset(cell);
+                return;
+            }
+        }
+    }
+
+    /**
+    @brief
+        Constructor.
+    @param numThreads
+        The number of threads which search the root position. If 0, the number of hardware threads is used.
+    @param tableSize
+        The number of entries of the transposition table (rounded down to a power of two). Each entry needs 16 bytes.
+    */
+    Mini4DgameSearch::Mini4DgameSearch(unsigned int numThreads, size_t tableSize)
+    {
+        Mini4DgameSearch::initialize();
+
+        size_t size = 1;
+        while (size * 2 <= tableSize)
+            size *= 2;
+        this->table_.resize(size);
+        this->clearTable();
+
+        this->numThreads_ = 0;
+        this->setNumThreads(numThreads);
+
+        this->clock_ = new Clock();
+        this->deadline_ = 0;
+        this->bCheckDeadline_ = false;
+        this->bAborted_ = false;
+        this->nextRootMove_ = 0;
+        this->rootAlpha_ = -Infinity;
+        this->bestRootMove_ = 0;
+    }
+
+    Mini4DgameSearch::~Mini4DgameSearch()
+    {
+        for (size_t i = 0; i < this->workers_.size(); ++i)
+            delete this->workers_[i];
+        delete this->clock_;
+    }
+
+    /**
+        @brief Changes the number of threads. If 0, the number of hardware threads is used.
+    */
+    void Mini4DgameSearch::setNumThreads(unsigned int numThreads)
+    {
+        if (numThreads == 0)
+            numThreads = std::max(boost::thread::hardware_concurrency(), 1u);
+        this->numThreads_ = numThreads;
+
+        while (this->workers_.size() < numThreads)
+        {
+            Worker* worker = new Worker();
+            worker->clear();
+            this->workers_.push_back(worker);
+        }
+    }
+
+    /**
+        @brief Removes all positions from the transposition table.
+    */
+    void Mini4DgameSearch::clearTable()
+    {
+        TableEntry empty;
+        empty.check = 0;
+        empty.data = 0;
+        std::fill(this->table_.begin(), this->table_.end(), empty);
+    }
+
+    /**
+    @brief
+        Sets the position which is searched.
+    @param player
+        The stones of the player who is to move
+    @param opponent
+        The stones of the other player
+    */
+    void Mini4DgameSearch::setPosition(const Mini4DgameBitboard& player, const Mini4DgameBitboard& opponent)
+    {
+        Worker& root = *this->workers_[0];
+        root.clear();
+        for (int cell = 0; cell < NumCells; ++cell)
+        {
+            if (player.test(cell))
+                root.placeStone(cell, 0);
+            else if (opponent.test(cell))
+                root.placeStone(cell, 1);
+        }
+    }
+
+    /**
+    @brief
+        Searches the best move for the player to move in the position of setPosition().
+    @param timeout
+        The time in seconds after which the search stops. At least the first iteration (depth 1) is completed.
+    @param maxDepth
+        The search stops after this depth even if there's time left.
+    */
+    Mini4DgameSearch::Result Mini4DgameSearch::search(float timeout, int maxDepth)
+    {
+        const unsigned long long start = this->clock_->getRealMicroseconds();
+        this->deadline_ = start + static_cast<unsigned long long>(std::max(timeout, 0.0f) * 1000000.0f);
+
+        Worker& root = *this->workers_[0];
+        root.nodes = 0;
+        memset(root.killers, -1, sizeof(root.killers));
+        memset(root.history, 0, sizeof(root.history));
+
+        Result result;
+
+        // immediate wins and forced blocks don't need a search
+        if (root.threats[0].any())
+        {
+            result.move = root.threats[0].first();
+            result.score = WinScore;
+        }
+        else if (root.threats[1].any())
+        {
+            result.move = root.threats[1].first();
+            result.score = (root.threats[1].count() > 1 ? -(WinScore - 1) : 0);
+        }
+        else if (root.numStones < NumCells)
+        {
+            this->rootMoves_.clear();
+            for (int cell = 0; cell < NumCells; ++cell)
+                if (!root.stones[0].test(cell) && !root.stones[1].test(cell))
+                    this->rootMoves_.push_back(cell);
+            this->rootScores_.resize(this->rootMoves_.size());
+
+            // start with the cells which are part of the most lines
+            std::vector<std::pair<int, int> > ordered;
+            for (size_t i = 0; i < this->rootMoves_.size(); ++i)
+            {
+                root.makeMove(this->rootMoves_[i]);
+                ordered.push_back(std::make_pair(root.evaluate() - 4 * cellLineCount[this->rootMoves_[i]], this->rootMoves_[i]));
+                root.unmakeMove(this->rootMoves_[i]);
+            }
+            std::stable_sort(ordered.begin(), ordered.end());
+            for (size_t i = 0; i < ordered.size(); ++i)
+                this->rootMoves_[i] = ordered[i].second;
+
+            maxDepth = std::min(maxDepth, NumCells - root.numStones);
+            for (int depth = 1; depth <= maxDepth; ++depth)
+            {
+                this->bCheckDeadline_ = (depth > 1);
+                this->bAborted_ = false;
+                this->searchRoot(depth);
+                if (this->bAborted_)
+                    break;
+
+                result.move = this->rootMoves_[this->bestRootMove_];
+                result.score = this->rootScores_[this->bestRootMove_];
+                result.depth = depth;
+
+                // search the best move first in the next iteration, followed by the other moves ordered by their score
+                std::vector<std::pair<int, int> > scored;
+                for (size_t i = 0; i < this->rootMoves_.size(); ++i)
+                    if (i != this->bestRootMove_)
+                        scored.push_back(std::make_pair(-this->rootScores_[i], this->rootMoves_[i]));
+                std::stable_sort(scored.begin(), scored.end());
+                this->rootMoves_[0] = result.move;
+                for (size_t i = 0; i < scored.size(); ++i)
+                    this->rootMoves_[i + 1] = scored[i].second;
+
+                if (Mini4DgameSearch::isWinScore(result.score) || this->clock_->getRealMicroseconds() >= this->deadline_)
+                    break;
+            }
+        }
+
+        for (unsigned int i = 0; i < this->numThreads_; ++i)
+            result.nodes += this->workers_[i]->nodes;
+        result.time = this->clock_->getRealMicroseconds() - start;
+        return result;
+    }
+
+    /**
+        @brief Searches all root moves with the given depth. The first move is searched alone, the other moves are distributed to all threads.
+    */
+    void Mini4DgameSearch::searchRoot(int depth)
+    {
+        Worker& root = *this->workers_[0];
+
+        const int firstMove = this->rootMoves_[0];
+        root.makeMove(firstMove);
+        const int score = -this->negamax(root, depth - 1, -Infinity, Infinity, 1);
+        root.unmakeMove(firstMove);
+        if (this->bAborted_)
+            return;
+
+        this->rootScores_[0] = score;
+        this->rootAlpha_ = score;
+        this->bestRootMove_ = 0;
+        this->nextRootMove_ = 1;
+
+        if (this->numThreads_ > 1 && this->rootMoves_.size() > 2)
+        {
+            boost::thread_group threads;
+            for (unsigned int i = 1; i < this->numThreads_; ++i)
+            {
+                Worker& worker = *this->workers_[i];
+                const uint64_t nodes = worker.nodes;
+                worker = root;
+                worker.nodes = (depth == 1 ? 0 : nodes);
+                threads.create_thread(boost::bind(&Mini4DgameSearch::searchRootMoves, this, boost::ref(worker), depth));
+            }
+            this->searchRootMoves(root, depth);
+            threads.join_all();
+        }
+        else
+            this->searchRootMoves(root, depth);
+    }
+
+    /**
+        @brief Searches root moves until all moves are taken. Is called by each thread.
+    */
+    void Mini4DgameSearch::searchRootMoves(Worker& worker, int depth)
+    {
+        while (!this->bAborted_)
+        {
+            size_t index;
+            int alpha;
+            {
+                boost::mutex::scoped_lock lock(this->rootMutex_);
+                if (this->nextRootMove_ >= this->rootMoves_.size())
+                    return;
+                index = this->nextRootMove_++;
+                alpha = this->rootAlpha_;
+            }
+
+            // a null window search proves that the move is not better than the best move so far, otherwise it's searched again with a full window
+            const int move = this->rootMoves_[index];
+            worker.makeMove(move);
+            int score = -this->negamax(worker, depth - 1, -alpha - 1, -alpha, 1);
+            if (score > alpha && !this->bAborted_)
+                score = -this->negamax(worker, depth - 1, -Infinity, -alpha, 1);
+            worker.unmakeMove(move);
+            if (this->bAborted_)
+                return;
+
+            boost::mutex::scoped_lock lock(this->rootMutex_);
+            this->rootScores_[index] = score;
+            if (score > this->rootAlpha_)
+            {
+                this->rootAlpha_ = score;
+                this->bestRootMove_ = index;
+            }
+        }
+    }
+
+    /**
+        @brief The alpha-beta search (fail-soft negamax). Returns the score from the point of view of the player to move.
+    */
+    int Mini4DgameSearch::negamax(Worker& worker, int depth, int alpha, int beta, int ply)
+    {
+        if ((++worker.nodes & NodesBetweenTimeChecks) == 0 && this->bCheckDeadline_ && this->clock_->getRealMicroseconds() >= this->deadline_)
+            this->bAborted_ = true;
+        if (this->bAborted_)
+            return 0;
+
+        const int side = worker.side;
+        const int opponent = 1 - side;
+
+        // the player to move completes a line
+        if (worker.threats[side].any())
+            return WinScore - ply;
+        if (worker.numStones == NumCells)
+            return 0;
+
+        // the opponent would complete a line with the next move, hence the player has to block it (the forced move doesn't reduce the depth, but counts as ply)
+        if (worker.threats[opponent].any())
+        {
+            if (worker.threats[opponent].count() > 1)
+                return -(WinScore - ply - 1);
+
+            const int move = worker.threats[opponent].first();
+            worker.makeMove(move);
+            const int score = -this->negamax(worker, depth, -beta, -alpha, ply + 1);
+            worker.unmakeMove(move);
+            return score;
+        }
+
+        if (depth <= 0)
+            return worker.evaluate();
+
+        int score;
+        int tableMove = -1;
+        if (this->probeTable(worker.hash, depth, alpha, beta, ply, score, tableMove))
+            return score;
+
+        // order the moves: the move from the table first, then the killer moves, then by the history and the number of lines through the cell
+        uint64_t moves[NumCells];
+        int numMoves = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            for (uint64_t bits = ~(worker.stones[0].words[i] | worker.stones[1].words[i]); bits; bits &= bits - 1)
+            {
+                const int cell = (i << 6) | bitScan(bits);
+                uint64_t key = worker.history[cell] + cellLineCount[cell];
+                if (cell == tableMove)
+                    key += (1 << 30);
+                else if (cell == worker.killers[ply][0])
+                    key += (1 << 29);
+                else if (cell == worker.killers[ply][1])
+                    key += (1 << 28);
+                moves[numMoves++] = (key << 8) | cell;
+            }
+        }
+        std::sort(moves, moves + numMoves, std::greater<uint64_t>());
+
+        const int originalAlpha = alpha;
+        int bestScore = -Infinity;
+        int bestMove = -1;
+        for (int i = 0; i < numMoves; ++i)
+        {
+            const int move = static_cast<int>(moves[i] & 0xFF);
+            worker.makeMove(move);
+            score = -this->negamax(worker, depth - 1, -beta, -alpha, ply + 1);
+            worker.unmakeMove(move);
+            if (this->bAborted_)
+                return 0;
+
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestMove = move;
+                if (score > alpha)
+                {
+                    alpha = score;
+                    if (alpha >= beta)
+                    {
+                        if (worker.killers[ply][0] != move)
+                        {
+                            worker.killers[ply][1] = worker.killers[ply][0];
+                            worker.killers[ply][0] = move;
+                        }
+                        worker.history[move] += depth * depth;
+                        break;
+                    }
+                }
+            }
+        }
+
+        int bound = ExactScore;
+        if (bestScore <= originalAlpha)
+            bound = UpperBound;
+        else if (bestScore >= beta)
+            bound = LowerBound;
+        this->storeTable(worker.hash, depth, bestScore, bound, bestMove, ply);
+
+        return bestScore;
+    }
+
+    /**
+        @brief Looks up a position in the transposition table. Returns true if the stored score can be used, otherwise only @a move may be set.
+    */
+    bool Mini4DgameSearch::probeTable(uint64_t hash, int depth, int alpha, int beta, int ply, int& score, int& move) const
+    {
+        const TableEntry& entry = this->table_[hash & (this->table_.size() - 1)];
+        const uint64_t data = entry.data;
+        if ((entry.check ^ data) != hash || data == 0)
+            return false;
+
+        move = static_cast<int>(data & 0x1FF) - 1;
+        const int storedDepth = static_cast<int>((data >> 9) & 0x1FF);
+        const int bound = static_cast<int>((data >> 18) & 0x3);
+        if (storedDepth < depth)
+            return false;
+
+        // wins are stored relative to the stored position
+        score = static_cast<int>(static_cast<uint32_t>(data >> 32)) - Infinity;
+        if (score > WinScore - MaxPly)
+            score -= ply;
+        else if (score < -(WinScore - MaxPly))
+            score += ply;
+
+        return (bound == ExactScore || (bound == LowerBound && score >= beta) || (bound == UpperBound && score <= alpha));
+    }
+
+    /**
+        @brief Stores the result of a search in the transposition table. Entries of other positions are always replaced, entries of the same position only by deeper searches.
+    */
+    void Mini4DgameSearch::storeTable(uint64_t hash, int depth, int score, int bound, int move, int ply)
+    {
+        TableEntry& entry = this->table_[hash & (this->table_.size() - 1)];
+        if ((entry.check ^ entry.data) == hash && static_cast<int>((entry.data >> 9) & 0x1FF) > depth)
+            return;
+
+        if (score > WinScore - MaxPly)
+            score += ply;
+        else if (score < -(WinScore - MaxPly))
+            score -= ply;
+
+        const uint64_t data = (static_cast<uint64_t>(score + Infinity) << 32) | (static_cast<uint64_t>(bound) << 18)
+                            | (static_cast<uint64_t>(depth) << 9) | static_cast<uint64_t>(move + 1);
+        entry.check = hash ^ data;
+        entry.data = data;
+    }
+
+    /**
+        @brief Returns the coordinates of a cell.
+    */
+    /*static*/ void Mini4DgameSearch::getCellPosition(int cell, int& x, int& y, int& z, int& w)
+    {
+        x = (cell >> 6) & 3;
+        y = (cell >> 4) & 3;
+        z = (cell >> 2) & 3;
+        w = cell & 3;
+    }
+
+    /**
+        @brief Returns the cells of a line (0 <= line < NumLines).
+    */
+    /*static*/ const Mini4DgameBitboard& Mini4DgameSearch::getLineMask(int line)
+    {
+        Mini4DgameSearch::initialize();
+        return lineMasks[line];
+    }
+
+    /**
+        @brief Returns true if the stones (of one player) contain a complete line through the given cell.
+    */
+    /*static*/ bool Mini4DgameSearch::isWinningMove(const Mini4DgameBitboard& stones, int cell)
+    {
+        Mini4DgameSearch::initialize();
+        for (int i = 0; i < cellLineCount[cell]; ++i)
+            if (stones.contains(lineMasks[cellLines[cell][i]]))
+                return true;
+        return false;
+    }
+
+    /**
+        @brief Returns true if the score of a search means that one of the players wins.
+    */
+    /*static*/ bool Mini4DgameSearch::isWinScore(int score)
+    {
+        return (score > WinScore - MaxPly || score < -(WinScore - MaxPly));
+    }
+
+    /**
+        @brief Computes the lines and the hash keys. The lines are generated by walking from each cell in all 40 directions (one of each pair of opposite directions).
+    */
+    /*static*/ void Mini4DgameSearch::initialize()
+    {
+        if (bInitialized)
+            return;
+
+        memset(cellLineCount, 0, sizeof(cellLineCount));
+
+        int numLines = 0;
+        for (int direction = 0; direction < 81; ++direction)
+        {
+            const int delta[4] = { direction / 27 - 1, (direction / 9) % 3 - 1, (direction / 3) % 3 - 1, direction % 3 - 1 };
+
+            // skip the null direction and directions whose first non-zero component is negative
+            int firstNonZero = 0;
+            for (int i = 0; i < 4 && firstNonZero == 0; ++i)
+                firstNonZero = delta[i];
+            if (firstNonZero <= 0)
+                continue;
+
+            for (int start = 0; start < NumCells; ++start)
+            {
+                int position[4];
+                Mini4DgameSearch::getCellPosition(start, position[0], position[1], position[2], position[3]);
+
+                bool bInside = true;
+                // the line has to span the whole board in each direction with a non-zero component
+                for (int i = 0; i < 4; ++i)
+                    if (delta[i] != 0)
+                        bInside &= (position[i] + 3 * delta[i] >= 0 && position[i] + 3 * delta[i] < 4);
+                if (!bInside)
+                    continue;
+
+                lineMasks[numLines].clear();
+                for (int step = 0; step < 4; ++step)
+                {
+                    const int cell = Mini4DgameSearch::getCellIndex(position[0] + step * delta[0], position[1] + step * delta[1],
+                                                                    position[2] + step * delta[2], position[3] + step * delta[3]);
+                    lineCells[numLines][step] = cell;
+                    lineMasks[numLines].set(cell);
+                    cellLines[cell][cellLineCount[cell]++] = numLines;
+                }
+                ++numLines;
+            }
+        }
+        assert(numLines == NumLines);
+
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        for (int player = 0; player < 2; ++player)
+            for (int cell = 0; cell < NumCells; ++cell)
+                zobristKeys[player][cell] = nextRandom(state);
+        zobristSideKey = nextRandom(state);
+
+        bInitialized = true;
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file Mini4DgameSearch.h
+    @brief Declaration of the Mini4DgameBitboard and the Mini4DgameSearch class.
+
+    The search doesn't depend on any game objects, it's used by Mini4DgameAI
+    and by the mini4dgame-benchmark tool.
+*/
+
+#ifndef _Mini4DgameSearch_H__
+#define _Mini4DgameSearch_H__
+
+#include "mini4dgame/Mini4DgamePrereqs.h"
+
+#include <vector>
+#include <boost/thread/mutex.hpp>
+
+#include "util/UtilPrereqs.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        A set of cells of the 4x4x4x4 board, stored as 256 bits. Cell (x, y, z, w)
+        has the index 64*x + 16*y + 4*z + w (see Mini4DgameSearch::getCellIndex()).
+    */
+    struct Mini4DgameBitboard
+    {
+        Mini4DgameBitboard()
+            { this->clear(); }
+
+        /// @brief Removes all cells from the set.
+        inline void clear()
+            { this->words[0] = this->words[1] = this->words[2] = this->words[3] = 0; }
+        /// @brief Adds a cell to the set.
+        inline void set(int cell)
+            { this->words[cell >> 6] |= (uint64_t)1 << (cell & 63); }
+        /// @brief Removes a cell from the set.
+        inline void reset(int cell)
+            { this->words[cell >> 6] &= ~((uint64_t)1 << (cell & 63)); }
+        /// @brief Returns true if the cell is in the set.
+        inline bool test(int cell) const
+            { return ((this->words[cell >> 6] >> (cell & 63)) & 1) != 0; }
+        /// @brief Returns true if the set contains at least one cell.
+        inline bool any() const
+            { return (this->words[0] | this->words[1] | this->words[2] | this->words[3]) != 0; }
+        /// @brief Returns true if all cells of @a other are in the set.
+        inline bool contains(const Mini4DgameBitboard& other) const
+        {
+            return (this->words[0] & other.words[0]) == other.words[0] && (this->words[1] & other.words[1]) == other.words[1]
+                && (this->words[2] & other.words[2]) == other.words[2] && (this->words[3] & other.words[3]) == other.words[3];
+        }
+
+        int count() const;
+        int first() const;
+
+        uint64_t words[4]; //!< The bits of the cells, cell i is bit (i % 64) of word (i / 64)
+    };
+
+    /**
+    @brief
+        Searches the best move for a position of the 4D four-in-a-row game.
+
+        The search is an alpha-beta search with iterative deepening which stops
+        when the given time is over and returns the result of the last completed
+        iteration. Positions are stored in a transposition table (with Zobrist
+        hashing) which is shared by all threads. The moves of the root position are
+        distributed to the threads after the first (best) move was searched, which
+        provides the bound for the other moves.
+
+        All 520 lines of the board (rows, columns and all diagonals) are precomputed
+        as bitboards. The evaluation and the lines with three stones (threats) are
+        updated incrementally with each move, hence immediate wins and forced blocks
+        are detected without searching them.
+    */
+    class _Mini4DgameExport Mini4DgameSearch
+    {
+        public:
+            /// @brief The result of a search.
+            struct Result
+            {
+                Result() : move(-1), score(0), depth(0), nodes(0), time(0) {}
+
+                int move;                   //!< The index of the best cell (or -1 if the board is full)
+                int score;                  //!< The score of the move from the point of view of the player to move
+                int depth;                  //!< The depth of the last completed iteration
+                uint64_t nodes;             //!< The number of searched positions (of all threads)
+                unsigned long long time;    //!< The duration of the search in microseconds
+            };
+
+            static const int NumCells = 256;        //!< The number of cells of the board
+            static const int NumLines = 520;        //!< The number of lines of four cells (in all directions)
+            static const int WinScore = 1000000;    //!< The score of a win in the current position, wins in later moves get a lower score
+
+            Mini4DgameSearch(unsigned int numThreads = 0, size_t tableSize = (1 << 20));
+            ~Mini4DgameSearch();
+
+            void setPosition(const Mini4DgameBitboard& player, const Mini4DgameBitboard& opponent);
+            Result search(float timeout, int maxDepth = NumCells);
+
+            void setNumThreads(unsigned int numThreads);
+            /// @brief Returns the number of threads used to search the root position.
+            inline unsigned int getNumThreads() const
+                { return this->numThreads_; }
+
+            void clearTable();
+
+            /// @brief Returns the index of the cell with the given coordinates.
+            static inline int getCellIndex(int x, int y, int z, int w)
+                { return (x << 6) | (y << 4) | (z << 2) | w; }
+            static void getCellPosition(int cell, int& x, int& y, int& z, int& w);
+
+            static const Mini4DgameBitboard& getLineMask(int line);
+            static bool isWinningMove(const Mini4DgameBitboard& stones, int cell);
+            static bool isWinScore(int score);
+
+        private:
+            struct Worker;
+
+            /// @brief An entry of the transposition table. The key is stored xor'ed with the data, so entries which were written concurrently by two threads are ignored.
+            struct TableEntry
+            {
+                uint64_t check; //!< The hash of the position xor data
+                uint64_t data;  //!< The packed score, bound, depth and best move
+            };
+
+            void searchRoot(int depth);
+            void searchRootMoves(Worker& worker, int depth);
+            int negamax(Worker& worker, int depth, int alpha, int beta, int ply);
+
+            bool probeTable(uint64_t hash, int depth, int alpha, int beta, int ply, int& score, int& move) const;
+            void storeTable(uint64_t hash, int depth, int score, int bound, int move, int ply);
+
+            static void initialize();
+
+            unsigned int numThreads_;               //!< The number of threads (including the calling thread)
+            std::vector<TableEntry> table_;         //!< The transposition table, the size is a power of two
+            std::vector<Worker*> workers_;          //!< The state of each thread, workers_[0] belongs to the calling thread and holds the root position
+            Clock* clock_;                          //!< Measures the time of the search
+
+            unsigned long long deadline_;           //!< The time (of clock_) when the search has to stop
+            bool bCheckDeadline_;                   //!< True if the search may be aborted (false while searching depth 1)
+            volatile bool bAborted_;                //!< Set to true if the time is over, all threads stop searching
+
+            boost::mutex rootMutex_;                //!< Protects the following members while the root moves are searched in parallel
+            std::vector<int> rootMoves_;            //!< The moves of the root position, ordered by the score of the previous iteration
+            std::vector<int> rootScores_;           //!< The scores of the root moves in the current iteration
+            size_t nextRootMove_;                   //!< The index of the next root move which should be searched
+            int rootAlpha_;                         //!< The best score of the current iteration so far
+            size_t bestRootMove_;                   //!< The index of the best root move of the current iteration
+    };
+}
+
+#endif /* _Mini4DgameSearch_H__ */
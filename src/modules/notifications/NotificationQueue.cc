@@ -179,10 +179,10 @@ namespace orxonox
       */
     void NotificationQueue::registerVariables()
     {
-        registerVariable( this->name_, VariableDirection::ToClient, new NetworkCallback<NotificationQueue>(this, &NotificationQueue::changedName));
-        registerVariable( this->maxSize_, VariableDirection::ToClient, new NetworkCallback<NotificationQueue>(this, &NotificationQueue::maxSizeChanged));
-        registerVariable( this->targets_, VariableDirection::ToClient, new NetworkCallback<NotificationQueue>(this, &NotificationQueue::targetsChanged));
-        registerVariable( this->displayTime_, VariableDirection::ToClient, new NetworkCallback<NotificationQueue>(this, &NotificationQueue::displayTimeChanged));
+        registerVariable( this->name_, VariableDirection::ToClient, &NotificationQueue::changedName);
+        registerVariable( this->maxSize_, VariableDirection::ToClient, &NotificationQueue::maxSizeChanged);
+        registerVariable( this->targets_, VariableDirection::ToClient, &NotificationQueue::targetsChanged);
+        registerVariable( this->displayTime_, VariableDirection::ToClient, &NotificationQueue::displayTimeChanged);
     }
 
     /**
@@ -90,11 +90,11 @@ namespace orxonox
     
     void NotificationQueueCEGUI::registerVariables()
     {
-        registerVariable( this->position_, VariableDirection::ToClient, new NetworkCallback<NotificationQueueCEGUI>(this, &NotificationQueueCEGUI::positionChanged));
-        registerVariable( this->fontSize_, VariableDirection::ToClient, new NetworkCallback<NotificationQueueCEGUI>(this, &NotificationQueueCEGUI::fontSizeChanged));
-        registerVariable( this->fontColor_, VariableDirection::ToClient, new NetworkCallback<NotificationQueueCEGUI>(this, &NotificationQueueCEGUI::fontColorChanged));
-        registerVariable( this->alignment_, VariableDirection::ToClient, new NetworkCallback<NotificationQueueCEGUI>(this, &NotificationQueueCEGUI::alignmentChanged));
-        registerVariable( this->displaySize_, VariableDirection::ToClient, new NetworkCallback<NotificationQueueCEGUI>(this, &NotificationQueueCEGUI::displaySizeChanged));
+        registerVariable( this->position_, VariableDirection::ToClient, &NotificationQueueCEGUI::positionChanged);
+        registerVariable( this->fontSize_, VariableDirection::ToClient, &NotificationQueueCEGUI::fontSizeChanged);
+        registerVariable( this->fontColor_, VariableDirection::ToClient, &NotificationQueueCEGUI::fontColorChanged);
+        registerVariable( this->alignment_, VariableDirection::ToClient, &NotificationQueueCEGUI::alignmentChanged);
+        registerVariable( this->displaySize_, VariableDirection::ToClient, &NotificationQueueCEGUI::displaySizeChanged);
     }
 
     void NotificationQueueCEGUI::changedName(void)
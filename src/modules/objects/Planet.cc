@@ -167,8 +167,8 @@ namespace orxonox
         registerVariable(this->atmosphereSize, VariableDirection::ToClient);
         registerVariable(this->imageSize, VariableDirection::ToClient);
         // Note: the meshSrc should be synchronised after atmosphere and other values, because the meshSrc callback setts the atmosphere billboards
-        registerVariable(this->meshSrc_, VariableDirection::ToClient, new NetworkCallback<Planet>(this, &Planet::changedMesh));
-        registerVariable(this->bCastShadows_, VariableDirection::ToClient, new NetworkCallback<Planet>(this, &Planet::changedShadows));
+        registerVariable(this->meshSrc_, VariableDirection::ToClient, &Planet::changedMesh);
+        registerVariable(this->bCastShadows_, VariableDirection::ToClient, &Planet::changedShadows);
     }
 
     void Planet::changedVisibility()
@@ -57,8 +57,8 @@ namespace orxonox
 
     void AbstractRadiusHeightCollisionShape::registerVariables()
     {
-        registerVariable(this->radius_, VariableDirection::ToClient, new NetworkCallback<CollisionShape>(this, &CollisionShape::updateShape));
-        registerVariable(this->height_, VariableDirection::ToClient, new NetworkCallback<CollisionShape>(this, &CollisionShape::updateShape));
+        registerVariable(this->radius_, VariableDirection::ToClient, &CollisionShape::updateShape);
+        registerVariable(this->height_, VariableDirection::ToClient, &CollisionShape::updateShape);
     }
 
     void AbstractRadiusHeightCollisionShape::XMLPort(Element& xmlelement, XMLPort::Mode mode)
@@ -66,8 +66,8 @@ namespace orxonox
 
     void PlaneCollisionShape::registerVariables()
     {
-        registerVariable(this->normal_, VariableDirection::ToClient, new NetworkCallback<CollisionShape>(this, &CollisionShape::updateShape));
-        registerVariable(this->offset_, VariableDirection::ToClient, new NetworkCallback<CollisionShape>(this, &CollisionShape::updateShape));
+        registerVariable(this->normal_, VariableDirection::ToClient, &CollisionShape::updateShape);
+        registerVariable(this->offset_, VariableDirection::ToClient, &CollisionShape::updateShape);
     }
 
     void PlaneCollisionShape::XMLPort(Element& xmlelement, XMLPort::Mode mode)
@@ -65,7 +65,7 @@ namespace orxonox
 
     void SphereCollisionShape::registerVariables()
     {
-        registerVariable(this->radius_, VariableDirection::ToClient, new NetworkCallback<CollisionShape>(this, &CollisionShape::updateShape));
+        registerVariable(this->radius_, VariableDirection::ToClient, &CollisionShape::updateShape);
     }
 
     void SphereCollisionShape::XMLPort(Element& xmlelement, XMLPort::Mode mode)
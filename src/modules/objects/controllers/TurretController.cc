@@ -29,6 +29,8 @@
 #include "TurretController.h"
 #include "worldentities/pawns/Pawn.h"
 #include "objects/Turret.h"
+#include "Scene.h"
+#include "controllers/TargetAcquisition.h"
 
  namespace orxonox
  {
@@ -100,11 +102,16 @@
         float tempScore;
         Pawn* minScorePawn = 0;
 
-        for (ObjectList<Pawn>::iterator it = ObjectList<Pawn>::begin(); it != ObjectList<Pawn>::end(); ++it)
+        // the shared target acquisition only returns hostile pawns within the attack radius, the pitch and yaw limits are tested here
+        TargetQuery query(turret, this->getGametype());
+        query.minDistance = turret->getMinAttackRadius();
+        query.maxDistance = turret->getMaxAttackRadius();
+        std::vector<Pawn*> targets;
+        turret->getScene()->getTargetAcquisition()->findTargets(query, targets);
+
+        for (std::vector<Pawn*>::iterator it = targets.begin(); it != targets.end(); ++it)
         {
-            Pawn* entity = orxonox_cast<Pawn*>(*it);
-            if (!entity || FormationController::sameTeam(this->getControllableEntity(), entity, this->getGametype()))
-                continue;
+            Pawn* entity = *it;
             tempScore = turret->isInRange(entity);
             if(tempScore != -1.f)
             {
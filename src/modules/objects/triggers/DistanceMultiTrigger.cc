@@ -61,6 +61,9 @@ namespace orxonox
         this->targetName_ = "";
         this->beaconMask_.exclude(Class(BaseObject));
         this->beaconMask_.include(Class(DistanceTriggerBeacon));
+
+        // The distances of the targets have to be checked each tick.
+        this->setPolling(true);
     }
 
     /**
@@ -98,6 +101,10 @@ namespace orxonox
 
         std::queue<MultiTriggerState*>* queue = NULL;
 
+        // Compare squared distances, this saves a square root for each object.
+        const Vector3& position = this->getWorldPosition();
+        const float squaredDistance = this->distance_ * this->distance_;
+
         // Check for objects that were in range but no longer are. Iterate through all objects, that are in range.
         for(std::map<WorldEntity*, WeakPtr<WorldEntity>* >::iterator it = this->range_.begin(); it != this->range_.end(); )
         {
@@ -111,9 +118,8 @@ namespace orxonox
                 continue;
             }
 
-            Vector3 distanceVec = entity->getWorldPosition() - this->getWorldPosition();
             // If the object is no longer in range.
-            if (distanceVec.length() > this->distance_)
+            if (entity->getWorldPosition().squaredDistance(position) > squaredDistance)
             {
                 // If for some reason the entity could not be removed.
                 if(!this->removeFromRange(key))
@@ -132,16 +138,18 @@ namespace orxonox
         }
 
         // Check for new objects that are in range
-        ClassTreeMask targetMask = this->getTargetMask();
         // If we are in identify-mode another target mask has to be applies to find the DistanceTriggerBeacons.
-        if(this->beaconMode_ == distanceMultiTriggerBeaconMode::identify)
-            targetMask = this->beaconMask_;
+        const ClassTreeMask& targetMask = (this->beaconMode_ == distanceMultiTriggerBeaconMode::identify ? this->beaconMask_ : this->getTargetMask());
 
         // Iterate through all objects that are targets of the DistanceMultiTrigger.
         for(ClassTreeMaskObjectIterator it = targetMask.begin(); it != targetMask.end(); ++it)
         {
             WorldEntity* entity = static_cast<WorldEntity*>(*it);
 
+            // Objects that already are in range were checked above.
+            if(this->range_.find(entity) != this->range_.end())
+                continue;
+
             // If the DistanceMultiTrigger is in identify-mode and the DistanceTriggerBeacon attached to the object has the wrong name we ignore it.
             if(this->beaconMode_ == distanceMultiTriggerBeaconMode::identify)
             {
@@ -170,12 +178,10 @@ namespace orxonox
                     continue;
             }
 
-            Vector3 distanceVec = entity->getWorldPosition() - this->getWorldPosition();
             // If the object is in range.
-            if (distanceVec.length() <= this->distance_)
+            if (entity->getWorldPosition().squaredDistance(position) <= squaredDistance)
             {
                 // Add the object to the objects that are in range.
-                // Objects that already are in range are not added twice, because in a map (this->range_) each key can only exist once and thus addToRange() will reject all attempts of duplicate entries.
                 if(!this->addToRange(entity))
                     continue;
 
@@ -34,6 +34,7 @@
 
 #include "MultiTrigger.h"
 
+#include "util/SmallObjectAllocator.h"
 #include "core/CoreIncludes.h"
 #include "core/XMLPort.h"
 
@@ -42,6 +43,28 @@
 namespace orxonox
 {
 
+    /**
+    @brief
+        Returns the pool of the MultiTriggerStates.
+    */
+    static SmallObjectAllocator& getStateAllocator()
+    {
+        static SmallObjectAllocator allocator(sizeof(MultiTriggerState), 256);
+        return allocator;
+    }
+
+    void* MultiTriggerState::operator new(size_t size)
+    {
+        assert(size == sizeof(MultiTriggerState));
+        return getStateAllocator().alloc();
+    }
+
+    void MultiTriggerState::operator delete(void* state)
+    {
+        if(state != NULL)
+            getStateAllocator().free(state);
+    }
+
     RegisterClass(MultiTrigger);
 
     /**
@@ -57,6 +80,7 @@ namespace orxonox
         this->maxNumSimultaneousTriggerers_ = INF_s;
 
         this->bBroadcast_ = false;
+        this->bPolling_ = false;
 
         this->targetMask_.exclude(Class(BaseObject));
 
@@ -121,8 +145,12 @@ namespace orxonox
 
         SUPER(MultiTrigger, tick, dt);
 
+        // If the MultiTrigger doesn't poll, its state only changes through changeTriggered() or its children, which add a pending state. So there is nothing to do.
+        if(!this->bPolling_ && this->stateQueue_.empty())
+            return;
+
         // Let the MultiTrigger return the states that trigger and process the new states if there are any.
-        std::queue<MultiTriggerState*>* queue  = this->letTrigger();
+        std::queue<MultiTriggerState*>* queue = (this->bPolling_ ? this->letTrigger() : NULL);
         if(queue != NULL)
         {
             while(queue->size() > 0)
@@ -339,6 +367,7 @@ namespace orxonox
     @brief
         This method is called by the MultiTrigger to get information about new trigger events that need to be looked at.
         This method is the device for the behavior (the conditions under which the MultiTrigger triggers) of any derived class of MultiTrigger.
+        It's only called if the MultiTrigger polls, derived classes which override it have to call setPolling(true).
     @return
         Returns a pointer to a queue of MultiTriggerState pointers, containing all the necessary information to decide whether these states should indeed become new states of the MultiTrigger.
         Please be aware that both the queue and the states in the queue need to be deleted once they have been used. This is already done in the tick() method of this class but would have to be done by any method calling this method.
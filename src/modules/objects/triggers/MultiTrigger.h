@@ -51,13 +51,17 @@ namespace orxonox
     /**
     @brief
     Struct to handle @ref orxonox::MultiTrigger "MultiTrigger" states internally.
+    The states are allocated from a pool (see @ref orxonox::SmallObjectAllocator "SmallObjectAllocator"), because many of them are created and destroyed each tick.
 
     @ingroup MultiTrigger
     */
-    struct MultiTriggerState
+    struct _ObjectsExport MultiTriggerState
     {
         BaseObject* originator;
         bool bTriggered;
+
+        static void* operator new(size_t size); //!< Allocates a state from the pool.
+        static void operator delete(void* state); //!< Returns a state to the pool.
     };
 
     /**
@@ -156,6 +160,20 @@ namespace orxonox
             bool isModeTriggered(BaseObject* triggerer = NULL); //!< Checks whether the MultiTrigger is triggered concerning it's children.
             bool isTriggered(BaseObject* triggerer = NULL); //!< Get whether the MultiTrigger is triggered for a given object.
 
+            /**
+            @brief Set whether letTrigger() has to be called each tick.
+                   MultiTriggers which only change their state through changeTriggered() (e.g. upon receiving an event) or through their children don't poll and their tick() returns immediately while there are no pending states.
+            @param bPolling True if letTrigger() has to be called each tick.
+            */
+            inline void setPolling(bool bPolling)
+                { this->bPolling_ = bPolling; }
+            /**
+            @brief Get whether letTrigger() is called each tick.
+            @return Returns true if the MultiTrigger polls.
+            */
+            inline bool isPolling(void) const
+                { return this->bPolling_; }
+
             virtual void fire(bool status, BaseObject* originator = NULL);  //!< Helper method. Creates an Event for the given status and originator and fires it.
             void broadcast(bool status); //!< Helper method. Broadcasts an Event for every object that is a target.
 
@@ -187,6 +205,7 @@ namespace orxonox
             int maxNumSimultaneousTriggerers_; //!< The maximum number of objects simultaneously trigggering this MultiTrigger.
 
             bool bBroadcast_; //!< Bool for the broadcast-mode, if true all triggers go to all possible targets.
+            bool bPolling_; //!< Bool for the polling, if false letTrigger() isn't called.
 
             std::set<BaseObject*> active_; //!< The set of all objects the MultiTrigger is active for.
             std::set<BaseObject*> triggered_; //!< The set of all objects the MultiTrigger is triggered for.
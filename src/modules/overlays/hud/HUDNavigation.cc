@@ -36,6 +36,7 @@
 #include <OgreTextAreaOverlayElement.h>
 #include <OgrePanelOverlayElement.h>
 
+#include <algorithm>
 #include <typeinfo>
 
 #include "util/Math.h"
@@ -61,11 +62,6 @@ namespace orxonox
     SetConsoleCommand("HUDNavigation","selectClosest", &HUDNavigation::selectClosestTarget).addShortcut().keybindMode(KeybindMode::OnPress);
     SetConsoleCommand("HUDNavigation","selectNext", &HUDNavigation::selectNextTarget).addShortcut().keybindMode(KeybindMode::OnPress);
 
-    static bool compareDistance(std::pair<RadarViewable*, unsigned int> a,
-            std::pair<RadarViewable*, unsigned int> b)
-    {
-        return a.second < b.second;
-    }
     RegisterClass ( HUDNavigation );
 
     HUDNavigation* HUDNavigation::localHUD_s = 0;
@@ -99,7 +95,8 @@ namespace orxonox
             for (std::map<RadarViewable*, ObjectInfo>::iterator it = this->activeObjectList_.begin(); it != this->activeObjectList_.end();)
             removeObject((it++)->first);
         }
-        this->sortedObjectList_.clear();
+        this->proximityIndex_.clear();
+        this->shownObjects_.clear();
     }
 
     void HUDNavigation::setConfigValues()
@@ -186,13 +183,13 @@ namespace orxonox
         return;
         const Matrix4& camTransform = cam->getOgreCamera()->getProjectionMatrix() * cam->getOgreCamera()->getViewMatrix();
 
-        for (std::list<std::pair<RadarViewable*, unsigned int> >::iterator listIt = this->sortedObjectList_.begin(); listIt != this->sortedObjectList_.end(); ++listIt)
-        listIt->second = (int)((listIt->first->getRVWorldPosition() - HumanController::getLocalControllerSingleton()->getControllableEntity()->getWorldPosition()).length() + 0.5f);
-
-        this->sortedObjectList_.sort(compareDistance);
+        // only the objects which may get a marker have to be sorted
+        ControllableEntity* entity = HumanController::getLocalControllerSingleton()->getControllableEntity();
+        this->proximityIndex_.update(entity->getScene()->getRadar(), entity->getWorldPosition(), this->markerLimit_);
+        const std::vector<RadarProximityIndex::Entry>& sortedObjects = this->proximityIndex_.getEntries();
 
-        unsigned int markerCount = 0;
         bool closeEnough = false; // only display objects that are close enough to be relevant for the player
+        std::vector<RadarViewable*> shownObjects;
 
         // if the selected object doesn't exist any more or is now out of range select the closest object
         std::map<RadarViewable*, ObjectInfo>::iterator selectedActiveObject = this->activeObjectList_.find(this->selectedTarget_);
@@ -208,16 +205,18 @@ namespace orxonox
 
         bool nextHasToBeSelected = false;
 
-        for (std::list<std::pair<RadarViewable*, unsigned int> >::iterator listIt = this->sortedObjectList_.begin(); listIt != this->sortedObjectList_.end(); ++markerCount, ++listIt)
+        for (size_t markerCount = 0; markerCount < this->proximityIndex_.getNumNearest(); ++markerCount)
         {
 
-            std::map<RadarViewable*, ObjectInfo>::iterator it = this->activeObjectList_.find(listIt->first);
-            closeEnough = listIt->second < this->detectionLimit_;
-            // display radarviewables on HUD if the marker limit and max-distance is not exceeded
-            if (markerCount < this->markerLimit_ && (closeEnough || this->detectionLimit_ < 0))
+            std::map<RadarViewable*, ObjectInfo>::iterator it = this->activeObjectList_.find(sortedObjects[markerCount].object);
+            int dist = (int)(sqrt(sortedObjects[markerCount].squaredDistance) + 0.5f);
+            closeEnough = dist < this->detectionLimit_;
+            // display radarviewables on HUD if the max-distance is not exceeded (the marker limit is respected by the proximity index)
+            if (closeEnough || this->detectionLimit_ < 0)
             {
+                shownObjects.push_back(it->first);
+
                 // Get Distance to HumanController and save it in the TextAreaOverlayElement.
-                int dist = listIt->second;
                 float textLength = 0.0f;
 
                 if (this->showDistance_)
@@ -237,7 +236,7 @@ namespace orxonox
                 if(this->closestTarget_)
                 // select the closest object
                 {
-                    if(listIt == this->sortedObjectList_.begin())
+                    if(markerCount == 0)
                     {
                         it->second.selected_ = true;
                         this->selectedTarget_ = it->first;
@@ -262,20 +261,18 @@ namespace orxonox
                         it->second.selected_ = false;
 
                         // check if there's a next object
-                        listIt++;
-                        if(listIt != this->sortedObjectList_.end())
+                        if(markerCount + 1 < sortedObjects.size())
                         {
                             // and if the marker limit and max-distance are not exceeded for it
                             if (markerCount + 1 >= this->markerLimit_ ||
-                                    (listIt->second > this->detectionLimit_ && detectionLimit_ >= 0))
+                                    ((int)(sqrt(sortedObjects[markerCount + 1].squaredDistance) + 0.5f) > this->detectionLimit_ && detectionLimit_ >= 0))
                             {
                                 // otherwise select the closest object
-                                this->activeObjectList_.find(this->sortedObjectList_.begin()->first)->second.selected_ = true;
+                                this->activeObjectList_.find(sortedObjects.front().object)->second.selected_ = true;
                                 this->selectedTarget_ = it->first;
                                 nextHasToBeSelected = false;
                             }
                         }
-                        listIt--;
                     }
                 }
 
@@ -505,16 +502,22 @@ namespace orxonox
 
                 }
             }
-            else // do not display on HUD
+        }
 
-            {
-                it->second.health_->hide();
-                it->second.healthLevel_->hide();
-                it->second.panel_->hide();
-                it->second.text_->hide();
-                it->second.target_->hide();
-            }
+        // hide the markers of the objects which aren't displayed any more
+        for (size_t i = 0; i < this->shownObjects_.size(); ++i)
+        {
+            if (std::find(shownObjects.begin(), shownObjects.end(), this->shownObjects_[i]) != shownObjects.end())
+                continue;
+
+            std::map<RadarViewable*, ObjectInfo>::iterator it = this->activeObjectList_.find(this->shownObjects_[i]);
+            it->second.health_->hide();
+            it->second.healthLevel_->hide();
+            it->second.panel_->hide();
+            it->second.text_->hide();
+            it->second.target_->hide();
         }
+        this->shownObjects_.swap(shownObjects);
 
         this->closestTarget_ = false;
         this->nextTarget_ = false;
@@ -615,7 +618,7 @@ namespace orxonox
         this->background_->addChild(target);
         this->background_->addChild(text);
 
-        this->sortedObjectList_.push_front(std::make_pair(object, (unsigned int)0));
+        this->proximityIndex_.add(object);
     }
 
     void HUDNavigation::removeObject(RadarViewable* viewable)
@@ -640,21 +643,33 @@ namespace orxonox
             this->activeObjectList_.erase(viewable);
         }
 
-        for (std::list<std::pair<RadarViewable*, unsigned int> >::iterator listIt = this->sortedObjectList_.begin(); listIt != this->sortedObjectList_.end(); ++listIt)
-        {
-            if ((listIt->first) == viewable)
-            {
-                this->sortedObjectList_.erase(listIt);
-                break;
-            }
-        }
+        this->proximityIndex_.remove(viewable);
+        this->shownObjects_.erase(std::remove(this->shownObjects_.begin(), this->shownObjects_.end(), viewable), this->shownObjects_.end());
     }
 
     void HUDNavigation::objectChanged(RadarViewable* viewable)
     {
-        // TODO: niceification neccessary ;)
-        removeObject(viewable);
-        addObject(viewable);
+        std::map<RadarViewable*, ObjectInfo>::iterator it = this->activeObjectList_.find(viewable);
+
+        // add or remove the object if its visibility changed
+        if (!this->showObject(viewable))
+        {
+            if (it != this->activeObjectList_.end())
+                this->removeObject(viewable);
+            return;
+        }
+        if (it == this->activeObjectList_.end())
+        {
+            this->addObject(viewable);
+            return;
+        }
+
+        // otherwise only update the colour of the existing overlay elements instead of creating new ones
+        const ColourValue& colour = viewable->getRadarObjectColour();
+        it->second.panel_->setMaterialName(TextureGenerator::getMaterialName(it->second.wasOutOfView_ ? "arrows.png" : "tdc.png", colour));
+        it->second.health_->setMaterialName(TextureGenerator::getMaterialName("barSquare.png", colour));
+        it->second.target_->setMaterialName(TextureGenerator::getMaterialName("target.png", colour));
+        it->second.text_->setColour(colour);
     }
 
     bool HUDNavigation::showObject(RadarViewable* rv)
@@ -34,10 +34,12 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "util/OgreForwardRefs.h"
 #include "tools/interfaces/Tickable.h"
 #include "interfaces/RadarListener.h"
+#include "RadarProximityIndex.h"
 #include "overlays/OrxonoxOverlay.h"
 
 namespace orxonox
@@ -140,7 +142,8 @@ namespace orxonox
             Vector3 toAimPosition(RadarViewable* target) const;
 
             std::map<RadarViewable*, ObjectInfo> activeObjectList_;
-            std::list<std::pair<RadarViewable*, unsigned int> > sortedObjectList_;
+            RadarProximityIndex proximityIndex_;        //!< The objects in activeObjectList_, the nearest objects are sorted by their distance
+            std::vector<RadarViewable*> shownObjects_;  //!< The objects whose markers were displayed in the last tick
 
             float healthMarkerSize_;
             float healthLevelMarkerSize_;
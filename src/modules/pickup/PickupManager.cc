@@ -56,8 +56,9 @@ namespace orxonox
     /*static*/ const std::string PickupManager::guiName_s = "PickupInventory";
 
     // Register static network functions that are used to communicate changes to pickups over the network, such that the PickupInventory can display the information about the pickups properly.
-    registerStaticNetworkFunction(PickupManager::pickupChangedUsedNetwork);
-    registerStaticNetworkFunction(PickupManager::pickupChangedPickedUpNetwork);
+    // Both only update the PickupInventory, so they don't have to wait for lost packets of the other calls (they stay in order with each other on their own channel).
+    registerStaticNetworkFunctionWithQoS(PickupManager::pickupChangedUsedNetwork, CallQoS::ReliableUnordered);
+    registerStaticNetworkFunctionWithQoS(PickupManager::pickupChangedPickedUpNetwork, CallQoS::ReliableUnordered);
     registerStaticNetworkFunction(PickupManager::dropPickupNetworked);
     registerStaticNetworkFunction(PickupManager::usePickupNetworked);
 
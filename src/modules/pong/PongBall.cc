@@ -123,7 +123,20 @@ namespace orxonox
         registerVariable( this->speed_ );
         registerVariable( this->relMercyOffset_ );
         registerVariable( this->batID_[0] );
-        registerVariable( this->batID_[1], VariableDirection::ToClient, new NetworkCallback<PongBall>( this, &PongBall::applyBats) );
+        registerVariable( this->batID_[1], VariableDirection::ToClient, &PongBall::applyBats );
+    }
+
+    /**
+    @brief
+        A joining client needs the bats to apply them (see applyBats()).
+    */
+    void PongBall::getReferencedObjects(std::vector<uint32_t>& objectIDs) const
+    {
+        MovableEntity::getReferencedObjects(objectIDs);
+
+        for (unsigned int i = 0; i < 2; ++i)
+            if (this->batID_[i] != OBJECTID_UNKNOWN)
+                objectIDs.push_back(this->batID_[i]);
     }
 
     /**
@@ -65,6 +65,7 @@ namespace orxonox
             virtual void tick(float dt);
 
             virtual void XMLPort(Element& xmlelement, XMLPort::Mode mode);
+            virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const;
 
             /**
             @brief Set the dimensions of the playing field.
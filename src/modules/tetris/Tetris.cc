@@ -48,6 +48,7 @@
 #include "TetrisCenterpoint.h"
 #include "TetrisStone.h"
 #include "TetrisBrick.h"
+#include "TetrisGrid.h"
 #include "infos/PlayerInfo.h"
 #include <cmath>
 
@@ -103,9 +104,12 @@ namespace orxonox
             this->futureBrick_ = 0;
         }
 
-        for (std::list<SmartPtr<TetrisStone> >::iterator it = this->stones_.begin(); it != this->stones_.end(); ++it)
-            (*it)->destroy();
+        for (std::vector<SmartPtr<TetrisStone> >::iterator it = this->stones_.begin(); it != this->stones_.end(); ++it)
+            if (*it)
+                (*it)->destroy();
         this->stones_.clear();
+        if (this->center_)
+            this->center_->getGrid().clear();
     }
 
     void Tetris::tick(float dt)
@@ -116,10 +120,19 @@ namespace orxonox
         {
             if(!this->isValidBrickPosition(this->activeBrick_))
             {
+                std::vector<TetrisStone*> stones;
                 for (unsigned int i = 0; i < this->activeBrick_->getNumberOfStones(); i++)
-                    this->stones_.push_back(this->activeBrick_->getStone(i));
+                    stones.push_back(this->activeBrick_->getStone(i));
                 this->activeBrick_->setVelocity(Vector3::ZERO);
                 this->activeBrick_->releaseStones(this->center_);
+                bool bInside = true;
+                for (unsigned int i = 0; i < stones.size(); i++)
+                    bInside = this->addStone(stones[i]) && bInside;
+                if(!bInside) // the stack of stones reached the top of the playing field
+                {
+                    this->end();
+                    return;
+                }
                 this->findFullRows();
                 this->startBrick();
             }
@@ -135,13 +148,13 @@ namespace orxonox
         else if(position.x > (this->center_->getWidth()-0.5)*this->center_->getStoneSize()) //!< If the stone touches the right edge of the level
             return false;
 
-        for(std::list<SmartPtr<TetrisStone> >::const_iterator it = this->stones_.begin(); it != this->stones_.end(); ++it)
-        {
-            const Vector3& currentStonePosition = (*it)->getPosition(); //!< Saves the position of the currentStone
-
-            if((position.x == currentStonePosition.x) && abs(position.y-currentStonePosition.y) < this->center_->getStoneSize())
-                return false;
-        }
+        // the stone collides with the stones whose center is less than one stone size away (at most two rows)
+        const TetrisGrid& grid = this->center_->getGrid();
+        const int column = static_cast<int>(floor(position.x/this->center_->getStoneSize()));
+        const float row = position.y/this->center_->getStoneSize() - 0.5f;
+        const int lowerRow = static_cast<int>(floor(row));
+        if(grid.isOccupied(column, lowerRow) || (row > lowerRow && grid.isOccupied(column, lowerRow + 1)))
+            return false;
 
         return true;
     }
@@ -190,18 +203,25 @@ namespace orxonox
     {
         assert(stone);
 
-        // check for collisions with all stones
-        for(std::list<SmartPtr<TetrisStone> >::const_iterator it = this->stones_.begin(); it != this->stones_.end(); ++it)
+        const TetrisGrid& grid = this->center_->getGrid();
+        const float stoneSize = this->center_->getStoneSize();
+        const int column = static_cast<int>(floor(position.x/stoneSize));
+
+        // check the (at most two) rows of steady stones which the falling stone can touch, the upper row first
+        const int upperRow = static_cast<int>(floor(position.y/stoneSize));
+        for (int row = upperRow; row >= upperRow - 1; --row)
         {
-            //Vector3 currentStonePosition = rotateVector((*it)->getPosition(), this->activeBrick_->getRotationCount());
-            const Vector3& currentStonePosition = (*it)->getPosition(); //!< Saves the position of the currentStone
+            if(!grid.isOccupied(column, row))
+                continue;
+
+            const float currentStoneY = (row + 0.5f)*stoneSize; //!< The position of the steady stone
 
             //filter out cases where the falling stone is already below a steady stone
-            if(position.y < currentStonePosition.y - this->center_->getStoneSize()/2.0f)
+            if(position.y < currentStoneY - stoneSize/2.0f)
                 continue;
-            if((position.x == currentStonePosition.x) && (position.y < currentStonePosition.y + this->center_->getStoneSize()))
+            if(position.y < currentStoneY + stoneSize)
             {
-                float y_offset = static_cast<int>((this->activeBrick_->getPosition().y-currentStonePosition.y+10)/10)*10 + currentStonePosition.y;
+                float y_offset = static_cast<int>((this->activeBrick_->getPosition().y-currentStoneY+stoneSize)/stoneSize)*stoneSize + currentStoneY;
                 if(y_offset < 0) //filter out extreme cases (very rare bug)
                     y_offset = 0;
                 this->activeBrick_->setPosition(Vector3(this->activeBrick_->getPosition().x, y_offset, this->activeBrick_->getPosition().z));
@@ -291,6 +311,10 @@ namespace orxonox
     {
         if (this->center_ != NULL) // There needs to be a TetrisCenterpoint, i.e. the area the game takes place.
         {
+            // Start with an empty playing field.
+            this->center_->getGrid().clear();
+            this->stones_.assign(this->center_->getWidth()*this->center_->getHeight(), SmartPtr<TetrisStone>());
+
             // Create the first brick.
             this->createBrick();
         }
@@ -457,57 +481,69 @@ namespace orxonox
         this->center_ = center;
     }
 
+    /**
+    @brief Adds a stone which was released by the active brick to the playing field.
+    @param stone The stone, its position has to be relative to the centerpoint.
+    @return Returns false if the stone is outside of the playing field (and was destroyed).
+    */
+    bool Tetris::addStone(TetrisStone* stone)
+    {
+        const int column = static_cast<int>(floor(stone->getPosition().x/this->center_->getStoneSize()));
+        const int row = static_cast<int>(floor(stone->getPosition().y/this->center_->getStoneSize()));
+
+        TetrisGrid& grid = this->center_->getGrid();
+        if(!grid.isInside(column, row)) // the stone sticks out of the playing field
+        {
+            stone->destroy();
+            return false;
+        }
+
+        grid.setOccupied(column, row, true);
+        this->stones_[row*grid.getWidth() + column] = stone;
+        return true;
+    }
+
     /**
     @brief Check each row if it is full. Removes all full rows. Update
     @brief Manages score.
     */
     void Tetris::findFullRows()
     {
-        unsigned int correctPosition = 0;
-        unsigned int stonesPerRow = 0;
-        for (unsigned int row = 0; row < this->center_->getHeight(); row++)
+        const TetrisGrid& grid = this->center_->getGrid();
+        for (unsigned int row = 0; row < grid.getHeight(); )
         {
-            stonesPerRow = 0;
-            for(std::list<SmartPtr<TetrisStone> >::iterator it = this->stones_.begin(); it != this->stones_.end(); )
+            if(grid.isRowFull(row))
             {
-                std::list<SmartPtr<TetrisStone> >::iterator it_temp = it++;
-                correctPosition = static_cast<unsigned int>(((*it_temp)->getPosition().y - 5)/this->center_->getStoneSize());
-                if(correctPosition == row)
-                {
-                    stonesPerRow++;
-                    if(stonesPerRow == this->center_->getWidth())
-                    {
-                        clearRow(row);
-                        row--; //the row counter has to be decreased in order to detect multiple rows!
-                        this->playerScored(this->player_);// add points
-                        //increase the stone's speed
-                        this->center_->setStoneSpeed(this->center_->getStoneSpeed()+1.0f);
-                    }
-                }
+                clearRow(row); // the rows above move down, so the same row has to be checked again
+                this->playerScored(this->player_);// add points
+                //increase the stone's speed
+                this->center_->setStoneSpeed(this->center_->getStoneSpeed()+1.0f);
             }
+            else
+                row++;
         }
     }
 
     void Tetris::clearRow(unsigned int row)
     {// clear the full row
-        for(std::list<SmartPtr<TetrisStone> >::iterator it = this->stones_.begin(); it != this->stones_.end(); )
+        TetrisGrid& grid = this->center_->getGrid();
+        const unsigned int width = grid.getWidth();
+        for(unsigned int column = 0; column < width; column++)
         {
-            if(static_cast<unsigned int>(((*it)->getPosition().y - 5)/this->center_->getStoneSize()) == row)
-            {
-                (*it)->destroy();
-                this->stones_.erase(it++);
-            }
-            else
-                ++it;
+            if(this->stones_[row*width + column])
+                this->stones_[row*width + column]->destroy();
         }
-      // adjust height of stones above the deleted row //TODO: check if this could be a source of a bug.
-        for(std::list<SmartPtr<TetrisStone> >::iterator it = this->stones_.begin(); it != this->stones_.end(); ++it)
+        // move the stones above the deleted row down
+        for(unsigned int i = row*width; i + width < this->stones_.size(); i++)
         {
-            if(static_cast<unsigned int>(((*it)->getPosition().y - 5)/this->center_->getStoneSize()) > row)
-                (*it)->setPosition((*it)->getPosition()-Vector3(0,10,0));
+            this->stones_[i] = this->stones_[i + width];
+            if(this->stones_[i])
+                this->stones_[i]->setPosition(this->stones_[i]->getPosition()-Vector3(0,this->center_->getStoneSize(),0));
         }
+        for(unsigned int i = this->stones_.size() - width; i < this->stones_.size(); i++)
+            this->stones_[i] = SmartPtr<TetrisStone>();
 
+        grid.removeRow(row);
     }
 
-
 }
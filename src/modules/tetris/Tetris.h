@@ -37,6 +37,8 @@
 
 #include "tetris/TetrisPrereqs.h"
 
+#include <vector>
+
 #include "tools/Timer.h"
 
 #include "gametypes/Deathmatch.h"
@@ -86,6 +88,7 @@ namespace orxonox
             bool checkStoneStoneCollision(TetrisStone* stone, const Vector3& position);
             bool checkStoneBottomCollision(TetrisStone* stone, const Vector3& position);
             bool isValidBrickPosition(TetrisBrick* brick);
+            bool addStone(TetrisStone* stone);
             void findFullRows(void);
             void clearRow(unsigned int row);
 
@@ -93,7 +96,7 @@ namespace orxonox
             PlayerInfo* player_;
 
             WeakPtr<TetrisCenterpoint> center_; //!< The playing field.
-            std::list<SmartPtr<TetrisStone> > stones_; //!< A list of all stones in play.
+            std::vector<SmartPtr<TetrisStone> > stones_; //!< The stones in play, indexed by their cell (row * width + column). Only used for rendering, the TetrisGrid of the centerpoint is the authoritative board.
             WeakPtr<TetrisBrick> activeBrick_;
             WeakPtr<TetrisBrick> futureBrick_;
 
@@ -0,0 +1,108 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+@file
+@brief
+    Entry point of tetris-benchmark which measures the speed of TetrisBot without starting the game.
+
+    Usage: tetris-benchmark [games] [bricks] [width] [height]
+
+    The bot plays a number of games (with the same random bricks in each run)
+    until the game is over or the given number of bricks was placed. Prints the
+    removed rows and the rated boards per second.
+*/
+
+#include "OrxonoxConfig.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#include "util/Clock.h"
+#include "TetrisBot.h"
+
+int main(int argc, char** argv)
+{
+    using namespace orxonox;
+
+    if (argc > 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " [games] [bricks] [width] [height]" << std::endl;
+        std::cerr << "Lets the bot play games with a lookahead of one brick (default: 10 games, 1000 bricks, 10x11 field)." << std::endl;
+        return 1;
+    }
+
+    const int numGames = (argc > 1 ? atoi(argv[1]) : 10);
+    const int maxBricks = (argc > 2 ? atoi(argv[2]) : 1000);
+    const unsigned int width = (argc > 3 ? static_cast<unsigned int>(atoi(argv[3])) : 10);
+    const unsigned int height = (argc > 4 ? static_cast<unsigned int>(atoi(argv[4])) : 11);
+    if (width == 0 || width > TetrisGrid::MaxWidth || height == 0)
+    {
+        std::cerr << "The width must be between 1 and " << TetrisGrid::MaxWidth << " and the height must be positive." << std::endl;
+        return 1;
+    }
+
+    Clock clock;
+    TetrisBot bot;
+    srand(1);
+
+    unsigned long long totalTime = 0;
+    for (int game = 0; game < numGames; ++game)
+    {
+        TetrisGrid grid(width, height);
+        const uint64_t boardsBefore = bot.getNumEvaluatedBoards();
+        const unsigned long long start = clock.getRealMicroseconds();
+
+        // the same bricks as the game uses (see TetrisBrick::TetrisBrick())
+        unsigned int shape = 1 + rand() % 6;
+        int bricks = 0;
+        unsigned int rows = 0;
+        for (; bricks < maxBricks; ++bricks)
+        {
+            const unsigned int nextShape = 1 + rand() % 6;
+            const TetrisBot::Move move = bot.findMove(grid, shape, nextShape);
+            if (move.column < 0)
+                break;
+
+            grid.place(TetrisShape::getShape(shape).rotate(move.rotation), move.column, move.row);
+            rows += grid.removeFullRows();
+            shape = nextShape;
+        }
+
+        const unsigned long long time = clock.getRealMicroseconds() - start;
+        const uint64_t boards = bot.getNumEvaluatedBoards() - boardsBefore;
+        totalTime += time;
+        std::cout << "Game " << game << ": " << bricks << " bricks, " << rows << " rows, " << boards << " boards in " << time / 1000 << " ms, "
+                  << static_cast<uint64_t>(boards * 1000000.0 / (time > 0 ? time : 1)) << " boards/s" << std::endl;
+    }
+
+    std::cout << "Total: " << bot.getNumEvaluatedBoards() << " boards in " << totalTime / 1000 << " ms, "
+              << static_cast<uint64_t>(bot.getNumEvaluatedBoards() * 1000000.0 / (totalTime > 0 ? totalTime : 1)) << " boards/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TetrisBot.cc
+    @brief Implementation of the TetrisBot class.
+*/
+
+#include "TetrisBot.h"
+
+#include <cmath>
+#include <limits>
+
+namespace orxonox
+{
+    /**
+    @brief
+        Constructor. The default weights are taken from a well known genetically optimized bot.
+    */
+    TetrisBot::TetrisBot()
+    {
+        this->setWeights(-0.510066f, 0.760666f, -0.35663f, -0.184483f);
+        this->numEvaluatedBoards_ = 0;
+    }
+
+    /**
+    @brief
+        Sets the weights of the rating of a board.
+    */
+    void TetrisBot::setWeights(float height, float rows, float holes, float bumpiness)
+    {
+        this->heightWeight_ = height;
+        this->rowsWeight_ = rows;
+        this->holesWeight_ = holes;
+        this->bumpinessWeight_ = bumpiness;
+    }
+
+    /**
+    @brief
+        Returns the best placement of the brick with index @a shape, considering all placements of the brick @a nextShape afterwards.
+    */
+    TetrisBot::Move TetrisBot::findMove(const TetrisGrid& grid, unsigned int shape, unsigned int nextShape)
+    {
+        const TetrisShape& next = TetrisShape::getShape(nextShape);
+        Move move;
+        this->findBestPlacement(grid, TetrisShape::getShape(shape), 0, this->firstScratch_, &next, &this->secondScratch_, &move);
+        return move;
+    }
+
+    /**
+    @brief
+        Returns the best placement of the brick with index @a shape without lookahead.
+    */
+    TetrisBot::Move TetrisBot::findMove(const TetrisGrid& grid, unsigned int shape)
+    {
+        Move move;
+        this->findBestPlacement(grid, TetrisShape::getShape(shape), 0, this->firstScratch_, NULL, NULL, &move);
+        return move;
+    }
+
+    /**
+    @brief
+        Tries all rotations and columns of a shape. The shape is dropped from above the playing field.
+    @param grid The board before placing the shape
+    @param shape The shape to place
+    @param removedRows The number of rows which were removed by earlier placements
+    @param scratch Receives the board after each placement
+    @param nextShape If not NULL, each resulting board is rated by the best placement of this shape
+    @param nextScratch The scratch board for the next shape
+    @param move If not NULL, receives the best placement
+    @return The rating of the best placement (or -infinity if the shape doesn't fit anywhere)
+    */
+    float TetrisBot::findBestPlacement(const TetrisGrid& grid, const TetrisShape& shape, unsigned int removedRows, TetrisGrid& scratch, const TetrisShape* nextShape, TetrisGrid* nextScratch, Move* move)
+    {
+        float bestScore = -std::numeric_limits<float>::infinity();
+        const int startRow = static_cast<int>(grid.getHeight()) + 3;
+
+        for (unsigned int rotation = 0; rotation < 4; ++rotation)
+        {
+            const TetrisShape rotated = shape.rotate(rotation);
+            for (int column = -3; column < static_cast<int>(grid.getWidth()) + 3; ++column)
+            {
+                if (!grid.fits(rotated, column, startRow))
+                    continue;
+
+                const int row = grid.drop(rotated, column, startRow);
+                scratch = grid;
+                if (!scratch.place(rotated, column, row))
+                    continue; // the brick sticks out of the playing field, the game would be over
+                const unsigned int rows = removedRows + scratch.removeFullRows();
+
+                float score;
+                if (nextShape)
+                    score = this->findBestPlacement(scratch, *nextShape, rows, *nextScratch, NULL, NULL, NULL);
+                else
+                    score = this->evaluate(scratch, rows);
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    if (move)
+                    {
+                        move->rotation = rotation;
+                        move->column = column;
+                        move->row = row;
+                        move->score = score;
+                    }
+                }
+            }
+        }
+
+        // if the next brick doesn't fit anywhere, the placement is still better than losing immediately
+        if (nextShape && bestScore == -std::numeric_limits<float>::infinity() && move && move->column == -1)
+            return this->findBestPlacement(grid, shape, removedRows, scratch, NULL, NULL, move);
+
+        return bestScore;
+    }
+
+    /**
+    @brief
+        Rates a board (higher is better).
+    */
+    float TetrisBot::evaluate(const TetrisGrid& grid, unsigned int removedRows)
+    {
+        ++this->numEvaluatedBoards_;
+
+        int heights[TetrisGrid::MaxWidth] = { 0 };
+        unsigned int holes = 0;
+
+        // walk from top to bottom: free cells below any stone are holes, the first stone of a column defines its height
+        uint64_t covered = 0;
+        for (int row = static_cast<int>(grid.getHeight()) - 1; row >= 0; --row)
+        {
+            const uint64_t stones = grid.getRow(row);
+            for (uint64_t free = covered & ~stones; free; free &= free - 1)
+                ++holes;
+            for (uint64_t top = stones & ~covered; top; top &= top - 1)
+            {
+                const uint64_t bit = top & (~top + 1);
+                unsigned int column = 0;
+                while ((bit >> column) != 1)
+                    ++column;
+                heights[column] = row + 1;
+            }
+            covered |= stones;
+        }
+
+        int aggregateHeight = 0;
+        int bumpiness = 0;
+        for (unsigned int column = 0; column < grid.getWidth(); ++column)
+        {
+            aggregateHeight += heights[column];
+            if (column > 0)
+                bumpiness += std::abs(heights[column] - heights[column - 1]);
+        }
+
+        return this->heightWeight_ * aggregateHeight + this->rowsWeight_ * removedRows + this->holesWeight_ * holes + this->bumpinessWeight_ * bumpiness;
+    }
+}
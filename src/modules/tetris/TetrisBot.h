@@ -0,0 +1,99 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TetrisBot.h
+    @brief Declaration of the TetrisBot class.
+    @ingroup Tetris
+*/
+
+#ifndef _TetrisBot_H__
+#define _TetrisBot_H__
+
+#include "tetris/TetrisPrereqs.h"
+
+#include "TetrisGrid.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Chooses the rotation and the column of a brick by simulating all
+        placements of the brick and of the next brick on copies of a TetrisGrid.
+
+        The resulting boards are rated by a weighted sum of the aggregate height
+        of the columns, the removed rows, the holes (free cells below a stone) and
+        the bumpiness (the height differences of neighbouring columns).
+
+        The bot doesn't depend on any game objects, hence it can be run (and
+        benchmarked) without a running game, see tetris-benchmark.
+
+    @ingroup Tetris
+    */
+    class _TetrisExport TetrisBot
+    {
+        public:
+            /// @brief A placement of a brick.
+            struct Move
+            {
+                Move() : rotation(0), column(-1), row(-1), score(0) {}
+
+                unsigned int rotation; //!< The number of anticlockwise rotations by 90°
+                int column; //!< The column of the first stone (or -1 if the brick doesn't fit anywhere)
+                int row; //!< The row of the first stone after dropping the brick
+                float score; //!< The rating of the resulting board
+            };
+
+            TetrisBot();
+
+            Move findMove(const TetrisGrid& grid, unsigned int shape, unsigned int nextShape);
+            Move findMove(const TetrisGrid& grid, unsigned int shape);
+
+            float evaluate(const TetrisGrid& grid, unsigned int removedRows);
+
+            void setWeights(float height, float rows, float holes, float bumpiness);
+
+            /// @brief Returns the number of boards which were rated so far.
+            inline uint64_t getNumEvaluatedBoards() const
+                { return this->numEvaluatedBoards_; }
+
+        private:
+            float findBestPlacement(const TetrisGrid& grid, const TetrisShape& shape, unsigned int removedRows, TetrisGrid& scratch, const TetrisShape* nextShape, TetrisGrid* nextScratch, Move* move);
+
+            float heightWeight_; //!< The weight of the aggregate height of all columns
+            float rowsWeight_; //!< The weight of the removed rows
+            float holesWeight_; //!< The weight of the number of holes
+            float bumpinessWeight_; //!< The weight of the height differences of neighbouring columns
+            uint64_t numEvaluatedBoards_; //!< The number of boards which were rated so far
+
+            TetrisGrid firstScratch_; //!< The board after placing the first brick, kept to avoid allocations
+            TetrisGrid secondScratch_; //!< The board after placing the next brick
+    };
+}
+
+#endif /* _TetrisBot_H__ */
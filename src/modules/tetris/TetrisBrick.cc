@@ -38,6 +38,7 @@
 
 #include "TetrisCenterpoint.h"
 #include "TetrisStone.h"
+#include "TetrisGrid.h"
 #include "Tetris.h"
 #include "util/Math.h"
 
@@ -71,8 +72,7 @@ namespace orxonox
     void TetrisBrick::createBrick(void)
     { //Index 0 : single stone, 1 : 4 in a row; 2: 4-Block right shifted; 3: 'T' 4: 4-Block left shifted;
       //Index 5 : 4-Block; 6 : 'L'; 7 : mirrored 'L';
-        if(this->shapeIndex_ == 0)
-            this->stonesPerBrick_ = 1;
+        this->stonesPerBrick_ = TetrisShape::getShape(this->shapeIndex_).numStones;
         for (unsigned int i = 0; i < this->stonesPerBrick_; i++)
         {
             // Create a new stone and add it to the brick.
@@ -95,7 +95,7 @@ namespace orxonox
 
     /**
     @brief
-        This function creates the shape of a TetrisBrick. ! Spaghetti-Code !
+        This function creates the shape of a TetrisBrick.
     @param i
         The stone's number.
     @param stone
@@ -103,52 +103,8 @@ namespace orxonox
     */
     void TetrisBrick::formBrick(TetrisStone* stone, unsigned int i)
     {
-        if(i == 0) //setting the first stone as
-        {
-            stone->setPosition(0.0f, 0.0f, 0.0f);
-        }
-        else if(i == 1)
-        {
-            stone->setPosition(0.0f, size_, 0.0f);
-        }
-        else if(i == 2)
-        {
-            if(this->shapeIndex_ == 1 || this->shapeIndex_ == 6 || this->shapeIndex_ == 7)
-            {
-                stone->setPosition(0.0f, 2*size_, 0.0f);
-            }
-            else if(this->shapeIndex_ == 3 || this->shapeIndex_ == 4|| this->shapeIndex_ == 5)
-            {
-                stone->setPosition(size_, 0, 0.0f);
-            }
-            else if(this->shapeIndex_ == 2)
-            {
-                stone->setPosition(-size_, 0, 0.0f);
-            }
-        }
-        else if(i == 3)
-        {
-            if(this->shapeIndex_ == 2 || this->shapeIndex_ == 5)
-            {
-                stone->setPosition(size_, size_, 0.0f);
-            }
-            else if(this->shapeIndex_ == 1)
-            {
-                stone->setPosition(0, 3*size_, 0.0f);
-            }
-            else if(this->shapeIndex_ == 3 || this->shapeIndex_ == 7)
-            {
-                stone->setPosition(-size_, 0, 0.0f);
-            }
-            else if(this->shapeIndex_ == 4)
-            {
-                stone->setPosition(-size_, size_, 0.0f);
-            }
-            else if(this->shapeIndex_ == 6)
-            {
-                stone->setPosition(size_, 0, 0.0f);
-            }
-        }
+        const TetrisShape& shape = TetrisShape::getShape(this->shapeIndex_);
+        stone->setPosition(shape.x[i]*size_, shape.y[i]*size_, 0.0f);
     }
 
     bool TetrisBrick::isValidMove(const Vector3& position, bool isRotation = false)
@@ -53,6 +53,7 @@ namespace orxonox
 
         this->width_ = 10;
         this->height_ = 11;
+        this->grid_.setSize(this->width_, this->height_);
         this->stoneSize_ = 10.0f;
         this->stoneTemplate_ = "";
         this->brickTemplate_ = "";
@@ -77,6 +78,25 @@ namespace orxonox
         XMLPortParam(TetrisCenterpoint, "stoneSpeed", setStoneSpeed, getStoneSpeed, xmlelement, mode);
     }
 
+    /**
+    @brief
+        Set the width of the playing field. The width is limited to the number of columns the TetrisGrid supports.
+    @param width
+        The width in number of tiles.
+    */
+    void TetrisCenterpoint::setWidth(unsigned int width)
+    {
+        if (width == 0 || width > TetrisGrid::MaxWidth)
+        {
+            unsigned int clamped = clamp(width, 1u, TetrisGrid::MaxWidth);
+            orxout(internal_warning) << "TetrisCenterpoint: The width must be between 1 and " << TetrisGrid::MaxWidth << ", using " << clamped << " instead of " << width << '.' << endl;
+            width = clamped;
+        }
+
+        this->width_ = width;
+        this->grid_.setSize(this->width_, this->height_);
+    }
+
     /**
     @brief
         Is called when the gametype has changed.
@@ -42,6 +42,7 @@
 #include <util/Math.h>
 
 #include "worldentities/StaticEntity.h"
+#include "TetrisGrid.h"
 
 namespace orxonox
 {//idea: add 2 triggers to the centerpoint (one to determine when a box would go above the centerpoint;
@@ -65,12 +66,7 @@ namespace orxonox
 
             virtual void changedGametype(); //!< Is called when the gametype has changed.
             
-            /**
-            @brief Set the width of the playing field.
-            @param width The width in number of tiles.
-            */
-            void setWidth(unsigned int width)
-                { this->width_ = width; }
+            void setWidth(unsigned int width); //!< Set the width of the playing field.
             /**
             @brief Get the width of the playing field.
             @return Returns the width in number of tiles.
@@ -83,7 +79,7 @@ namespace orxonox
             @param height The height in number of tiles.
             */
             void setHeight(unsigned int height)
-                { this->height_ = height; }
+                { this->height_ = height; this->grid_.setSize(this->width_, this->height_); }
             /**
             @brief Get the height of the playing field.
             @return Returns the height in number of tiles.
@@ -130,6 +126,13 @@ namespace orxonox
             const std::string& getBrickTemplate(void) const
                 { return this->brickTemplate_; }
 
+            /**
+            @brief Get the occupancy of the playing field.
+            @return Returns the grid which stores which cells are occupied by stones.
+            */
+            TetrisGrid& getGrid(void)
+                { return this->grid_; }
+
             /**
             @brief Set the speed of the stones.
             @param speed The speed to be set.
@@ -149,6 +152,7 @@ namespace orxonox
             unsigned int width_;
             unsigned int height_;
             float stoneSize_;
+            TetrisGrid grid_; //!< The occupancy of the playing field, the authoritative board of the game
             std::string stoneTemplate_;
             std::string brickTemplate_;
             float stoneSpeed_;
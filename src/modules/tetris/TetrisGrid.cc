@@ -0,0 +1,193 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TetrisGrid.cc
+    @brief Implementation of the TetrisGrid class and the TetrisShape struct.
+*/
+
+#include "TetrisGrid.h"
+
+#include <cassert>
+
+namespace orxonox
+{
+    namespace
+    {
+        // Index 0 : single stone, 1 : 4 in a row; 2: 4-Block right shifted; 3: 'T' 4: 4-Block left shifted;
+        // Index 5 : 4-Block; 6 : 'L'; 7 : mirrored 'L';
+        const TetrisShape shapes[TetrisShape::NumShapes] =
+        {
+            { 1, { 0, 0, 0, 0 }, { 0, 0, 0, 0 } },
+            { 4, { 0, 0, 0, 0 }, { 0, 1, 2, 3 } },
+            { 4, { 0, 0, -1, 1 }, { 0, 1, 0, 1 } },
+            { 4, { 0, 0, 1, -1 }, { 0, 1, 0, 0 } },
+            { 4, { 0, 0, 1, -1 }, { 0, 1, 0, 1 } },
+            { 4, { 0, 0, 1, 1 }, { 0, 1, 0, 1 } },
+            { 4, { 0, 0, 0, 1 }, { 0, 1, 2, 0 } },
+            { 4, { 0, 0, 0, -1 }, { 0, 1, 2, 0 } }
+        };
+    }
+
+    /**
+    @brief
+        Returns the shape with the given index (see TetrisBrick::createBrick()).
+    */
+    /*static*/ const TetrisShape& TetrisShape::getShape(unsigned int index)
+    {
+        assert(index < NumShapes);
+        return shapes[index];
+    }
+
+    /**
+    @brief
+        Returns the shape rotated by 90° * amount (anticlockwise, like Tetris::rotateVector()).
+    */
+    TetrisShape TetrisShape::rotate(unsigned int amount) const
+    {
+        TetrisShape rotated = *this;
+        for (unsigned int i = 0; i < amount % 4; ++i)
+        {
+            for (unsigned int j = 0; j < rotated.numStones; ++j)
+            {
+                const int temp = rotated.x[j];
+                rotated.x[j] = -rotated.y[j];
+                rotated.y[j] = temp;
+            }
+        }
+        return rotated;
+    }
+
+    const unsigned int TetrisGrid::MaxWidth;
+
+    TetrisGrid::TetrisGrid(unsigned int width, unsigned int height)
+    {
+        this->setSize(width, height);
+    }
+
+    /**
+    @brief
+        Changes the size of the playing field. All cells are free afterwards.
+    */
+    void TetrisGrid::setSize(unsigned int width, unsigned int height)
+    {
+        assert(width > 0 && width <= MaxWidth);
+        this->width_ = width;
+        this->height_ = height;
+        this->fullRow_ = (width == MaxWidth ? ~(uint64_t)0 : ((uint64_t)1 << width) - 1);
+        this->rows_.assign(height, 0);
+    }
+
+    /**
+    @brief
+        Frees all cells.
+    */
+    void TetrisGrid::clear()
+    {
+        this->rows_.assign(this->height_, 0);
+    }
+
+    /**
+    @brief
+        Removes a row, the rows above move down by one.
+    */
+    void TetrisGrid::removeRow(unsigned int row)
+    {
+        for (unsigned int i = row; i + 1 < this->height_; ++i)
+            this->rows_[i] = this->rows_[i + 1];
+        this->rows_[this->height_ - 1] = 0;
+    }
+
+    /**
+    @brief
+        Removes all full rows and returns their number.
+    */
+    unsigned int TetrisGrid::removeFullRows()
+    {
+        unsigned int removed = 0;
+        for (unsigned int row = 0; row < this->height_; ++row)
+        {
+            if (this->rows_[row] == this->fullRow_)
+                ++removed;
+            else if (removed > 0)
+                this->rows_[row - removed] = this->rows_[row];
+        }
+        for (unsigned int row = this->height_ - removed; row < this->height_; ++row)
+            this->rows_[row] = 0;
+        return removed;
+    }
+
+    /**
+    @brief
+        Returns true if the shape fits at the given position, i.e. no stone is
+        outside the walls or below the floor and all cells are free. Stones may be
+        above the playing field.
+    */
+    bool TetrisGrid::fits(const TetrisShape& shape, int column, int row) const
+    {
+        for (unsigned int i = 0; i < shape.numStones; ++i)
+        {
+            const int x = column + shape.x[i];
+            const int y = row + shape.y[i];
+            if (x < 0 || x >= static_cast<int>(this->width_) || y < 0)
+                return false;
+            if (y < static_cast<int>(this->height_) && ((this->rows_[y] >> x) & 1))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+    @brief
+        Moves the shape down from the given position (where it has to fit) until it lands and returns the row.
+    */
+    int TetrisGrid::drop(const TetrisShape& shape, int column, int row) const
+    {
+        while (this->fits(shape, column, row - 1))
+            --row;
+        return row;
+    }
+
+    /**
+    @brief
+        Occupies the cells of the shape. Returns false if a stone is above the playing field (this stone is not placed).
+    */
+    bool TetrisGrid::place(const TetrisShape& shape, int column, int row)
+    {
+        bool bInside = true;
+        for (unsigned int i = 0; i < shape.numStones; ++i)
+        {
+            const int y = row + shape.y[i];
+            if (y < static_cast<int>(this->height_))
+                this->setOccupied(column + shape.x[i], y, true);
+            else
+                bInside = false;
+        }
+        return bInside;
+    }
+}
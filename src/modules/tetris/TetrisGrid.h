@@ -0,0 +1,132 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TetrisGrid.h
+    @brief Declaration of the TetrisGrid class and the TetrisShape struct.
+    @ingroup Tetris
+*/
+
+#ifndef _TetrisGrid_H__
+#define _TetrisGrid_H__
+
+#include "tetris/TetrisPrereqs.h"
+
+#include <vector>
+
+namespace orxonox
+{
+    /**
+    @brief
+        The offsets of the stones of a brick (in units of stones, relative to the
+        first stone). The shapes are indexed like TetrisBrick::shapeIndex_.
+
+    @ingroup Tetris
+    */
+    struct _TetrisExport TetrisShape
+    {
+        static const unsigned int NumShapes = 8; //!< The number of shapes (index 0 is a single stone)
+
+        unsigned int numStones; //!< The number of stones of the brick
+        int x[4]; //!< The horizontal offsets of the stones
+        int y[4]; //!< The vertical offsets of the stones
+
+        static const TetrisShape& getShape(unsigned int index);
+        TetrisShape rotate(unsigned int amount) const;
+    };
+
+    /**
+    @brief
+        The occupancy of the playing field, stored as one bitmask per row (bit i
+        of a row is column i). This is the authoritative board of the game, the
+        stones are only used to render it.
+
+        Cells can be checked in constant time and full rows are detected by
+        comparing a row with the mask of a full row. Copying a grid is cheap,
+        so it's also used by TetrisBot to simulate moves.
+
+    @ingroup Tetris
+    */
+    class _TetrisExport TetrisGrid
+    {
+        public:
+            static const unsigned int MaxWidth = 64; //!< The maximal number of columns
+
+            TetrisGrid(unsigned int width = 10, unsigned int height = 11);
+
+            void setSize(unsigned int width, unsigned int height);
+            void clear();
+
+            /// @brief Returns the number of columns.
+            inline unsigned int getWidth() const
+                { return this->width_; }
+            /// @brief Returns the number of rows.
+            inline unsigned int getHeight() const
+                { return this->height_; }
+
+            /// @brief Returns true if the cell is part of the playing field.
+            inline bool isInside(int column, int row) const
+                { return (column >= 0 && row >= 0 && column < static_cast<int>(this->width_) && row < static_cast<int>(this->height_)); }
+            /// @brief Returns true if a stone lies in the cell. Cells outside the playing field are free.
+            inline bool isOccupied(int column, int row) const
+                { return this->isInside(column, row) && ((this->rows_[row] >> column) & 1); }
+            /// @brief Marks a cell as occupied or free. The cell must be inside the playing field.
+            inline void setOccupied(int column, int row, bool bOccupied)
+            {
+                if (bOccupied)
+                    this->rows_[row] |= (uint64_t)1 << column;
+                else
+                    this->rows_[row] &= ~((uint64_t)1 << column);
+            }
+
+            /// @brief Returns the bitmask of a row.
+            inline uint64_t getRow(unsigned int row) const
+                { return this->rows_[row]; }
+            /// @brief Returns the bitmask of a full row.
+            inline uint64_t getFullRow() const
+                { return this->fullRow_; }
+            /// @brief Returns true if all cells of the row are occupied.
+            inline bool isRowFull(unsigned int row) const
+                { return this->rows_[row] == this->fullRow_; }
+
+            void removeRow(unsigned int row);
+            unsigned int removeFullRows();
+
+            bool fits(const TetrisShape& shape, int column, int row) const;
+            int drop(const TetrisShape& shape, int column, int row) const;
+            bool place(const TetrisShape& shape, int column, int row);
+
+        private:
+            unsigned int width_; //!< The number of columns
+            unsigned int height_; //!< The number of rows
+            uint64_t fullRow_; //!< The bitmask of a full row
+            std::vector<uint64_t> rows_; //!< The bitmasks of all rows, from bottom to top
+    };
+}
+
+#endif /* _TetrisGrid_H__ */
@@ -69,6 +69,9 @@ namespace orxonox
     class TetrisStone;
     class TetrisBrick;
     class TetrisScore;
+    class TetrisGrid;
+    class TetrisBot;
+    struct TetrisShape;
 }
 
 #endif /* _TetrisPrereqs_H__ */
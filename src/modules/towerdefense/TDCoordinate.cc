@@ -32,11 +32,11 @@ namespace orxonox
     {
         float tileScale = 100;
 
-        Vector3 *coord = new Vector3();
-        coord->x= (x-8) * tileScale;
-        coord->y= (y-8) * tileScale;
-        coord->z=100;
+        Vector3 coord;
+        coord.x= (x-8) * tileScale;
+        coord.y= (y-8) * tileScale;
+        coord.z=100;
 
-        return *coord;
+        return coord;
     }
 }
@@ -0,0 +1,369 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TDFlowField.cc
+    @brief Implementation of the TDFlowField class.
+*/
+
+#include "TDFlowField.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace orxonox
+{
+    const int TDFlowField::Unreachable;
+
+    TDFlowField::TDFlowField()
+    {
+        this->width_ = 0;
+        this->height_ = 0;
+        this->goal_ = -1;
+    }
+
+    /**
+        @brief Resizes the grid. All cells are free afterwards and the goal has to be set again.
+    */
+    void TDFlowField::setSize(int width, int height)
+    {
+        this->width_ = width;
+        this->height_ = height;
+        this->goal_ = -1;
+        this->cells_.assign(width * height, Cell());
+    }
+
+    /**
+        @brief Sets the cell which all enemies try to reach and computes the whole field.
+    */
+    void TDFlowField::setGoal(int x, int y)
+    {
+        this->goal_ = (this->isInside(x, y) ? this->getIndex(x, y) : -1);
+        this->recompute();
+    }
+
+    /**
+        @brief Blocks a cell (e.g. when a tower is built) or frees it again. Only the affected part of the field is recomputed.
+    */
+    void TDFlowField::setBlocked(int x, int y, bool bBlocked)
+    {
+        const int index = this->getIndex(x, y);
+        if (this->cells_[index].bBlocked == bBlocked)
+            return;
+
+        this->cells_[index].bBlocked = bBlocked;
+        if (index == this->goal_)
+            this->recompute();
+        else if (bBlocked)
+            this->increaseCost(index);
+        else
+            this->decreaseCost(index);
+    }
+
+    /**
+        @brief Sets the additional cost of entering a cell (e.g. the danger of nearby towers). Only the affected part of the field is recomputed.
+    */
+    void TDFlowField::setCost(int x, int y, int cost)
+    {
+        const int index = this->getIndex(x, y);
+        const int oldCost = this->cells_[index].cost;
+        if (cost == oldCost)
+            return;
+
+        this->cells_[index].cost = cost;
+        if (cost > oldCost)
+            this->increaseCost(index);
+        else
+            this->decreaseCost(index);
+    }
+
+    /**
+    @brief
+        Returns the next cell on the shortest path from the given cell to the goal.
+        The goal returns itself. Returns false if there's no path to the goal.
+
+        Enemies on a blocked cell (e.g. if a tower was built where they are) move
+        to the neighbour with the shortest distance.
+    */
+    bool TDFlowField::getNextCell(int x, int y, int& nextX, int& nextY) const
+    {
+        if (!this->isInside(x, y))
+            return false;
+
+        const int index = this->getIndex(x, y);
+        int next = this->cells_[index].next;
+        if (index == this->goal_ && !this->cells_[index].bBlocked)
+            next = index;
+        else if (this->cells_[index].bBlocked)
+        {
+            int neighbours[4];
+            const int count = this->getNeighbours(index, neighbours);
+            for (int i = 0; i < count; ++i)
+                if (this->cells_[neighbours[i]].distance != Unreachable && (next == -1 || this->cells_[neighbours[i]].distance < this->cells_[next].distance))
+                    next = neighbours[i];
+        }
+
+        if (next == -1)
+            return false;
+
+        nextX = next % this->width_;
+        nextY = next / this->width_;
+        return true;
+    }
+
+    /**
+        @brief Returns true if blocking the cell (x, y) would cut the cell (fromX, fromY) off from the goal.
+    */
+    bool TDFlowField::wouldDisconnect(int x, int y, int fromX, int fromY) const
+    {
+        return this->wouldDisconnect(x, y, std::vector<std::pair<int, int> >(1, std::make_pair(fromX, fromY)));
+    }
+
+    /**
+    @brief
+        Returns true if blocking the cell (x, y) would cut any of the given cells off from the goal
+        (or if one of them is the cell itself). Cells which have no path to the goal anyway are ignored.
+    */
+    bool TDFlowField::wouldDisconnect(int x, int y, const std::vector<std::pair<int, int> >& cells) const
+    {
+        const int index = this->getIndex(x, y);
+        if (index == this->goal_)
+            return true;
+
+        // if the current path of a cell doesn't lead through the blocked cell, it's still available after blocking it
+        std::vector<int> affected;
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            const int from = this->getIndex(cells[i].first, cells[i].second);
+            if (from == index)
+                return true;
+            if (this->cells_[from].distance == Unreachable)
+                continue;
+
+            for (int cell = from; cell != -1; cell = this->cells_[cell].next)
+            {
+                if (cell == index)
+                {
+                    affected.push_back(from);
+                    break;
+                }
+            }
+        }
+        if (affected.empty())
+            return false;
+
+        // otherwise search other paths for all affected cells at once
+        std::vector<bool> visited(this->cells_.size(), false);
+        std::vector<int> stack(1, this->goal_);
+        visited[this->goal_] = true;
+        visited[index] = true;
+        while (!stack.empty())
+        {
+            const int cell = stack.back();
+            stack.pop_back();
+
+            int neighbours[4];
+            const int count = this->getNeighbours(cell, neighbours);
+            for (int i = 0; i < count; ++i)
+            {
+                if (!visited[neighbours[i]] && !this->cells_[neighbours[i]].bBlocked)
+                {
+                    visited[neighbours[i]] = true;
+                    stack.push_back(neighbours[i]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < affected.size(); ++i)
+            if (!visited[affected[i]])
+                return true;
+        return false;
+    }
+
+    /**
+        @brief Writes the indices of the direct neighbours of a cell to @a neighbours and returns their number.
+    */
+    int TDFlowField::getNeighbours(int index, int* neighbours) const
+    {
+        const int x = index % this->width_;
+        const int y = index / this->width_;
+        int count = 0;
+        if (x > 0)
+            neighbours[count++] = index - 1;
+        if (x < this->width_ - 1)
+            neighbours[count++] = index + 1;
+        if (y > 0)
+            neighbours[count++] = index - this->width_;
+        if (y < this->height_ - 1)
+            neighbours[count++] = index + this->width_;
+        return count;
+    }
+
+    /**
+        @brief Computes the whole field, starting at the goal.
+    */
+    void TDFlowField::recompute()
+    {
+        for (size_t i = 0; i < this->cells_.size(); ++i)
+        {
+            this->cells_[i].distance = Unreachable;
+            this->cells_[i].next = -1;
+        }
+
+        if (this->goal_ == -1 || this->cells_[this->goal_].bBlocked)
+            return;
+
+        this->cells_[this->goal_].distance = 0;
+        std::vector<std::pair<int, int> > queue(1, std::make_pair(0, this->goal_));
+        this->propagate(queue);
+    }
+
+    /**
+        @brief Is called if entering a cell got more expensive. Resets all cells whose path leads through the cell and searches their paths again.
+    */
+    void TDFlowField::increaseCost(int index)
+    {
+        std::vector<int> affected;
+        std::vector<bool> bAffected(this->cells_.size(), false);
+
+        if (this->cells_[index].bBlocked)
+        {
+            affected.push_back(index);
+            bAffected[index] = true;
+        }
+
+        // collect all cells whose path leads through the cell (these point to the cell or to an affected cell)
+        std::vector<int> stack(1, index);
+        while (!stack.empty())
+        {
+            const int cell = stack.back();
+            stack.pop_back();
+
+            int neighbours[4];
+            const int count = this->getNeighbours(cell, neighbours);
+            for (int i = 0; i < count; ++i)
+            {
+                if (!bAffected[neighbours[i]] && this->cells_[neighbours[i]].next == cell)
+                {
+                    bAffected[neighbours[i]] = true;
+                    affected.push_back(neighbours[i]);
+                    stack.push_back(neighbours[i]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < affected.size(); ++i)
+        {
+            this->cells_[affected[i]].distance = Unreachable;
+            this->cells_[affected[i]].next = -1;
+        }
+
+        // the paths of all other cells are still valid, so the affected cells start from their best unaffected neighbour
+        std::vector<std::pair<int, int> > queue;
+        for (size_t i = 0; i < affected.size(); ++i)
+        {
+            this->updateFromNeighbours(affected[i]);
+            if (this->cells_[affected[i]].distance != Unreachable)
+                queue.push_back(std::make_pair(this->cells_[affected[i]].distance, affected[i]));
+        }
+        std::make_heap(queue.begin(), queue.end(), std::greater<std::pair<int, int> >());
+        this->propagate(queue);
+    }
+
+    /**
+        @brief Is called if entering a cell got cheaper (or the cell was freed). Propagates the shorter distances from the cell.
+    */
+    void TDFlowField::decreaseCost(int index)
+    {
+        this->updateFromNeighbours(index);
+        if (this->cells_[index].distance == Unreachable)
+            return;
+
+        std::vector<std::pair<int, int> > queue(1, std::make_pair(this->cells_[index].distance, index));
+        this->propagate(queue);
+    }
+
+    /**
+        @brief Sets the distance of a free cell to the shortest path through one of its neighbours (if it's shorter than the current distance).
+    */
+    void TDFlowField::updateFromNeighbours(int index)
+    {
+        Cell& cell = this->cells_[index];
+        if (cell.bBlocked)
+            return;
+
+        int neighbours[4];
+        const int count = this->getNeighbours(index, neighbours);
+        for (int i = 0; i < count; ++i)
+        {
+            const Cell& neighbour = this->cells_[neighbours[i]];
+            if (neighbour.bBlocked || neighbour.distance == Unreachable)
+                continue;
+
+            const int distance = neighbour.distance + 1 + neighbour.cost;
+            if (distance < cell.distance)
+            {
+                cell.distance = distance;
+                cell.next = neighbours[i];
+            }
+        }
+    }
+
+    /**
+        @brief Dijkstra's algorithm: Propagates the distances of the cells in the queue (a heap of distance and index) to their neighbours.
+    */
+    void TDFlowField::propagate(std::vector<std::pair<int, int> >& queue)
+    {
+        while (!queue.empty())
+        {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<std::pair<int, int> >());
+            const int distance = queue.back().first;
+            const int index = queue.back().second;
+            queue.pop_back();
+
+            // the cell was added again with a shorter distance
+            if (distance > this->cells_[index].distance)
+                continue;
+
+            const int step = distance + 1 + this->cells_[index].cost;
+            int neighbours[4];
+            const int count = this->getNeighbours(index, neighbours);
+            for (int i = 0; i < count; ++i)
+            {
+                Cell& neighbour = this->cells_[neighbours[i]];
+                if (!neighbour.bBlocked && step < neighbour.distance)
+                {
+                    neighbour.distance = step;
+                    neighbour.next = index;
+                    queue.push_back(std::make_pair(step, neighbours[i]));
+                    std::push_heap(queue.begin(), queue.end(), std::greater<std::pair<int, int> >());
+                }
+            }
+        }
+    }
+}
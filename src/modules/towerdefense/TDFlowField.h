@@ -0,0 +1,126 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TDFlowField.h
+    @brief Declaration of the TDFlowField class.
+    @ingroup TowerDefense
+*/
+
+#ifndef _TDFlowField_H__
+#define _TDFlowField_H__
+
+#include "towerdefense/TowerDefensePrereqs.h"
+
+#include <vector>
+
+namespace orxonox
+{
+    /**
+    @brief
+        A Dijkstra map over the grid of the tower defense playfield which stores
+        for each cell the distance to the goal and the next cell on the shortest path.
+
+        The field is shared by all enemies, each enemy only looks up the next cell
+        of its current cell (see getNextCell()). Towers block cells and may increase
+        the cost of entering the cells around them. Only the cells whose shortest
+        path is affected by a change are recomputed: if a cell gets more expensive,
+        all cells whose path leads through it are reset and searched again from the
+        unaffected cells around them. If a cell gets cheaper, the shorter distances
+        are propagated from the cell.
+
+        Enemies move to the four direct neighbours of a cell, the cost of a step is
+        1 plus the cost of the entered cell.
+    */
+    class _TowerDefenseExport TDFlowField
+    {
+        public:
+            static const int Unreachable = 0x7FFFFFFF; //!< The distance of cells which have no path to the goal
+
+            TDFlowField();
+
+            void setSize(int width, int height);
+            void setGoal(int x, int y);
+
+            void setBlocked(int x, int y, bool bBlocked);
+            void setCost(int x, int y, int cost);
+
+            /// @brief Returns the width of the grid.
+            inline int getWidth() const
+                { return this->width_; }
+            /// @brief Returns the height of the grid.
+            inline int getHeight() const
+                { return this->height_; }
+            /// @brief Returns true if the cell is part of the grid.
+            inline bool isInside(int x, int y) const
+                { return (x >= 0 && y >= 0 && x < this->width_ && y < this->height_); }
+            /// @brief Returns true if the cell is blocked (e.g. by a tower).
+            inline bool isBlocked(int x, int y) const
+                { return this->cells_[this->getIndex(x, y)].bBlocked; }
+            /// @brief Returns the additional cost of entering the cell.
+            inline int getCost(int x, int y) const
+                { return this->cells_[this->getIndex(x, y)].cost; }
+            /// @brief Returns the distance of the cell to the goal (or Unreachable).
+            inline int getDistance(int x, int y) const
+                { return this->cells_[this->getIndex(x, y)].distance; }
+
+            bool getNextCell(int x, int y, int& nextX, int& nextY) const;
+            bool wouldDisconnect(int x, int y, int fromX, int fromY) const;
+            bool wouldDisconnect(int x, int y, const std::vector<std::pair<int, int> >& cells) const;
+
+        private:
+            /// @brief The state of a cell.
+            struct Cell
+            {
+                Cell() : distance(Unreachable), next(-1), cost(0), bBlocked(false) {}
+
+                int distance;   //!< The distance to the goal
+                int next;       //!< The index of the next cell on the path to the goal (-1 for the goal and unreachable cells)
+                int cost;       //!< The additional cost of entering the cell
+                bool bBlocked;  //!< True if the cell can't be entered
+            };
+
+            /// @brief Returns the index of a cell in cells_.
+            inline int getIndex(int x, int y) const
+                { return y * this->width_ + x; }
+            int getNeighbours(int index, int* neighbours) const;
+
+            void recompute();
+            void increaseCost(int index);
+            void decreaseCost(int index);
+            void updateFromNeighbours(int index);
+            void propagate(std::vector<std::pair<int, int> >& queue);
+
+            int width_;                 //!< The number of cells in x direction
+            int height_;                //!< The number of cells in y direction
+            int goal_;                  //!< The index of the goal cell (or -1 if not set)
+            std::vector<Cell> cells_;   //!< The state of all cells
+    };
+}
+
+#endif /* _TDFlowField_H__ */
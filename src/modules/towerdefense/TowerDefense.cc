@@ -92,6 +92,13 @@ namespace orxonox
 {
     RegisterUnloadableClass(TowerDefense);
 
+    // the cells where the enemies spawn and where they leave the playfield, enemies fly in this height above the playfield
+    static const int spawnX = 1;
+    static const int spawnY = 1;
+    static const int goalX = 13;
+    static const int goalY = 15;
+    static const float pathHeight = 150.0f;
+
     TowerDefense::TowerDefense(Context* context) : Deathmatch(context)
     {
         RegisterObject(TowerDefense);
@@ -133,23 +140,16 @@ namespace orxonox
 
         Deathmatch::start();
 
-// Waypoints: [1,3] [10,3] [10,11] [13,11] -> add the points to a matrix so the player cant place towers on the path
+        // no path is reserved, the enemies follow the flow field around the towers
         for (int i=0; i < 16 ; i++){
             for (int j = 0; j< 16 ; j++){
                 towermatrix[i][j] = false;
             }
         }
 
-        for (int k=0; k<3; k++)
-            towermatrix[1][k]=true;
-        for (int l=1; l<11; l++)
-            towermatrix[l][3]=true;
-        for (int m=3; m<12; m++)
-            towermatrix[10][m]=true;
-        for (int n=10; n<14; n++)
-            towermatrix[n][11]=true;
-        for (int o=13; o<16; o++)
-            towermatrix[13][o]=true;
+        // the flow field has to be ready before the initial towers are added
+        this->flowField_.setSize(16, 16);
+        this->flowField_.setGoal(goalX, goalY);
 
         //set initial credits, lifes and WaveNumber
         this->setCredit(200);
@@ -166,8 +166,8 @@ namespace orxonox
         }*/
     }
 
-    // Generates a TowerDefenseEnemy. Uses Template "enemytowerdefense". Sets position at first waypoint of path.
-    void TowerDefense::addTowerDefenseEnemy(std::vector<TDCoordinate*> path, int templatenr){
+    // Generates a TowerDefenseEnemy. Uses Template "enemytowerdefense". Sets position at the spawn cell, the enemy finds its way with the flow field.
+    void TowerDefense::addTowerDefenseEnemy(int templatenr){
 
 
         TowerDefenseEnemy* en1 = new TowerDefenseEnemy(this->center_->getContext());
@@ -195,13 +195,8 @@ namespace orxonox
         }
 
         en1->getController();
-        en1->setPosition(path.at(0)->get3dcoordinate());
+        en1->setPosition(TDCoordinate(spawnX, spawnY).get3dcoordinate());
         TowerDefenseEnemyvector.push_back(en1);
-
-        for(unsigned int i = 0; i < path.size(); ++i)
-        {
-            en1->addWaypoint((path.at(i)));
-        }
     }
 
 
@@ -213,27 +208,29 @@ namespace orxonox
 
     }
 
-    //not working yet
+    /*upgrades the Tower at Position (x,y) and reduces credit. Upgraded towers are more dangerous, so the enemies try harder to avoid them.
+    */
     void TowerDefense::upgradeTower(int x,int y)
-    {/*
+    {
         const int upgradeCost = 20;
 
-        if (!this->hasEnoughCreditForTower(upgradeCost))
+        if (!this->flowField_.isInside(x, y) || !this->towerGrid_[x][y])
         {
-            orxout() << "not enough credit: " << (this->getCredit()) << " available, " << upgradeCost << " needed.";
+            orxout() << "no tower on this position" << endl;
             return;
         }
 
-        if (towermatrix [x][y] == NULL)
+        if (!this->hasEnoughCreditForTower(upgradeCost))
         {
-            orxout() << "no tower on this position" << endl;
+            orxout() << "not enough credit: " << (this->getCredit()) << " available, " << upgradeCost << " needed.";
             return;
         }
 
-        else
+        if (this->towerGrid_[x][y]->upgradeTower())
         {
-            (towermatrix [x][y])->upgradeTower();
-        }*/
+            this->buyTower(upgradeCost);
+            this->addTowerDanger(x, y, 1);
+        }
     }
 
     /*adds Tower at Position (x,y) and reduces credit and adds the point to the towermatrix. template ("towerturret")
@@ -250,12 +247,35 @@ namespace orxonox
             return;
         }
 
+        if (x > 15 || y > 15 || x < 0 || y < 0)
+        {
+            //Hard coded: TODO: let this depend on the centerpoint's height, width and fieldsize (fieldsize doesn't exist yet)
+            orxout() << "Can not add Tower: x and y should be between 0 and 15" << endl;
+            return;
+        }
+
         if (towermatrix [x][y]==true)
         {
             orxout() << "not possible to put tower here!!" << endl;
             return;
         }
 
+        // the enemies must always be able to reach the goal, from the spawn point and from wherever they are right now
+        std::vector<std::pair<int, int> > cells(1, std::make_pair(spawnX, spawnY));
+        for (std::vector<WeakPtr<TowerDefenseEnemy> >::iterator it = this->TowerDefenseEnemyvector.begin(); it != this->TowerDefenseEnemyvector.end(); ++it)
+        {
+            if (*it == NULL || !(*it)->isAlive())
+                continue;
+            int enemyX, enemyY;
+            if (this->getCell((*it)->getPosition(), enemyX, enemyY))
+                cells.push_back(std::make_pair(enemyX, enemyY));
+        }
+        if (this->flowField_.wouldDisconnect(x, y, cells))
+        {
+            orxout() << "not possible to put tower here, it would block the path!!" << endl;
+            return;
+        }
+
 /*
         unsigned int width = this->center_->getWidth();
         unsigned int height = this->center_->getHeight();
@@ -263,24 +283,61 @@ namespace orxonox
 
         int tileScale = (int) this->center_->getTileScale();
 
-        if (x > 15 || y > 15 || x < 0 || y < 0)
-        {
-            //Hard coded: TODO: let this depend on the centerpoint's height, width and fieldsize (fieldsize doesn't exist yet)
-            orxout() << "Can not add Tower: x and y should be between 0 and 15" << endl;
-            return;
-        }
-
         orxout() << "Will add tower at (" << (x-8) * tileScale << "," << (y-8) * tileScale << ")" << endl;
 
        //Reduce credit
         this->buyTower(towerCost);
         towermatrix [x][y]=true;
+        this->flowField_.setBlocked(x, y, true);
+        this->addTowerDanger(x, y, 1);
 
         //Creates tower
         TowerDefenseTower* towernew = new TowerDefenseTower(this->center_->getContext());
         towernew->addTemplate("towerturret");
         towernew->setPosition(static_cast<float>((x-8) * tileScale), static_cast<float>((y-8) * tileScale), 75);
         towernew->setGame(this);
+        this->towerGrid_[x][y] = towernew;
+    }
+
+    /*returns the waypoint of an enemy at the given position: the center of the next cell on the shortest path to the goal. Returns false if there's no path.
+    */
+    bool TowerDefense::getNextWaypoint(const Vector3& position, Vector3& waypoint) const
+    {
+        int x, y, nextX, nextY;
+        if (!this->getCell(position, x, y) || !this->flowField_.getNextCell(x, y, nextX, nextY))
+            return false;
+
+        waypoint = this->getCellPosition(nextX, nextY);
+        return true;
+    }
+
+    /*returns the cell which contains the given position. Returns false if the position is outside of the playfield.
+    */
+    bool TowerDefense::getCell(const Vector3& position, int& x, int& y) const
+    {
+        if (this->center_ == NULL)
+            return false;
+
+        const float tileScale = static_cast<float>(this->center_->getTileScale());
+        x = static_cast<int>(floor(position.x / tileScale + 0.5f)) + 8;
+        y = static_cast<int>(floor(position.y / tileScale + 0.5f)) + 8;
+        return this->flowField_.isInside(x, y);
+    }
+
+    Vector3 TowerDefense::getCellPosition(int x, int y) const
+    {
+        const float tileScale = static_cast<float>(this->center_->getTileScale());
+        return Vector3((x-8) * tileScale, (y-8) * tileScale, pathHeight);
+    }
+
+    /*increases the cost of the cells around a tower, the flow field leads the enemies around dangerous cells if the detour is short enough
+    */
+    void TowerDefense::addTowerDanger(int x, int y, int danger)
+    {
+        for (int i = x-1; i <= x+1; ++i)
+            for (int j = y-1; j <= y+1; ++j)
+                if (this->flowField_.isInside(i, j) && (i != x || j != y))
+                    this->flowField_.setCost(i, j, this->flowField_.getCost(i, j) + danger);
     }
 
     bool TowerDefense::hasEnoughCreditForTower(int towerCost)
@@ -300,17 +357,14 @@ namespace orxonox
         SUPER(TowerDefense, tick, dt);
         time +=dt;
 
-        TDCoordinate* coord1 = new TDCoordinate(1,1);
-        std::vector<TDCoordinate*> path;
-        path.push_back(coord1);
         if(time>1 && TowerDefenseEnemyvector.size() < 30)
         {
             //adds different types of enemys depending on the WaveNumber
-            addTowerDefenseEnemy(path, this->getWaveNumber() % 3 +1 );
+            addTowerDefenseEnemy(this->getWaveNumber() % 3 +1 );
             time = time-1;
         }
 
-        Vector3* endpoint = new Vector3(500, 700, 150);
+        const Vector3 endpoint = this->getCellPosition(goalX, goalY);
         //if ships are at the end they get destroyed
         for(unsigned int i =0; i < TowerDefenseEnemyvector.size(); ++i)
         {
@@ -319,7 +373,7 @@ namespace orxonox
                 //destroys enemys at the end of teh path and reduces the life by 1. no credits gifted
 
                 Vector3 ship = TowerDefenseEnemyvector.at(i)->getRVWorldPosition();
-                float distance = ship.distance(*endpoint);
+                float distance = ship.distance(endpoint);
 
                 if(distance <50){
                     TowerDefenseEnemyvector.at(i)->destroy();
@@ -37,6 +37,7 @@
 #ifndef _TowerDefense_H__
 #define _TowerDefense_H__
 #include "TDCoordinate.h"
+#include "TDFlowField.h"
 #include "towerdefense/TowerDefensePrereqs.h"
 #include "gametypes/Deathmatch.h"
 #include "TowerDefenseEnemy.h"
@@ -53,7 +54,7 @@ namespace orxonox
 
         std::vector<orxonox::WeakPtr<TowerDefenseEnemy> > TowerDefenseEnemyvector;
         bool towermatrix[16][16];
-        void addTowerDefenseEnemy(std::vector<TDCoordinate*> path, int templatenr);
+        void addTowerDefenseEnemy(int templatenr);
         virtual void start(); //<! The function is called when the gametype starts
         virtual void end();
         virtual void tick(float dt);
@@ -84,6 +85,10 @@ namespace orxonox
         void addTower(int x, int y);
 
         void upgradeTower(int x, int y);
+
+        /* The shortest paths of all cells to the goal, shared by all enemies */
+        const TDFlowField& getFlowField() const { return this->flowField_; }
+        bool getNextWaypoint(const Vector3& position, Vector3& waypoint) const;
         /* Part of a temporary hack to allow the player to add towers */
         ConsoleCommand* dedicatedAddTower_;
         ConsoleCommand* dedicatedUpgradeTower_;
@@ -105,9 +110,12 @@ namespace orxonox
         bool hasEnoughCreditForTower(int towerCost);
         bool hasEnoughCreditForUpgrade();
 
+        bool getCell(const Vector3& position, int& x, int& y) const;
+        Vector3 getCellPosition(int x, int y) const;
+        void addTowerDanger(int x, int y, int danger);
 
-
-        std::vector<TowerTurret*> towers_;
+        TDFlowField flowField_;                         ///< The shortest paths to the goal, updated when towers are built or upgraded
+        WeakPtr<TowerDefenseTower> towerGrid_[16][16];  ///< The tower on each cell (if any)
     };
 }
 
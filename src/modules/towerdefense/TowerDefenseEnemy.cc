@@ -37,12 +37,6 @@ namespace orxonox
         //this->td->addCredit(1);
     }
 
-    void TowerDefenseEnemy::addWaypoint(TDCoordinate* coord)
-    {
-        this->Waypointsvector_.push_back(coord);
-    }
-
-
     void TowerDefenseEnemy::tick(float dt)
     {
         SUPER(TowerDefenseEnemy, tick, dt);
@@ -67,25 +61,5 @@ namespace orxonox
             once_ = true;
         }
     }
-/*
-    void TowerDefenseEnemy::popWaypoint()
-    {
-        if(Waypointsvector_.size()>0)
-            Waypointsvector_.pop_back();
-    }
-
-    TDCoordinate TowerDefenseEnemy::peekWaypoint()
-    {
-        if(Waypointsvector_.size()<=0){
-            TDCoordinate* coord = TDCoordinate(-1,-1);
-            return coord;
-        }else{
-            return Waypointsvector_.at(Waypointsvector_.size()-1);
-
-        }
-
-
-    }
-*/
 
 }
@@ -38,9 +38,6 @@ namespace orxonox
         //health gibt es unter: health_
 
         virtual void tick(float dt);
-        void addWaypoint(TDCoordinate* coord);
-        void popWaypoint();
-        TDCoordinate peekWaypoint();
 
         virtual void damage(float damage, float healthdamage, float shielddamage, Pawn* originator);
 
@@ -50,7 +47,6 @@ namespace orxonox
         WeakPtr<TowerDefense> game;
         TowerDefense* td;
         bool once_;
-        std::vector<TDCoordinate*> Waypointsvector_;
 
     };
 
@@ -0,0 +1,63 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TowerDefenseEnemyController.cc
+    @brief Implementation of the TowerDefenseEnemyController class.
+*/
+
+#include "TowerDefenseEnemyController.h"
+
+#include "core/CoreIncludes.h"
+#include "worldentities/ControllableEntity.h"
+#include "TowerDefense.h"
+
+namespace orxonox
+{
+    RegisterClass(TowerDefenseEnemyController);
+
+    TowerDefenseEnemyController::TowerDefenseEnemyController(Context* context) : ArtificialController(context)
+    {
+        RegisterObject(TowerDefenseEnemyController);
+    }
+
+    void TowerDefenseEnemyController::tick(float dt)
+    {
+        if (!this->isActive() || !this->getControllableEntity())
+            return;
+
+        if (!this->game_)
+            this->game_ = orxonox_cast<TowerDefense*>(this->getControllableEntity()->getGametype().get());
+        if (!this->game_)
+            return;
+
+        Vector3 waypoint;
+        if (this->game_->getNextWaypoint(this->getControllableEntity()->getPosition(), waypoint))
+            this->moveToPosition(waypoint);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TowerDefenseEnemyController.h
+    @brief Declaration of the TowerDefenseEnemyController class.
+    @ingroup TowerDefense
+*/
+
+#ifndef _TowerDefenseEnemyController_H__
+#define _TowerDefenseEnemyController_H__
+
+#include "towerdefense/TowerDefensePrereqs.h"
+
+#include "core/object/WeakPtr.h"
+#include "tools/interfaces/Tickable.h"
+#include "controllers/ArtificialController.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Moves a TowerDefenseEnemy along the shortest path to the goal. The next
+        cell is looked up in the TDFlowField of the TowerDefense gametype which
+        is shared by all enemies, hence the enemies don't need their own path.
+    */
+    class _TowerDefenseExport TowerDefenseEnemyController : public ArtificialController, public Tickable
+    {
+        public:
+            TowerDefenseEnemyController(Context* context);
+            virtual ~TowerDefenseEnemyController() {}
+
+            virtual void tick(float dt);
+
+        private:
+            WeakPtr<TowerDefense> game_; //!< The gametype which holds the flow field
+    };
+}
+
+#endif /* _TowerDefenseEnemyController_H__ */
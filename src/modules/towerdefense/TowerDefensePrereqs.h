@@ -73,6 +73,8 @@ namespace orxonox
     class TowerDefensePlayerStats;
     class TowerDefenseEnemy;
     class TDCoordinate;
+    class TDFlowField;
+    class TowerDefenseEnemyController;
     class TowerTurret;
     class TowerDefenseTower;
 }
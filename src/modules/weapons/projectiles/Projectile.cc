@@ -33,16 +33,53 @@
 
 #include "Projectile.h"
 
+#include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+
 #include "core/config/ConfigValueIncludes.h"
 #include "core/CoreIncludes.h"
 #include "core/GameMode.h"
 #include "core/command/Executor.h"
 
 #include "objects/collisionshapes/SphereCollisionShape.h"
+#include "tools/BulletConversions.h"
 #include "worldentities/pawns/Pawn.h"
+#include "weaponsystem/LagCompensation.h"
+#include "Scene.h"
 
 namespace orxonox
 {
+    namespace
+    {
+        /**
+        @brief
+            A ray test callback which ignores pawns (they are tested at their rewound position by LagCompensation) and projectiles.
+        */
+        struct ObstacleRayResultCallback : public btCollisionWorld::ClosestRayResultCallback
+        {
+            ObstacleRayResultCallback(const btVector3& from, const btVector3& to)
+                : btCollisionWorld::ClosestRayResultCallback(from, to), m_shape(0) {}
+
+            virtual bool needsCollision(btBroadphaseProxy* proxy) const
+            {
+                if (!btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy))
+                    return false;
+
+                const btCollisionObject* object = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+                const WorldEntity* entity = static_cast<const WorldEntity*>(object->getUserPointer());
+                return (entity != NULL && orxonox_cast<const Pawn*>(entity) == NULL && orxonox_cast<const BasicProjectile*>(entity) == NULL);
+            }
+
+            virtual btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
+            {
+                this->m_shape = rayResult.m_collisionObject->getCollisionShape();
+                return btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+            }
+
+            const btCollisionShape* m_shape;
+        };
+    }
+
     RegisterClass(Projectile);
 
     Projectile::Projectile(Context* context) : MovableEntity(context), BasicProjectile()
@@ -92,4 +129,64 @@ namespace orxonox
         return this->processCollision(otherObject, contactPoint, cs);
     }
 
+    /**
+    @brief
+        Compensates the latency of the shooter. Must be called after the position, velocity and shooter were set.
+
+        The projectile was fired on the client of the shooter some time ago. The part of its
+        path it travelled since then is tested against the pawns as they were at that time
+        (see LagCompensation). If a pawn is hit, the projectile hits it now, otherwise the
+        projectile is moved to the position where it is on the screen of the shooter. The
+        other objects are tested at their current position, the projectile stops at the
+        first one it hits.
+    */
+    void Projectile::compensateLag()
+    {
+        if (!GameMode::isMaster() || !this->getScene() || !this->getScene()->getLagCompensation())
+            return;
+
+        LagCompensation* lagCompensation = this->getScene()->getLagCompensation();
+        const double time = lagCompensation->getShooterTime(this->getShooter());
+        const float latency = static_cast<float>(lagCompensation->getTime() - time);
+        if (latency <= 0)
+            return;
+
+        const Vector3 from = this->getPosition();
+        Vector3 to = from + this->getVelocity() * latency;
+
+        // the projectile must not pass through the other objects (e.g. asteroids or stations), these are tested at their current position
+        WorldEntity* obstacle = NULL;
+        const btCollisionShape* obstacleShape = NULL;
+        Vector3 obstacleNormal;
+        if (this->getScene()->hasPhysics())
+        {
+            ObstacleRayResultCallback callback(multi_cast<btVector3>(from), multi_cast<btVector3>(to));
+            this->getScene()->getPhysicalWorld()->rayTest(multi_cast<btVector3>(from), multi_cast<btVector3>(to), callback);
+            if (callback.hasHit())
+            {
+                obstacle = static_cast<WorldEntity*>(callback.m_collisionObject->getUserPointer());
+                obstacleShape = callback.m_shape;
+                obstacleNormal = multi_cast<Vector3>(callback.m_hitNormalWorld);
+                to = multi_cast<Vector3>(callback.m_hitPointWorld);
+            }
+        }
+
+        LagCompensation::Hit hit;
+        if (lagCompensation->rayTest(from, to, time, this->getShooter(), hit))
+        {
+            this->setPosition(hit.position);
+            btManifoldPoint contactPoint(multi_cast<btVector3>(hit.position), multi_cast<btVector3>(hit.position), multi_cast<btVector3>(hit.normal), 0);
+            this->processCollision(hit.pawn, contactPoint, hit.shape);
+        }
+        else
+        {
+            this->setPosition(to);
+            if (obstacle)
+            {
+                btManifoldPoint contactPoint(multi_cast<btVector3>(to), multi_cast<btVector3>(to), multi_cast<btVector3>(obstacleNormal), 0);
+                this->processCollision(obstacle, contactPoint, obstacleShape);
+            }
+        }
+    }
+
 }
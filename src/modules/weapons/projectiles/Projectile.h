@@ -65,6 +65,8 @@ namespace orxonox
             virtual void tick(float dt);
             virtual bool collidesAgainst(WorldEntity* otherObject, const btCollisionShape* cs, btManifoldPoint& contactPoint);
 
+            void compensateLag();
+
         private:
             float lifetime_; //!< The time the projectile exists.
             Timer destroyTimer_; //!< Timer to destroy the projectile after its lifetime has run out.
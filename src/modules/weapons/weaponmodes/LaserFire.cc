@@ -73,5 +73,7 @@ namespace orxonox
         projectile->setDamage(this->getDamage());
         projectile->setShieldDamage(this->getShieldDamage());
         projectile->setHealthDamage(this->getHealthDamage());
+
+        projectile->compensateLag();
     }
 }
@@ -79,5 +79,7 @@ namespace orxonox
         projectile->setDamage(this->getDamage());
         projectile->setShieldDamage(this->getShieldDamage());
         projectile->setHealthDamage(this->getHealthDamage());
+
+        projectile->compensateLag();
     }
 }
@@ -78,9 +78,9 @@ namespace orxonox
 
     void Level::registerVariables()
     {
-        registerVariable(this->xmlfilename_,            VariableDirection::ToClient, new NetworkCallback<Level>(this, &Level::networkcallback_applyXMLFile));
-        registerVariable(this->name_,                   VariableDirection::ToClient, new NetworkCallback<Level>(this, &Level::changedName));
-        registerVariable(this->networkTemplateNames_,   VariableDirection::ToClient, new NetworkCallback<Level>(this, &Level::networkCallbackTemplatesChanged));
+        registerVariable(this->xmlfilename_,            VariableDirection::ToClient, &Level::networkcallback_applyXMLFile);
+        registerVariable(this->name_,                   VariableDirection::ToClient, &Level::changedName);
+        registerVariable(this->networkTemplateNames_,   VariableDirection::ToClient, &Level::networkCallbackTemplatesChanged);
     }
 
     void Level::networkcallback_applyXMLFile()
@@ -47,6 +47,7 @@ namespace orxonox
     SetCommandLineSwitch(dedicated).information("Start in dedicated server mode");
     SetCommandLineSwitch(standalone).information("Start in standalone mode");
     SetCommandLineSwitch(dedicatedClient).information("Start in dedicated client mode");
+    SetCommandLineSwitch(simulate).information("Run a level without graphics as fast as possible with a fixed time step and print timing statistics");
 
     /* ADD masterserver command */
     SetCommandLineSwitch(masterserver).information("Start in masterserver mode");
@@ -76,9 +77,9 @@ namespace orxonox
             "root"
             " graphics"
             "  mainMenu"
-            "  standalone,server,client"
+            "  standalone,server,client,replay"
             "   level"
-            " server,client,masterserver"
+            " server,client,masterserver,simulate,replay"
             "  level"
             );
 
@@ -95,6 +96,15 @@ namespace orxonox
                 Game::getInstance().requestStates("server, level");
             else if (CommandLineParser::getValue("dedicatedClient").get<bool>())
                 Game::getInstance().requestStates("client, level");
+            else if (CommandLineParser::getValue("simulate").get<bool>())
+                Game::getInstance().requestStates("simulate, level");
+            else if (!CommandLineParser::getValue("replay").get<std::string>().empty())
+            {
+                if (CommandLineParser::getValue("console").get<bool>())
+                    Game::getInstance().requestStates("replay, level");
+                else
+                    Game::getInstance().requestStates("graphics, replay, level");
+            }
             /* ADD masterserver command */
             else if (CommandLineParser::getValue("masterserver").get<bool>())
                 Game::getInstance().requestStates("masterserver");
@@ -92,11 +92,15 @@ namespace orxonox
 
     // controllers
     class AIController;
+    class AIScheduler;
     class ArtificialController;
     class Controller;
     class DroneController;
+    class FormationSlots;
     class HumanController;
     class ScriptController;
+    class TargetAcquisition;
+    struct TargetQuery;
     class WaypointController;
     class WaypointPatrolController;
 
@@ -138,6 +142,7 @@ namespace orxonox
     class PickupCarrier;
     class PlayerTrigger;
     class RadarListener;
+    class RadarProximityIndex;
     class RadarViewable;
     class Rewardable;
     class TeamColourable;
@@ -166,6 +171,7 @@ namespace orxonox
 
     // weaponsystem
     class DefaultWeaponmodeLink;
+    class LagCompensation;
     class Munition;
     class Weapon;
     class WeaponMode;
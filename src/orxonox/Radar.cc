@@ -80,6 +80,9 @@ namespace orxonox
     {
         assert( this->radarObjects_.find(rv) == this->radarObjects_.end() );
         this->radarObjects_.insert(rv);
+        rv->radarIndex_ = this->objectArray_.size();
+        this->objectArray_.push_back(rv);
+        this->positions_.push_back(rv->getRVWorldPosition());
         // iterate through all radarlisteners and notify them
         for (ObjectList<RadarListener>::iterator itListener = ObjectList<RadarListener>::begin(); itListener; ++itListener)
         {
@@ -91,6 +94,14 @@ namespace orxonox
     {
         assert( this->radarObjects_.find(rv) != this->radarObjects_.end() );
         this->radarObjects_.erase(rv);
+        // move the last object to the free slot
+        const size_t index = rv->radarIndex_;
+        assert( this->objectArray_[index] == rv );
+        this->objectArray_[index] = this->objectArray_.back();
+        this->positions_[index] = this->positions_.back();
+        this->objectArray_[index]->radarIndex_ = index;
+        this->objectArray_.pop_back();
+        this->positions_.pop_back();
         // iterate through all radarlisteners and notify them
         for (ObjectList<RadarListener>::iterator itListener = ObjectList<RadarListener>::begin(); itListener; ++itListener)
         {
@@ -127,6 +138,8 @@ namespace orxonox
             this->itFocus_ = 0;
         }
 
+        this->updatePositions();
+
         for (ObjectList<RadarListener>::iterator itListener = ObjectList<RadarListener>::begin(); itListener; ++itListener)
         {
             (*itListener)->radarTick(dt);
@@ -203,6 +216,15 @@ namespace orxonox
         }
     }
 
+    /**
+        @brief Captures the world positions of all radar objects (see getRadarObjectPosition()).
+    */
+    void Radar::updatePositions()
+    {
+        for (size_t i = 0; i < this->objectArray_.size(); ++i)
+            this->positions_[i] = this->objectArray_[i]->getRVWorldPosition();
+    }
+
     void Radar::radarObjectChanged(RadarViewable* rv)
     {
         for (ObjectList<RadarListener>::iterator itListener = ObjectList<RadarListener>::begin(); itListener; ++itListener)
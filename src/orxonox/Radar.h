@@ -39,6 +39,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "core/object/ObjectListIterator.h"
 #include "interfaces/RadarViewable.h"
@@ -62,6 +63,21 @@ namespace orxonox
         const std::set<RadarViewable*>& getRadarObjects() const
             { return this->radarObjects_; }
 
+        /**
+        @brief
+            Returns the position of a radar object as captured at the beginning of the
+            current tick. The positions of all objects are updated together in one pass,
+            so listeners can read them without querying each WorldEntity again.
+        */
+        inline const Vector3& getRadarObjectPosition(const RadarViewable* rv) const
+        {
+            // objects of other scenes aren't in our arrays
+            if (rv->radarIndex_ < this->objectArray_.size() && this->objectArray_[rv->radarIndex_] == rv)
+                return this->positions_[rv->radarIndex_];
+            else
+                return rv->getRVWorldPosition();
+        }
+
         void releaseFocus();
         void cycleFocus();
 
@@ -72,11 +88,14 @@ namespace orxonox
         void addRadarObject(RadarViewable* rv);
         void removeRadarObject(RadarViewable* rv);
         void radarObjectChanged(RadarViewable* rv);
+        void updatePositions();
 
         ObjectList<RadarViewable>::iterator itFocus_;
         RadarViewable* focus_;
         std::map<std::string, RadarViewable::Shape> objectTypes_;
         std::set<RadarViewable*> radarObjects_;
+        std::vector<RadarViewable*> objectArray_;   //!< All radar objects, RadarViewable::radarIndex_ is the index in this array
+        std::vector<Vector3> positions_;            //!< The world positions of the objects in objectArray_ (see updatePositions())
         int objectTypeCounter_;
     };
 }
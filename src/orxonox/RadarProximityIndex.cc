@@ -0,0 +1,102 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+@file
+@brief
+    Implementation of the RadarProximityIndex class.
+*/
+
+#include "RadarProximityIndex.h"
+
+#include <algorithm>
+
+#include "Radar.h"
+
+namespace orxonox
+{
+    static bool compareDistance(const RadarProximityIndex::Entry& a, const RadarProximityIndex::Entry& b)
+    {
+        return a.squaredDistance < b.squaredDistance;
+    }
+
+    RadarProximityIndex::RadarProximityIndex()
+        : numNearest_(0)
+    {
+    }
+
+    /**
+        @brief Adds an object, it's sorted in the next update().
+    */
+    void RadarProximityIndex::add(RadarViewable* object)
+    {
+        Entry entry = { object, 0.0f };
+        this->entries_.push_back(entry);
+        this->numNearest_ = 0;
+    }
+
+    void RadarProximityIndex::remove(RadarViewable* object)
+    {
+        for (std::vector<Entry>::iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
+        {
+            if (it->object == object)
+            {
+                // keep the order, so the next update doesn't have to move all objects again
+                if (static_cast<size_t>(it - this->entries_.begin()) < this->numNearest_)
+                    --this->numNearest_;
+                this->entries_.erase(it);
+                return;
+            }
+        }
+    }
+
+    void RadarProximityIndex::clear()
+    {
+        this->entries_.clear();
+        this->numNearest_ = 0;
+    }
+
+    /**
+    @brief
+        Computes the distances of all objects to @a position and sorts the nearest objects.
+    @param radar
+        The Radar whose captured positions are used
+    @param position
+        The position, usually the position of the local player
+    @param numNearest
+        The number of objects which are sorted (e.g. the number of markers on the HUD)
+    */
+    void RadarProximityIndex::update(const Radar* radar, const Vector3& position, size_t numNearest)
+    {
+        for (size_t i = 0; i < this->entries_.size(); ++i)
+            this->entries_[i].squaredDistance = radar->getRadarObjectPosition(this->entries_[i].object).squaredDistance(position);
+
+        this->numNearest_ = std::min(numNearest, this->entries_.size());
+        std::partial_sort(this->entries_.begin(), this->entries_.begin() + this->numNearest_, this->entries_.end(), compareDistance);
+    }
+}
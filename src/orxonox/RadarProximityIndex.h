@@ -0,0 +1,87 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+@file
+@brief
+    Definition of the RadarProximityIndex class.
+*/
+
+#ifndef _RadarProximityIndex_H__
+#define _RadarProximityIndex_H__
+
+#include "OrxonoxPrereqs.h"
+
+#include <vector>
+#include "util/Math.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Keeps the radar objects of a RadarListener ordered by their distance to a
+        position (usually the local player).
+
+        The listener adds and removes the objects when it's notified by the Radar.
+        update() computes the distances of all objects in one pass from the positions
+        captured by the Radar and sorts only the nearest objects (the others remain in
+        the order of the previous update). Because the order changes little between two
+        frames, this is much cheaper than sorting all objects in each frame.
+    */
+    class _OrxonoxExport RadarProximityIndex
+    {
+        public:
+            /// An object and its squared distance to the position of the last update().
+            struct Entry
+            {
+                RadarViewable* object;
+                float squaredDistance;
+            };
+
+            RadarProximityIndex();
+
+            void add(RadarViewable* object);
+            void remove(RadarViewable* object);
+            void clear();
+
+            void update(const Radar* radar, const Vector3& position, size_t numNearest);
+
+            /// Returns all objects, the first getNumNearest() objects are sorted by their distance.
+            inline const std::vector<Entry>& getEntries() const
+                { return this->entries_; }
+            /// Returns the number of objects which were sorted by the last update().
+            inline size_t getNumNearest() const
+                { return this->numNearest_; }
+
+        private:
+            std::vector<Entry> entries_;    //!< The objects, partially sorted by their distance
+            size_t numNearest_;             //!< The number of sorted objects at the beginning of entries_
+    };
+}
+
+#endif /* _RadarProximityIndex_H__ */
@@ -29,6 +29,7 @@
 
 #include "Scene.h"
 
+
 #include <OgreRoot.h>
 #include <OgreSceneManager.h>
 #include <OgreSceneManagerEnumerator.h>
@@ -39,6 +40,8 @@
 #include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
 
+#include "util/Clock.h"
+#include "util/Metrics.h"
 #include "core/CoreIncludes.h"
 #include "core/GameMode.h"
 #include "core/GUIManager.h"
@@ -48,6 +51,9 @@
 #include "tools/BulletDebugDrawer.h"
 #include "tools/DebugDrawer.h"
 #include "Radar.h"
+#include "controllers/AIScheduler.h"
+#include "controllers/TargetAcquisition.h"
+#include "weaponsystem/LagCompensation.h"
 #include "worldentities/WorldEntity.h"
 #include "Level.h"
 
@@ -84,6 +90,10 @@ namespace orxonox
             this->radar_ = 0;
         }
 
+        this->targetAcquisition_ = new TargetAcquisition(this);
+        this->aiScheduler_ = new AIScheduler(this);
+        this->lagCompensation_ = new LagCompensation(this);
+
         // No physics yet, XMLPort will do that.
         const int defaultMaxWorldSize = 100000;
         this->negativeWorldRange_ = Vector3::UNIT_SCALE * -defaultMaxWorldSize;
@@ -106,6 +116,9 @@ namespace orxonox
 
             if (this->radar_)
                 this->radar_->destroy();
+            delete this->targetAcquisition_;
+            delete this->aiScheduler_;
+            delete this->lagCompensation_;
 
             if (GameMode::showsGraphics())
                 Ogre::Root::getSingleton().destroySceneManager(this->sceneManager_);
@@ -127,20 +140,21 @@ namespace orxonox
         XMLPortParam(Scene, "negativeWorldRange", setNegativeWorldRange, getNegativeWorldRange, xmlelement, mode);
         XMLPortParam(Scene, "positiveWorldRange", setPositiveWorldRange, getPositiveWorldRange, xmlelement, mode);
         XMLPortParam(Scene, "hasPhysics", setPhysicalWorld, hasPhysics, xmlelement, mode).defaultValues(true);
+        XMLPortParam(Scene, "targetUpdateInterval", setTargetUpdateInterval, getTargetUpdateInterval, xmlelement, mode).defaultValues(0.0f);
 
         XMLPortObjectExtended(Scene, BaseObject, "", addObject, getObject, xmlelement, mode, true, false);
     }
 
     void Scene::registerVariables()
     {
-        registerVariable(this->skybox_,             VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_applySkybox));
-        registerVariable(this->ambientLight_,       VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_applyAmbientLight));
-        registerVariable(this->negativeWorldRange_, VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_negativeWorldRange));
-        registerVariable(this->positiveWorldRange_, VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_positiveWorldRange));
-        registerVariable(this->gravity_,            VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_gravity));
-        registerVariable(this->bHasPhysics_,        VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_hasPhysics));
-        registerVariable(this->bShadows_,           VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::networkcallback_applyShadows));
-        registerVariable(this->getLevel(),          VariableDirection::ToClient, new NetworkCallback<Scene>(this, &Scene::changedLevel));
+        registerVariable(this->skybox_,             VariableDirection::ToClient, &Scene::networkcallback_applySkybox);
+        registerVariable(this->ambientLight_,       VariableDirection::ToClient, &Scene::networkcallback_applyAmbientLight);
+        registerVariable(this->negativeWorldRange_, VariableDirection::ToClient, &Scene::networkcallback_negativeWorldRange);
+        registerVariable(this->positiveWorldRange_, VariableDirection::ToClient, &Scene::networkcallback_positiveWorldRange);
+        registerVariable(this->gravity_,            VariableDirection::ToClient, &Scene::networkcallback_gravity);
+        registerVariable(this->bHasPhysics_,        VariableDirection::ToClient, &Scene::networkcallback_hasPhysics);
+        registerVariable(this->bShadows_,           VariableDirection::ToClient, &Scene::networkcallback_applyShadows);
+        registerVariable(this->getLevel(),          VariableDirection::ToClient, &Scene::changedLevel);
     }
 
     void Scene::setNegativeWorldRange(const Vector3& range)
@@ -225,6 +239,7 @@ namespace orxonox
                 this->physicalObjectQueue_.insert(*it);
             }
             this->physicalObjects_.clear();
+            this->collisions_.clear();
 
             delete this->debugDrawer_;
             delete this->physicalWorld_;
@@ -247,6 +262,9 @@ namespace orxonox
             // We need to update the scene nodes if we don't render
             this->rootSceneNode_->_update(true, false);
         }
+        this->targetAcquisition_->tick(dt);
+        this->aiScheduler_->tick(dt);
+        this->lagCompensation_->tick(dt);
         if (this->hasPhysics())
         {
             // TODO: This here is bad practice! It will slow down the first tick() by ages.
@@ -265,7 +283,16 @@ namespace orxonox
 
             // Note: 60 means that Bullet will do physics correctly down to 1 frames per seconds.
             //       Under that mark, the simulation will "loose time" and get unusable.
+            static Clock physicsClock;
+            uint64_t timeBeforeStep = physicsClock.getRealMicroseconds();
+
             physicalWorld_->stepSimulation(dt, 60);
+            this->dispatchCollisions();
+
+            static MetricHistogram& stepTimeMetric = MetricsRegistry::getInstance().registerHistogram("physics.step_time", MetricHistogram::getDefaultTimeBounds());
+            static MetricGauge& physicalObjectsMetric = MetricsRegistry::getInstance().registerGauge("physics.objects");
+            stepTimeMetric.sample((physicsClock.getRealMicroseconds() - timeBeforeStep) / 1000000.0);
+            physicalObjectsMetric.set(this->physicalObjects_.size());
 
             if (this->bDebugDrawPhysics_)
                 physicalWorld_->debugDrawWorld();
@@ -362,21 +389,87 @@ namespace orxonox
                                              int index0, const btCollisionObject* colObj1, int partId1, int index1)
     {
         // get the WorldEntity pointers
-        SmartPtr<WorldEntity> object0 = static_cast<WorldEntity*>(colObj0->getUserPointer());
-        SmartPtr<WorldEntity> object1 = static_cast<WorldEntity*>(colObj1->getUserPointer());
-
-        // get the CollisionShape pointers
-        const btCollisionShape* cs0 = colObj0->getCollisionShape();
-        const btCollisionShape* cs1 = colObj1->getCollisionShape();
+        WorldEntity* object0 = static_cast<WorldEntity*>(colObj0->getUserPointer());
+        WorldEntity* object1 = static_cast<WorldEntity*>(colObj1->getUserPointer());
+
+        Scene* scene = object0->getScene().get();
+        if (!scene)
+            return false;
+
+        // only record the contact, the objects are notified after the physics step (see dispatchCollisions())
+        scene->collisions_.push_back(Collision());
+        Collision& collision = scene->collisions_.back();
+        collision.object0 = object0;
+        collision.object1 = object1;
+        collision.shape0 = colObj0->getCollisionShape();
+        collision.shape1 = colObj1->getCollisionShape();
+        collision.contactPoint = cp;
 
         // false means that bullet will assume we didn't modify the contact
-        bool modified = false;
-        if (object0->isCollisionCallbackActive())
-            modified |= object0->collidesAgainst(object1, cs1, cp);
-        if (object1->isCollisionCallbackActive())
-            modified |= object1->collidesAgainst(object0, cs0, cp);
+        return false;
+    }
+
+    /**
+    @brief
+        Notifies the objects about the contacts of the last physics step. Each pair
+        of objects is notified only once (with the first contact point of the step).
+    */
+    void Scene::dispatchCollisions()
+    {
+        static MetricGauge& collisionsMetric = MetricsRegistry::getInstance().registerGauge("physics.collisions");
+        if (this->collisions_.empty())
+        {
+            collisionsMetric.set(0);
+            return;
+        }
+
+        // keep the first contact of each pair in the order in which bullet reported the contacts
+        size_t count = 0;
+        for (size_t i = 0; i < this->collisions_.size(); ++i)
+        {
+            const Collision& collision = this->collisions_[i];
+            std::pair<WorldEntity*, WorldEntity*> pair = (collision.object0 < collision.object1) ?
+                std::make_pair(collision.object0, collision.object1) : std::make_pair(collision.object1, collision.object0);
+            if (this->collidingPairs_.insert(pair).second)
+                this->collisions_[count++] = collision;
+        }
+        this->collisions_.resize(count);
+        this->collidingPairs_.clear();
+        collisionsMetric.set(count);
+
+        // the collision handlers may destroy objects, but they're only deleted after all collisions were dispatched
+        for (size_t i = 0; i < count; ++i)
+        {
+            this->collidingObjects_.push_back(this->collisions_[i].object0);
+            this->collidingObjects_.push_back(this->collisions_[i].object1);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Collision& collision = this->collisions_[i];
+            if (collision.object0->isCollisionCallbackActive())
+                collision.object0->collidesAgainst(collision.object1, collision.shape1, collision.contactPoint);
+            if (collision.object1->isCollisionCallbackActive())
+                collision.object1->collidesAgainst(collision.object0, collision.shape0, collision.contactPoint);
+        }
 
-        return modified;
+        this->collisions_.clear();
+        this->collidingObjects_.clear();
+    }
+
+    /**
+    @brief
+        Sets the time (in seconds) after which the target acquisition collects the positions of the pawns again.
+        Higher values make the turrets and bots cheaper but react later to moving targets. 0 means every tick.
+    */
+    void Scene::setTargetUpdateInterval(float interval)
+    {
+        this->targetAcquisition_->setUpdateInterval(interval);
+    }
+
+    float Scene::getTargetUpdateInterval() const
+    {
+        return this->targetAcquisition_->getUpdateInterval();
     }
 
     void Scene::setDebugDrawPhysics(bool bDraw, bool bFill, float fillAlpha)
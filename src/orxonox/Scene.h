@@ -35,6 +35,9 @@
 #include <list>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
+#include <BulletCollision/NarrowPhaseCollision/btManifoldPoint.h>
 
 #include "util/Math.h"
 #include "util/OgreForwardRefs.h"
@@ -77,6 +80,17 @@ namespace orxonox
 
             inline Radar* getRadar()
                 { return this->radar_; }
+            /// Returns the service which finds hostile pawns for turrets and AI controllers in this scene.
+            inline TargetAcquisition* getTargetAcquisition()
+                { return this->targetAcquisition_; }
+            void setTargetUpdateInterval(float interval);
+            float getTargetUpdateInterval() const;
+            /// Returns the scheduler which decides how often the bots in this scene are updated.
+            inline AIScheduler* getAIScheduler()
+                { return this->aiScheduler_; }
+            /// Returns the service which rewinds the pawns in this scene to test the hits of clients with latency.
+            inline LagCompensation* getLagCompensation()
+                { return this->lagCompensation_; }
 
             inline virtual uint32_t getSceneID() const { return this->getObjectID(); }
 
@@ -102,6 +116,9 @@ namespace orxonox
             bool                     bShadows_;
             float                    soundReferenceDistance_;
             Radar*                   radar_;
+            TargetAcquisition*       targetAcquisition_;
+            AIScheduler*             aiScheduler_;
+            LagCompensation*         lagCompensation_;
 
 
         /////////////
@@ -111,6 +128,9 @@ namespace orxonox
         public:
             inline bool hasPhysics()
                 { return this->physicalWorld_ != 0; }
+            /// Returns the Bullet world of this scene (NULL if the scene has no physics). Can be used for ray tests.
+            inline btDiscreteDynamicsWorld* getPhysicalWorld() const
+                { return this->physicalWorld_; }
             void setPhysicalWorld(bool wantsPhysics);
 
             void setNegativeWorldRange(const Vector3& range);
@@ -142,9 +162,20 @@ namespace orxonox
             inline void networkcallback_gravity()
                 { this->setGravity(this->gravity_); }
 
+            /// @brief A contact between two objects, recorded during the physics step and dispatched afterwards.
+            struct Collision
+            {
+                WorldEntity* object0;
+                WorldEntity* object1;
+                const btCollisionShape* shape0;     ///< The collision shape of object0
+                const btCollisionShape* shape1;     ///< The collision shape of object1
+                btManifoldPoint contactPoint;
+            };
+
             // collision callback from bullet
             static bool collisionCallback(btManifoldPoint& cp, const btCollisionObject* colObj0, int partId0,
                                           int index0, const btCollisionObject* colObj1, int partId1, int index1);
+            void dispatchCollisions();
 
             // Bullet objects
             btDiscreteDynamicsWorld*             physicalWorld_;
@@ -155,6 +186,9 @@ namespace orxonox
 
             std::set<WorldEntity*>               physicalObjectQueue_;
             std::set<WorldEntity*>               physicalObjects_;
+            std::vector<Collision>               collisions_;               ///< The contacts of the current physics step
+            std::set<std::pair<WorldEntity*, WorldEntity*> > collidingPairs_; ///< The pairs of objects whose first contact was already kept by dispatchCollisions()
+            std::vector<SmartPtr<WorldEntity> >  collidingObjects_;         ///< Keeps the colliding objects alive while the collisions are dispatched
             bool                                 bHasPhysics_;
             Vector3                              negativeWorldRange_;
             Vector3                              positiveWorldRange_;
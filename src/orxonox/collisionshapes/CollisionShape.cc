@@ -97,7 +97,17 @@ namespace orxonox
     void CollisionShape::registerVariables()
     {
         // Keep the shape's parent (can be either a CompoundCollisionShape or a WorldEntity) consistent over the network.
-        registerVariable(this->parentID_, VariableDirection::ToClient, new NetworkCallback<CollisionShape>(this, &CollisionShape::parentChanged));
+        registerVariable(this->parentID_, VariableDirection::ToClient, &CollisionShape::parentChanged);
+    }
+
+    /**
+    @brief
+        A joining client needs the parent to attach the CollisionShape (see parentChanged()).
+    */
+    void CollisionShape::getReferencedObjects(std::vector<uint32_t>& objectIDs) const
+    {
+        if (this->parentID_ != OBJECTID_UNKNOWN)
+            objectIDs.push_back(this->parentID_);
     }
 
     /**
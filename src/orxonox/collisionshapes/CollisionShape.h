@@ -61,6 +61,7 @@ namespace orxonox
             virtual ~CollisionShape();
 
             virtual void XMLPort(Element& xmlelement, XMLPort::Mode mode);
+            virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const;
 
             /**
             @brief Set the position of the CollisionShape.
@@ -53,6 +53,9 @@ namespace orxonox
 
     void AIController::action()
     {
+        if (!this->isScheduledAction())
+            return;
+
         float random;
         float maxrand = 100.0f / ACTION_INTERVAL;
 
@@ -149,6 +152,14 @@ namespace orxonox
         if (!this->isActive())
             return;
 
+        // distant bots only keep steering between the ticks in which the AIScheduler updates them
+        if (!this->isScheduledUpdate(this->target_ && this->bShooting_))
+        {
+            this->keepSteering();
+            SUPER(AIController, tick, dt);
+            return;
+        }
+
         float random;
         float maxrand = 100.0f / ACTION_INTERVAL;
         ControllableEntity* controllable = this->getControllableEntity();
@@ -177,6 +188,8 @@ namespace orxonox
 
         if (this->mode_ == DEFAULT)
         {
+            this->readFormationSlot();
+
             if (this->state_ == MASTER)
             {
                 if (this->specificMasterAction_ ==  NONE)
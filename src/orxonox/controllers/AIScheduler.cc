@@ -0,0 +1,137 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file AIScheduler.cc
+    @brief Implementation of the AIScheduler class.
+*/
+
+#include "AIScheduler.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "util/Metrics.h"
+#include "core/object/ObjectList.h"
+#include "Scene.h"
+#include "infos/PlayerInfo.h"
+#include "worldentities/ControllableEntity.h"
+
+namespace orxonox
+{
+    AIScheduler::AIScheduler(Scene* scene)
+    {
+        this->scene_ = scene;
+        this->bStale_ = true;
+        this->frame_ = 0;
+        this->nearDistance_ = 3000.0f;
+        this->farDistance_ = 10000.0f;
+        this->intervals_[0] = 1;
+        this->intervals_[1] = 4;
+        this->intervals_[2] = 16;
+        this->noHumansLevel_ = 0;
+    }
+
+    AIScheduler::~AIScheduler()
+    {
+    }
+
+    /**
+        @brief Is called by the scene each tick. Starts the next frame.
+    */
+    void AIScheduler::tick(float dt)
+    {
+        ++this->frame_;
+        this->bStale_ = true;
+    }
+
+    /**
+        @brief Returns a new bucket. The buckets are assigned round-robin, so consecutive bots are updated in different ticks.
+    */
+    /*static*/ unsigned int AIScheduler::createBucket()
+    {
+        static unsigned int nextBucket = 0;
+        return nextBucket++;
+    }
+
+    /**
+        @brief Collects the positions of all entities in this scene which are controlled by human players (including spectators).
+    */
+    void AIScheduler::updateHumanPositions()
+    {
+        this->humanPositions_.clear();
+        for (ObjectList<PlayerInfo>::iterator it = ObjectList<PlayerInfo>::begin(); it != ObjectList<PlayerInfo>::end(); ++it)
+        {
+            ControllableEntity* entity = it->getControllableEntity();
+            if (it->isHumanPlayer() && entity && entity->getScene().get() == this->scene_)
+                this->humanPositions_.push_back(entity->getWorldPosition());
+        }
+        this->bStale_ = false;
+    }
+
+    /**
+        @brief Returns the level of detail of a bot at the given position.
+        @param position The world position of the bot
+        @param bInCombat Bots in combat are always updated every tick
+    */
+    unsigned int AIScheduler::getLevel(const Vector3& position, bool bInCombat)
+    {
+        static MetricCounter& levelMetrics0 = MetricsRegistry::getInstance().registerCounter("ai.updates_level0");
+        static MetricCounter& levelMetrics1 = MetricsRegistry::getInstance().registerCounter("ai.updates_level1");
+        static MetricCounter& levelMetrics2 = MetricsRegistry::getInstance().registerCounter("ai.updates_level2");
+        static MetricCounter* levelMetrics[NumLevels] = { &levelMetrics0, &levelMetrics1, &levelMetrics2 };
+
+        unsigned int level;
+        if (bInCombat)
+            level = 0;
+        else
+        {
+            if (this->bStale_)
+                this->updateHumanPositions();
+
+            if (this->humanPositions_.empty())
+                level = this->noHumansLevel_; // no distance to measure
+            else
+            {
+                float squaredDistance = FLT_MAX;
+                for (size_t i = 0; i < this->humanPositions_.size(); ++i)
+                    squaredDistance = std::min(squaredDistance, position.squaredDistance(this->humanPositions_[i]));
+
+                if (squaredDistance < this->nearDistance_ * this->nearDistance_)
+                    level = 0;
+                else if (squaredDistance < this->farDistance_ * this->farDistance_)
+                    level = 1;
+                else
+                    level = 2;
+            }
+        }
+
+        levelMetrics[level]->add();
+        return level;
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file AIScheduler.h
+    @brief Declaration of the AIScheduler class.
+*/
+
+#ifndef _AIScheduler_H__
+#define _AIScheduler_H__
+
+#include "OrxonoxPrereqs.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "util/Math.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Decides how often the bots of a Scene run their decision logic (see
+        ArtificialController::isScheduledUpdate()). There's one instance per
+        Scene (see Scene::getAIScheduler()).
+
+        Each bot gets a level of detail depending on its distance to the
+        closest entity controlled by a human player:
+         - Level 0 (closer than the near distance, or in combat): every tick
+         - Level 1 (closer than the far distance): every midInterval-th tick
+         - Level 2 (farther away): every farInterval-th tick
+
+        If no human player controls an entity in the scene (e.g. on a server
+        without players), all bots get the same level (0 by default, see
+        setNoHumansLevel()).
+
+        The bots are distributed to round-robin buckets, so the updates of the
+        bots with the same level are spread evenly over the frames. Between two
+        updates the bots keep steering towards the position they decided on in
+        their last update.
+    */
+    class _OrxonoxExport AIScheduler
+    {
+        public:
+            static const unsigned int NumLevels = 3; //!< The number of levels of detail
+
+            AIScheduler(Scene* scene);
+            ~AIScheduler();
+
+            void tick(float dt);
+
+            unsigned int getLevel(const Vector3& position, bool bInCombat);
+            /// @brief Returns the number of ticks between two updates of a bot with the given level.
+            inline unsigned int getInterval(unsigned int level) const
+                { return this->intervals_[std::min(level, NumLevels - 1)]; }
+            /// @brief Returns true if a bot in the given bucket with the given level has to be updated in this tick.
+            inline bool isDue(unsigned int bucket, unsigned int level) const
+                { return ((this->frame_ + bucket) % this->getInterval(level)) == 0; }
+
+            static unsigned int createBucket();
+
+            /// @brief Sets the distance to human players within which bots are updated every tick.
+            inline void setNearDistance(float distance)
+                { this->nearDistance_ = distance; }
+            /// @brief Sets the distance to human players within which bots are updated every midInterval-th tick.
+            inline void setFarDistance(float distance)
+                { this->farDistance_ = distance; }
+            /// @brief Sets the number of ticks between two updates of bots with level 1.
+            inline void setMidInterval(unsigned int interval)
+                { this->intervals_[1] = std::max(interval, 1u); }
+            /// @brief Sets the number of ticks between two updates of bots with level 2.
+            inline void setFarInterval(unsigned int interval)
+                { this->intervals_[2] = std::max(interval, 1u); }
+            /// @brief Sets the level of all bots while no human player is in the scene.
+            inline void setNoHumansLevel(unsigned int level)
+                { this->noHumansLevel_ = std::min(level, NumLevels - 1); }
+
+        private:
+            void updateHumanPositions();
+
+            Scene* scene_;                          //!< The scene whose bots are scheduled
+            std::vector<Vector3> humanPositions_;   //!< The positions of the entities controlled by human players in this scene
+            bool bStale_;                           //!< True if the human positions have to be collected again
+            unsigned int frame_;                    //!< The number of the current tick
+            float nearDistance_;                    //!< Bots closer than this to a human player have level 0
+            float farDistance_;                     //!< Bots closer than this to a human player have level 1
+            unsigned int intervals_[NumLevels];     //!< The number of ticks between two updates for each level
+            unsigned int noHumansLevel_;            //!< The level of all bots while no human player is in the scene
+    };
+}
+
+#endif /* _AIScheduler_H__ */
@@ -32,6 +32,8 @@
 #include "core/command/ConsoleCommand.h"
 #include "worldentities/pawns/Pawn.h"
 #include "worldentities/pawns/SpaceShip.h"
+#include "controllers/AIScheduler.h"
+#include "Scene.h"
 
 #include "weaponsystem/WeaponMode.h"
 #include "weaponsystem/WeaponPack.h"
@@ -57,6 +59,10 @@ namespace orxonox
         this->setAccuracy(5);
         this->defaultWaypoint_ = NULL;
         this->mode_ = DEFAULT;//Vector-implementation: mode_.push_back(DEFAULT);
+
+        this->updateBucket_ = AIScheduler::createBucket();
+        this->updateLevel_ = 0;
+        this->actionCounter_ = 0;
     }
 
     ArtificialController::~ArtificialController()
@@ -288,4 +294,36 @@ namespace orxonox
             this->updatePointsOfInterest("PickupSpawner", 20.0f); // take pickup en passant if there is a default waypoint
     }
 
+    /**
+        @brief Returns true if the bot has to run its decision logic in this tick.
+        @param bInCombat Bots in combat are updated every tick
+
+        Bots which are far away from human players are only updated every few ticks (see AIScheduler).
+        In the other ticks they should only call keepSteering(). Bots which control a rocket are always updated.
+    */
+    bool ArtificialController::isScheduledUpdate(bool bInCombat)
+    {
+        ControllableEntity* controllable = this->getControllableEntity();
+        if (controllable && controllable->getScene() && this->mode_ == DEFAULT)
+        {
+            AIScheduler* scheduler = controllable->getScene()->getAIScheduler();
+            if (!bInCombat && !scheduler->isDue(this->updateBucket_, this->updateLevel_))
+                return false;
+            this->updateLevel_ = scheduler->getLevel(controllable->getWorldPosition(), bInCombat);
+        }
+        else
+            this->updateLevel_ = 0;
+
+        this->bHasSteeringPosition_ = false;
+        return true;
+    }
+
+    /**
+        @brief Returns true if a regularly called action (e.g. AIController::action()) should be carried out.
+        Bots with a lower level of detail carry out only every second (level 1) or fourth (level 2) action.
+    */
+    bool ArtificialController::isScheduledAction()
+    {
+        return ((this->actionCounter_++ + this->updateBucket_) % (1u << this->updateLevel_)) == 0;
+    }
 }
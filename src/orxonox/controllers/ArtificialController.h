@@ -95,7 +95,14 @@ namespace orxonox
 
             void boostControl(); //<! Sets and resets the boost parameter of the spaceship. Bots alternate between boosting and saving boost.
 
+            //SCHEDULING
+            bool isScheduledUpdate(bool bInCombat); //<! Returns true if the bot has to run its decision logic in this tick (see AIScheduler).
+            bool isScheduledAction(); //<! Returns true if a regularly called action should be carried out (less often for distant bots).
+
         private:
+            unsigned int updateBucket_; //<! The round-robin bucket of the bot in the AIScheduler.
+            unsigned int updateLevel_; //<! The level of detail of the bot, determined in the last scheduled update.
+            unsigned int actionCounter_; //<! Counts the calls of isScheduledAction().
     };
 }
 
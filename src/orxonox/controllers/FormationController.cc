@@ -44,6 +44,8 @@
 #include "controllers/WaypointPatrolController.h"
 #include "controllers/NewHumanController.h"
 #include "controllers/DroneController.h"
+#include "controllers/TargetAcquisition.h"
+#include "Scene.h"
 
 
 namespace orxonox
@@ -76,6 +78,8 @@ namespace orxonox
         this->passive_ = false;
         this->maxFormationSize_ = STANDARD_MAX_FORMATION_SIZE;
         this->myMaster_ = 0;
+        this->formationSlot_ = 0;
+        this->formationGeneration_ = 0;
         this->freedomCount_ = 0;
 
         this->state_ = FREE;
@@ -87,6 +91,8 @@ namespace orxonox
         this->bHasTargetOrientation_=false;
         this->speedCounter_ = 0.2f;
         this->targetPosition_ = Vector3::ZERO;
+        this->steeringPosition_ = Vector3::ZERO;
+        this->bHasSteeringPosition_ = false;
         this->target_.setCallback(createFunctor(&FormationController::targetDied, this));
     }
 
@@ -269,6 +275,9 @@ namespace orxonox
         if (!this->getControllableEntity())
             return;
 
+        this->steeringPosition_ = target;
+        this->bHasSteeringPosition_ = true;
+
         // Slave uses special movement if its master is in FOLLOW mode
         if(this->state_ == SLAVE && this->myMaster_ && this->myMaster_->specificMasterAction_ == FOLLOW)
         {
@@ -351,6 +360,15 @@ namespace orxonox
         this->moveToPosition(this->targetPosition_);
     }
 
+    /**
+        @brief Steers towards the position of the last call of moveToPosition(). Is called in the ticks in which the AIScheduler skips the decision logic of the bot.
+    */
+    void FormationController::keepSteering()
+    {
+        if (this->bHasSteeringPosition_)
+            this->moveToPosition(this->steeringPosition_);
+    }
+
     //copy the Roll orientation of given Quaternion.
     void FormationController::copyOrientation(const Quaternion& orient)
     {
@@ -468,39 +486,28 @@ namespace orxonox
     {
         if(this->state_ != MASTER) return;
 
-        Quaternion orient = this->getControllableEntity()->getOrientation();
-        Vector3 dest = this->getControllableEntity()->getPosition();
+        // compute the positions of all slaves in one pass, each slave reads its slot in readFormationSlot()
+        this->formationSlots_.update(this->getControllableEntity()->getPosition(), this->getControllableEntity()->getOrientation(), this->slaves_.size(), FORMATION_WIDTH, FORMATION_LENGTH);
+        for (size_t i = 0; i < this->slaves_.size(); ++i)
+            this->slaves_[i]->formationSlot_ = i;
+    }
 
-        // 1 slave: follow
-        if (this->slaves_.size() == 1)
-        {
-            dest += 4*orient*WorldEntity::BACK;
-            this->slaves_.front()->setTargetPosition(dest);
-        }
-        else
-        // formation:
-        {
-            dest += 1.0f*orient*WorldEntity::BACK;
-            Vector3 pos = Vector3::ZERO;
-            bool left=true;
-            int i = 1;
+    /**
+        @brief Takes the target position (and orientation) from the slot of this slave if the master updated the formation since the last call.
+    */
+    void FormationController::readFormationSlot()
+    {
+        if (this->state_ != SLAVE || !this->myMaster_)
+            return;
 
-            for(std::vector<FormationController*>::iterator it = slaves_.begin(); it != slaves_.end(); it++)
-            {
-                pos = Vector3::ZERO;
-                if (left)
-                {
-                    pos+=dest+i*FORMATION_WIDTH*(orient*WorldEntity::LEFT);
-                } else{
-                    pos+=dest+i*FORMATION_WIDTH*(orient*WorldEntity::RIGHT);
-                    i++;
-                    dest+=FORMATION_LENGTH*(orient*WorldEntity::BACK);
-                }
-                (*it)->setTargetOrientation(orient);
-                (*it)->setTargetPosition(pos);
-                left=!left;
-            }
-        }
+        const FormationSlots& slots = this->myMaster_->formationSlots_;
+        if (slots.getGeneration() == this->formationGeneration_ || this->formationSlot_ >= slots.size())
+            return;
+
+        this->formationGeneration_ = slots.getGeneration();
+        if (slots.hasOrientation())
+            this->setTargetOrientation(slots.getOrientation());
+        this->setTargetPosition(slots.getPosition(this->formationSlot_));
     }
 
     /**
@@ -917,25 +924,21 @@ namespace orxonox
         this->targetPosition_ = this->getControllableEntity()->getPosition();
         this->forgetTarget();
 
-        for (ObjectList<Pawn>::iterator it = ObjectList<Pawn>::begin(); it; ++it)
-        {
-            if (FormationController::sameTeam(this->getControllableEntity(), static_cast<ControllableEntity*>(*it), this->getGametype()))
-                continue;
-
-            /* So AI won't choose invisible Spaceships as target */
-            if (!it->getRadarVisibility())
-                continue;
+        /* So AI won't choose invisible Spaceships as target */
+        TargetQuery query(this->getControllableEntity(), this->getGametype());
+        query.bRadarVisibleOnly = true;
+        std::vector<Pawn*> targets;
+        this->getControllableEntity()->getScene()->getTargetAcquisition()->findTargets(query, targets);
 
-            if (static_cast<ControllableEntity*>(*it) != this->getControllableEntity())
+        for (std::vector<Pawn*>::iterator it = targets.begin(); it != targets.end(); ++it)
+        {
+            float speed = this->getControllableEntity()->getVelocity().length();
+            Vector3 distanceCurrent = this->targetPosition_ - this->getControllableEntity()->getPosition();
+            Vector3 distanceNew = (*it)->getPosition() - this->getControllableEntity()->getPosition();
+            if (!this->target_ || (*it)->getPosition().squaredDistance(this->getControllableEntity()->getPosition()) * (1.5f + acos((this->getControllableEntity()->getOrientation() * WorldEntity::FRONT).dotProduct(distanceNew) / speed / distanceNew.length()) / math::twoPi)
+                    < this->targetPosition_.squaredDistance(this->getControllableEntity()->getPosition()) * (1.5f + acos((this->getControllableEntity()->getOrientation() * WorldEntity::FRONT).dotProduct(distanceCurrent) / speed / distanceCurrent.length()) / math::twoPi) + rnd(-250, 250))
             {
-                float speed = this->getControllableEntity()->getVelocity().length();
-                Vector3 distanceCurrent = this->targetPosition_ - this->getControllableEntity()->getPosition();
-                Vector3 distanceNew = it->getPosition() - this->getControllableEntity()->getPosition();
-                if (!this->target_ || it->getPosition().squaredDistance(this->getControllableEntity()->getPosition()) * (1.5f + acos((this->getControllableEntity()->getOrientation() * WorldEntity::FRONT).dotProduct(distanceNew) / speed / distanceNew.length()) / math::twoPi)
-                        < this->targetPosition_.squaredDistance(this->getControllableEntity()->getPosition()) * (1.5f + acos((this->getControllableEntity()->getOrientation() * WorldEntity::FRONT).dotProduct(distanceCurrent) / speed / distanceCurrent.length()) / math::twoPi) + rnd(-250, 250))
-                {
-                    this->setTarget(*it);
-                }
+                this->setTarget(*it);
             }
         }
     }
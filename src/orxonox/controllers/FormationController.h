@@ -36,6 +36,7 @@
 
 #include "util/Math.h"
 #include "controllers/Controller.h"
+#include "controllers/FormationSlots.h"
 #include "worldentities/ControllableEntity.h"
 
 
@@ -43,6 +44,7 @@ namespace orxonox {
 
   class _OrxonoxExport FormationController : public Controller
   {
+      friend class TargetAcquisition; // uses sameTeam()
 
       public:
       FormationController(Context* context);
@@ -108,6 +110,9 @@ namespace orxonox {
       State state_;
       std::vector<FormationController*> slaves_;
       FormationController* myMaster_;
+      FormationSlots formationSlots_;       //!< The target positions of the slaves (if this is a master)
+      size_t formationSlot_;                //!< The index of the slot in the formation of the master (if this is a slave)
+      unsigned int formationGeneration_;    //!< The generation of the slots of the master when the slot was read the last time
 
       FormationMode formationMode_;
 
@@ -126,6 +131,7 @@ namespace orxonox {
       void unregisterSlave();
       void searchNewMaster();
       void commandSlaves();
+      void readFormationSlot();
       void takeLeadOfFormation();
       void loseMasterState();
       void setNewMasterWithinFormation();
@@ -149,6 +155,8 @@ namespace orxonox {
       void setTargetPosition(const Vector3& target);
       void searchRandomTargetPosition();
 
+      void keepSteering();
+
       void setTargetOrientation(const Quaternion& orient);
       void setTargetOrientation(Pawn* target);
 
@@ -171,6 +179,9 @@ namespace orxonox {
 
       WeakPtr<Pawn> target_;
       bool bShooting_;
+
+      Vector3 steeringPosition_;    //!< The position passed to moveToPosition() in the last scheduled update (see keepSteering())
+      bool bHasSteeringPosition_;   //!< True if moveToPosition() was called since the last scheduled update
   };
 
 
@@ -0,0 +1,105 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file FormationSlots.cc
+    @brief Implementation of the FormationSlots class.
+*/
+
+#include "FormationSlots.h"
+
+#include "worldentities/WorldEntity.h"
+
+namespace orxonox
+{
+    FormationSlots::FormationSlots()
+    {
+        this->width_ = 0;
+        this->length_ = 0;
+        this->orientation_ = Quaternion::IDENTITY;
+        this->generation_ = 0;
+    }
+
+    /**
+        @brief Computes the positions of all slots.
+        @param position The position of the master
+        @param orientation The orientation of the master
+        @param numSlots The number of slaves
+        @param width The distance between two slaves of a pair
+        @param length The distance between two pairs
+    */
+    void FormationSlots::update(const Vector3& position, const Quaternion& orientation, size_t numSlots, float width, float length)
+    {
+        if (numSlots != this->left_.size() || width != this->width_ || length != this->length_)
+        {
+            this->left_.resize(numSlots);
+            this->back_.resize(numSlots);
+            this->x_.resize(numSlots);
+            this->y_.resize(numSlots);
+            this->z_.resize(numSlots);
+            this->width_ = width;
+            this->length_ = length;
+
+            if (numSlots == 1)
+            {
+                this->left_[0] = 0.0f;
+                this->back_[0] = 4.0f;
+            }
+            else
+            {
+                for (size_t i = 0; i < numSlots; ++i)
+                {
+                    const float pair = static_cast<float>(i / 2);
+                    this->left_[i] = ((i % 2 == 0) ? 1.0f : -1.0f) * (pair + 1.0f) * width;
+                    this->back_[i] = 1.0f + pair * length;
+                }
+            }
+        }
+
+        static unsigned int nextGeneration = 0;
+        this->orientation_ = orientation;
+        this->generation_ = ++nextGeneration;
+        if (numSlots == 0)
+            return;
+
+        const Vector3 left = orientation * WorldEntity::LEFT;
+        const Vector3 back = orientation * WorldEntity::BACK;
+
+        const float* leftOffsets = &this->left_[0];
+        const float* backOffsets = &this->back_[0];
+        float* x = &this->x_[0];
+        float* y = &this->y_[0];
+        float* z = &this->z_[0];
+        for (size_t i = 0; i < numSlots; ++i)
+        {
+            x[i] = position.x + leftOffsets[i] * left.x + backOffsets[i] * back.x;
+            y[i] = position.y + leftOffsets[i] * left.y + backOffsets[i] * back.y;
+            z[i] = position.z + leftOffsets[i] * left.z + backOffsets[i] * back.z;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file FormationSlots.h
+    @brief Declaration of the FormationSlots class.
+*/
+
+#ifndef _FormationSlots_H__
+#define _FormationSlots_H__
+
+#include "OrxonoxPrereqs.h"
+
+#include <vector>
+
+#include "util/Math.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        The target positions of the slaves of a formation, computed by the master
+        in one pass (see FormationController::commandSlaves()). Each slave reads
+        the slot with its index (see FormationController::readFormationSlot()).
+
+        The positions are stored as a structure of arrays. The offsets of the
+        slots relative to the master only depend on the number of slaves and are
+        computed when it changes. An update rotates only the two axes of the
+        formation, the positions are then a linear combination of the axes
+        which the compiler can vectorise.
+
+        A single slave follows right behind the master, more slaves fly in
+        pairs, one on the left and one on the right, each pair further behind.
+    */
+    class _OrxonoxExport FormationSlots
+    {
+        public:
+            FormationSlots();
+
+            void update(const Vector3& position, const Quaternion& orientation, size_t numSlots, float width, float length);
+
+            /// @brief Returns the number of slots.
+            inline size_t size() const
+                { return this->x_.size(); }
+            /// @brief Returns the position of a slot.
+            inline Vector3 getPosition(size_t slot) const
+                { return Vector3(this->x_[slot], this->y_[slot], this->z_[slot]); }
+            /// @brief Returns the orientation the slaves should copy.
+            inline const Quaternion& getOrientation() const
+                { return this->orientation_; }
+            /// @brief Returns true if the slaves should copy the orientation of the master (false if there's only one slave).
+            inline bool hasOrientation() const
+                { return this->x_.size() > 1; }
+            /// @brief Returns a number that changes with every update (and is unique among all formations), so slaves can tell if their slot changed.
+            inline unsigned int getGeneration() const
+                { return this->generation_; }
+
+        private:
+            std::vector<float> left_;   //!< The offset of each slot along the left axis of the master
+            std::vector<float> back_;   //!< The offset of each slot along the back axis of the master
+            std::vector<float> x_;      //!< The x coordinate of each slot
+            std::vector<float> y_;      //!< The y coordinate of each slot
+            std::vector<float> z_;      //!< The z coordinate of each slot
+            float width_;               //!< The width which was used to compute the offsets
+            float length_;              //!< The length which was used to compute the offsets
+            Quaternion orientation_;    //!< The orientation of the master in the last update
+            unsigned int generation_;   //!< Is incremented with each update
+    };
+}
+
+#endif /* _FormationSlots_H__ */
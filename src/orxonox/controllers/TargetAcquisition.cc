@@ -0,0 +1,186 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TargetAcquisition.cc
+    @brief Implementation of the TargetAcquisition class.
+*/
+
+#include "TargetAcquisition.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "util/Metrics.h"
+#include "core/object/ObjectList.h"
+#include "Scene.h"
+#include "controllers/FormationController.h"
+#include "worldentities/pawns/Pawn.h"
+
+namespace orxonox
+{
+    /**
+        @brief Initializes a query without distance and cone restrictions at the position of the seeker.
+    */
+    TargetQuery::TargetQuery(ControllableEntity* seeker, Gametype* gametype)
+        : seeker(seeker)
+        , gametype(gametype)
+        , position(seeker ? seeker->getWorldPosition() : Vector3::ZERO)
+        , direction(Vector3::ZERO)
+        , maxAngle(math::pi)
+        , minDistance(0.0f)
+        , maxDistance(FLT_MAX)
+        , bRadarVisibleOnly(false)
+    {
+    }
+
+    TargetAcquisition::TargetAcquisition(Scene* scene)
+    {
+        this->scene_ = scene;
+        this->updateInterval_ = 0.0f;
+        this->timeSinceUpdate_ = 0.0f;
+        this->bStale_ = true;
+    }
+
+    TargetAcquisition::~TargetAcquisition()
+    {
+    }
+
+    /**
+        @brief Is called by the scene each tick. Marks the snapshot stale if the update interval is over.
+    */
+    void TargetAcquisition::tick(float dt)
+    {
+        this->timeSinceUpdate_ += dt;
+        if (this->timeSinceUpdate_ >= this->updateInterval_)
+        {
+            this->timeSinceUpdate_ = 0.0f;
+            this->bStale_ = true;
+        }
+    }
+
+    /**
+        @brief Collects the positions of all pawns in the scene and sorts them along the x-axis.
+    */
+    void TargetAcquisition::update()
+    {
+        std::vector<std::pair<float, Pawn*> > pawns;
+        for (ObjectList<Pawn>::iterator it = ObjectList<Pawn>::begin(); it != ObjectList<Pawn>::end(); ++it)
+            if (it->getScene().get() == this->scene_)
+                pawns.push_back(std::make_pair(it->getWorldPosition().x, *it));
+        std::sort(pawns.begin(), pawns.end());
+
+        this->candidates_.resize(pawns.size());
+        this->candidateX_.resize(pawns.size());
+        for (size_t i = 0; i < pawns.size(); ++i)
+        {
+            Candidate& candidate = this->candidates_[i];
+            candidate.pawn = pawns[i].second;
+            candidate.position = pawns[i].second->getWorldPosition();
+            candidate.bRadarVisible = pawns[i].second->getRadarVisibility();
+            this->candidateX_[i] = pawns[i].first;
+        }
+
+        this->bStale_ = false;
+
+        static MetricGauge& candidatesMetric = MetricsRegistry::getInstance().registerGauge("ai.target_candidates");
+        candidatesMetric.set(static_cast<double>(this->candidates_.size()));
+    }
+
+    /**
+        @brief Returns true if the candidate is a valid target for the query and writes its squared distance to @a squaredDistance.
+        The team relation is tested last because it's the most expensive test.
+    */
+    bool TargetAcquisition::test(const TargetQuery& query, const Candidate& candidate, float& squaredDistance) const
+    {
+        Pawn* pawn = candidate.pawn;
+        if (!pawn || pawn == query.seeker)
+            return false;
+        if (query.bRadarVisibleOnly && !candidate.bRadarVisible)
+            return false;
+
+        const Vector3 offset = candidate.position - query.position;
+        squaredDistance = offset.squaredLength();
+        if (squaredDistance > query.maxDistance * query.maxDistance || squaredDistance < query.minDistance * query.minDistance)
+            return false;
+
+        if (query.direction != Vector3::ZERO && squaredDistance > 0.0f)
+        {
+            const float cosine = query.direction.dotProduct(offset) / sqrt(squaredDistance);
+            if (cosine < cos(query.maxAngle))
+                return false;
+        }
+
+        return !FormationController::sameTeam(query.seeker, pawn, query.gametype);
+    }
+
+    /**
+        @brief Writes all hostile pawns which satisfy the query to @a targets (in no particular order).
+    */
+    void TargetAcquisition::findTargets(const TargetQuery& query, std::vector<Pawn*>& targets)
+    {
+        targets.clear();
+        if (!query.seeker)
+            return;
+        if (this->bStale_)
+            this->update();
+
+        const size_t begin = std::lower_bound(this->candidateX_.begin(), this->candidateX_.end(), query.position.x - query.maxDistance) - this->candidateX_.begin();
+        const float endX = query.position.x + query.maxDistance;
+        float squaredDistance;
+        for (size_t i = begin; i < this->candidates_.size() && this->candidateX_[i] <= endX; ++i)
+            if (this->test(query, this->candidates_[i], squaredDistance))
+                targets.push_back(this->candidates_[i].pawn);
+    }
+
+    /**
+        @brief Returns the nearest hostile pawn which satisfies the query (or NULL if there's none).
+    */
+    Pawn* TargetAcquisition::findNearestTarget(const TargetQuery& query)
+    {
+        if (!query.seeker)
+            return NULL;
+        if (this->bStale_)
+            this->update();
+
+        const size_t begin = std::lower_bound(this->candidateX_.begin(), this->candidateX_.end(), query.position.x - query.maxDistance) - this->candidateX_.begin();
+        const float endX = query.position.x + query.maxDistance;
+        Pawn* nearest = NULL;
+        float nearestDistance = FLT_MAX;
+        float squaredDistance;
+        for (size_t i = begin; i < this->candidates_.size() && this->candidateX_[i] <= endX; ++i)
+        {
+            if (this->test(query, this->candidates_[i], squaredDistance) && squaredDistance < nearestDistance)
+            {
+                nearest = this->candidates_[i].pawn;
+                nearestDistance = squaredDistance;
+            }
+        }
+        return nearest;
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file TargetAcquisition.h
+    @brief Declaration of the TargetAcquisition class and the TargetQuery struct.
+*/
+
+#ifndef _TargetAcquisition_H__
+#define _TargetAcquisition_H__
+
+#include "OrxonoxPrereqs.h"
+
+#include <vector>
+
+#include "util/Math.h"
+#include "core/object/WeakPtr.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Describes which targets a controller is looking for. The seeker defines
+        the team (see FormationController::sameTeam()) and is never returned.
+    */
+    struct _OrxonoxExport TargetQuery
+    {
+        TargetQuery(ControllableEntity* seeker, Gametype* gametype);
+
+        ControllableEntity* seeker; //!< The entity which is looking for a target
+        Gametype* gametype;         //!< The gametype which defines the teams
+        Vector3 position;           //!< The origin of the query (the world position of the seeker by default)
+        Vector3 direction;          //!< The axis of the cone (normalised), the cone is ignored if this is Vector3::ZERO
+        float maxAngle;             //!< The half opening angle of the cone in radians
+        float minDistance;          //!< Targets closer than this are ignored
+        float maxDistance;          //!< Targets farther away than this are ignored
+        bool bRadarVisibleOnly;     //!< If true, pawns which are invisible on the radar are ignored
+    };
+
+    /**
+    @brief
+        Finds hostile pawns for turrets and AI controllers. There's one instance
+        per Scene (see Scene::getTargetAcquisition()).
+
+        Instead of letting each controller iterate over all pawns, the positions
+        of the pawns in the scene are collected once per update interval and
+        sorted along the x-axis. A query then only visits the pawns whose x
+        coordinate is within the maximal distance, tests distance and cone and
+        finally checks the team relation of the remaining pawns with
+        FormationController::sameTeam() (which also respects the teams copied
+        from parents by TeamTargetProxy and the special relations of the
+        gametypes).
+
+        The snapshot is rebuilt lazily by the first query after it got stale,
+        hence scenes without turrets or bots don't pay anything. Within an update
+        interval the positions of the snapshot are used, the returned pawns are
+        always alive.
+    */
+    class _OrxonoxExport TargetAcquisition
+    {
+        public:
+            TargetAcquisition(Scene* scene);
+            ~TargetAcquisition();
+
+            void tick(float dt);
+
+            /// @brief Sets the time (in seconds) after which the positions are collected again. 0 means every tick (see the XML attribute targetUpdateInterval of Scene).
+            inline void setUpdateInterval(float interval)
+                { this->updateInterval_ = interval; }
+            /// @brief Returns the time (in seconds) after which the positions are collected again.
+            inline float getUpdateInterval() const
+                { return this->updateInterval_; }
+
+            void findTargets(const TargetQuery& query, std::vector<Pawn*>& targets);
+            Pawn* findNearestTarget(const TargetQuery& query);
+
+            /// @brief Forces the positions to be collected again by the next query (e.g. after a pawn was teleported).
+            inline void invalidate()
+                { this->bStale_ = true; }
+
+        private:
+            /// @brief A pawn in the snapshot.
+            struct Candidate
+            {
+                WeakPtr<Pawn> pawn;     //!< The pawn (NULL if it was destroyed since the snapshot was taken)
+                Vector3 position;       //!< The world position of the pawn when the snapshot was taken
+                bool bRadarVisible;     //!< The radar visibility of the pawn when the snapshot was taken
+            };
+
+            void update();
+            bool test(const TargetQuery& query, const Candidate& candidate, float& squaredDistance) const;
+
+            Scene* scene_;                          //!< The scene whose pawns are collected
+            std::vector<Candidate> candidates_;     //!< All pawns of the scene, sorted by the x coordinate of their position
+            std::vector<float> candidateX_;         //!< The x coordinates of the candidates (for binary search)
+            float updateInterval_;                  //!< The time after which the snapshot gets stale
+            float timeSinceUpdate_;                 //!< The time since the snapshot was marked stale the last time
+            bool bStale_;                           //!< True if the snapshot has to be rebuilt by the next query
+    };
+}
+
+#endif /* _TargetAcquisition_H__ */
@@ -58,6 +58,12 @@ namespace orxonox
         if (this->waypoints_.size() == 0 || !this->getControllableEntity())
             return;
 
+        if (!this->isScheduledUpdate(false))
+        {
+            this->keepSteering();
+            return;
+        }
+
         if (this->waypoints_[this->currentWaypoint_]->getWorldPosition().squaredDistance(this->getControllableEntity()->getPosition()) <= this->squaredaccuracy_)
             this->currentWaypoint_ = (this->currentWaypoint_ + 1) % this->waypoints_.size();
 
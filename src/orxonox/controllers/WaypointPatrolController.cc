@@ -32,6 +32,8 @@
 #include "core/CoreIncludes.h"
 #include "core/XMLPort.h"
 #include "worldentities/pawns/Pawn.h"
+#include "Scene.h"
+#include "controllers/TargetAcquisition.h"
 
 namespace orxonox
 {
@@ -83,23 +85,8 @@ namespace orxonox
         if (!this->getControllableEntity())
             return;
 
-        Vector3 myposition = this->getControllableEntity()->getPosition();
-        float shortestsqdistance = (float)static_cast<unsigned int>(-1);
-
-        for (ObjectList<Pawn>::iterator it = ObjectList<Pawn>::begin(); it != ObjectList<Pawn>::end(); ++it)
-        {
-            if (ArtificialController::sameTeam(this->getControllableEntity(), static_cast<ControllableEntity*>(*it), this->getGametype()))
-                continue;
-
-            float sqdistance = it->getPosition().squaredDistance(myposition);
-            if (sqdistance < shortestsqdistance)
-            {
-                shortestsqdistance = sqdistance;
-                this->target_ = (*it);
-            }
-        }
-
-        if (shortestsqdistance > (this->alertnessradius_ * this->alertnessradius_))
-            this->target_ = 0;
+        TargetQuery query(this->getControllableEntity(), this->getGametype());
+        query.maxDistance = this->alertnessradius_;
+        this->target_ = this->getControllableEntity()->getScene()->getTargetAcquisition()->findNearestTarget(query);
     }
 }
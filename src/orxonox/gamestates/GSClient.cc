@@ -28,11 +28,16 @@
 
 #include "GSClient.h"
 
+#include <OgreException.h>
+#include <OgreResourceBackgroundQueue.h>
+#include <OgreResourceGroupManager.h>
+
 #include "util/Exception.h"
 #include "core/config/CommandLineParser.h"
 #include "core/Game.h"
 #include "core/GameMode.h"
 #include "network/Client.h"
+#include "network/GamestateManager.h"
 
 namespace orxonox
 {
@@ -40,6 +45,28 @@ namespace orxonox
 
     SetCommandLineArgument(dest, "127.0.0.1").information("Server hostname/IP (IP in the form of #.#.#.#)");
 
+    /**
+        @brief Loads a mesh which the server announced for objects that we will get soon, so creating them doesn't stall.
+
+        The mesh is loaded by Ogre's background queue. If Ogre was built without thread support,
+        the queue loads it immediately on the main thread.
+    */
+    static void prefetchMesh(const std::string& name)
+    {
+        if (name.size() < 5 || name.compare(name.size() - 5, 5, ".mesh") != 0)
+            return;
+
+        try
+        {
+            Ogre::ResourceBackgroundQueue::getSingleton().load("Mesh", name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        }
+        catch (const Ogre::Exception&)
+        {
+            orxout(internal_warning) << "Could not prefetch mesh '" << name << "':" << endl;
+            orxout(internal_warning) << Exception::handleMessage() << endl;
+        }
+    }
+
     GSClient::GSClient(const GameStateInfo& info)
         : GameState(info)
     {
@@ -79,5 +106,10 @@ namespace orxonox
     void GSClient::update(const Clock& time)
     {
         Client::getInstance()->update(time);
+
+        // while joining, load one of the announced meshes per frame (see GamestateManager::sendPrefetchResources())
+        std::string resource;
+        if (GamestateManager::popPrefetchResource(resource) && GameMode::showsGraphics())
+            prefetchMesh(resource);
     }
 }
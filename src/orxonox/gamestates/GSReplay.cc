@@ -0,0 +1,152 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+#include "GSReplay.h"
+
+#include "util/Exception.h"
+#include "util/Output.h"
+#include "core/command/ConsoleCommand.h"
+#include "core/config/CommandLineParser.h"
+#include "core/Game.h"
+#include "core/GameMode.h"
+#include "core/object/ObjectList.h"
+#include "network/ReplayPlayer.h"
+#include "infos/PlayerInfo.h"
+#include "worldentities/ControllableEntity.h"
+
+namespace orxonox
+{
+    DeclareGameState(GSReplay, "replay", false, false);
+
+    SetCommandLineArgument(replay, "").information("Play a replay file which was recorded with --record");
+    SetCommandLineArgument(replaySpeed, 1.0f).information("Playback speed of the replay (default: 1)");
+    SetCommandLineArgument(replayPlayer, 0).information("Client ID of the player whose view is shown in the replay (default: 0, the player of the server)");
+
+    static const std::string __CC_replaySeek_name = "replaySeek";
+    static const std::string __CC_replaySpeed_name = "replaySpeed";
+
+    SetConsoleCommand(__CC_replaySeek_name, &GSReplay::seek).deactivate();
+    SetConsoleCommand(__CC_replaySpeed_name, &GSReplay::setSpeed).deactivate();
+
+    GSReplay::GSReplay(const GameStateInfo& info)
+        : GameState(info)
+        , player_(0)
+        , viewedClientID_(0)
+    {
+    }
+
+    GSReplay::~GSReplay()
+    {
+    }
+
+    void GSReplay::activate()
+    {
+        orxout(user_status) << "Starting replay" << endl;
+
+        GameMode::setIsClient(true);
+
+        this->player_ = new ReplayPlayer();
+        if (!this->player_->open(CommandLineParser::getValue("replay").get<std::string>()))
+        {
+            delete this->player_;
+            this->player_ = 0;
+            GameMode::setIsClient(false);
+            ThrowException(InitialisationFailed, "Could not open replay file.");
+        }
+        this->player_->setSpeed(CommandLineParser::getValue("replaySpeed").get<float>());
+        this->viewedClientID_ = CommandLineParser::getValue("replayPlayer").get<unsigned int>();
+        // no player of the replay is local, otherwise it would be controlled by our input instead of the recorded state
+        Host::setClientID(NETWORK_PEER_ID_UNKNOWN);
+
+        ModifyConsoleCommand(__CC_replaySeek_name).setObject(this).activate();
+        ModifyConsoleCommand(__CC_replaySpeed_name).setObject(this).activate();
+    }
+
+    void GSReplay::deactivate()
+    {
+        ModifyConsoleCommand(__CC_replaySeek_name).setObject(NULL).deactivate();
+        ModifyConsoleCommand(__CC_replaySpeed_name).setObject(NULL).deactivate();
+
+        if (this->viewedEntity_)
+            this->viewedEntity_->stopViewing();
+        this->viewedEntity_.reset();
+
+        delete this->player_;
+        this->player_ = 0;
+
+        Host::setClientID(0);
+        GameMode::setIsClient(false);
+    }
+
+    void GSReplay::update(const Clock& time)
+    {
+        this->player_->update(time);
+        this->updateView();
+    }
+
+    /**
+        @brief Shows the camera of the entity which the watched player currently controls (it changes e.g. when the player respawns).
+    */
+    void GSReplay::updateView()
+    {
+        ControllableEntity* entity = 0;
+        for (ObjectList<PlayerInfo>::iterator it = ObjectList<PlayerInfo>::begin(); it != ObjectList<PlayerInfo>::end(); ++it)
+        {
+            if (it->isHumanPlayer() && it->getClientID() == this->viewedClientID_)
+            {
+                entity = it->getControllableEntity();
+                break;
+            }
+        }
+
+        if (entity == this->viewedEntity_.get())
+            return;
+
+        if (this->viewedEntity_)
+            this->viewedEntity_->stopViewing();
+        this->viewedEntity_ = entity;
+        if (entity)
+            entity->startViewing();
+    }
+
+    /**
+        @brief Moves the replay to the given time in seconds.
+    */
+    void GSReplay::seek(float time)
+    {
+        this->player_->seek(time);
+    }
+
+    /**
+        @brief Sets the playback speed of the replay (1 is real time, 0 pauses it).
+    */
+    void GSReplay::setSpeed(float speed)
+    {
+        this->player_->setSpeed(speed);
+    }
+}
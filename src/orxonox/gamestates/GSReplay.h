@@ -0,0 +1,74 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+#ifndef _GSReplay_H__
+#define _GSReplay_H__
+
+#include "OrxonoxPrereqs.h"
+
+#include "core/GameState.h"
+#include "core/object/WeakPtr.h"
+#include "network/NetworkPrereqs.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Plays a replay file (recorded with --record on the server) like a client
+        which is connected to the recorded server, see ReplayPlayer. The view is
+        the one of the player with the given client ID (the player of the server
+        by default). The player is only watched: the replay doesn't control any
+        player, so the recorded movement is shown and the input is ignored.
+
+        Start with: --replay file [--replaySpeed factor] [--replayPlayer clientID]
+        (and --console to play it without graphics). The console commands
+        replaySeek and replaySpeed control the playback.
+    */
+    class _OrxonoxExport GSReplay : public GameState
+    {
+    public:
+        GSReplay(const GameStateInfo& info);
+        ~GSReplay();
+
+        void activate();
+        void deactivate();
+        void update(const Clock& time);
+
+        void seek(float time);
+        void setSpeed(float speed);
+
+    private:
+        void updateView();
+
+        ReplayPlayer* player_;
+        unsigned int viewedClientID_;               //!< The client ID of the player whose view is shown
+        WeakPtr<ControllableEntity> viewedEntity_;  //!< The entity of that player which currently shows its camera
+    };
+}
+
+#endif /* _GSReplay_H__ */
@@ -30,9 +30,12 @@
 
 #include "util/Clock.h"
 #include "core/BaseObject.h"
+#include "core/CoreIncludes.h"
 #include "core/Game.h"
 #include "core/GameMode.h"
 #include "core/command/ConsoleCommand.h"
+#include "core/config/ConfigValueIncludes.h"
+#include "network/FunctionCallManager.h"
 #include "network/NetworkFunction.h"
 #include "tools/Timer.h"
 #include "tools/interfaces/Tickable.h"
@@ -49,6 +52,8 @@ namespace orxonox
     static const std::string __CC_pause_name = "pause";
 
     /*static*/ bool GSRoot::startMainMenu_s = false;
+    /*static*/ bool GSRoot::bTickProfiling_s = false;
+    /*static*/ std::map<Identifier*, GSRoot::TickProfile> GSRoot::tickProfile_s;
 
     SetConsoleCommand("printObjects", &GSRoot::printObjects).hide();
     SetConsoleCommand(__CC_setTimeFactor_name, &GSRoot::setTimeFactor).accessLevel(AccessLevel::Master).defaultValues(1.0);
@@ -62,7 +67,11 @@ namespace orxonox
         : GameState(info)
         , bPaused_(false)
         , timeFactorPauseBackup_(1.0f)
+        , maxFunctionCallPacketSize_(FunctionCallManager::getMaxPacketSize())
     {
+        RegisterObject(GSRoot);
+
+        this->setConfigValues();
     }
 
     GSRoot::~GSRoot()
@@ -70,6 +79,18 @@ namespace orxonox
         NetworkFunctionBase::destroyAllNetworkFunctions();
     }
 
+    void GSRoot::setConfigValues()
+    {
+        SetConfigValue(maxFunctionCallPacketSize_, 1200)
+            .description("The size (in bytes) after which a packet of network function calls is sent. Should stay below the MTU, so the packets aren't fragmented.")
+            .callback(this, &GSRoot::changedMaxFunctionCallPacketSize);
+    }
+
+    void GSRoot::changedMaxFunctionCallPacketSize()
+    {
+        FunctionCallManager::setMaxPacketSize(this->maxFunctionCallPacketSize_);
+    }
+
     void GSRoot::printObjects()
     {
         unsigned int nr=0;
@@ -104,6 +125,18 @@ namespace orxonox
         ModifyConsoleCommand(__CC_pause_name).setObject(0);
     }
 
+    /**
+    @brief
+        Enables or disables measuring the tick time of each Timer and Tickable.
+        The times are accumulated per class, enabling the profiling clears them.
+    */
+    /*static*/ void GSRoot::setTickProfiling(bool bEnabled)
+    {
+        if (bEnabled && !bTickProfiling_s)
+            tickProfile_s.clear();
+        bTickProfiling_s = bEnabled;
+    }
+
     void GSRoot::update(const Clock& time)
     {
         if(startMainMenu_s)
@@ -116,7 +149,16 @@ namespace orxonox
         {
             Timer* object = *it;
             ++it;
-            object->tick(time);
+            if (bTickProfiling_s)
+            {
+                TickProfile& profile = tickProfile_s[object->getIdentifier()];
+                uint64_t timeBeforeTick = time.getRealMicroseconds();
+                object->tick(time);
+                profile.time += time.getRealMicroseconds() - timeBeforeTick;
+                ++profile.calls;
+            }
+            else
+                object->tick(time);
         }
 
         /*** HACK *** HACK ***/
@@ -132,7 +174,16 @@ namespace orxonox
         {
             Tickable* object = *it;
             ++it;
-            object->tick(realdt);
+            if (bTickProfiling_s)
+            {
+                TickProfile& profile = tickProfile_s[object->getIdentifier()];
+                uint64_t timeBeforeTick = time.getRealMicroseconds();
+                object->tick(realdt);
+                profile.time += time.getRealMicroseconds() - timeBeforeTick;
+                ++profile.calls;
+            }
+            else
+                object->tick(realdt);
         }
         /*** HACK *** HACK ***/
     }
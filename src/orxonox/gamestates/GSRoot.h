@@ -30,17 +30,31 @@
 #define _GSRoot_H__
 
 #include "OrxonoxPrereqs.h"
+
+#include <map>
 #include "core/GameState.h"
+#include "core/config/Configurable.h"
 #include "tools/interfaces/TimeFactorListener.h"
 
 namespace orxonox
 {
-    class _OrxonoxExport GSRoot : public GameState, public TimeFactorListener
+    class _OrxonoxExport GSRoot : public GameState, public TimeFactorListener, public Configurable
     {
     public:
+        /// The accumulated tick time of all objects of a class (see setTickProfiling()).
+        struct TickProfile
+        {
+            TickProfile() : time(0), calls(0) {}
+
+            uint64_t time;  ///< The accumulated tick time in microseconds
+            uint64_t calls; ///< The number of ticks
+        };
+
         GSRoot(const GameStateInfo& info);
         ~GSRoot();
 
+        void setConfigValues();
+
         static void printObjects();
 
         void activate();
@@ -57,13 +71,23 @@ namespace orxonox
 
         static void delayedStartMainMenu(void);
 
+        static void setTickProfiling(bool bEnabled);
+        /// Returns the tick times of all Timer and Tickable classes since the profiling was enabled.
+        static const std::map<Identifier*, TickProfile>& getTickProfile()
+            { return tickProfile_s; }
+
     protected:
         virtual void changedTimeFactor(float factor_new, float factor_old);
 
     private:
+        void changedMaxFunctionCallPacketSize();
+
         bool                  bPaused_;
         float                 timeFactorPauseBackup_;
+        unsigned int          maxFunctionCallPacketSize_; //!< The size (in bytes) after which a packet of network function calls is sent (see FunctionCallManager)
         static bool           startMainMenu_s;
+        static bool           bTickProfiling_s;     //!< If true, the tick time of each object is measured
+        static std::map<Identifier*, TickProfile> tickProfile_s; //!< The tick times per class
     };
 }
 
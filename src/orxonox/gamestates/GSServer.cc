@@ -40,6 +40,7 @@ namespace orxonox
     DeclareGameState(GSServer, "server", false, false);
 
     SetCommandLineArgument(port, NETWORK_PORT).shortcut("p").information("Network communication port to be used 0-65535 (default: 55556)");
+    SetCommandLineArgument(record, "").information("Record the game to a replay file (play it with --replay)");
 
     GSServer::GSServer(const GameStateInfo& info)
         : GameState(info)
@@ -61,6 +62,10 @@ namespace orxonox
         orxout(user_status) << "Loading scene in server mode" << endl;
 
         server_->open();
+
+        const std::string& replayFile = CommandLineParser::getValue("record").get<std::string>();
+        if (!replayFile.empty())
+            this->server_->startRecording(replayFile);
     }
 
     void GSServer::deactivate()
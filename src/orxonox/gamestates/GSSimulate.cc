@@ -0,0 +1,161 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+#include "GSSimulate.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "util/Clock.h"
+#include "util/Output.h"
+#include "core/class/Identifier.h"
+#include "core/config/CommandLineParser.h"
+#include "core/object/ObjectList.h"
+#include "core/Game.h"
+#include "core/GameMode.h"
+#include "gametypes/Gametype.h"
+#include "GSRoot.h"
+
+namespace orxonox
+{
+    DeclareGameState(GSSimulate, "simulate", false, false);
+
+    SetCommandLineArgument(simulationTicks, 3600).information("Number of ticks to simulate in simulation mode (default: 3600)");
+    SetCommandLineArgument(simulationFPS, 60).information("Number of ticks per simulated second in simulation mode (default: 60)");
+    SetCommandLineArgument(simulationBots, 0).information("Number of bots added to the gametype in simulation mode (in addition to the configured bots)");
+    SetCommandLineArgument(simulationSeed, 1).information("Seed of the random number generator in simulation mode (default: 1)");
+
+    /// Sorts the tick profiles by descending time.
+    static bool compareProfiles(const std::pair<Identifier*, GSRoot::TickProfile>& a, const std::pair<Identifier*, GSRoot::TickProfile>& b)
+    {
+        return a.second.time > b.second.time;
+    }
+
+    GSSimulate::GSSimulate(const GameStateInfo& info)
+        : GameState(info)
+        , ticks_(0)
+        , numTicks_(0)
+        , bAddedBots_(false)
+        , realClock_(0)
+        , startTime_(0)
+    {
+    }
+
+    GSSimulate::~GSSimulate()
+    {
+    }
+
+    void GSSimulate::activate()
+    {
+        // the simulation runs as standalone game, but without a local player
+        GameMode::setIsStandalone(true);
+
+        srand(static_cast<unsigned int>(CommandLineParser::getValue("simulationSeed").get<int>()));
+
+        const int fps = std::max(CommandLineParser::getValue("simulationFPS").get<int>(), 1);
+        Game::getInstance().setFixedTimeStep(1.0f / fps);
+
+        this->ticks_ = 0;
+        this->numTicks_ = static_cast<unsigned int>(std::max(CommandLineParser::getValue("simulationTicks").get<int>(), 0));
+        this->bAddedBots_ = false;
+        this->realClock_ = new Clock();
+
+        GSRoot::setTickProfiling(true);
+
+        orxout(user_status) << "Simulating " << this->numTicks_ << " ticks with " << fps << " ticks per second" << endl;
+    }
+
+    void GSSimulate::deactivate()
+    {
+        GSRoot::setTickProfiling(false);
+        Game::getInstance().setFixedTimeStep(0.0f);
+
+        delete this->realClock_;
+        this->realClock_ = 0;
+
+        GameMode::setIsStandalone(false);
+    }
+
+    void GSSimulate::update(const Clock& time)
+    {
+        // the level is loaded when this state is updated the first time: add the bots and start the game
+        if (!this->bAddedBots_)
+        {
+            const int numBots = std::max(CommandLineParser::getValue("simulationBots").get<int>(), 0);
+            for (ObjectList<Gametype>::iterator it = ObjectList<Gametype>::begin(); it != ObjectList<Gametype>::end(); ++it)
+            {
+                it->addBots(numBots);
+                if (!it->hasStarted())
+                    it->start();
+            }
+            this->bAddedBots_ = true;
+
+            // the loading time doesn't belong to the simulation
+            GSRoot::setTickProfiling(false);
+            GSRoot::setTickProfiling(true);
+            this->realClock_->capture();
+            this->startTime_ = this->realClock_->getMicroseconds();
+            return;
+        }
+
+        if (++this->ticks_ >= this->numTicks_)
+        {
+            this->printStatistics();
+            Game::getInstance().stop();
+        }
+    }
+
+    void GSSimulate::printStatistics()
+    {
+        this->realClock_->capture();
+        const double realTime = (this->realClock_->getMicroseconds() - this->startTime_) / 1000000.0;
+        const double simulatedTime = this->ticks_ * Game::getInstance().getFixedTimeStep();
+
+        orxout(user_status) << "Simulated " << this->ticks_ << " ticks (" << simulatedTime << " s) in " << realTime << " s: "
+                            << (realTime > 0 ? this->ticks_ / realTime : 0.0) << " ticks/s" << endl;
+
+        // print the classes with the highest tick time
+        std::vector<std::pair<Identifier*, GSRoot::TickProfile> > profiles(GSRoot::getTickProfile().begin(), GSRoot::getTickProfile().end());
+        std::sort(profiles.begin(), profiles.end(), compareProfiles);
+
+        uint64_t totalTime = 0;
+        for (size_t i = 0; i < profiles.size(); ++i)
+            totalTime += profiles[i].second.time;
+
+        orxout(user_status) << "Tick time per class (total " << totalTime / 1000 << " ms):" << endl;
+        for (size_t i = 0; i < profiles.size() && i < 20; ++i)
+        {
+            const GSRoot::TickProfile& profile = profiles[i].second;
+            orxout(user_status) << "  " << profiles[i].first->getName() << ": " << profile.time / 1000 << " ms ("
+                                << (totalTime > 0 ? 100.0 * profile.time / totalTime : 0.0) << "%), "
+                                << profile.calls / std::max(this->ticks_, 1u) << " objects, "
+                                << (profile.calls > 0 ? static_cast<double>(profile.time) / profile.calls : 0.0) << " us per tick" << endl;
+        }
+    }
+}
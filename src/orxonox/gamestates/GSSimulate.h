@@ -0,0 +1,68 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+#ifndef _GSSimulate_H__
+#define _GSSimulate_H__
+
+#include "OrxonoxPrereqs.h"
+#include "core/GameState.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Runs a level without graphics, input and network with a fixed time step
+        as fast as possible and prints the achieved ticks per second and the
+        tick time of each class at the end. Bots are added to all gametypes and
+        rand() is seeded, hence runs with the same arguments are reproducible.
+
+        Start with: --simulate [--level file.oxw] [--simulationTicks N]
+        [--simulationFPS N] [--simulationBots N] [--simulationSeed N]
+    */
+    class _OrxonoxExport GSSimulate : public GameState
+    {
+    public:
+        GSSimulate(const GameStateInfo& info);
+        ~GSSimulate();
+
+        void activate();
+        void deactivate();
+        void update(const Clock& time);
+
+    private:
+        void printStatistics();
+
+        unsigned int ticks_;            //!< The number of ticks simulated so far
+        unsigned int numTicks_;         //!< The number of ticks to simulate
+        bool bAddedBots_;               //!< True if the bots were added to the gametypes
+        Clock* realClock_;              //!< Measures the real duration of the simulation
+        unsigned long long startTime_;  //!< The time of realClock_ when the level was loaded (in microseconds)
+    };
+}
+
+#endif /* _GSSimulate_H__ */
@@ -65,7 +65,7 @@ namespace orxonox
 
     void GlobalShader::registerVariables()
     {
-        registerVariable(this->bVisible_,                                         VariableDirection::ToClient, new NetworkCallback<GlobalShader>(this, &GlobalShader::changedVisibility));
+        registerVariable(this->bVisible_,                                         VariableDirection::ToClient, &GlobalShader::changedVisibility);
         registerVariable(const_cast<std::string&>(this->shader_.getCompositorName()), VariableDirection::ToClient, new NetworkCallback<Shader>(&this->shader_, &Shader::changedCompositorName));
     }
 
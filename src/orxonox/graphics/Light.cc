@@ -105,11 +105,11 @@ namespace orxonox
 
     void Light::registerVariables()
     {
-        registerVariable((int&)this->type_,     VariableDirection::ToClient, new NetworkCallback<Light>(this, &Light::updateType));
-        registerVariable(this->diffuse_,        VariableDirection::ToClient, new NetworkCallback<Light>(this, &Light::updateDiffuseColour));
-        registerVariable(this->specular_,       VariableDirection::ToClient, new NetworkCallback<Light>(this, &Light::updateSpecularColour));
-        registerVariable(this->attenuation_,    VariableDirection::ToClient, new NetworkCallback<Light>(this, &Light::updateAttenuation));
-        registerVariable(this->spotlightRange_, VariableDirection::ToClient, new NetworkCallback<Light>(this, &Light::updateSpotlightRange));
+        registerVariable((int&)this->type_,     VariableDirection::ToClient, &Light::updateType);
+        registerVariable(this->diffuse_,        VariableDirection::ToClient, &Light::updateDiffuseColour);
+        registerVariable(this->specular_,       VariableDirection::ToClient, &Light::updateSpecularColour);
+        registerVariable(this->attenuation_,    VariableDirection::ToClient, &Light::updateAttenuation);
+        registerVariable(this->spotlightRange_, VariableDirection::ToClient, &Light::updateSpotlightRange);
     }
 
     void Light::updateDiffuseColour()
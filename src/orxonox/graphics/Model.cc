@@ -76,8 +76,18 @@ namespace orxonox
 
     void Model::registerVariables()
     {
-        registerVariable(this->meshSrc_,    VariableDirection::ToClient, new NetworkCallback<Model>(this, &Model::changedMesh));
-        registerVariable(this->bCastShadows_, VariableDirection::ToClient, new NetworkCallback<Model>(this, &Model::changedShadows));
+        registerVariable(this->meshSrc_,    VariableDirection::ToClient, &Model::changedMesh);
+        registerVariable(this->bCastShadows_, VariableDirection::ToClient, &Model::changedShadows);
+    }
+
+    /**
+    @brief
+        Lets a joining client load the mesh before it gets the Model.
+    */
+    void Model::getPrefetchResources(std::vector<std::string>& resources) const
+    {
+        if (!this->meshSrc_.empty())
+            resources.push_back(this->meshSrc_);
     }
 
     float Model::getBiggestScale(Vector3 scale3d)
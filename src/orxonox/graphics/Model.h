@@ -46,6 +46,7 @@ namespace orxonox
             void setConfigValues();
 
             virtual void XMLPort(Element& xmlelement, XMLPort::Mode mode);
+            virtual void getPrefetchResources(std::vector<std::string>& resources) const;
 
             virtual void changedVisibility();
 
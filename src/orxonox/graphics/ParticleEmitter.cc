@@ -76,8 +76,8 @@ namespace orxonox
 
     void ParticleEmitter::registerVariables()
     {
-        registerVariable(this->source_, VariableDirection::ToClient, new NetworkCallback<ParticleEmitter>(this, &ParticleEmitter::sourceChanged));
-        registerVariable((int&)(this->LOD_),    VariableDirection::ToClient, new NetworkCallback<ParticleEmitter>(this, &ParticleEmitter::LODchanged));
+        registerVariable(this->source_, VariableDirection::ToClient, &ParticleEmitter::sourceChanged);
+        registerVariable((int&)(this->LOD_),    VariableDirection::ToClient, &ParticleEmitter::LODchanged);
     }
 
     void ParticleEmitter::changedVisibility()
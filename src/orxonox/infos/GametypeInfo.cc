@@ -49,9 +49,10 @@ namespace orxonox
 {
     RegisterUnloadableClass(GametypeInfo);
 
-    registerMemberNetworkFunction(GametypeInfo, dispatchAnnounceMessage);
-    registerMemberNetworkFunction(GametypeInfo, dispatchKillMessage);
-    registerMemberNetworkFunction(GametypeInfo, dispatchDeathMessage);
+    // these messages don't depend on other calls, hence they don't have to wait for lost reliable packets
+    registerMemberNetworkFunctionWithQoS(GametypeInfo, dispatchAnnounceMessage, CallQoS::ReliableUnordered);
+    registerMemberNetworkFunctionWithQoS(GametypeInfo, dispatchKillMessage, CallQoS::ReliableUnordered);
+    registerMemberNetworkFunctionWithQoS(GametypeInfo, dispatchDeathMessage, CallQoS::ReliableUnordered);
     registerMemberNetworkFunction(GametypeInfo, dispatchStaticMessage);
     registerMemberNetworkFunction(GametypeInfo, dispatchFadingMessage);
 
@@ -85,11 +86,11 @@ namespace orxonox
 
     void GametypeInfo::registerVariables()
     {
-        registerVariable(this->bStarted_,               VariableDirection::ToClient, new NetworkCallback<GametypeInfo>(this, &GametypeInfo::changedStarted));
-        registerVariable(this->bEnded_,                 VariableDirection::ToClient, new NetworkCallback<GametypeInfo>(this, &GametypeInfo::changedEnded));
-        registerVariable(this->bStartCountdownRunning_, VariableDirection::ToClient, new NetworkCallback<GametypeInfo>(this, &GametypeInfo::changedStartCountdownRunning));
+        registerVariable(this->bStarted_,               VariableDirection::ToClient, &GametypeInfo::changedStarted);
+        registerVariable(this->bEnded_,                 VariableDirection::ToClient, &GametypeInfo::changedEnded);
+        registerVariable(this->bStartCountdownRunning_, VariableDirection::ToClient, &GametypeInfo::changedStartCountdownRunning);
         registerVariable(this->startCountdown_,         VariableDirection::ToClient);
-        registerVariable(this->counter_,                VariableDirection::ToClient, new NetworkCallback<GametypeInfo>(this, &GametypeInfo::changedCountdownCounter));
+        registerVariable(this->counter_,                VariableDirection::ToClient, &GametypeInfo::changedCountdownCounter);
         registerVariable(this->hudtemplate_,            VariableDirection::ToClient);
     }
 
@@ -79,11 +79,11 @@ namespace orxonox
 
     void HumanPlayer::registerVariables()
     {
-        registerVariable(this->synchronize_nick_, VariableDirection::ToServer, new NetworkCallback<HumanPlayer>(this, &HumanPlayer::networkcallback_changednick));
+        registerVariable(this->synchronize_nick_, VariableDirection::ToServer, &HumanPlayer::networkcallback_changednick);
 
-        registerVariable(this->clientID_,           VariableDirection::ToClient, new NetworkCallback<HumanPlayer>(this, &HumanPlayer::networkcallback_clientIDchanged));
-        registerVariable(this->server_initialized_, VariableDirection::ToClient, new NetworkCallback<HumanPlayer>(this, &HumanPlayer::networkcallback_server_initialized));
-        registerVariable(this->client_initialized_, VariableDirection::ToServer, new NetworkCallback<HumanPlayer>(this, &HumanPlayer::networkcallback_client_initialized));
+        registerVariable(this->clientID_,           VariableDirection::ToClient, &HumanPlayer::networkcallback_clientIDchanged);
+        registerVariable(this->server_initialized_, VariableDirection::ToClient, &HumanPlayer::networkcallback_server_initialized);
+        registerVariable(this->client_initialized_, VariableDirection::ToServer, &HumanPlayer::networkcallback_client_initialized);
     }
 
     void HumanPlayer::configvaluecallback_changednick()
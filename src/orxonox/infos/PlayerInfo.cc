@@ -81,9 +81,17 @@ namespace orxonox
 
     void PlayerInfo::registerVariables()
     {
-        registerVariable(this->name_,                 VariableDirection::ToClient, new NetworkCallback<PlayerInfo>(this, &PlayerInfo::changedName));
-        registerVariable(this->controllableEntityID_, VariableDirection::ToClient, new NetworkCallback<PlayerInfo>(this, &PlayerInfo::networkcallback_changedcontrollableentityID));
-        registerVariable(this->gtinfoID_,             VariableDirection::ToClient, new NetworkCallback<PlayerInfo>(this, &PlayerInfo::networkcallback_changedgtinfoID));
+        registerVariable(this->name_,                 VariableDirection::ToClient, &PlayerInfo::changedName);
+        registerVariable(this->controllableEntityID_, VariableDirection::ToClient, &PlayerInfo::networkcallback_changedcontrollableentityID);
+        registerVariable(this->gtinfoID_,             VariableDirection::ToClient, &PlayerInfo::networkcallback_changedgtinfoID);
+    }
+
+    void PlayerInfo::getReferencedObjects(std::vector<uint32_t>& objectIDs) const
+    {
+        if (this->controllableEntityID_ != OBJECTID_UNKNOWN)
+            objectIDs.push_back(this->controllableEntityID_);
+        if (this->gtinfoID_ != OBJECTID_UNKNOWN)
+            objectIDs.push_back(this->gtinfoID_);
     }
 
     void PlayerInfo::changedName()
@@ -44,6 +44,7 @@ namespace orxonox // tolua_export
             virtual ~PlayerInfo();
 
             virtual void changedName();
+            virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const;
             virtual void changedGametype();
 
             virtual void changedController() {}
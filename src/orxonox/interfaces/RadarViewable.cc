@@ -46,6 +46,7 @@ namespace orxonox
         : isHumanShip_(false)
         , bVisibility_(true)
         , bInitialized_(false)
+        , radarIndex_(0)
         , wePtr_(wePtr)
         , radarObjectCamouflage_(0.0f)
         , radarObjectShape_(Dot)
@@ -47,6 +47,7 @@ namespace orxonox
     */
     class _OrxonoxExport RadarViewable : virtual public OrxonoxInterface
     {
+        friend class Radar;
     public:
         enum Shape
         {
@@ -156,6 +157,7 @@ namespace orxonox
         void validate(const WorldEntity* object) const;
         bool bVisibility_;
         bool bInitialized_;
+        size_t radarIndex_;     //!< The index of this object in the arrays of the Radar
         //Map
         std::string uniqueId_;
 
@@ -114,7 +114,7 @@ namespace orxonox
 
     void Engine::registerVariables()
     {
-        registerVariable(this->shipID_, VariableDirection::ToClient, new NetworkCallback<Engine>(this, &Engine::networkcallback_shipID));
+        registerVariable(this->shipID_, VariableDirection::ToClient, &Engine::networkcallback_shipID);
 
         registerVariable(this->boostFactor_, VariableDirection::ToClient);
 
@@ -133,6 +133,16 @@ namespace orxonox
         registerVariable(this->speedMultiply_, VariableDirection::ToClient);
     }
 
+    /**
+    @brief
+        A joining client needs the ship to mount the Engine (see networkcallback_shipID()).
+    */
+    void Engine::getReferencedObjects(std::vector<uint32_t>& objectIDs) const
+    {
+        if (this->shipID_ != OBJECTID_UNKNOWN)
+            objectIDs.push_back(this->shipID_);
+    }
+
     void Engine::networkcallback_shipID()
     {
         this->ship_ = 0;
@@ -60,6 +60,7 @@ namespace orxonox
 
             virtual void XMLPort(Element& xmlelement, XMLPort::Mode mode);
             void setConfigValues();
+            virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const;
 
             virtual void run(float dt); // Run the engine for a given time interval.
 
@@ -53,11 +53,11 @@ namespace orxonox
 
     void WorldSound::registerVariables()
     {
-        registerVariable(volume_,   ObjectDirection::ToClient, new NetworkCallback<WorldSound>(this, &WorldSound::volumeChanged));
-        registerVariable(source_,   ObjectDirection::ToClient, new NetworkCallback<WorldSound>(this, &WorldSound::sourceChanged));
-        registerVariable(bLooping_, ObjectDirection::ToClient, new NetworkCallback<WorldSound>(this, &WorldSound::loopingChanged));
-        registerVariable(pitch_,    ObjectDirection::ToClient, new NetworkCallback<WorldSound>(this, &WorldSound::pitchChanged));
-        registerVariable((uint8_t&)(BaseSound::state_), ObjectDirection::ToClient, new NetworkCallback<WorldSound>(this, &WorldSound::stateChanged));
+        registerVariable(volume_,   ObjectDirection::ToClient, &WorldSound::volumeChanged);
+        registerVariable(source_,   ObjectDirection::ToClient, &WorldSound::sourceChanged);
+        registerVariable(bLooping_, ObjectDirection::ToClient, &WorldSound::loopingChanged);
+        registerVariable(pitch_,    ObjectDirection::ToClient, &WorldSound::pitchChanged);
+        registerVariable((uint8_t&)(BaseSound::state_), ObjectDirection::ToClient, &WorldSound::stateChanged);
     }
 
     void WorldSound::XMLPort(Element& xmlelement, XMLPort::Mode mode)
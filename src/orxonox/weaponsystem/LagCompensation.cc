@@ -0,0 +1,244 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file LagCompensation.cc
+    @brief Implementation of the LagCompensation class.
+*/
+
+#include "LagCompensation.h"
+
+#include <algorithm>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+
+#include "util/Clock.h"
+#include "util/Metrics.h"
+#include "core/Game.h"
+#include "core/GameMode.h"
+#include "core/object/ObjectList.h"
+#include "tools/BulletConversions.h"
+#include "Scene.h"
+#include "worldentities/pawns/Pawn.h"
+
+namespace orxonox
+{
+    namespace
+    {
+        /// @brief Like btCollisionWorld::ClosestRayResultCallback, but also remembers the hit (child) shape.
+        struct ShapeRayResultCallback : public btCollisionWorld::ClosestRayResultCallback
+        {
+            ShapeRayResultCallback(const btVector3& from, const btVector3& to)
+                : btCollisionWorld::ClosestRayResultCallback(from, to), m_shape(0) {}
+
+            virtual btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
+            {
+                // the collision object holds the child shape of a compound shape while it's tested
+                this->m_shape = rayResult.m_collisionObject->getCollisionShape();
+                return btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+            }
+
+            const btCollisionShape* m_shape;
+        };
+    }
+
+    LagCompensation::LagCompensation(Scene* scene)
+    {
+        this->scene_ = scene;
+        this->maxRewindTime_ = 0.5f;
+        this->remoteViewTime_ = 0;
+        this->lastRemoteViewTime_ = 0;
+    }
+
+    LagCompensation::~LagCompensation()
+    {
+    }
+
+    /**
+        @brief Returns the current time of the server. Uses the same clock as the timestamps of ControllableEntity.
+    */
+    double LagCompensation::getTime() const
+    {
+        return Game::getInstance().getGameClock().getMicroseconds() / 1000000.0;
+    }
+
+    /**
+        @brief Is called by the scene each tick. Records the positions of all pawns on a server.
+    */
+    void LagCompensation::tick(float dt)
+    {
+        // the remote entities set the view time again in each tick
+        this->lastRemoteViewTime_ = this->remoteViewTime_;
+        this->remoteViewTime_ = 0;
+
+        if (!GameMode::isServer())
+        {
+            this->frames_.clear();
+            return;
+        }
+
+        // keep one frame older than the maximal rewind time to interpolate
+        const double now = this->getTime();
+        while (this->frames_.size() > 1 && this->frames_[1].time < now - this->maxRewindTime_)
+            this->frames_.pop_front();
+        if (!this->frames_.empty() && this->frames_.back().time >= now)
+            return;
+
+        this->frames_.push_back(Frame());
+        Frame& frame = this->frames_.back();
+        frame.time = now;
+
+        for (ObjectList<Pawn>::iterator it = ObjectList<Pawn>::begin(); it != ObjectList<Pawn>::end(); ++it)
+        {
+            if (it->getScene().get() != this->scene_ || !it->physicalBody_ || !it->physicalBody_->getCollisionShape() || !it->isAlive())
+                continue;
+
+            btVector3 center;
+            btScalar radius;
+            it->physicalBody_->getCollisionShape()->getBoundingSphere(center, radius);
+
+            Record record;
+            record.objectID = it->getObjectID();
+            record.position = it->getWorldPosition();
+            record.orientation = it->getWorldOrientation();
+            record.radius = radius + center.length();
+            frame.records.push_back(record);
+        }
+        std::sort(frame.records.begin(), frame.records.end(), &LagCompensation::compareRecords);
+
+        static MetricGauge& framesMetric = MetricsRegistry::getInstance().registerGauge("weapons.lag_compensation_frames");
+        framesMetric.set(static_cast<double>(this->frames_.size()));
+    }
+
+    /**
+    @brief
+        Returns the time at which the pawns have to be rewound for a shot of the given entity.
+        This is the time the controlling client sees (clamped to the maximal rewind time), or
+        the current time if the entity isn't controlled by a remote client.
+    */
+    double LagCompensation::getShooterTime(ControllableEntity* shooter) const
+    {
+        const double now = this->getTime();
+        if (!shooter || shooter->getClientViewTime() <= 0)
+            return now;
+        return clamp(shooter->getClientViewTime(), now - this->maxRewindTime_, now);
+    }
+
+    /**
+    @brief
+        Tests a ray against the collision shapes of the pawns at the given time.
+    @param from The start of the ray
+    @param to The end of the ray
+    @param time The time at which the pawns are tested (see getShooterTime())
+    @param ignore This pawn is never hit (usually the shooter)
+    @param hit Returns the first hit
+    @return Returns true if a pawn was hit
+    */
+    bool LagCompensation::rayTest(const Vector3& from, const Vector3& to, double time, Pawn* ignore, Hit& hit) const
+    {
+        if (this->frames_.empty())
+            return false;
+
+        const Vector3 direction = to - from;
+        const float squaredLength = direction.squaredLength();
+        if (squaredLength <= 0)
+            return false;
+
+        // the frames before and after the time
+        size_t index = this->frames_.size() - 1;
+        while (index > 0 && this->frames_[index - 1].time >= time)
+            --index;
+        const Frame& after = this->frames_[index];
+        const Frame& before = this->frames_[index > 0 ? index - 1 : 0];
+        const float factor = (after.time > before.time ? static_cast<float>(clamp((time - before.time) / (after.time - before.time), 0.0, 1.0)) : 1.0f);
+
+        const btVector3 btFrom = multi_cast<btVector3>(from);
+        const btVector3 btTo = multi_cast<btVector3>(to);
+        const btTransform rayFrom(btQuaternion::getIdentity(), btFrom);
+        const btTransform rayTo(btQuaternion::getIdentity(), btTo);
+
+        bool bHit = false;
+        hit.fraction = 1.0f;
+        for (size_t i = 0; i < after.records.size(); ++i)
+        {
+            const Record& record = after.records[i];
+            Vector3 position = record.position;
+            Quaternion orientation = record.orientation;
+            const Record* previous = findRecord(before, record.objectID);
+            if (previous && previous != &record)
+            {
+                position = previous->position + (record.position - previous->position) * factor;
+                orientation = Quaternion::Slerp(factor, previous->orientation, record.orientation, true);
+            }
+
+            // fast test against the bounding sphere
+            const float t = clamp((position - from).dotProduct(direction) / squaredLength, 0.0f, 1.0f);
+            if ((from + direction * t).squaredDistance(position) > record.radius * record.radius)
+                continue;
+
+            Pawn* pawn = orxonox_cast<Pawn*>(Synchronisable::getSynchronisable(record.objectID));
+            if (!pawn || pawn == ignore || !pawn->physicalBody_ || !pawn->physicalBody_->getCollisionShape())
+                continue;
+
+            ShapeRayResultCallback callback(btFrom, btTo);
+            callback.m_closestHitFraction = hit.fraction;
+            const btTransform rewound(multi_cast<btQuaternion>(orientation), multi_cast<btVector3>(position));
+            btCollisionWorld::rayTestSingle(rayFrom, rayTo, pawn->physicalBody_, pawn->physicalBody_->getCollisionShape(), rewound, callback);
+            if (!callback.hasHit() || callback.m_closestHitFraction >= hit.fraction)
+                continue;
+
+            // move the hit point along with the pawn to the current position
+            const Quaternion rotation = pawn->getWorldOrientation() * orientation.Inverse();
+            hit.pawn = pawn;
+            hit.shape = callback.m_shape;
+            hit.position = pawn->getWorldPosition() + rotation * (multi_cast<Vector3>(callback.m_hitPointWorld) - position);
+            hit.normal = rotation * multi_cast<Vector3>(callback.m_hitNormalWorld);
+            hit.fraction = callback.m_closestHitFraction;
+            bHit = true;
+        }
+
+        return bHit;
+    }
+
+    /*static*/ bool LagCompensation::compareRecords(const Record& a, const Record& b)
+    {
+        return a.objectID < b.objectID;
+    }
+
+    /**
+        @brief Returns the record of the pawn with the given object ID in the frame or NULL if the pawn wasn't recorded.
+    */
+    /*static*/ const LagCompensation::Record* LagCompensation::findRecord(const Frame& frame, unsigned int objectID)
+    {
+        Record key;
+        key.objectID = objectID;
+        std::vector<Record>::const_iterator it = std::lower_bound(frame.records.begin(), frame.records.end(), key, &LagCompensation::compareRecords);
+        return (it != frame.records.end() && it->objectID == objectID ? &(*it) : 0);
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ *   ORXONOX - the hottest 3D action shooter ever to exist
+ *                    > www.orxonox.net <
+ *
+ *
+ *   License notice:
+ *
+ *   This program is free software; you can redistribute it and/or
+ *   modify it under the terms of the GNU General Public License
+ *   as published by the Free Software Foundation; either version 2
+ *   of the License, or (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ *   Author:
+ *      Fabian 'x3n' Landau
+ *   Co-authors:
+ *      ...
+ *
+ */
+
+/**
+    @file LagCompensation.h
+    @brief Declaration of the LagCompensation class.
+*/
+
+#ifndef _LagCompensation_H__
+#define _LagCompensation_H__
+
+#include "OrxonoxPrereqs.h"
+
+#include <deque>
+#include <vector>
+
+#include "util/Math.h"
+
+namespace orxonox
+{
+    /**
+    @brief
+        Keeps the positions of all pawns of the last few hundred milliseconds on the
+        server, so hits can be tested against the world as a client saw it when it
+        fired. There's one instance per Scene (see Scene::getLagCompensation()).
+
+        Clients show remote entities in the past (see ControllableEntity::interpolateRemoteState())
+        and report the time they show to the server (ControllableEntity::getClientViewTime()).
+        A weapon of such a client rewinds the pawns to this time and tests its ray
+        against their collision shapes at the rewound position (see rayTest()).
+
+        The positions are only recorded on a server, in standalone mode there's no latency.
+    */
+    class _OrxonoxExport LagCompensation
+    {
+        public:
+            /// @brief The result of rayTest().
+            struct Hit
+            {
+                Pawn* pawn;                     //!< The pawn which was hit
+                const btCollisionShape* shape;  //!< The collision shape of the pawn which was hit
+                Vector3 position;               //!< The hit point, moved along with the pawn to its current position
+                Vector3 normal;                 //!< The normal of the surface at the hit point (at the current orientation of the pawn)
+                float fraction;                 //!< The position of the hit point on the ray (0 = start, 1 = end)
+            };
+
+            LagCompensation(Scene* scene);
+            ~LagCompensation();
+
+            void tick(float dt);
+
+            /// @brief Sets the maximal time (in seconds) the pawns are rewound. Clients with a higher latency have to lead their targets.
+            inline void setMaxRewindTime(float time)
+                { this->maxRewindTime_ = time; }
+            /// @brief Returns the maximal time (in seconds) the pawns are rewound.
+            inline float getMaxRewindTime() const
+                { return this->maxRewindTime_; }
+
+            double getTime() const;
+            double getShooterTime(ControllableEntity* shooter) const;
+
+            /// @brief Sets the server time at which a remote entity is shown on this client (see ControllableEntity::interpolateRemoteState()).
+            inline void setRemoteViewTime(double time)
+                { this->remoteViewTime_ = time; }
+            /// @brief Returns the server time at which remote entities are shown on this client in the current (or last) tick, 0 if no remote entity was shown.
+            inline double getRemoteViewTime() const
+                { return (this->remoteViewTime_ > 0 ? this->remoteViewTime_ : this->lastRemoteViewTime_); }
+
+            bool rayTest(const Vector3& from, const Vector3& to, double time, Pawn* ignore, Hit& hit) const;
+
+        private:
+            /// @brief The position of a pawn in a frame.
+            struct Record
+            {
+                unsigned int objectID;  //!< The object ID of the pawn (the pawn may be destroyed in the meantime)
+                Vector3 position;       //!< The world position
+                Quaternion orientation; //!< The world orientation
+                float radius;           //!< The radius of a sphere around the position which encloses the collision shape
+            };
+
+            /// @brief The positions of all pawns at a given time.
+            struct Frame
+            {
+                double time;                    //!< The time of the frame (see getTime())
+                std::vector<Record> records;    //!< The positions of the pawns, sorted by object ID
+            };
+
+            static bool compareRecords(const Record& a, const Record& b);
+            static const Record* findRecord(const Frame& frame, unsigned int objectID);
+
+            Scene* scene_;                  //!< The scene whose pawns are recorded
+            std::deque<Frame> frames_;      //!< The recorded frames, ordered by time
+            float maxRewindTime_;           //!< The maximal time the pawns are rewound
+            double remoteViewTime_;         //!< The server time at which remote entities were shown in the current tick (client only)
+            double lastRemoteViewTime_;     //!< The server time at which remote entities were shown in the last tick (client only)
+    };
+}
+
+#endif /* _LagCompensation_H__ */
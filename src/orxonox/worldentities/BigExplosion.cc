@@ -269,8 +269,8 @@ namespace orxonox
 
     void BigExplosion::registerVariables()
     {
-        registerVariable((int&)(this->LOD_), VariableDirection::ToClient, new NetworkCallback<BigExplosion>(this, &BigExplosion::LODchanged));
-        registerVariable(this->bStop_,       VariableDirection::ToClient, new NetworkCallback<BigExplosion>(this, &BigExplosion::checkStop));
+        registerVariable((int&)(this->LOD_), VariableDirection::ToClient, &BigExplosion::LODchanged);
+        registerVariable(this->bStop_,       VariableDirection::ToClient, &BigExplosion::checkStop);
     }
 
     void BigExplosion::LODchanged()
@@ -31,8 +31,10 @@
 #include <OgreSceneManager.h>
 #include <OgreSceneNode.h>
 
+#include "util/Clock.h"
 #include "core/CoreIncludes.h"
 #include "core/config/ConfigValueIncludes.h"
+#include "core/Game.h"
 #include "core/GameMode.h"
 #include "core/XMLPort.h"
 #include "network/NetworkFunction.h"
@@ -43,13 +45,23 @@
 #include "graphics/Camera.h"
 #include "worldentities/CameraPosition.h"
 #include "overlays/OverlayGroup.h"
+#include "weaponsystem/LagCompensation.h"
 
 namespace orxonox
 {
     RegisterClass(ControllableEntity);
 
     registerMemberNetworkFunction( ControllableEntity, fire );
-    registerMemberNetworkFunction( ControllableEntity, setTargetInternal );
+    registerMemberNetworkFunctionWithQoS( ControllableEntity, setTargetInternal, CallQoS::UnreliableSequenced );
+
+    static const float TARGET_RESEND_INTERVAL = 0.5f; ///< The interval in seconds in which a client repeats the target (in case a call got lost)
+
+    /// @brief Returns the time which is used to timestamp the server state.
+    static inline double getNetworkTime()
+    {
+        // a float in seconds would lose the precision needed for interpolation after a few hours
+        return Game::getInstance().getGameClock().getMicroseconds() / 1000000.0;
+    }
 
     ControllableEntity::ControllableEntity(Context* context) : MobileEntity(context)
     {
@@ -57,6 +69,7 @@ namespace orxonox
 
         this->bHasLocalController_ = false;
         this->bHasHumanController_ = false;
+        this->bViewed_ = false;
 
         this->server_overwrite_ = 0;
         this->client_overwrite_ = 0;
@@ -83,6 +96,18 @@ namespace orxonox
         this->server_angular_velocity_ = Vector3::ZERO;
         this->client_angular_velocity_ = Vector3::ZERO;
 
+        this->client_sequence_ = 0;
+        this->server_acked_sequence_ = 0;
+        this->positionCorrection_ = Vector3::ZERO;
+        this->orientationCorrection_ = Quaternion::IDENTITY;
+        this->server_timestamp_ = 0;
+        this->stampedPosition_ = Vector3::ZERO;
+        this->stampedOrientation_ = Quaternion::IDENTITY;
+        this->stampedLinearVelocity_ = Vector3::ZERO;
+        this->stampedAngularVelocity_ = Vector3::ZERO;
+        this->client_view_time_ = 0;
+        this->timeSinceTargetSent_ = 0;
+
         this->setConfigValues();
         this->setPriority( Priority::VeryHigh );
         this->registerVariables();
@@ -130,6 +155,10 @@ namespace orxonox
     void ControllableEntity::setConfigValues()
     {
         SetConfigValue(mouseLookSpeed_, 3.0f);
+        SetConfigValue(predictionSmoothingTime_, 0.1f).description("The time in seconds over which the client spreads corrections of its predicted position");
+        SetConfigValue(interpolationDelay_, 0.1f).description("Remote entities are shown this many seconds in the past to interpolate between the received states (0 = off)");
+        SetConfigValue(maxExtrapolationTime_, 0.25f).description("The maximal time in seconds a remote entity is extrapolated if no new state arrives");
+        SetConfigValue(maxSmoothedCorrection_, 50.0f).description("Corrections of the predicted position which are larger than this are applied immediately");
     }
 
     void ControllableEntity::preDestroy()
@@ -137,6 +166,8 @@ namespace orxonox
         // HACK - solve this clean and without preDestroy hook for multiplayer where removePlayer() isn't called
         if (this->isInitialized() && this->bHasLocalController_ && this->bHasHumanController_)
             this->stopLocalHumanControl();
+        if (this->bViewed_)
+            this->stopViewing();
     }
 
     void ControllableEntity::addCameraPosition(CameraPosition* position)
@@ -319,16 +350,25 @@ namespace orxonox
     {
         this->target_ = target;
         if ( !GameMode::isMaster() )
+            this->sendTarget();
+    }
+
+    /**
+    @brief
+        Sends the target to the server. Only the latest target matters, so the calls are unreliable
+        (and merged within a tick). A lost call is corrected by the regular repetition in tick().
+    */
+    void ControllableEntity::sendTarget()
+    {
+        if ( this->target_ )
         {
-            if ( target != 0 )
-            {
-                callMemberNetworkFunction(ControllableEntity, setTargetInternal, this->getObjectID(), 0, target->getObjectID() );
-            }
-           else
-           {
-                callMemberNetworkFunction(ControllableEntity, setTargetInternal, this->getObjectID(), 0, OBJECTID_UNKNOWN );
-           }
+            callMemberNetworkFunction(ControllableEntity, setTargetInternal, this->getObjectID(), 0, this->target_->getObjectID() );
         }
+        else
+        {
+            callMemberNetworkFunction(ControllableEntity, setTargetInternal, this->getObjectID(), 0, OBJECTID_UNKNOWN );
+        }
+        this->timeSinceTargetSent_ = 0;
     }
 
     void ControllableEntity::setTargetInternal( uint32_t targetID )
@@ -349,11 +389,13 @@ namespace orxonox
         this->playerID_ = player->getObjectID();
         this->bHasLocalController_ = player->isLocalPlayer();
         this->bHasHumanController_ = player->isHumanPlayer();
+        this->snapshots_.clear();
         if(controller_ != NULL)
             this->team_ = controller_->getTeam(); // forward controller team number
 
         if (this->bHasLocalController_ && this->bHasHumanController_)
         {
+            this->bViewed_ = false; // the local player takes over the camera
             this->startLocalHumanControl();
 
             if (!GameMode::isMaster())
@@ -375,6 +417,7 @@ namespace orxonox
         this->playerID_ = OBJECTID_UNKNOWN;
         this->bHasLocalController_ = false;
         this->bHasHumanController_ = false;
+        this->client_view_time_ = 0;
         this->setSyncMode(ObjectDirection::ToClient);
 
         this->changedPlayer();
@@ -394,6 +437,32 @@ namespace orxonox
         }
     }
 
+    /**
+        @brief Shows the camera and the HUD of this entity without controlling it, e.g. to watch a player in a replay.
+        The entity keeps following the synchronised state of the server.
+    */
+    void ControllableEntity::startViewing()
+    {
+        if (this->bViewed_ || (this->bHasLocalController_ && this->bHasHumanController_))
+            return;
+
+        this->bViewed_ = true;
+        // call the implementation of ControllableEntity only, the derived classes change the input behaviour (e.g. Spectator)
+        this->ControllableEntity::startLocalHumanControl();
+    }
+
+    /**
+        @brief Removes the camera and the HUD which were created by startViewing().
+    */
+    void ControllableEntity::stopViewing()
+    {
+        if (!this->bViewed_)
+            return;
+
+        this->bViewed_ = false;
+        this->ControllableEntity::stopLocalHumanControl();
+    }
+
     void ControllableEntity::startLocalHumanControl()
     {
         if (!this->camera_ && GameMode::showsGraphics())
@@ -506,34 +575,130 @@ namespace orxonox
                     this->client_angular_velocity_ = this->getAngularVelocity();
                 }
             }
+
+            if (GameMode::isMaster())
+            {
+                // the timestamp changes with the state (including the tick in which the entity comes to rest), idle entities keep it and don't have to be sent again
+                if (this->getPosition() != this->stampedPosition_ || this->getOrientation() != this->stampedOrientation_
+                    || this->getVelocity() != this->stampedLinearVelocity_ || this->getAngularVelocity() != this->stampedAngularVelocity_)
+                {
+                    this->server_timestamp_ = getNetworkTime();
+                    this->stampedPosition_ = this->getPosition();
+                    this->stampedOrientation_ = this->getOrientation();
+                    this->stampedLinearVelocity_ = this->getVelocity();
+                    this->stampedAngularVelocity_ = this->getAngularVelocity();
+                }
+            }
+            else if (this->bHasLocalController_)
+            {
+                this->applyPredictionCorrection(dt);
+                this->recordPredictedState();
+                if (this->getScene() && this->getScene()->getLagCompensation())
+                    this->client_view_time_ = this->getScene()->getLagCompensation()->getRemoteViewTime();
+
+                this->timeSinceTargetSent_ += dt;
+                if (this->timeSinceTargetSent_ > TARGET_RESEND_INTERVAL)
+                    this->sendTarget();
+            }
+            else
+                this->interpolateRemoteState();
         }
     }
 
+    /**
+    @brief
+        Stores the current state of the locally controlled entity together with a new sequence number.
+        The server acknowledges the sequence of the last state it applied (see processClientSequence()).
+    */
+    void ControllableEntity::recordPredictedState()
+    {
+        if (this->predictionHistory_.empty())
+            this->predictionHistory_.resize(PREDICTION_HISTORY_SIZE);
+
+        ++this->client_sequence_;
+        PredictedState& state = this->predictionHistory_[this->client_sequence_ % PREDICTION_HISTORY_SIZE];
+        state.sequence = this->client_sequence_;
+        state.position = this->getPosition();
+        state.orientation = this->getOrientation();
+        state.linearVelocity = this->getVelocity();
+        state.angularVelocity = this->getAngularVelocity();
+    }
+
+    /**
+        @brief Returns the predicted state with the given sequence or NULL if it's not in the history anymore.
+    */
+    const ControllableEntity::PredictedState* ControllableEntity::findPredictedState(unsigned int sequence) const
+    {
+        if (this->predictionHistory_.empty() || sequence == 0)
+            return 0;
+
+        const PredictedState& state = this->predictionHistory_[sequence % PREDICTION_HISTORY_SIZE];
+        return (state.sequence == sequence ? &state : 0);
+    }
+
+    /**
+        @brief Applies a part of the remaining correction, so the entity doesn't jump if the prediction was slightly wrong.
+    */
+    void ControllableEntity::applyPredictionCorrection(float dt)
+    {
+        if (this->positionCorrection_ == Vector3::ZERO && this->orientationCorrection_ == Quaternion::IDENTITY)
+            return;
+
+        const float factor = (this->predictionSmoothingTime_ > dt ? dt / this->predictionSmoothingTime_ : 1.0f);
+        if (factor >= 1.0f)
+        {
+            this->setPosition(this->getPosition() + this->positionCorrection_);
+            this->setOrientation(this->orientationCorrection_ * this->getOrientation());
+            this->positionCorrection_ = Vector3::ZERO;
+            this->orientationCorrection_ = Quaternion::IDENTITY;
+            return;
+        }
+
+        const Vector3 positionStep = this->positionCorrection_ * factor;
+        const Quaternion orientationStep = Quaternion::Slerp(factor, Quaternion::IDENTITY, this->orientationCorrection_, true);
+        this->setPosition(this->getPosition() + positionStep);
+        this->setOrientation(orientationStep * this->getOrientation());
+        this->positionCorrection_ -= positionStep;
+        this->orientationCorrection_ = orientationStep.Inverse() * this->orientationCorrection_;
+    }
+
     void ControllableEntity::registerVariables()
     {
         registerVariable(this->cameraPositionTemplate_,  VariableDirection::ToClient);
         registerVariable(this->hudtemplate_,             VariableDirection::ToClient);
 
-        registerVariable(this->server_position_,         VariableDirection::ToClient, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processServerPosition));
-        registerVariable(this->server_linear_velocity_,  VariableDirection::ToClient, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processServerLinearVelocity));
-        registerVariable(this->server_orientation_,      VariableDirection::ToClient, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processServerOrientation));
-        registerVariable(this->server_angular_velocity_, VariableDirection::ToClient, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processServerAngularVelocity));
+        registerVariable(this->server_position_,         VariableDirection::ToClient, &ControllableEntity::processServerPosition);
+        registerVariable(this->server_linear_velocity_,  VariableDirection::ToClient, &ControllableEntity::processServerLinearVelocity);
+        registerVariable(this->server_orientation_,      VariableDirection::ToClient, &ControllableEntity::processServerOrientation);
+        registerVariable(this->server_angular_velocity_, VariableDirection::ToClient, &ControllableEntity::processServerAngularVelocity);
 
-        registerVariable(this->server_overwrite_,        VariableDirection::ToClient, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processOverwrite));
+        registerVariable(this->server_overwrite_,        VariableDirection::ToClient, &ControllableEntity::processOverwrite);
         registerVariable(this->client_overwrite_,        VariableDirection::ToServer);
 
-        registerVariable(this->client_position_,         VariableDirection::ToServer, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processClientPosition));
-        registerVariable(this->client_linear_velocity_,  VariableDirection::ToServer, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processClientLinearVelocity));
-        registerVariable(this->client_orientation_,      VariableDirection::ToServer, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processClientOrientation));
-        registerVariable(this->client_angular_velocity_, VariableDirection::ToServer, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::processClientAngularVelocity));
+        registerVariable(this->client_position_,         VariableDirection::ToServer, &ControllableEntity::processClientPosition);
+        registerVariable(this->client_linear_velocity_,  VariableDirection::ToServer, &ControllableEntity::processClientLinearVelocity);
+        registerVariable(this->client_orientation_,      VariableDirection::ToServer, &ControllableEntity::processClientOrientation);
+        registerVariable(this->client_angular_velocity_, VariableDirection::ToServer, &ControllableEntity::processClientAngularVelocity);
+        registerVariable(this->client_sequence_,         VariableDirection::ToServer, &ControllableEntity::processClientSequence);
+        registerVariable(this->server_acked_sequence_,   VariableDirection::ToClient);
+        registerVariable(this->server_timestamp_,        VariableDirection::ToClient, &ControllableEntity::processServerTimestamp);
+        registerVariable(this->client_view_time_,        VariableDirection::ToServer);
 
 
-        registerVariable(this->playerID_,                VariableDirection::ToClient, new NetworkCallback<ControllableEntity>(this, &ControllableEntity::networkcallback_changedplayerID));
+        registerVariable(this->playerID_,                VariableDirection::ToClient, &ControllableEntity::networkcallback_changedplayerID);
+    }
+
+    void ControllableEntity::getReferencedObjects(std::vector<uint32_t>& objectIDs) const
+    {
+        MobileEntity::getReferencedObjects(objectIDs);
+
+        if (this->playerID_ != OBJECTID_UNKNOWN)
+            objectIDs.push_back(this->playerID_);
     }
 
     void ControllableEntity::processServerPosition()
     {
-        if (!this->bHasLocalController_)
+        if (!this->bHasLocalController_ && (this->interpolationDelay_ <= 0 || this->snapshots_.size() == 0))
             MobileEntity::setPosition(this->server_position_);
     }
 
@@ -545,29 +710,120 @@ namespace orxonox
 
     void ControllableEntity::processServerOrientation()
     {
-        if (!this->bHasLocalController_)
+        if (!this->bHasLocalController_ && (this->interpolationDelay_ <= 0 || this->snapshots_.size() == 0))
             MobileEntity::setOrientation(this->server_orientation_);
     }
 
+    /**
+        @brief Is called on the client if a new server state arrived. Stores the state of remote entities in the snapshot buffer.
+    */
+    void ControllableEntity::processServerTimestamp()
+    {
+        if (this->bHasLocalController_ || this->interpolationDelay_ <= 0)
+            return;
+
+        SnapshotBuffer::Snapshot snapshot;
+        snapshot.time = this->server_timestamp_;
+        snapshot.position = this->server_position_;
+        snapshot.linearVelocity = this->server_linear_velocity_;
+        snapshot.orientation = this->server_orientation_;
+        snapshot.angularVelocity = this->server_angular_velocity_;
+
+        // don't interpolate across teleports
+        if (this->snapshots_.size() > 0)
+        {
+            const SnapshotBuffer::Snapshot& latest = this->snapshots_.getLatest();
+            const Vector3 expected = latest.position + latest.linearVelocity * static_cast<float>(snapshot.time - latest.time);
+            if (expected.squaredDistance(snapshot.position) > this->maxSmoothedCorrection_ * this->maxSmoothedCorrection_)
+                this->snapshots_.clear();
+        }
+
+        this->snapshots_.updateClockOffset(getNetworkTime(), snapshot.time);
+        this->snapshots_.add(snapshot);
+    }
+
+    /**
+        @brief Sets the position and orientation of a remote entity to the interpolated server state of the recent past.
+    */
+    void ControllableEntity::interpolateRemoteState()
+    {
+        if (this->interpolationDelay_ <= 0)
+            return;
+
+        Vector3 position;
+        Quaternion orientation;
+        const double time = this->snapshots_.getServerTime(getNetworkTime()) - this->interpolationDelay_;
+        if (this->snapshots_.sample(time, this->maxExtrapolationTime_, position, orientation))
+        {
+            if (this->getScene() && this->getScene()->getLagCompensation())
+                this->getScene()->getLagCompensation()->setRemoteViewTime(time);
+            MobileEntity::setPosition(position);
+            MobileEntity::setOrientation(orientation);
+        }
+    }
+
     void ControllableEntity::processServerAngularVelocity()
     {
         if (!this->bHasLocalController_)
             MobileEntity::setAngularVelocity(this->server_angular_velocity_);
     }
 
+    /**
+    @brief
+        Is called on the client if the server changed the state of the entity. The server state
+        belongs to the last acknowledged tick of the client, hence the movement which was predicted
+        since then is applied on top of it. Small differences to the current state are spread over
+        the next ticks (see applyPredictionCorrection()), large ones are applied immediately.
+    */
     void ControllableEntity::processOverwrite()
     {
         if (this->bHasLocalController_)
         {
-            this->setPosition(this->server_position_);
-            this->setOrientation(this->server_orientation_);
-            this->setVelocity(this->server_linear_velocity_);
-            this->setAngularVelocity(this->server_angular_velocity_);
+            // the new server state replaces the remaining part of earlier corrections
+            const Vector3 position = this->getPosition();
+            const Quaternion orientation = this->getOrientation();
+            this->positionCorrection_ = Vector3::ZERO;
+            this->orientationCorrection_ = Quaternion::IDENTITY;
+
+            Vector3 targetPosition = this->server_position_;
+            Quaternion targetOrientation = this->server_orientation_;
+            Vector3 targetLinearVelocity = this->server_linear_velocity_;
+            Vector3 targetAngularVelocity = this->server_angular_velocity_;
+
+            const PredictedState* acked = this->findPredictedState(this->server_acked_sequence_);
+            if (acked)
+            {
+                targetPosition += position - acked->position;
+                targetOrientation = targetOrientation * acked->orientation.Inverse() * orientation;
+                targetOrientation.normalise();
+                targetLinearVelocity += this->getVelocity() - acked->linearVelocity;
+                targetAngularVelocity += this->getAngularVelocity() - acked->angularVelocity;
+            }
+
+            this->setVelocity(targetLinearVelocity);
+            this->setAngularVelocity(targetAngularVelocity);
+
+            if (acked && position.squaredDistance(targetPosition) < this->maxSmoothedCorrection_ * this->maxSmoothedCorrection_)
+            {
+                this->positionCorrection_ = targetPosition - position;
+                this->orientationCorrection_ = targetOrientation * orientation.Inverse();
+            }
+            else
+            {
+                this->setPosition(targetPosition);
+                this->setOrientation(targetOrientation);
+            }
 
             this->client_overwrite_ = this->server_overwrite_;
         }
     }
 
+    void ControllableEntity::processClientSequence()
+    {
+        if (this->server_overwrite_ == this->client_overwrite_)
+            this->server_acked_sequence_ = this->client_sequence_;
+    }
+
     void ControllableEntity::processClientPosition()
     {
         if (this->server_overwrite_ == this->client_overwrite_)
@@ -611,6 +867,7 @@ namespace orxonox
             MobileEntity::setPosition(position);
             this->server_position_ = this->getPosition();
             ++this->server_overwrite_;
+            this->server_timestamp_ = getNetworkTime();
         }
         else if (this->bHasLocalController_)
         {
@@ -626,6 +883,7 @@ namespace orxonox
             MobileEntity::setOrientation(orientation);
             this->server_orientation_ = this->getOrientation();
             ++this->server_overwrite_;
+            this->server_timestamp_ = getNetworkTime();
         }
         else if (this->bHasLocalController_)
         {
@@ -641,6 +899,7 @@ namespace orxonox
             MobileEntity::setVelocity(velocity);
             this->server_linear_velocity_ = this->getVelocity();
             ++this->server_overwrite_;
+            this->server_timestamp_ = getNetworkTime();
         }
         else if (this->bHasLocalController_)
         {
@@ -656,6 +915,7 @@ namespace orxonox
             MobileEntity::setAngularVelocity(velocity);
             this->server_angular_velocity_ = this->getAngularVelocity();
             ++this->server_overwrite_;
+            this->server_timestamp_ = getNetworkTime();
         }
         else if (this->bHasLocalController_)
         {
@@ -33,7 +33,9 @@
 
 #include <list>
 #include <string>
+#include <vector>
 #include "util/Math.h"
+#include "util/SnapshotBuffer.h"
 #include "MobileEntity.h"
 
 namespace orxonox
@@ -56,6 +58,7 @@ namespace orxonox
             virtual void XMLPort(Element& xmlelement, XMLPort::Mode mode);
             virtual void tick(float dt);
             void setConfigValues();
+            virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const;
 
             virtual void changedPlayer() {}
 
@@ -150,6 +153,12 @@ namespace orxonox
             inline bool hasHumanController() const
                 { return this->bHasHumanController_; }
 
+            void startViewing();
+            void stopViewing();
+            /// @brief Returns true if the camera and the HUD of this entity are shown without controlling it (see startViewing()).
+            inline bool isViewed() const
+                { return this->bViewed_; }
+
             inline bool isInMouseLook() const
                 { return this->bMouseLook_; }
             inline float getMouseLookSpeed() const
@@ -175,6 +184,10 @@ namespace orxonox
             inline int getTeam() const
                 { return this->team_; }
 
+            /// @brief Returns the server time the controlling client sees remote entities at (0 if unknown). Used for lag compensation.
+            inline double getClientViewTime() const
+                { return this->client_view_time_; }
+
         protected:
             virtual void preDestroy();
 
@@ -194,7 +207,20 @@ namespace orxonox
             Ogre::SceneNode* cameraPositionRootNode_;
 
         private:
+            /// @brief The state of the entity after a tick on the client, used to reconcile the prediction with the server.
+            struct PredictedState
+            {
+                unsigned int sequence;      ///< The value of client_sequence_ when the state was recorded
+                Vector3 position;
+                Quaternion orientation;
+                Vector3 linearVelocity;
+                Vector3 angularVelocity;
+            };
+
+            static const size_t PREDICTION_HISTORY_SIZE = 128; ///< The number of ticks which are kept in predictionHistory_
+
             void registerVariables();
+            void sendTarget();
             void setXMLController(Controller* controller);
 
             void overwrite();
@@ -209,6 +235,13 @@ namespace orxonox
             void processClientLinearVelocity();
             void processClientOrientation();
             void processClientAngularVelocity();
+            void processClientSequence();
+            void processServerTimestamp();
+            void interpolateRemoteState();
+
+            void recordPredictedState();
+            const PredictedState* findPredictedState(unsigned int sequence) const;
+            void applyPredictionCorrection(float dt);
 
             void networkcallback_changedplayerID();
 
@@ -220,6 +253,7 @@ namespace orxonox
 
             bool bHasLocalController_;
             bool bHasHumanController_;
+            bool bViewed_;                      //!< True if the camera and the HUD are shown without controlling the entity
             bool bDestroyWhenPlayerLeft_;
 
             Vector3 server_position_;
@@ -231,6 +265,25 @@ namespace orxonox
             Vector3 server_angular_velocity_;
             Vector3 client_angular_velocity_;
 
+            unsigned int client_sequence_;                  ///< Incremented by the client in each tick
+            unsigned int server_acked_sequence_;            ///< The last client_sequence_ the server applied
+            std::vector<PredictedState> predictionHistory_; ///< Ring buffer with the states of the last ticks (client only)
+            Vector3 positionCorrection_;                    ///< The part of the last correction which wasn't applied yet
+            Quaternion orientationCorrection_;              ///< The part of the last correction which wasn't applied yet
+            float predictionSmoothingTime_;                 ///< The time in seconds over which corrections are spread
+            float maxSmoothedCorrection_;                   ///< Larger corrections (e.g. teleports) are applied immediately
+
+            double server_timestamp_;                       ///< The time of the server (in seconds) when the server state last changed
+            Vector3 stampedPosition_;                       ///< The position when server_timestamp_ was last set (server only)
+            Quaternion stampedOrientation_;                 ///< The orientation when server_timestamp_ was last set (server only)
+            Vector3 stampedLinearVelocity_;                 ///< The linear velocity when server_timestamp_ was last set (server only)
+            Vector3 stampedAngularVelocity_;                ///< The angular velocity when server_timestamp_ was last set (server only)
+            SnapshotBuffer snapshots_;                      ///< The received server states of a remote entity (client only)
+            float interpolationDelay_;                      ///< Remote entities are shown this many seconds in the past
+            float maxExtrapolationTime_;                    ///< The maximal time a remote entity is extrapolated if no new state arrives
+            double client_view_time_;                       ///< The server time at which the controlling client shows the remote entities
+            float timeSinceTargetSent_;                     ///< The target is sent unreliably, so the client repeats it regularly (client only)
+
             PlayerInfo* player_;
             PlayerInfo* formerPlayer_;
             unsigned int playerID_;
@@ -103,8 +103,8 @@ namespace orxonox
 
     void ExplosionChunk::registerVariables()
     {
-        registerVariable((int&)(this->LOD_), VariableDirection::ToClient, new NetworkCallback<ExplosionChunk>(this, &ExplosionChunk::LODchanged));
-        registerVariable(this->bStop_,       VariableDirection::ToClient, new NetworkCallback<ExplosionChunk>(this, &ExplosionChunk::checkStop));
+        registerVariable((int&)(this->LOD_), VariableDirection::ToClient, &ExplosionChunk::LODchanged);
+        registerVariable(this->bStop_,       VariableDirection::ToClient, &ExplosionChunk::checkStop);
     }
 
     void ExplosionChunk::LODchanged()
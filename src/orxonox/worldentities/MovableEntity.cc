@@ -88,11 +88,11 @@ namespace orxonox
 
     void MovableEntity::registerVariables()
     {
-        registerVariable(this->linearVelocity_,        VariableDirection::ToClient, new NetworkCallback<MovableEntity>(this, &MovableEntity::processLinearVelocity));
-        registerVariable(this->angularVelocity_,       VariableDirection::ToClient, new NetworkCallback<MovableEntity>(this, &MovableEntity::processAngularVelocity));
+        registerVariable(this->linearVelocity_,        VariableDirection::ToClient, &MovableEntity::processLinearVelocity);
+        registerVariable(this->angularVelocity_,       VariableDirection::ToClient, &MovableEntity::processAngularVelocity);
 
-        registerVariable(this->overwrite_position_,    VariableDirection::ToClient, new NetworkCallback<MovableEntity>(this, &MovableEntity::overwritePosition));
-        registerVariable(this->overwrite_orientation_, VariableDirection::ToClient, new NetworkCallback<MovableEntity>(this, &MovableEntity::overwriteOrientation));
+        registerVariable(this->overwrite_position_,    VariableDirection::ToClient, &MovableEntity::overwritePosition);
+        registerVariable(this->overwrite_orientation_, VariableDirection::ToClient, &MovableEntity::overwriteOrientation);
     }
 
     void MovableEntity::clientConnected(unsigned int clientID)
@@ -53,8 +53,8 @@ namespace orxonox
 
     void StaticEntity::registerVariables()
     {
-        registerVariable(this->getPosition(),    VariableDirection::ToClient, new NetworkCallback<StaticEntity>(this, &StaticEntity::positionChanged));
-        registerVariable(this->getOrientation(), VariableDirection::ToClient, new NetworkCallback<StaticEntity>(this, &StaticEntity::orientationChanged));
+        registerVariable(this->getPosition(),    VariableDirection::ToClient, &StaticEntity::positionChanged);
+        registerVariable(this->getOrientation(), VariableDirection::ToClient, &StaticEntity::orientationChanged);
     }
 
 
@@ -185,35 +185,45 @@ namespace orxonox
 
     void WorldEntity::registerVariables()
     {
-        registerVariable(this->mainStateName_,  VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::changedMainStateName));
+        registerVariable(this->mainStateName_,  VariableDirection::ToClient, &WorldEntity::changedMainStateName);
 
-        registerVariable(this->bActive_,        VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::changedActivity));
-        registerVariable(this->bVisible_,       VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::changedVisibility));
+        registerVariable(this->bActive_,        VariableDirection::ToClient, &WorldEntity::changedActivity);
+        registerVariable(this->bVisible_,       VariableDirection::ToClient, &WorldEntity::changedVisibility);
 
-        registerVariable(this->getScale3D(),    VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::scaleChanged));
+        registerVariable(this->getScale3D(),    VariableDirection::ToClient, &WorldEntity::scaleChanged);
 
         // Physics stuff
-        registerVariable(this->mass_,           VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::massChanged));
-        registerVariable(this->restitution_,    VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::restitutionChanged));
-        registerVariable(this->angularFactor_,  VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::angularFactorChanged));
-        registerVariable(this->linearDamping_,  VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::linearDampingChanged));
-        registerVariable(this->angularDamping_, VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::angularDampingChanged));
-        registerVariable(this->friction_,       VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::frictionChanged));
+        registerVariable(this->mass_,           VariableDirection::ToClient, &WorldEntity::massChanged);
+        registerVariable(this->restitution_,    VariableDirection::ToClient, &WorldEntity::restitutionChanged);
+        registerVariable(this->angularFactor_,  VariableDirection::ToClient, &WorldEntity::angularFactorChanged);
+        registerVariable(this->linearDamping_,  VariableDirection::ToClient, &WorldEntity::linearDampingChanged);
+        registerVariable(this->angularDamping_, VariableDirection::ToClient, &WorldEntity::angularDampingChanged);
+        registerVariable(this->friction_,       VariableDirection::ToClient, &WorldEntity::frictionChanged);
         registerVariable(this->ccdMotionThreshold_,
-                                                VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::ccdMotionThresholdChanged));
+                                                VariableDirection::ToClient, &WorldEntity::ccdMotionThresholdChanged);
         registerVariable(this->ccdSweptSphereRadius_,
-                                                VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::ccdSweptSphereRadiusChanged));
+                                                VariableDirection::ToClient, &WorldEntity::ccdSweptSphereRadiusChanged);
         registerVariable(this->bCollisionCallbackActive_,
-                                                VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::collisionCallbackActivityChanged));
+                                                VariableDirection::ToClient, &WorldEntity::collisionCallbackActivityChanged);
         registerVariable(this->bCollisionResponseActive_,
-                                                VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::collisionResponseActivityChanged));
+                                                VariableDirection::ToClient, &WorldEntity::collisionResponseActivityChanged);
         registerVariable((int&)this->collisionTypeSynchronised_,
-                                                VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::collisionTypeChanged));
+                                                VariableDirection::ToClient, &WorldEntity::collisionTypeChanged);
         registerVariable(this->bPhysicsActiveSynchronised_,
-                                                VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::physicsActivityChanged));
+                                                VariableDirection::ToClient, &WorldEntity::physicsActivityChanged);
 
         // Attach to parent if necessary
-        registerVariable(this->parentID_,       VariableDirection::ToClient, new NetworkCallback<WorldEntity>(this, &WorldEntity::networkcallback_parentChanged));
+        registerVariable(this->parentID_,       VariableDirection::ToClient, &WorldEntity::networkcallback_parentChanged);
+    }
+
+    /**
+    @brief
+        A joining client needs the parent to attach the WorldEntity (see networkcallback_parentChanged()).
+    */
+    void WorldEntity::getReferencedObjects(std::vector<uint32_t>& objectIDs) const
+    {
+        if (this->parentID_ != OBJECTID_UNKNOWN)
+            objectIDs.push_back(this->parentID_);
     }
 
     /**
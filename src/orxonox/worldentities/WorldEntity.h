@@ -71,6 +71,7 @@ namespace orxonox
     class _OrxonoxExport WorldEntity : public BaseObject, public Synchronisable, public btMotionState
     {
         friend class Scene;
+        friend class LagCompensation;
 
         public:
             // Define our own transform space enum to avoid Ogre includes here
@@ -93,6 +94,7 @@ namespace orxonox
             virtual ~WorldEntity();
 
             virtual void XMLPort(Element& xmlelement, XMLPort::Mode mode);
+            virtual void getReferencedObjects(std::vector<uint32_t>& objectIDs) const;
 
             inline const Ogre::SceneNode* getNode() const
                 { return this->node_; }
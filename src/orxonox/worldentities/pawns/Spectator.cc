@@ -98,8 +98,8 @@ namespace orxonox
 
     void Spectator::registerVariables()
     {
-        registerVariable(this->bGreetingFlareVisible_, VariableDirection::ToClient, new NetworkCallback<Spectator>(this, &Spectator::changedFlareVisibility));
-        registerVariable(this->bGreeting_,             VariableDirection::ToServer, new NetworkCallback<Spectator>(this, &Spectator::changedGreeting));
+        registerVariable(this->bGreetingFlareVisible_, VariableDirection::ToClient, &Spectator::changedFlareVisibility);
+        registerVariable(this->bGreeting_,             VariableDirection::ToServer, &Spectator::changedGreeting);
     }
 
     void Spectator::changedGreeting()
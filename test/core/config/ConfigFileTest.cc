@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include "core/config/ConfigFile.h"
+#include "core/config/ConfigFileManager.h"
+
+namespace orxonox
+{
+    namespace
+    {
+        // Fixture
+        class ConfigFileTest : public ::testing::Test
+        {
+            public:
+                virtual void SetUp()
+                {
+                    // use an absolute path, so the file doesn't depend on PathConfig
+                    this->filepath_ = (boost::filesystem::initial_path() / "ConfigFileTest.ini").string();
+                    boost::filesystem::remove(this->filepath_);
+                }
+
+                virtual void TearDown()
+                {
+                    boost::filesystem::remove(this->filepath_);
+                }
+
+            protected:
+                std::string filepath_;
+        };
+    }
+
+    TEST_F(ConfigFileTest, SetAndGetValue)
+    {
+        ConfigFile file(this->filepath_, false);
+        EXPECT_EQ("", file.getValue("Section", "value", false));
+
+        file.setValue("Section", "value", "123", false);
+        EXPECT_EQ("123", file.getValue("Section", "value", false));
+        EXPECT_EQ("", file.getValue("Section", "other", false));
+        EXPECT_EQ("", file.getValue("Other", "value", false));
+    }
+
+    TEST_F(ConfigFileTest, GetOrCreateValueUsesFallback)
+    {
+        ConfigFile file(this->filepath_, false);
+        EXPECT_EQ("fallback", file.getOrCreateValue("Section", "value", "fallback", false));
+        EXPECT_EQ("fallback", file.getOrCreateValue("Section", "value", "other", false));
+        EXPECT_EQ("fallback", file.getValue("Section", "value", false));
+    }
+
+    TEST_F(ConfigFileTest, VectorValues)
+    {
+        ConfigFile file(this->filepath_, false);
+        EXPECT_EQ(0u, file.getVectorSize("Section", "vector"));
+
+        file.setValue("Section", "vector", 0, "a", false);
+        file.setValue("Section", "vector", 2, "c", false);
+        EXPECT_EQ(3u, file.getVectorSize("Section", "vector"));
+        EXPECT_EQ("a", file.getValue("Section", "vector", 0, false));
+        EXPECT_EQ("", file.getValue("Section", "vector", 1, false));
+        EXPECT_EQ("c", file.getValue("Section", "vector", 2, false));
+
+        file.deleteVectorEntries("Section", "vector", 1);
+        EXPECT_EQ(1u, file.getVectorSize("Section", "vector"));
+        EXPECT_EQ("a", file.getValue("Section", "vector", 0, false));
+        EXPECT_EQ("", file.getValue("Section", "vector", 2, false));
+
+        // the index is valid after removing entries
+        file.setValue("Section", "vector", 1, "b", false);
+        EXPECT_EQ(2u, file.getVectorSize("Section", "vector"));
+        EXPECT_EQ("b", file.getValue("Section", "vector", 1, false));
+    }
+
+    TEST_F(ConfigFileTest, ChangesMarkFileAsDirty)
+    {
+        ConfigFile file(this->filepath_, false);
+        EXPECT_FALSE(file.isDirty());
+
+        file.getOrCreateValue("Section", "value", "1", false);
+        EXPECT_TRUE(file.isDirty());
+
+        file.save();
+        EXPECT_FALSE(file.isDirty());
+
+        // reading or setting the same value is no change
+        file.getOrCreateValue("Section", "value", "2", false);
+        file.setValue("Section", "value", "1", false);
+        EXPECT_FALSE(file.isDirty());
+
+        file.setValue("Section", "value", "2", false);
+        EXPECT_TRUE(file.isDirty());
+    }
+
+    TEST_F(ConfigFileTest, ChangesAreNotSavedImmediately)
+    {
+        ConfigFile file(this->filepath_, false);
+        file.setValue("Section", "value", "1", false);
+        EXPECT_FALSE(boost::filesystem::exists(this->filepath_));
+
+        file.save();
+        EXPECT_TRUE(boost::filesystem::exists(this->filepath_));
+        EXPECT_FALSE(boost::filesystem::exists(this->filepath_ + ".tmp"));
+    }
+
+    TEST_F(ConfigFileTest, SaveAndLoad)
+    {
+        {
+            ConfigFile file(this->filepath_, false);
+            file.setValue("Section1", "value", "1", false);
+            file.setValue("Section1", "string", "text", true);
+            file.setValue("Section2", "vector", 0, "a", false);
+            file.setValue("Section2", "vector", 1, "b", false);
+            // the file is saved by the destructor
+        }
+
+        ConfigFile file(this->filepath_, false);
+        file.load();
+        EXPECT_FALSE(file.isDirty());
+        EXPECT_EQ("1", file.getValue("Section1", "value", false));
+        EXPECT_EQ("text", file.getValue("Section1", "string", true));
+        EXPECT_EQ(2u, file.getVectorSize("Section2", "vector"));
+        EXPECT_EQ("a", file.getValue("Section2", "vector", 0, false));
+        EXPECT_EQ("b", file.getValue("Section2", "vector", 1, false));
+    }
+
+    TEST_F(ConfigFileTest, GetContent)
+    {
+        ConfigFile file(this->filepath_, false);
+        file.setValue("Section", "value", "1", false);
+        file.setValue("Section", "vector", 0, "a", false);
+        EXPECT_EQ("[Section]\nvalue = 1\nvector[0] = a\n\n", file.getContent());
+    }
+
+    TEST_F(ConfigFileTest, ManagerSavesChangedFilesInBackground)
+    {
+        ConfigFileManager manager;
+        manager.setFilename(ConfigFileType::CommandHistory, this->filepath_);
+
+        ConfigFile* file = manager.getConfigFile(ConfigFileType::CommandHistory);
+        file->setValue("Section", "value", "1", false);
+        EXPECT_TRUE(file->isDirty());
+
+        manager.saveChangedFiles();
+        EXPECT_FALSE(file->isDirty());
+
+        manager.waitForPendingWrites();
+        EXPECT_TRUE(boost::filesystem::exists(this->filepath_));
+
+        ConfigFile loadedFile(this->filepath_, false);
+        loadedFile.load();
+        EXPECT_EQ("1", loadedFile.getValue("Section", "value", false));
+    }
+}
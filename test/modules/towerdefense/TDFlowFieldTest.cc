@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "towerdefense/TDFlowField.h"
+
+namespace orxonox
+{
+    namespace
+    {
+        // Walks along the field from (x, y) and returns the number of steps to the goal (or -1 if there's no path).
+        int countSteps(const TDFlowField& field, int x, int y)
+        {
+            int steps = 0;
+            int nextX, nextY;
+            while (field.getNextCell(x, y, nextX, nextY))
+            {
+                if (nextX == x && nextY == y)
+                    return steps;
+                x = nextX;
+                y = nextY;
+                if (++steps > field.getWidth() * field.getHeight())
+                    break;
+            }
+            return -1;
+        }
+    }
+
+    TEST(TDFlowFieldTest, DistancesOnFreeField)
+    {
+        TDFlowField field;
+        field.setSize(5, 5);
+        field.setGoal(4, 4);
+
+        EXPECT_EQ(0, field.getDistance(4, 4));
+        EXPECT_EQ(8, field.getDistance(0, 0));
+        EXPECT_EQ(8, countSteps(field, 0, 0));
+    }
+
+    TEST(TDFlowFieldTest, PathLeadsAroundBlockedCells)
+    {
+        TDFlowField field;
+        field.setSize(3, 3);
+        field.setGoal(2, 0);
+
+        // a wall in the middle column with a gap at the bottom
+        field.setBlocked(1, 0, true);
+        field.setBlocked(1, 1, true);
+
+        EXPECT_EQ(6, field.getDistance(0, 0));
+        EXPECT_EQ(6, countSteps(field, 0, 0));
+
+        field.setBlocked(1, 0, false);
+        EXPECT_EQ(2, field.getDistance(0, 0));
+    }
+
+    TEST(TDFlowFieldTest, CostReroutes)
+    {
+        TDFlowField field;
+        field.setSize(3, 2);
+        field.setGoal(2, 0);
+
+        EXPECT_EQ(2, field.getDistance(0, 0));
+
+        // the direct path gets more expensive than the detour through the second row
+        field.setCost(1, 0, 5);
+        EXPECT_EQ(4, field.getDistance(0, 0));
+
+        field.setCost(1, 0, 0);
+        EXPECT_EQ(2, field.getDistance(0, 0));
+    }
+
+    TEST(TDFlowFieldTest, UnreachableCell)
+    {
+        TDFlowField field;
+        field.setSize(3, 1);
+        field.setGoal(2, 0);
+        field.setBlocked(1, 0, true);
+
+        int nextX, nextY;
+        EXPECT_EQ(TDFlowField::Unreachable, field.getDistance(0, 0));
+        EXPECT_FALSE(field.getNextCell(0, 0, nextX, nextY));
+    }
+
+    TEST(TDFlowFieldTest, BlockedCellLeadsToBestNeighbour)
+    {
+        TDFlowField field;
+        field.setSize(3, 3);
+        field.setGoal(2, 1);
+        field.setBlocked(1, 1, true);
+
+        int nextX, nextY;
+        ASSERT_TRUE(field.getNextCell(1, 1, nextX, nextY));
+        EXPECT_EQ(2, nextX);
+        EXPECT_EQ(1, nextY);
+    }
+
+    TEST(TDFlowFieldTest, WouldDisconnect)
+    {
+        TDFlowField field;
+        field.setSize(3, 2);
+        field.setGoal(2, 0);
+
+        // there's always a detour through the other row
+        EXPECT_FALSE(field.wouldDisconnect(1, 0, 0, 0));
+        EXPECT_TRUE(field.wouldDisconnect(2, 0, 0, 0));
+        EXPECT_TRUE(field.wouldDisconnect(0, 0, 0, 0));
+
+        // only the second row is left
+        field.setBlocked(1, 0, true);
+        EXPECT_TRUE(field.wouldDisconnect(1, 1, 0, 0));
+        EXPECT_FALSE(field.wouldDisconnect(0, 1, 2, 1));
+    }
+
+    TEST(TDFlowFieldTest, WouldDisconnectAnyCell)
+    {
+        TDFlowField field;
+        field.setSize(4, 3);
+        field.setGoal(3, 0);
+        field.setBlocked(1, 0, true);
+        field.setBlocked(1, 2, true);
+
+        // (1, 1) is the only gap in the wall, it connects the spawn to the goal
+        std::vector<std::pair<int, int> > cells;
+        cells.push_back(std::make_pair(3, 2));
+        EXPECT_FALSE(field.wouldDisconnect(2, 1, cells));
+
+        cells.push_back(std::make_pair(0, 0));
+        EXPECT_TRUE(field.wouldDisconnect(1, 1, cells));
+        EXPECT_FALSE(field.wouldDisconnect(2, 2, cells));
+
+        // a cell which is cut off anyway doesn't prevent blocking
+        field.setBlocked(1, 1, true);
+        EXPECT_FALSE(field.wouldDisconnect(2, 1, cells));
+    }
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "util/Metrics.h"
+
+namespace orxonox
+{
+    namespace
+    {
+        std::vector<double> getBounds()
+        {
+            std::vector<double> bounds;
+            bounds.push_back(10);
+            bounds.push_back(1);
+            return bounds;
+        }
+
+        std::string convert(const std::string& stream, size_t* numSnapshots = 0)
+        {
+            std::istringstream input(stream);
+            MetricsReader reader;
+            EXPECT_TRUE(reader.readStreamHeader(input));
+
+            std::string lines;
+            while (reader.readRecord(input, lines, "test"));
+            EXPECT_EQ("", reader.getError());
+
+            if (numSnapshots)
+                *numSnapshots = reader.getNumSnapshots();
+            return lines;
+        }
+    }
+
+    TEST(MetricsRegistryTest, RegisterReturnsSameMetric)
+    {
+        MetricsRegistry registry;
+        MetricCounter& counter1 = registry.registerCounter("counter");
+        MetricCounter& counter2 = registry.registerCounter("counter");
+        MetricGauge& gauge = registry.registerGauge("gauge");
+
+        EXPECT_EQ(&counter1, &counter2);
+        EXPECT_EQ(0u, counter1.getID());
+        EXPECT_EQ(1u, gauge.getID());
+        EXPECT_EQ(&gauge, registry.getMetric("gauge"));
+        EXPECT_TRUE(registry.getMetric("unknown") == 0);
+        EXPECT_EQ(2u, registry.getMetrics().size());
+    }
+
+    TEST(MetricsRegistryTest, HistogramSortsSamplesIntoBuckets)
+    {
+        MetricsRegistry registry;
+        MetricHistogram& histogram = registry.registerHistogram("histogram", getBounds());
+
+        ASSERT_EQ(2u, histogram.getBounds().size());
+        EXPECT_EQ(1, histogram.getBounds()[0]);
+        EXPECT_EQ(10, histogram.getBounds()[1]);
+
+        histogram.sample(0.5);
+        histogram.sample(1);
+        histogram.sample(5);
+        histogram.sample(20);
+
+        MetricValue value;
+        histogram.getValue(value);
+        EXPECT_EQ(4u, value.count);
+        EXPECT_EQ(26.5, value.sum);
+        EXPECT_EQ(20, value.max);
+        ASSERT_EQ(3u, value.buckets.size());
+        EXPECT_EQ(2u, value.buckets[0]);
+        EXPECT_EQ(1u, value.buckets[1]);
+        EXPECT_EQ(1u, value.buckets[2]);
+
+        registry.resetIntervals();
+        EXPECT_EQ(0u, histogram.getCount());
+    }
+
+    TEST(MetricsRegistryTest, WritesLineProtocol)
+    {
+        MetricsRegistry registry;
+        registry.registerCounter("packets").add(3);
+        registry.registerGauge("players").set(2.5);
+
+        std::string lines;
+        registry.writeLineProtocol(lines, "server", 2.0);
+        EXPECT_EQ("packets,instance=server value=3i 2000000000\nplayers,instance=server value=2.5 2000000000\n", lines);
+    }
+
+    TEST(MetricsRegistryTest, BinaryStreamMatchesLineProtocol)
+    {
+        MetricsRegistry registry;
+        MetricCounter& counter = registry.registerCounter("packets");
+        registry.registerGauge("players").set(4);
+        MetricHistogram& histogram = registry.registerHistogram("tick", getBounds());
+
+        counter.add(7);
+        histogram.sample(0.5);
+        histogram.sample(100);
+
+        std::string stream;
+        MetricsRegistry::writeStreamHeader(stream);
+        registry.writeDefinitions(stream);
+        registry.writeSnapshot(stream, 1.5);
+
+        std::string expected;
+        registry.writeLineProtocol(expected, "test", 1.5);
+        EXPECT_EQ("tick,instance=test count=2i,sum=100.5,max=100,le_1=1i,le_10=0i,le_inf=1i 1500000000\n", expected.substr(expected.find("tick")));
+
+        size_t numSnapshots = 0;
+        EXPECT_EQ(expected, convert(stream, &numSnapshots));
+        EXPECT_EQ(1u, numSnapshots);
+    }
+
+    TEST(MetricsRegistryTest, BinaryStreamWithManyHistogramBounds)
+    {
+        std::vector<double> bounds;
+        for (size_t i = 0; i < 300; ++i)
+            bounds.push_back(static_cast<double>(i));
+
+        MetricsRegistry registry;
+        MetricHistogram& histogram = registry.registerHistogram("histogram", bounds);
+        histogram.sample(299);
+        histogram.sample(1000);
+
+        std::string stream;
+        MetricsRegistry::writeStreamHeader(stream);
+        registry.writeDefinitions(stream);
+        registry.writeSnapshot(stream, 1.0);
+
+        std::string expected;
+        registry.writeLineProtocol(expected, "test", 1.0);
+        EXPECT_NE(std::string::npos, expected.find(",le_299=1i,le_inf=1i "));
+        EXPECT_EQ(expected, convert(stream));
+    }
+
+    TEST(MetricsRegistryTest, BinaryStreamWithLateDefinitions)
+    {
+        MetricsRegistry registry;
+        registry.registerCounter("first").add(1);
+
+        std::string stream;
+        MetricsRegistry::writeStreamHeader(stream);
+        registry.writeDefinitions(stream);
+        registry.writeSnapshot(stream, 1.0);
+
+        // a metric registered after the first snapshot needs only its own definition
+        registry.registerGauge("second").set(2);
+        registry.writeDefinitions(stream, 1);
+        registry.writeSnapshot(stream, 2.0);
+
+        size_t numSnapshots = 0;
+        EXPECT_EQ("first,instance=test value=1i 1000000000\n"
+                  "first,instance=test value=1i 2000000000\n"
+                  "second,instance=test value=2 2000000000\n", convert(stream, &numSnapshots));
+        EXPECT_EQ(2u, numSnapshots);
+    }
+
+    TEST(MetricsReaderTest, RejectsInvalidStreams)
+    {
+        std::istringstream input("not a metrics stream");
+        MetricsReader reader;
+        EXPECT_FALSE(reader.readStreamHeader(input));
+        EXPECT_NE("", reader.getError());
+    }
+
+    TEST(MetricsReaderTest, DetectsTruncatedStreams)
+    {
+        MetricsRegistry registry;
+        registry.registerCounter("counter");
+
+        std::string stream;
+        MetricsRegistry::writeStreamHeader(stream);
+        registry.writeDefinitions(stream);
+        registry.writeSnapshot(stream, 1.0);
+        stream.resize(stream.size() - 3);
+
+        std::istringstream input(stream);
+        MetricsReader reader;
+        ASSERT_TRUE(reader.readStreamHeader(input));
+
+        std::string lines;
+        EXPECT_TRUE(reader.readRecord(input, lines, ""));
+        EXPECT_FALSE(reader.readRecord(input, lines, ""));
+        EXPECT_NE("", reader.getError());
+        EXPECT_EQ("", lines);
+    }
+}
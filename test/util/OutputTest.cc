@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "util/Output.h"
+#include "util/output/OutputListener.h"
+#include "util/SharedPtr.h"
 
 namespace orxonox
 {
@@ -46,4 +48,64 @@ namespace orxonox
         EXPECT_EQ(context::unittest().name, stream.getOutputContext()->name);
         EXPECT_EQ(context::unittest().sub_id, stream.getOutputContext()->sub_id);
     }
+
+    namespace
+    {
+        class TestOutputListener : public OutputListener
+        {
+            protected:
+                virtual void output(OutputLevel, const OutputContextContainer&, const std::vector<std::string>&) {}
+        };
+
+        int countedArgument(int* counter)
+        {
+            return ++(*counter);
+        }
+    }
+
+    // Fixture
+    class OutputTestWithoutListeners : public ::testing::Test
+    {
+        public:
+            virtual void SetUp()
+            {
+                // create a new OutputManager with the default listeners, then remove all listeners to mask out all output
+                OutputManager::Testing::getInstancePointer() = new OutputManager();
+                while (!OutputManager::getInstanceAndCreateListeners().getListeners().empty())
+                    OutputManager::getInstance().unregisterListener(OutputManager::getInstance().getListeners()[0]);
+            }
+
+            virtual void TearDown()
+            {
+                OutputManager::Testing::getInstancePointer() = new OutputManager();
+            }
+    };
+
+    TEST_F(OutputTestWithoutListeners, OrxoutFilteredDoesNotEvaluateArgumentsIfOutputIsNotAccepted)
+    {
+        int counter = 0;
+        orxout_filtered(verbose, context::unittest) << countedArgument(&counter) << endl;
+        EXPECT_EQ(0, counter);
+    }
+
+    TEST_F(OutputTestWithoutListeners, OrxoutFilteredEvaluatesArgumentsIfOutputIsAccepted)
+    {
+        TestOutputListener listener;
+        listener.setLevelMask(level::all);
+
+        int counter = 0;
+        orxout_filtered(verbose, context::unittest) << countedArgument(&counter) << endl;
+        orxout_filtered(verbose, context::unittest()) << countedArgument(&counter) << endl;
+        EXPECT_EQ(2, counter);
+    }
+
+    TEST_F(OutputTestWithoutListeners, OrxoutFilteredCanBeUsedInIfStatementWithoutBraces)
+    {
+        bool bElseBranch = false;
+        if (false)
+            orxout_filtered(user_error, context::unittest) << "test" << endl;
+        else
+            bElseBranch = true;
+        EXPECT_TRUE(bElseBranch);
+    }
 }
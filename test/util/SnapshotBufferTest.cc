@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "util/SnapshotBuffer.h"
+
+namespace orxonox
+{
+    namespace
+    {
+        SnapshotBuffer::Snapshot createSnapshot(double time, const Vector3& position, const Vector3& velocity)
+        {
+            SnapshotBuffer::Snapshot snapshot;
+            snapshot.time = time;
+            snapshot.position = position;
+            snapshot.linearVelocity = velocity;
+            return snapshot;
+        }
+    }
+
+    TEST(SnapshotBufferTest, EmptyBuffer)
+    {
+        SnapshotBuffer buffer;
+        Vector3 position;
+        Quaternion orientation;
+        EXPECT_FALSE(buffer.sample(1.0f, 0.1f, position, orientation));
+    }
+
+    TEST(SnapshotBufferTest, IgnoresOldSnapshots)
+    {
+        SnapshotBuffer buffer;
+        buffer.add(createSnapshot(1.0f, Vector3(1, 0, 0), Vector3::ZERO));
+        buffer.add(createSnapshot(0.5f, Vector3(2, 0, 0), Vector3::ZERO));
+        buffer.add(createSnapshot(1.0f, Vector3(3, 0, 0), Vector3::ZERO));
+        EXPECT_EQ(1u, buffer.size());
+        EXPECT_EQ(Vector3(1, 0, 0), buffer.getLatest().position);
+    }
+
+    TEST(SnapshotBufferTest, RemovesOldestIfFull)
+    {
+        SnapshotBuffer buffer(3);
+        for (int i = 0; i < 5; ++i)
+            buffer.add(createSnapshot(static_cast<float>(i), Vector3(static_cast<float>(i), 0, 0), Vector3::ZERO));
+        EXPECT_EQ(3u, buffer.size());
+
+        Vector3 position;
+        Quaternion orientation;
+        ASSERT_TRUE(buffer.sample(0.0f, 0.1f, position, orientation));
+        EXPECT_FLOAT_EQ(2.0f, position.x);
+    }
+
+    TEST(SnapshotBufferTest, InterpolatesConstantMotionExactly)
+    {
+        SnapshotBuffer buffer;
+        buffer.add(createSnapshot(0.0f, Vector3(0, 0, 0), Vector3(10, 0, 0)));
+        buffer.add(createSnapshot(0.1f, Vector3(1, 0, 0), Vector3(10, 0, 0)));
+        buffer.add(createSnapshot(0.2f, Vector3(2, 0, 0), Vector3(10, 0, 0)));
+
+        Vector3 position;
+        Quaternion orientation;
+        ASSERT_TRUE(buffer.sample(0.15f, 0.1f, position, orientation));
+        EXPECT_NEAR(1.5f, position.x, 0.0001f);
+        ASSERT_TRUE(buffer.sample(0.025f, 0.1f, position, orientation));
+        EXPECT_NEAR(0.25f, position.x, 0.0001f);
+    }
+
+    TEST(SnapshotBufferTest, InterpolatesAfterOneDayOfServerTime)
+    {
+        // a float would only resolve about 8 ms at this time
+        const double day = 24 * 60 * 60;
+        SnapshotBuffer buffer;
+        buffer.add(createSnapshot(day, Vector3(0, 0, 0), Vector3(10, 0, 0)));
+        buffer.add(createSnapshot(day + 0.05, Vector3(0.5f, 0, 0), Vector3(10, 0, 0)));
+
+        Vector3 position;
+        Quaternion orientation;
+        ASSERT_TRUE(buffer.sample(day + 0.025, 0.1f, position, orientation));
+        EXPECT_NEAR(0.25f, position.x, 0.0001f);
+        ASSERT_TRUE(buffer.sample(day + 0.001, 0.1f, position, orientation));
+        EXPECT_NEAR(0.01f, position.x, 0.0001f);
+    }
+
+    TEST(SnapshotBufferTest, HitsSnapshotPositions)
+    {
+        SnapshotBuffer buffer;
+        buffer.add(createSnapshot(0.0f, Vector3(0, 0, 0), Vector3(0, 5, 0)));
+        buffer.add(createSnapshot(0.5f, Vector3(3, 1, 0), Vector3(-2, 0, 0)));
+        buffer.add(createSnapshot(1.0f, Vector3(4, 4, 4), Vector3(0, 0, 0)));
+
+        Vector3 position;
+        Quaternion orientation;
+        ASSERT_TRUE(buffer.sample(0.5f, 0.1f, position, orientation));
+        EXPECT_NEAR(3.0f, position.x, 0.0001f);
+        EXPECT_NEAR(1.0f, position.y, 0.0001f);
+    }
+
+    TEST(SnapshotBufferTest, ExtrapolationIsBounded)
+    {
+        SnapshotBuffer buffer;
+        buffer.add(createSnapshot(1.0f, Vector3(0, 0, 0), Vector3(10, 0, 0)));
+
+        Vector3 position;
+        Quaternion orientation;
+        ASSERT_TRUE(buffer.sample(1.05f, 0.2f, position, orientation));
+        EXPECT_NEAR(0.5f, position.x, 0.0001f);
+        ASSERT_TRUE(buffer.sample(5.0f, 0.2f, position, orientation));
+        EXPECT_NEAR(2.0f, position.x, 0.0001f);
+    }
+
+    TEST(SnapshotBufferTest, InterpolatesOrientation)
+    {
+        SnapshotBuffer buffer;
+        SnapshotBuffer::Snapshot first = createSnapshot(0.0f, Vector3::ZERO, Vector3::ZERO);
+        SnapshotBuffer::Snapshot second = createSnapshot(1.0f, Vector3::ZERO, Vector3::ZERO);
+        second.orientation = Quaternion(Degree(90), Vector3::UNIT_Y);
+        buffer.add(first);
+        buffer.add(second);
+
+        Vector3 position;
+        Quaternion orientation;
+        ASSERT_TRUE(buffer.sample(0.5f, 0.1f, position, orientation));
+        EXPECT_TRUE(orientation.equals(Quaternion(Degree(45), Vector3::UNIT_Y), Degree(0.01f)));
+    }
+
+    TEST(SnapshotBufferTest, ClockOffsetFollowsLowestLatency)
+    {
+        SnapshotBuffer buffer;
+        buffer.updateClockOffset(10.2f, 0.0f);
+        EXPECT_NEAR(10.0f, buffer.getServerTime(20.2f), 0.0001f);
+
+        buffer.updateClockOffset(10.3f, 0.2f);
+        EXPECT_NEAR(10.1f, buffer.getServerTime(20.2f), 0.0001f);
+
+        // a late snapshot only changes the offset slightly
+        buffer.updateClockOffset(11.0f, 0.3f);
+        EXPECT_NEAR(10.1f, buffer.getServerTime(20.2f), 0.01f);
+    }
+}
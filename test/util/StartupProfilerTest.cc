@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "util/StartupProfiler.h"
+#include "util/Metrics.h"
+
+namespace orxonox
+{
+    TEST(StartupProfilerTest, BeginPhaseEndsPreviousPhase)
+    {
+        StartupProfiler profiler;
+        profiler.beginPhase("modules", 100);
+        profiler.beginPhase("config", 300);
+        profiler.finish(600);
+
+        ASSERT_EQ(2u, profiler.getPhases().size());
+        EXPECT_EQ("modules", profiler.getPhases()[0].name);
+        EXPECT_EQ(100u, profiler.getPhases()[0].begin);
+        EXPECT_EQ(200u, profiler.getPhases()[0].duration);
+        EXPECT_EQ("config", profiler.getPhases()[1].name);
+        EXPECT_EQ(300u, profiler.getPhases()[1].begin);
+        EXPECT_EQ(300u, profiler.getPhases()[1].duration);
+        EXPECT_EQ(600u, profiler.getTotalTime());
+    }
+
+    TEST(StartupProfilerTest, EndPhaseLeavesGap)
+    {
+        StartupProfiler profiler;
+        profiler.beginPhase("modules", 0);
+        profiler.endPhase(50);
+        profiler.endPhase(80);
+        profiler.beginPhase("config", 100);
+        profiler.finish(150);
+
+        ASSERT_EQ(2u, profiler.getPhases().size());
+        EXPECT_EQ(50u, profiler.getPhases()[0].duration);
+        EXPECT_EQ(50u, profiler.getPhases()[1].duration);
+    }
+
+    TEST(StartupProfilerTest, IgnoresPhasesAfterFinish)
+    {
+        StartupProfiler profiler;
+        profiler.beginPhase("modules", 0);
+        EXPECT_FALSE(profiler.isFinished());
+        profiler.finish(10);
+        EXPECT_TRUE(profiler.isFinished());
+
+        profiler.beginPhase("late", 20);
+        profiler.finish(30);
+
+        ASSERT_EQ(1u, profiler.getPhases().size());
+        EXPECT_EQ(10u, profiler.getTotalTime());
+    }
+
+    TEST(StartupProfilerTest, FinishPublishesMetrics)
+    {
+        StartupProfiler profiler;
+        profiler.beginPhase("test_modules", 0);
+        profiler.beginPhase("test_state", 1000);
+        profiler.beginPhase("test_modules", 3000);
+        profiler.finish(7000);
+
+        MetricGauge* modules = dynamic_cast<MetricGauge*>(MetricsRegistry::getInstance().getMetric("startup.test_modules"));
+        MetricGauge* state = dynamic_cast<MetricGauge*>(MetricsRegistry::getInstance().getMetric("startup.test_state"));
+        MetricGauge* total = dynamic_cast<MetricGauge*>(MetricsRegistry::getInstance().getMetric("startup.total"));
+        ASSERT_TRUE(modules != NULL);
+        ASSERT_TRUE(state != NULL);
+        ASSERT_TRUE(total != NULL);
+        EXPECT_DOUBLE_EQ(0.005, modules->getGauge());
+        EXPECT_DOUBLE_EQ(0.002, state->getGauge());
+        EXPECT_DOUBLE_EQ(0.007, total->getGauge());
+    }
+
+    TEST(StartupProfilerTest, TraceContainsAllPhases)
+    {
+        StartupProfiler profiler;
+        profiler.beginPhase("modules", 0);
+        profiler.beginPhase("config", 2000);
+        profiler.finish(4000);
+
+        const std::string& trace = profiler.getTrace();
+        EXPECT_NE(std::string::npos, trace.find("total 4.0 ms"));
+        EXPECT_NE(std::string::npos, trace.find("modules"));
+        EXPECT_NE(std::string::npos, trace.find("config"));
+        EXPECT_NE(std::string::npos, trace.find("50.0%"));
+    }
+}
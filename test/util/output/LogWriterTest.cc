@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
 #include "util/Output.h"
 #include "util/output/LogWriter.h"
 #include "util/Convert.h"
@@ -13,10 +14,30 @@ namespace orxonox
                 virtual void printLine(const std::string& line, OutputLevel level)
                     { this->LogWriter::printLine(line, level); }
         };
+
+        // Fixture
+        class LogWriterTest : public ::testing::Test
+        {
+            public:
+                virtual void SetUp()
+                {
+                    // write the log files to an empty temporary directory instead of the working directory
+                    this->directory_ = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("LogWriterTest-%%%%-%%%%-%%%%")).string();
+                    boost::filesystem::create_directory(this->directory_);
+                }
+
+                virtual void TearDown()
+                {
+                    boost::filesystem::remove_all(this->directory_);
+                }
+
+            protected:
+                std::string directory_;
+        };
     }
 
     // test constructor opens file
-    TEST(LogWriterTest, ConstructorOpensFile)
+    TEST_F(LogWriterTest, ConstructorOpensFile)
     {
         LogWriter logWriter;
         EXPECT_TRUE(logWriter.getFile().is_open());
@@ -56,33 +77,20 @@ namespace orxonox
         return !getLineWhichContains(path, message).empty();
     }
 
-    bool deleteFile(const std::string& path)
+    TEST_F(LogWriterTest, SetLogDirectoryOpensNewFile)
     {
-        bool result = std::remove(path.c_str()) == 0;
-        EXPECT_FALSE(fileExists(path));
-        return result;
-    }
-
-    TEST(LogWriterTest, SetLogDirectoryOpensNewFile)
-    {
-        std::string path = "./orxonox.log";
-
-        // cleanup before test
-        deleteFile(path);
+        std::string path = this->directory_ + "/orxonox.log";
 
         {
             LogWriter logWriter;
             EXPECT_FALSE(fileExists(path));
-            logWriter.setLogDirectory(".");
+            logWriter.setLogDirectory(this->directory_);
             EXPECT_TRUE(fileExists(path));
         }
-
-        // cleanup after test
-        EXPECT_TRUE(deleteFile(path));
     }
 
     // prints output to logfile
-    TEST(LogWriterTest, PrintsOutputToLogfile)
+    TEST_F(LogWriterTest, PrintsOutputToLogfile)
     {
         std::string path;
 
@@ -92,7 +100,7 @@ namespace orxonox
             lines.push_back("mytestoutput");
 
             LogWriter logWriter;
-            logWriter.setLogDirectory(".");
+            logWriter.setLogDirectory(this->directory_);
             logWriter.unfilteredOutput(level::debug_output, context::undefined(), lines);
 
             path = logWriter.getPath();
@@ -102,7 +110,7 @@ namespace orxonox
     }
 
     // prints time to logfile
-    TEST(LogWriterTest, PrintsTimestampToLogfile)
+    TEST_F(LogWriterTest, PrintsTimestampToLogfile)
     {
         std::string path;
 
@@ -112,7 +120,7 @@ namespace orxonox
             lines.push_back("myothertestoutput");
 
             LogWriter logWriter;
-            logWriter.setLogDirectory(".");
+            logWriter.setLogDirectory(this->directory_);
             logWriter.unfilteredOutput(level::debug_output, context::undefined(), lines);
 
             path = logWriter.getPath();
@@ -131,34 +139,13 @@ namespace orxonox
         EXPECT_EQ(' ', line[8]);
     }
 
-    void deleteAllLogFiles()
-    {
-        std::string path;
-        {
-            LogWriter writer;
-            path = writer.getPath();
-        }
-
-        deleteFile(path);
-        deleteFile(path + ".1");
-        deleteFile(path + ".2");
-        deleteFile(path + ".3");
-        deleteFile(path + ".4");
-        deleteFile(path + ".5");
-        deleteFile(path + ".6");
-        deleteFile(path + ".7");
-        deleteFile(path + ".8");
-        deleteFile(path + ".9");
-    }
-
-    TEST(LogWriterTest, ArchivesOldLogFile)
+    TEST_F(LogWriterTest, ArchivesOldLogFile)
     {
-        deleteAllLogFiles();
-
         std::string path;
 
         {
             MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
             path = writer.getPath();
             writer.printLine("test1", level::message);
         }
@@ -171,6 +158,7 @@ namespace orxonox
 
         {
             MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
             writer.printLine("test2", level::message);
         }
 
@@ -183,6 +171,7 @@ namespace orxonox
 
         {
             MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
             writer.printLine("test3", level::message);
         }
 
@@ -195,14 +184,13 @@ namespace orxonox
         EXPECT_FALSE(fileExists(path + ".3"));
     }
 
-    TEST(LogWriterTest, ArchivesNineLogFiles)
+    TEST_F(LogWriterTest, ArchivesNineLogFiles)
     {
-        deleteAllLogFiles();
-
         std::string path;
         for (int i = 0; i < 20; ++i)
         {
             MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
             path = writer.getPath();
             writer.printLine("test" + multi_cast<std::string>(i), level::message);
         }
@@ -220,4 +208,83 @@ namespace orxonox
         EXPECT_FALSE(fileExists(path + ".10"));
         EXPECT_FALSE(fileExists(path + ".11"));
     }
+
+    TEST_F(LogWriterTest, SetAsynchronousStartsAndStopsWriterThread)
+    {
+        LogWriter logWriter;
+        EXPECT_FALSE(logWriter.isAsynchronous());
+        logWriter.setAsynchronous(true);
+        EXPECT_TRUE(logWriter.isAsynchronous());
+        logWriter.setAsynchronous(false);
+        EXPECT_FALSE(logWriter.isAsynchronous());
+    }
+
+    TEST_F(LogWriterTest, AsynchronousPrintsOutputToLogfileAfterFlush)
+    {
+        std::string path;
+
+        {
+            MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
+            writer.setAsynchronous(true);
+            path = writer.getPath();
+
+            for (int i = 0; i < 100; ++i)
+                writer.printLine("asynctest" + multi_cast<std::string>(i), level::message);
+
+            writer.flush();
+
+            EXPECT_TRUE(fileContains(path, "asynctest0"));
+            EXPECT_TRUE(fileContains(path, "asynctest99"));
+        }
+
+        EXPECT_TRUE(fileContains(path, "Log file closed"));
+    }
+
+    TEST_F(LogWriterTest, AsynchronousWritesQueuedOutputInDestructor)
+    {
+        std::string path;
+
+        {
+            MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
+            writer.setAsynchronous(true);
+            path = writer.getPath();
+
+            writer.printLine("asyncdestructortest", level::message);
+        }
+
+        EXPECT_TRUE(fileContains(path, "asyncdestructortest"));
+    }
+
+    TEST_F(LogWriterTest, AsynchronousBlockingDoesNotLoseOutput)
+    {
+        std::string path;
+
+        {
+            MockLogWriter writer;
+            writer.setLogDirectory(this->directory_);
+            writer.setQueueCapacity(2);
+            writer.setOverflowPolicy(LogWriter::BlockCaller);
+            writer.setAsynchronous(true);
+            path = writer.getPath();
+
+            for (int i = 0; i < 100; ++i)
+                writer.printLine("blockingtest" + multi_cast<std::string>(i), level::message);
+
+            EXPECT_EQ(0u, writer.getNumDroppedLines());
+        }
+
+        for (int i = 0; i < 100; ++i)
+            EXPECT_TRUE(fileContains(path, "blockingtest" + multi_cast<std::string>(i)));
+    }
+
+    TEST_F(LogWriterTest, SetQueueCapacity)
+    {
+        LogWriter logWriter;
+        logWriter.setQueueCapacity(10);
+        EXPECT_EQ(10u, logWriter.getQueueCapacity());
+        logWriter.setQueueCapacity(0);
+        EXPECT_EQ(1u, logWriter.getQueueCapacity());
+    }
 }
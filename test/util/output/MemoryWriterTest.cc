@@ -43,4 +43,44 @@ namespace orxonox
 
         writer.resendOutput(&other);
     }
+
+    TEST(MemoryWriterTest, MaxMessagesDiscardsOldestMessages)
+    {
+        MemoryWriter writer;
+        writer.setMaxMessages(2);
+
+        std::vector<std::string> lines1(1, "first");
+        std::vector<std::string> lines2(1, "second");
+        std::vector<std::string> lines3(1, "third");
+
+        writer.unfilteredOutput(level::user_info, context::undefined(), lines1);
+        writer.unfilteredOutput(level::user_info, context::undefined(), lines2);
+        writer.unfilteredOutput(level::user_info, context::undefined(), lines3);
+
+        EXPECT_EQ(2u, writer.getNumMessages());
+        EXPECT_EQ(1u, writer.getNumDiscardedMessages());
+
+        MockOutputListener other;
+        other.setLevelMask(level::all);
+
+        EXPECT_CALL(other, output(level::internal_warning, context::undefined(), testing::_));
+        EXPECT_CALL(other, output(level::user_info, context::undefined(), lines2));
+        EXPECT_CALL(other, output(level::user_info, context::undefined(), lines3));
+
+        writer.resendOutput(&other);
+    }
+
+    TEST(MemoryWriterTest, SetMaxMessagesTruncatesStoredMessages)
+    {
+        MemoryWriter writer;
+
+        std::vector<std::string> lines(1, "line");
+        for (int i = 0; i < 10; ++i)
+            writer.unfilteredOutput(level::user_info, context::undefined(), lines);
+
+        EXPECT_EQ(10u, writer.getNumMessages());
+        writer.setMaxMessages(3);
+        EXPECT_EQ(3u, writer.getNumMessages());
+        EXPECT_EQ(7u, writer.getNumDiscardedMessages());
+    }
 }